@@ -61,6 +61,9 @@ public:
 private:
     void Init(const std::string &abilityInfo);
     DCamRetCode CreateDStreamOperator();
+    OHOS::sptr<DOfflineStreamOperator> GetOfflineStreamOperator(int streamId);
+    void ReleaseOfflineStreamOperator();
+    void OnOfflineStreamsFinished(const DOfflineStreamOperator *offlineOperator);
     std::string GenerateCameraId(const std::shared_ptr<DHBase> &dhBase);
 
 private:
@@ -72,6 +75,8 @@ private:
     OHOS::sptr<IDCameraProviderCallback> dCameraProviderCallback_;
     OHOS::sptr<DStreamOperator> dCameraStreamOperator_;
     std::shared_ptr<DMetadataProcessor> dMetadataProcessor_;
+    OHOS::sptr<DOfflineStreamOperator> dCameraOfflineOperator_;
+    std::mutex offlineLock_;
 
     std::mutex openSesslock_;
     std::condition_variable openSessCV_;
@@ -18,6 +18,7 @@
 
 #include <set>
 #include <map>
+#include <mutex>
 #include <vector>
 #include "constants.h"
 #include "dcamera.h"
@@ -58,9 +59,14 @@ private:
     DCamRetCode InitDCameraOutputAbilityKeys(const std::string &abilityInfo);
     DCamRetCode AddAbilityEntry(uint32_t tag, const void *data, size_t size);
     DCamRetCode UpdateAbilityEntry(uint32_t tag, const void *data, size_t size);
-    void ConvertToCameraMetadata(common_metadata_header_t *&input,
-                                 std::shared_ptr<CameraStandard::CameraMetadata> &output);
-    void ResizeMetadataHeader(common_metadata_header_t *header, uint32_t itemCapacity, uint32_t dataCapacity);
+    void InitResultMetadataStore();
+    DCamRetCode ApplyResultSnapshot(const std::shared_ptr<CameraStandard::CameraMetadata> &snapshot);
+    DCamRetCode ApplyResultDelta(const std::shared_ptr<CameraStandard::CameraMetadata> &delta);
+    DCamRetCode UpdateResultEntry(const camera_metadata_item_t &item);
+    DCamRetCode CloneResultMetadata(uint32_t itemCapacity, uint32_t dataCapacity,
+        const common_metadata_header_t *source);
+    void SetResultBit(std::vector<uint64_t> &bits, uint32_t tag, bool isSet);
+    bool IsSameMetadataItem(const camera_metadata_item_t &item, const camera_metadata_item_t &anoItem);
     uint32_t GetDataSize(uint32_t type);
     std::map<int, std::vector<DCResolution>> GetDCameraSupportedFormats(const std::string &abilityInfo);
 
@@ -70,15 +76,23 @@ private:
     std::string dCameraPosition_;
     DCResolution maxPreviewResolution_;
     DCResolution maxPhotoResolution_;
+    uint32_t maxFps_ = MAX_SUPPORT_DEFAULT_FPS;
     ResultCallbackMode metaResultMode_;
     std::set<MetaType> allResultSet_;
     std::set<MetaType> enabledResultSet_;
 
-    // The latest result metadata that received from the sink device.
-    common_metadata_header_t *latestProducerResultMetadata_;
-
-    // The latest result metadata that replied to the camera service.
-    common_metadata_header_t *latestConsumerResultMetadata_;
+    // The result metadata rebuilt from the snapshots and deltas sent by the sink device. It is sized
+    // once from the ability's result keys and updated in place; only while a replied result is still
+    // held by the camera service is it copied before the next update.
+    std::shared_ptr<CameraStandard::CameraMetadata> resultMetadata_;
+    // Bit positions of the result tags, one bit per tag of allResultSet_.
+    std::map<uint32_t, uint32_t> resultTagIndex_;
+    // The result tags changed since the last result replied to the camera service.
+    std::vector<uint64_t> dirtyResultBits_;
+    std::vector<uint64_t> enabledResultBits_;
+    uint32_t resultGeneration_ = 0;
+    bool isResultSynced_ = false;
+    std::mutex resultLock_;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -16,6 +16,8 @@
 #ifndef DISTRIBUTED_CAMERA_PROVIDER_H
 #define DISTRIBUTED_CAMERA_PROVIDER_H
 
+#include <map>
+#include <mutex>
 #include "dcamera.h"
 #include "idistributed_camera_provider_callback.h"
 
@@ -41,6 +43,12 @@ public:
                               std::shared_ptr<DCameraBuffer> &buffer);
     DCamRetCode ShutterBuffer(const std::shared_ptr<DHBase> &dhBase, int streamId,
                               const std::shared_ptr<DCameraBuffer> &buffer);
+    DCamRetCode RegisterStream(const std::shared_ptr<DHBase> &dhBase, int streamId, int32_t &streamHandle);
+    DCamRetCode UnregisterStream(int32_t streamHandle);
+    DCamRetCode AcquireBuffers(int32_t streamHandle, uint32_t count,
+                               std::vector<std::shared_ptr<DCameraBuffer>> &buffers);
+    DCamRetCode ShutterAndAcquireBuffer(int32_t streamHandle, const std::shared_ptr<DCameraBuffer> &buffer,
+                                       std::shared_ptr<DCameraBuffer> &nextBuffer);
     DCamRetCode OnSettingsResult(const std::shared_ptr<DHBase> &dhBase, const std::shared_ptr<DCameraSettings> &result);
     DCamRetCode Notify(const std::shared_ptr<DHBase> &dhBase, const std::shared_ptr<DCameraHDFEvent> &event);
 
@@ -54,13 +62,27 @@ public:
     DCamRetCode StopCapture(const std::shared_ptr<DHBase> &dhBase);
     DCamRetCode UpdateSettings(const std::shared_ptr<DHBase> &dhBase,
                                const std::vector<std::shared_ptr<DCameraSettings>> &settings);
+    void NotifyBufferAvailable(const std::shared_ptr<DHBase> &dhBase, int streamId);
+    void ReturnBuffers(int32_t streamHandle, const std::vector<std::shared_ptr<DCameraBuffer>> &buffers);
 
 private:
     bool IsDhBaseInfoInvalid(const std::shared_ptr<DHBase> &dhBase);
     sptr<IDCameraProviderCallback> GetCallbackBydhBase(const std::shared_ptr<DHBase> &dhBase);
     OHOS::sptr<DCameraDevice> GetDCameraDevice(const std::shared_ptr<DHBase> &dhBase);
+    OHOS::sptr<DCameraDevice> GetStreamDevice(int32_t streamHandle, int &streamId);
+    void RemoveStreamBindings(const std::shared_ptr<DHBase> &dhBase);
 
 private:
+    struct StreamBinding {
+        DHBase dhBase;
+        OHOS::sptr<DCameraDevice> device;
+        int streamId;
+    };
+    std::mutex streamLock_;
+    int32_t nextStreamHandle_ = 1;
+    // Registered streams, resolved to their device once so that per frame calls skip the host lookups.
+    std::map<int32_t, StreamBinding> streamBindings_;
+
     class AutoRelease {
     public:
         AutoRelease() {};
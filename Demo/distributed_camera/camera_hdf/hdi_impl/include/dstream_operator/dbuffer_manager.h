@@ -16,8 +16,8 @@
 #ifndef DISTRIBUTED_CAMERA_BUFFER_MANAGER_H
 #define DISTRIBUTED_CAMERA_BUFFER_MANAGER_H
 
-#include <list>
-#include <mutex>
+#include <atomic>
+#include <memory>
 #include "constants.h"
 #include "display_type.h"
 #include <surface_buffer.h>
@@ -26,9 +26,28 @@
 
 namespace OHOS {
 namespace DistributedHardware {
+enum class DBufferSlotState : uint32_t {
+    SLOT_IDLE = 0,
+    SLOT_REQUESTED = 1,
+    SLOT_FILLED = 2,
+    SLOT_FLUSHED = 3,
+};
+
+/*
+ * Index addressed buffer slot table. The buffer index handed out to the
+ * source is the slot number, so returning a buffer is a direct slot access.
+ * Free and ready slots are tracked in bitmaps updated with atomic operations,
+ * acquire and return never take a lock.
+ *
+ *   IDLE -> REQUESTED    ReserveSlot, a surface buffer is being requested for the slot
+ *   REQUESTED            AddBuffer publishes the buffer, it can be acquired
+ *   REQUESTED -> FILLED  AcquireBuffer hands the buffer to the source to be filled
+ *   FILLED -> FLUSHED    RemoveBuffer takes the returned buffer back to be flushed
+ *   FLUSHED -> IDLE      ReleaseSlot
+ */
 class DBufferManager {
 public:
-    DBufferManager() = default;
+    explicit DBufferManager(uint32_t capacity = BUFFER_QUEUE_SIZE);
     virtual ~DBufferManager() = default;
     DBufferManager(const DBufferManager &other) = delete;
     DBufferManager(DBufferManager &&other) = delete;
@@ -36,9 +55,13 @@ public:
     DBufferManager& operator=(DBufferManager &&other) = delete;
 
 public:
-    std::shared_ptr<DImageBuffer> AcquireBuffer();
+    int32_t ReserveSlot();
     RetCode AddBuffer(std::shared_ptr<DImageBuffer>& buffer);
-    RetCode RemoveBuffer(std::shared_ptr<DImageBuffer>& buffer);
+    std::shared_ptr<DImageBuffer> AcquireBuffer();
+    std::shared_ptr<DImageBuffer> RemoveBuffer(int32_t index);
+    RetCode ReleaseSlot(int32_t index);
+    DBufferSlotState GetSlotState(int32_t index) const;
+    uint32_t GetCapacity() const;
     void NotifyStop(bool state);
     static RetCode SurfaceBufferToDImageBuffer(const OHOS::sptr<OHOS::SurfaceBuffer> &surfaceBuffer,
                                                    const std::shared_ptr<DImageBuffer> &buffer);
@@ -47,11 +70,23 @@ public:
     static uint64_t CameraUsageToGrallocUsage(const uint64_t cameraUsage);
     static uint32_t PixelFormatToDCameraFormat(const PixelFormat format);
 
+    static constexpr uint32_t MAX_SLOT_COUNT = 64;
+
 private:
-    std::mutex lock_;
+    struct BufferSlot {
+        std::atomic<uint32_t> state { static_cast<uint32_t>(DBufferSlotState::SLOT_IDLE) };
+        std::shared_ptr<DImageBuffer> buffer = nullptr;
+    };
+
+    static int32_t ClaimLowestBit(std::atomic<uint64_t> &mask);
+    bool IsValidIndex(int32_t index) const;
+    bool SwitchSlotState(int32_t index, DBufferSlotState from, DBufferSlotState to);
+
+    uint32_t capacity_;
     std::atomic_bool streamStop_ = false;
-    std::list<std::shared_ptr<DImageBuffer>> idleList_ = {};
-    std::list<std::shared_ptr<DImageBuffer>> busyList_ = {};
+    std::unique_ptr<BufferSlot[]> slots_;
+    std::atomic<uint64_t> freeMask_;
+    std::atomic<uint64_t> readyMask_ { 0 };
 };
 } // namespace DistributedHardware
 } // namespace OHOS
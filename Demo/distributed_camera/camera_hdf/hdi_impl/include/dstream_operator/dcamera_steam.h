@@ -16,6 +16,8 @@
 #ifndef DISTRIBUTED_CAMERA_STREAM_H
 #define DISTRIBUTED_CAMERA_STREAM_H
 
+#include <atomic>
+#include <functional>
 #include "surface.h"
 #include "dimage_buffer.h"
 #include "dbuffer_manager.h"
@@ -31,7 +33,9 @@ namespace OHOS {
 namespace DistributedHardware {
 using namespace std;
 using namespace OHOS::Camera;
-class DCameraStream {
+using DBufferAvailableNotifier = std::function<void(int streamId)>;
+
+class DCameraStream : public std::enable_shared_from_this<DCameraStream> {
 public:
     DCameraStream() = default;
     ~DCameraStream() = default;
@@ -49,25 +53,39 @@ public:
     DCamRetCode GetDCameraBuffer(shared_ptr<DCameraBuffer> &buffer);
     DCamRetCode ReturnDCameraBuffer(const shared_ptr<DCameraBuffer> &buffer);
     DCamRetCode FlushDCameraBuffer();
+    DCamRetCode FlushIdleDCameraBuffer();
     DCamRetCode FinishCommitStream();
     bool HasBufferQueue();
+    bool HasCaptureBuffer();
+    void SetBufferAvailableNotifier(const DBufferAvailableNotifier &notifier);
 
 private:
     DCamRetCode InitDCameraBufferManager();
     DCamRetCode GetNextRequest();
+    void FlushSurfaceBuffer(int32_t index, bool isCancel);
+    void NotifyBufferAvailable();
 
 private:
-    int32_t index_ = -1;
+    struct DSurfaceBufferConfig {
+        OHOS::sptr<OHOS::SurfaceBuffer> surfaceBuffer = nullptr;
+        int32_t fence = -1;
+        int32_t usage = 0;
+    };
+
     int dcStreamId_;
     shared_ptr<StreamInfo> dcStreamInfo_ = nullptr;
     shared_ptr<StreamAttribute> dcStreamAttribute_ = nullptr;
     shared_ptr<DBufferManager> dcStreamBufferMgr_ = nullptr;
     OHOS::sptr<OHOS::Surface> dcStreamProducer_ = nullptr;
-    map<shared_ptr<DImageBuffer>, tuple<OHOS::sptr<OHOS::SurfaceBuffer>, int, int>> bufferConfigMap_;
+    // Surface buffer of every slot of dcStreamBufferMgr_, indexed by the buffer index.
+    vector<DSurfaceBufferConfig> bufferConfigs_;
     mutex lock_;
     condition_variable cv_;
     int captureBufferCount_ = 0;
     bool isBufferMgrInited_ = false;
+    DBufferAvailableNotifier bufferNotifier_ = nullptr;
+    // Set when an acquire found no buffer, the next buffer that frees up is announced once.
+    std::atomic_bool isBufferWanted_ = false;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -16,13 +16,28 @@
 #ifndef DISTRIBUTED_CAMERA_OFFLINE_STREAM_OPERATOR_H
 #define DISTRIBUTED_CAMERA_OFFLINE_STREAM_OPERATOR_H
 
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
 #include "doffline_stream_operator_stub.h"
 #include "dcamera.h"
+#include "dcamera_steam.h"
+#include "istream_operator_callback.h"
 
 namespace OHOS {
 namespace DistributedHardware {
+/*
+ * Owns the snapshot streams handed over by DStreamOperator::ChangeToOfflineStream,
+ * together with their buffers. Frames of these streams keep flowing into it after
+ * the camera device is closed, and the device keeps the channel to the sink open
+ * until the capture of the last offline stream has ended or was cancelled. An
+ * ended stream takes no new buffers and is released once the source has given
+ * back every buffer it still held.
+ */
 class DOfflineStreamOperator : public DOfflineStreamOperatorStub {
 public:
+    explicit DOfflineStreamOperator(const OHOS::sptr<IStreamOperatorCallback> &callback);
     DOfflineStreamOperator() = default;
     virtual ~DOfflineStreamOperator() = default;
     DOfflineStreamOperator(const DOfflineStreamOperator &other) = delete;
@@ -34,6 +49,35 @@ public:
     virtual CamRetCode CancelCapture(int captureId) override;
     virtual CamRetCode ReleaseStreams(const std::vector<int>& streamIds) override;
     virtual CamRetCode Release() override;
+
+    DCamRetCode AddOfflineStream(int streamId, int32_t captureId, const std::shared_ptr<DCameraStream> &stream,
+        const std::shared_ptr<std::atomic<uint32_t>> &frameCount, uint32_t captureDepth, bool enableShutterCbk);
+    DCamRetCode AcquireBuffer(int streamId, std::shared_ptr<DCameraBuffer> &buffer);
+    DCamRetCode ShutterBuffer(int streamId, const std::shared_ptr<DCameraBuffer> &buffer);
+    bool HasStream(int streamId);
+    bool IsEmpty();
+    bool IsCapturing();
+    bool SetFinishedCallback(const std::function<void()> &callback);
+
+private:
+    struct OfflineStream {
+        int32_t captureId = -1;
+        std::shared_ptr<DCameraStream> stream = nullptr;
+        std::shared_ptr<std::atomic<uint32_t>> frameCount = nullptr;
+        uint32_t captureDepth = 0;
+        bool enableShutterCbk = false;
+        bool isEnded = false;
+    };
+
+    bool IsCapturingLocked();
+    void EndStreams(const std::vector<int> &streamIds);
+    void DrainStreams(const std::vector<int> &streamIds);
+
+private:
+    OHOS::sptr<IStreamOperatorCallback> callback_;
+    std::function<void()> finishedCallback_;
+    std::map<int, OfflineStream> offlineStreams_;
+    std::mutex offlineLock_;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTED_CAMERA_STREAM_CALLBACK_DISPATCHER_H
+#define DISTRIBUTED_CAMERA_STREAM_CALLBACK_DISPATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "constants.h"
+#include "istream_operator_callback.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+using namespace OHOS::Camera;
+
+struct DStreamCallbackMetrics {
+    uint64_t shutterCount = 0;
+    uint64_t coalescedCount = 0;
+    uint64_t droppedCount = 0;
+    uint64_t avgShutterLatencyUs = 0;
+    uint64_t maxShutterLatencyUs = 0;
+    uint32_t backlog = 0;
+    uint32_t maxBacklog = 0;
+};
+
+/*
+ * Delivers stream operator callbacks on its own thread so the frame path never
+ * waits for the camera framework. Callbacks keep their order. A frame shutter
+ * queued right behind another shutter of the same capture is merged into it, and
+ * when the queue is full the oldest shutter is dropped; capture start and end
+ * notifications are never merged nor dropped. Stop delivers what is still
+ * queued and ignores anything posted while it drains; a later post starts the
+ * dispatcher again.
+ */
+class DStreamCallbackDispatcher {
+public:
+    explicit DStreamCallbackDispatcher(uint32_t capacity = CALLBACK_QUEUE_CAPACITY);
+    ~DStreamCallbackDispatcher();
+    DStreamCallbackDispatcher(const DStreamCallbackDispatcher &other) = delete;
+    DStreamCallbackDispatcher& operator=(const DStreamCallbackDispatcher &other) = delete;
+
+    void SetCallback(const OHOS::sptr<IStreamOperatorCallback> &callback);
+    void OnCaptureStarted(int32_t captureId, const std::vector<int32_t> &streamIds);
+    void OnCaptureEnded(int32_t captureId, const std::vector<std::shared_ptr<CaptureEndedInfo>> &infos);
+    void OnFrameShutter(int32_t captureId, int32_t streamId, uint64_t timestamp);
+    void Stop();
+    DStreamCallbackMetrics GetMetrics();
+
+private:
+    enum class DCallbackType {
+        CAPTURE_STARTED,
+        CAPTURE_ENDED,
+        FRAME_SHUTTER,
+    };
+
+    struct DCallbackEvent {
+        DCallbackType type = DCallbackType::FRAME_SHUTTER;
+        int32_t captureId = -1;
+        std::vector<int32_t> streamIds;
+        std::vector<std::shared_ptr<CaptureEndedInfo>> endedInfos;
+        uint64_t timestamp = 0;
+        std::chrono::steady_clock::time_point postTime;
+    };
+
+    void Post(DCallbackEvent &event);
+    bool CoalesceShutter(const DCallbackEvent &event);
+    void DropOldestShutter();
+    void Deliver(const OHOS::sptr<IStreamOperatorCallback> &callback, const DCallbackEvent &event);
+    void DispatchLoop();
+
+private:
+    uint32_t capacity_;
+    OHOS::sptr<IStreamOperatorCallback> callback_;
+    std::deque<DCallbackEvent> events_;
+    std::mutex eventLock_;
+    std::condition_variable eventCond_;
+    std::thread dispatchThread_;
+    bool isRunning_ = false;
+    bool isStopped_ = false;
+
+    DStreamCallbackMetrics metrics_;
+    uint64_t totalShutterLatencyUs_ = 0;
+    uint64_t deliveredShutterCount_ = 0;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // DISTRIBUTED_CAMERA_STREAM_CALLBACK_DISPATCHER_H
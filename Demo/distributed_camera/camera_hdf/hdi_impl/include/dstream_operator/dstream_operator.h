@@ -16,8 +16,14 @@
 #ifndef DISTRIBUTED_CAMERA_STREAM_OPERATOR_H
 #define DISTRIBUTED_CAMERA_STREAM_OPERATOR_H
 
+#include <atomic>
+#include <condition_variable>
 #include <map>
+#include <mutex>
+#include <queue>
 #include <set>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include "istream_operator.h"
 #include "dstream_operator_stub.h"
@@ -26,6 +32,8 @@
 #include "types.h"
 #include "constants.h"
 #include "dcamera_steam.h"
+#include "doffline_stream_operator.h"
+#include "dstream_callback_dispatcher.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -35,7 +43,7 @@ class DStreamOperator : public DStreamOperatorStub {
 public:
     DStreamOperator(std::shared_ptr<DMetadataProcessor> &dMetadataProcessor);
     DStreamOperator() = default;
-    virtual ~DStreamOperator() = default;
+    virtual ~DStreamOperator();
     DStreamOperator(const DStreamOperator &other) = delete;
     DStreamOperator(DStreamOperator &&other) = delete;
     DStreamOperator& operator=(const DStreamOperator &other) = delete;
@@ -65,28 +73,54 @@ public:
     DCamRetCode SetDeviceCallback(function<void(ErrorType, int)> &errorCbk,
                                   function<void(uint64_t, std::shared_ptr<CameraStandard::CameraMetadata>)> &resultCbk);
     void Release();
+    OHOS::sptr<DOfflineStreamOperator> GetOfflineStreamOperator();
+    DStreamCallbackMetrics GetCallbackMetrics();
 
 private:
     bool IsCapturing();
     void SetCapturing(bool isCapturing);
-    DCamRetCode NegotiateSuitableCaptureInfo(const std::shared_ptr<CaptureInfo>& srcCaptureInfo, bool isStreaming);
+    DCamRetCode NegotiateSuitableCaptureInfo(const std::shared_ptr<CaptureInfo>& srcCaptureInfo, bool isStreaming,
+        uint32_t &captureDepth);
     void ChooseSuitableFormat(std::vector<std::shared_ptr<DCStreamInfo>> &streamInfo,
                               std::shared_ptr<DCCaptureInfo> &captureInfo);
     void ChooseSuitableResolution(std::vector<std::shared_ptr<DCStreamInfo>> &streamInfo,
                                   std::shared_ptr<DCCaptureInfo> &captureInfo);
     void ChooseSuitableDataSpace(std::vector<std::shared_ptr<DCStreamInfo>> &streamInfo,
                                  std::shared_ptr<DCCaptureInfo> &captureInfo);
+    void ChooseSuitableFps(const shared_ptr<CaptureInfo>& srcCaptureInfo,
+        std::vector<std::shared_ptr<DCStreamInfo>> &streamInfo, std::shared_ptr<DCCaptureInfo> &captureInfo);
+    bool GetRequestedBurstDepth(const shared_ptr<CaptureInfo>& srcCaptureInfo, uint32_t &depth);
     void ChooseSuitableEncodeType(std::vector<std::shared_ptr<DCStreamInfo>> &streamInfo,
                                   std::shared_ptr<DCCaptureInfo> &captureInfo);
+    void ChooseSuitableThumbnail(std::vector<std::shared_ptr<DCStreamInfo>> &streamInfo,
+                                 std::shared_ptr<DCCaptureInfo> &captureInfo);
     void ConvertStreamInfo(std::shared_ptr<StreamInfo> &srcInfo, std::shared_ptr<DCStreamInfo> &dstInfo);
     DCEncodeType ConvertDCEncodeType(std::string &srcEncodeType);
     std::shared_ptr<DCCaptureInfo> BuildSuitableCaptureInfo(const shared_ptr<CaptureInfo>& srcCaptureInfo,
         std::vector<std::shared_ptr<DCStreamInfo>> &srcStreamInfo);
-    void SnapShotStreamOnCaptureEnded(int32_t captureId, int streamId);
+    void SnapShotStreamOnCaptureEnded(int32_t captureId, int streamId, uint32_t frameCount);
+    void RebuildRouteTable();
+    void PostResultMetadata(uint64_t resultTimestamp);
+    void StopResultThread();
+    void ResultLoop();
+
+    // Everything the frame path needs for a stream, rebuilt only when captures or streams change.
+    struct DStreamRoute {
+        int32_t captureId = -1;
+        std::shared_ptr<DCameraStream> stream = nullptr;
+        bool enableShutterCbk = false;
+        bool isSnapshot = false;
+        std::shared_ptr<std::atomic<uint32_t>> frameCount = nullptr;
+        // Frames after which a snapshot capture has ended, 0 when only CancelCapture ends it.
+        uint32_t captureDepth = 0;
+    };
+    using DStreamRouteTable = std::unordered_map<int, DStreamRoute>;
+    bool IsCaptureEnded(const DStreamRoute &route);
 
 private:
     std::shared_ptr<DMetadataProcessor> dMetadataProcessor_;
     OHOS::sptr<IStreamOperatorCallback> dcStreamOperatorCallback_;
+    DStreamCallbackDispatcher callbackDispatcher_;
     function<void(ErrorType, int)> errorCallback_;
     function<void(uint64_t, std::shared_ptr<CameraStandard::CameraMetadata>)> resultCallback_;
 
@@ -94,13 +128,23 @@ private:
     std::vector<DCEncodeType> dcSupportedCodecType_;
     std::map<DCSceneType, std::vector<int>> dcSupportedFormatMap_;
     std::map<int, std::vector<DCResolution>> dcSupportedResolutionMap_;
+    uint32_t dcSupportedMaxFps_ = MAX_SUPPORT_DEFAULT_FPS;
 
     std::map<int, std::shared_ptr<DCameraStream>> halStreamMap_;
     std::map<int, std::shared_ptr<DCStreamInfo>> dcStreamInfoMap_;
     std::map<int, std::shared_ptr<CaptureInfo>> halCaptureInfoMap_;
+    std::map<int, uint32_t> captureDepthMap_;
     std::vector<std::shared_ptr<DCCaptureInfo>> cachedDCaptureInfoList_;
-    std::map<int, bool> enableShutterCbkMap_;
-    std::map<pair<int, int>, int> acceptedBufferNum_;
+    std::shared_ptr<const DStreamRouteTable> routeTable_ = std::make_shared<const DStreamRouteTable>();
+
+    std::thread resultThread_;
+    std::mutex resultLock_;
+    std::condition_variable resultCond_;
+    std::queue<uint64_t> resultQueue_;
+    bool isResultRunning_ = false;
+    bool isResultStopped_ = false;
+
+    OHOS::sptr<DOfflineStreamOperator> offlineStreamOperator_;
 
     std::mutex requestLock_;
     bool isCapturing_ = false;
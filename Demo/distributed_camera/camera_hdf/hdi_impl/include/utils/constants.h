@@ -29,20 +29,30 @@ const uint32_t DHID_MAX_LENGTH = 64;
 
 constexpr size_t DEFAULT_ENTRY_CAPACITY = 100;
 constexpr size_t DEFAULT_DATA_CAPACITY = 2000;
+const uint32_t RESULT_METADATA_CAPACITY_FACTOR = 2;
+const uint32_t RESULT_METADATA_EXTRA_ITEMS = 8;
+const uint32_t RESULT_BITS_PER_WORD = 64;
 
 const uint32_t SIZE_FMT_LEN = 2;
-const uint32_t MAX_SUPPORT_PREVIEW_WIDTH = 1920;
-const uint32_t MAX_SUPPORT_PREVIEW_HEIGHT = 1080;
+const uint32_t MAX_SUPPORT_PREVIEW_WIDTH = 3840;
+const uint32_t MAX_SUPPORT_PREVIEW_HEIGHT = 2160;
 const uint32_t MAX_SUPPORT_PHOTO_WIDTH = 4096;
 const uint32_t MAX_SUPPORT_PHOTO_HEIGHT = 3072;
 const std::string STAR_SEPARATOR = "*";
 
 const uint32_t MIN_SUPPORT_DEFAULT_FPS = 15;
 const uint32_t MAX_SUPPORT_DEFAULT_FPS = 30;
+const uint32_t MAX_SUPPORT_FPS = 60;
+const uint32_t FPS_RANGE_SIZE = 2;
+
+// vendor section capture setting, an int32 burst depth that turns a streamed snapshot request into a burst
+const uint32_t DCAMERA_VENDOR_SECTION_START = 0x8000U << 16;
+const uint32_t DCAMERA_SNAPSHOT_BURST_DEPTH = DCAMERA_VENDOR_SECTION_START;
 
 const int64_t MAX_FRAME_DURATION = 1000000000LL / 10;
 
 const uint32_t BUFFER_QUEUE_SIZE = 8;
+const uint32_t CALLBACK_QUEUE_CAPACITY = 32;
 
 const uint32_t DEGREE_180 = 180;
 const uint32_t DEGREE_240 = 240;
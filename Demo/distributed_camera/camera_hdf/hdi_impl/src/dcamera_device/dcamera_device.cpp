@@ -222,16 +222,32 @@ CamRetCode DCameraDevice::DisableResult(const std::vector<MetaType> &results)
 void DCameraDevice::Close()
 {
     DHLOGI("DCameraDevice::Close distributed camera: %s", dCameraId_.c_str());
+    // Closed before the finished callback is set, an offline capture ending meanwhile closes the session itself.
+    isOpened_ = false;
+
+    OHOS::sptr<DOfflineStreamOperator> offlineOperator = nullptr;
+    if (dCameraStreamOperator_ != nullptr) {
+        offlineOperator = dCameraStreamOperator_->GetOfflineStreamOperator();
+    }
+    // Published before the callback is set, so a capture ending right away already finds its operator here.
+    if (offlineOperator != nullptr && !offlineOperator->IsEmpty()) {
+        std::lock_guard<std::mutex> autoLock(offlineLock_);
+        dCameraOfflineOperator_ = offlineOperator;
+    }
+    // Offline snapshot captures may still run, the session is closed once they have ended.
+    DOfflineStreamOperator *finishedOperator = offlineOperator.GetRefPtr();
+    bool hasOfflineStreams = (offlineOperator != nullptr) && offlineOperator->SetFinishedCallback(
+        [this, finishedOperator]() { OnOfflineStreamsFinished(finishedOperator); });
 
     std::shared_ptr<DCameraProvider> provider = DCameraProvider::GetInstance();
-    if (provider != nullptr) {
+    if (provider != nullptr && !hasOfflineStreams) {
         provider->StopCapture(dhBase_);
     }
     if (dCameraStreamOperator_ != nullptr) {
         dCameraStreamOperator_->Release();
         dCameraStreamOperator_ = nullptr;
     }
-    if (provider != nullptr) {
+    if (provider != nullptr && !hasOfflineStreams) {
         provider->CloseSession(dhBase_);
     }
     if (dMetadataProcessor_ != nullptr) {
@@ -239,7 +255,6 @@ void DCameraDevice::Close()
     }
     dCameraDeviceCallback_ = nullptr;
     isOpenSessFailed_ = false;
-    isOpened_ = false;
 }
 
 CamRetCode DCameraDevice::OpenDCamera(const OHOS::sptr<ICameraDeviceCallback> &callback)
@@ -255,27 +270,36 @@ CamRetCode DCameraDevice::OpenDCamera(const OHOS::sptr<ICameraDeviceCallback> &c
         DHLOGE("Get distributed camera provider instance is null.");
         return CamRetCode::DEVICE_ERROR;
     }
-    DCamRetCode ret = provider->OpenSession(dhBase_);
-    if (ret != DCamRetCode::SUCCESS) {
-        DHLOGE("Open distributed camera control session failed, ret = %d.", ret);
-        return MapToExternalRetCode(ret);
-    }
-
-    unique_lock<mutex> lock(openSesslock_);
-    auto st = openSessCV_.wait_for(lock, chrono::seconds(WAIT_OPEN_TIMEOUT_SEC));
-    if (st == cv_status::timeout) {
-        DHLOGE("Wait for distributed camera session open timeout.");
-        return CamRetCode::DEVICE_ERROR;
-    }
+    bool isSessionOpened = false;
     {
-        unique_lock<mutex> lock(isOpenSessFailedlock_);
-        if (isOpenSessFailed_) {
-            DHLOGE("Open distributed camera session failed.");
+        std::lock_guard<std::mutex> autoLock(offlineLock_);
+        isSessionOpened = (dCameraOfflineOperator_ != nullptr) && dCameraOfflineOperator_->IsCapturing();
+    }
+    if (isSessionOpened) {
+        DHLOGI("Offline streams are still running, reuse the opened session of %s.", dCameraId_.c_str());
+    } else {
+        DCamRetCode ret = provider->OpenSession(dhBase_);
+        if (ret != DCamRetCode::SUCCESS) {
+            DHLOGE("Open distributed camera control session failed, ret = %d.", ret);
+            return MapToExternalRetCode(ret);
+        }
+
+        unique_lock<mutex> lock(openSesslock_);
+        auto st = openSessCV_.wait_for(lock, chrono::seconds(WAIT_OPEN_TIMEOUT_SEC));
+        if (st == cv_status::timeout) {
+            DHLOGE("Wait for distributed camera session open timeout.");
             return CamRetCode::DEVICE_ERROR;
         }
+        {
+            unique_lock<mutex> lock(isOpenSessFailedlock_);
+            if (isOpenSessFailed_) {
+                DHLOGE("Open distributed camera session failed.");
+                return CamRetCode::DEVICE_ERROR;
+            }
+        }
     }
 
-    ret = CreateDStreamOperator();
+    DCamRetCode ret = CreateDStreamOperator();
     if (ret != SUCCESS) {
         DHLOGE("Create distributed camera stream operator failed.");
         return MapToExternalRetCode(ret);
@@ -301,6 +325,10 @@ CamRetCode DCameraDevice::GetDCameraAbility(std::shared_ptr<CameraAbility> &abil
 
 DCamRetCode DCameraDevice::AcquireBuffer(int streamId, std::shared_ptr<DCameraBuffer> &buffer)
 {
+    OHOS::sptr<DOfflineStreamOperator> offlineOperator = GetOfflineStreamOperator(streamId);
+    if (offlineOperator != nullptr) {
+        return offlineOperator->AcquireBuffer(streamId, buffer);
+    }
     if (dCameraStreamOperator_ == nullptr) {
         DHLOGE("Stream operator not init.");
         return DEVICE_NOT_INIT;
@@ -315,6 +343,10 @@ DCamRetCode DCameraDevice::AcquireBuffer(int streamId, std::shared_ptr<DCameraBu
 
 DCamRetCode DCameraDevice::ShutterBuffer(int streamId, const std::shared_ptr<DCameraBuffer> &buffer)
 {
+    OHOS::sptr<DOfflineStreamOperator> offlineOperator = GetOfflineStreamOperator(streamId);
+    if (offlineOperator != nullptr) {
+        return offlineOperator->ShutterBuffer(streamId, buffer);
+    }
     if (dCameraStreamOperator_ == nullptr) {
         DHLOGE("Stream operator not init.");
         return DEVICE_NOT_INIT;
@@ -381,6 +413,7 @@ DCamRetCode DCameraDevice::Notify(const std::shared_ptr<DCameraHDFEvent> &event)
             break;
         }
         case DCameraEventResult::DCAMERA_EVENT_CHANNEL_DISCONNECTED: {
+            ReleaseOfflineStreamOperator();
             if (dCameraDeviceCallback_ != nullptr) {
                 dCameraDeviceCallback_->OnError(ErrorType::FATAL_ERROR, 0);
                 Close();
@@ -418,6 +451,49 @@ DCamRetCode DCameraDevice::Notify(const std::shared_ptr<DCameraHDFEvent> &event)
     return SUCCESS;
 }
 
+OHOS::sptr<DOfflineStreamOperator> DCameraDevice::GetOfflineStreamOperator(int streamId)
+{
+    std::lock_guard<std::mutex> autoLock(offlineLock_);
+    if (dCameraOfflineOperator_ == nullptr || !dCameraOfflineOperator_->HasStream(streamId)) {
+        return nullptr;
+    }
+    return dCameraOfflineOperator_;
+}
+
+void DCameraDevice::ReleaseOfflineStreamOperator()
+{
+    OHOS::sptr<DOfflineStreamOperator> offlineOperator = nullptr;
+    {
+        std::lock_guard<std::mutex> autoLock(offlineLock_);
+        offlineOperator = dCameraOfflineOperator_;
+    }
+    if (offlineOperator != nullptr) {
+        offlineOperator->Release();
+    }
+}
+
+void DCameraDevice::OnOfflineStreamsFinished(const DOfflineStreamOperator *offlineOperator)
+{
+    DHLOGI("DCameraDevice::OnOfflineStreamsFinished, offline captures of %s are finished.", dCameraId_.c_str());
+    {
+        // A later Close may have handed the session to a newer offline operator.
+        std::lock_guard<std::mutex> autoLock(offlineLock_);
+        if (dCameraOfflineOperator_.GetRefPtr() != offlineOperator) {
+            DHLOGI("Offline operator of %s was replaced, keep the session.", dCameraId_.c_str());
+            return;
+        }
+    }
+    // The offline operator stays reachable, the source still gives back the buffers it held through it.
+    if (IsOpened()) {
+        return;
+    }
+    std::shared_ptr<DCameraProvider> provider = DCameraProvider::GetInstance();
+    if (provider != nullptr) {
+        provider->StopCapture(dhBase_);
+        provider->CloseSession(dhBase_);
+    }
+}
+
 void DCameraDevice::SetProviderCallback(const OHOS::sptr<IDCameraProviderCallback> &callback)
 {
     dCameraProviderCallback_ = callback;
@@ -14,6 +14,10 @@
  */
 
 #include "dmetadata_processor.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "dbuffer_manager.h"
 #include "dcamera_utils_tools.h"
 #include "distributed_hardware_log.h"
@@ -38,6 +42,10 @@ DCamRetCode DMetadataProcessor::InitDCameraAbility(const std::string &abilityInf
                 DHLOGI("Decode distributed camera metadata from string success.");
             }
         }
+        if (rootValue.isMember("MaxFps") && rootValue["MaxFps"].isUInt()) {
+            maxFps_ = rootValue["MaxFps"].asUInt();
+            maxFps_ = std::max(MIN_SUPPORT_DEFAULT_FPS, std::min(maxFps_, MAX_SUPPORT_FPS));
+        }
     }
 
     if (dCameraAbility_ == nullptr) {
@@ -66,9 +74,47 @@ DCamRetCode DMetadataProcessor::InitDCameraAbility(const std::string &abilityInf
     for (uint32_t i = 0; i < count; i++, itemEntry++) {
         allResultSet_.insert((MetaType)(itemEntry->item));
     }
+    InitResultMetadataStore();
     return SUCCESS;
 }
 
+void DMetadataProcessor::InitResultMetadataStore()
+{
+    std::lock_guard<std::mutex> autoLock(resultLock_);
+    resultTagIndex_.clear();
+    uint32_t bit = 0;
+    for (auto tag : allResultSet_) {
+        resultTagIndex_[static_cast<uint32_t>(tag)] = bit++;
+    }
+    size_t words = (resultTagIndex_.size() + RESULT_BITS_PER_WORD - 1) / RESULT_BITS_PER_WORD;
+    dirtyResultBits_.assign(words, 0);
+    enabledResultBits_.assign(words, 0);
+    for (auto tag : enabledResultSet_) {
+        SetResultBit(enabledResultBits_, static_cast<uint32_t>(tag), true);
+    }
+
+    // Every result tag is one of the ability's keys, so the ability bounds the size of the result.
+    uint32_t itemCapacity = static_cast<uint32_t>(allResultSet_.size()) + RESULT_METADATA_EXTRA_ITEMS;
+    uint32_t dataCapacity = std::max(static_cast<uint32_t>(DEFAULT_DATA_CAPACITY),
+        CameraStandard::GetCameraMetadataDataSize(dCameraAbility_->get()) * RESULT_METADATA_CAPACITY_FACTOR);
+    resultMetadata_ = std::make_shared<CameraStandard::CameraMetadata>(itemCapacity, dataCapacity);
+    isResultSynced_ = false;
+}
+
+void DMetadataProcessor::SetResultBit(std::vector<uint64_t> &bits, uint32_t tag, bool isSet)
+{
+    auto iter = resultTagIndex_.find(tag);
+    if (iter == resultTagIndex_.end()) {
+        return;
+    }
+    uint64_t mask = 1ULL << (iter->second % RESULT_BITS_PER_WORD);
+    if (isSet) {
+        bits[iter->second / RESULT_BITS_PER_WORD] |= mask;
+    } else {
+        bits[iter->second / RESULT_BITS_PER_WORD] &= ~mask;
+    }
+}
+
 DCamRetCode DMetadataProcessor::InitDCameraDefaultAbilityKeys(const std::string &abilityInfo)
 {
     JSONCPP_STRING errs;
@@ -126,7 +172,7 @@ DCamRetCode DMetadataProcessor::InitDCameraDefaultAbilityKeys(const std::string
 
     std::vector<int32_t> fpsRanges;
     fpsRanges.push_back(MIN_SUPPORT_DEFAULT_FPS);
-    fpsRanges.push_back(MAX_SUPPORT_DEFAULT_FPS);
+    fpsRanges.push_back(maxFps_);
     AddAbilityEntry(OHOS_CONTROL_AE_TARGET_FPS_RANGE, fpsRanges.data(), fpsRanges.size());
 
     AddAbilityEntry(OHOS_CONTROL_AE_AVAILABLE_TARGET_FPS_RANGES, fpsRanges.data(), fpsRanges.size());
@@ -315,6 +361,8 @@ DCamRetCode DMetadataProcessor::EnableMetadataResult(const std::vector<MetaType>
             auto anoIter = enabledResultSet_.find(results[i]);
             if (anoIter == enabledResultSet_.end()) {
                 enabledResultSet_.insert(results[i]);
+                std::lock_guard<std::mutex> autoLock(resultLock_);
+                SetResultBit(enabledResultBits_, static_cast<uint32_t>(results[i]), true);
             }
         } else {
             DHLOGE("Cannot find match metatype.");
@@ -337,6 +385,8 @@ DCamRetCode DMetadataProcessor::DisableMetadataResult(const std::vector<MetaType
             auto anoIter = enabledResultSet_.find(results[i]);
             if (anoIter != enabledResultSet_.end()) {
                 enabledResultSet_.erase(*iter);
+                std::lock_guard<std::mutex> autoLock(resultLock_);
+                SetResultBit(enabledResultBits_, static_cast<uint32_t>(results[i]), false);
             }
         } else {
             DHLOGE("Cannot find match metatype.");
@@ -349,8 +399,10 @@ DCamRetCode DMetadataProcessor::DisableMetadataResult(const std::vector<MetaType
 DCamRetCode DMetadataProcessor::ResetEnableResults()
 {
     if (enabledResultSet_.size() < allResultSet_.size()) {
+        std::lock_guard<std::mutex> autoLock(resultLock_);
         for (auto result : allResultSet_) {
             enabledResultSet_.insert(result);
+            SetResultBit(enabledResultBits_, static_cast<uint32_t>(result), true);
         }
     }
     return SUCCESS;
@@ -359,60 +411,26 @@ DCamRetCode DMetadataProcessor::ResetEnableResults()
 DCamRetCode DMetadataProcessor::UpdateResultMetadata(bool &needReturn,
     std::shared_ptr<CameraStandard::CameraMetadata> &result)
 {
-    if (latestProducerResultMetadata_ == nullptr) {
-        needReturn = false;
+    std::lock_guard<std::mutex> autoLock(resultLock_);
+    needReturn = false;
+    if (resultMetadata_ == nullptr) {
         return SUCCESS;
     }
 
-    uint32_t itemCapacity = CameraStandard::GetCameraMetadataItemCapacity(latestProducerResultMetadata_);
-    uint32_t dataCapacity = CameraStandard::GetCameraMetadataDataSize(latestProducerResultMetadata_);
-
-    if (metaResultMode_ == ResultCallbackMode::PER_FRAME) {
-        ResizeMetadataHeader(latestConsumerResultMetadata_, itemCapacity, dataCapacity);
-        CameraStandard::CopyCameraMetadataItems(latestConsumerResultMetadata_, latestProducerResultMetadata_);
-        ConvertToCameraMetadata(latestConsumerResultMetadata_, result);
-        needReturn = true;
+    bool isChanged = false;
+    for (size_t i = 0; i < dirtyResultBits_.size(); i++) {
+        isChanged = isChanged || ((dirtyResultBits_[i] & enabledResultBits_[i]) != 0);
+        dirtyResultBits_[i] = 0;
+    }
+    if (metaResultMode_ == ResultCallbackMode::ON_CHANGED && !isChanged) {
+        return SUCCESS;
+    }
+    if (!isResultSynced_ && CameraStandard::GetCameraMetadataItemCount(resultMetadata_->get()) == 0) {
         return SUCCESS;
-    } else {
-        for (auto tag : enabledResultSet_) {
-            camera_metadata_item_t item;
-            camera_metadata_item_t anoItem;
-            int ret1 = CameraStandard::FindCameraMetadataItem(latestProducerResultMetadata_, tag, &item);
-            int ret2 = CameraStandard::FindCameraMetadataItem(latestConsumerResultMetadata_, tag, &anoItem);
-            if (ret1 == 0 && ret2 == 0) {
-                if (item.count != anoItem.count || item.data_type != anoItem.data_type) {
-                    ResizeMetadataHeader(latestConsumerResultMetadata_, itemCapacity, dataCapacity);
-                    CameraStandard::CopyCameraMetadataItems(latestConsumerResultMetadata_,
-                        latestProducerResultMetadata_);
-                    ConvertToCameraMetadata(latestConsumerResultMetadata_, result);
-                    needReturn = true;
-                    return SUCCESS;
-                } else {
-                    uint32_t size = GetDataSize(item.data_type);
-                    for (uint32_t i = 0; i < (size * static_cast<uint32_t>(item.count)); i++) {
-                        if (*(item.data.u8 + i) != *(anoItem.data.u8 + i)) {
-                            ResizeMetadataHeader(latestConsumerResultMetadata_, itemCapacity, dataCapacity);
-                            CameraStandard::CopyCameraMetadataItems(latestConsumerResultMetadata_,
-                                latestProducerResultMetadata_);
-                            ConvertToCameraMetadata(latestConsumerResultMetadata_, result);
-                            needReturn = true;
-                            return SUCCESS;
-                        }
-                    }
-                    ResizeMetadataHeader(latestConsumerResultMetadata_, itemCapacity, dataCapacity);
-                    CameraStandard::CopyCameraMetadataItems(latestConsumerResultMetadata_,
-                        latestProducerResultMetadata_);
-                    needReturn = false;
-                }
-            } else if (ret1 == 0 || ret2 == 0) {
-                ResizeMetadataHeader(latestConsumerResultMetadata_, itemCapacity, dataCapacity);
-                CameraStandard::CopyCameraMetadataItems(latestConsumerResultMetadata_, latestProducerResultMetadata_);
-                ConvertToCameraMetadata(latestConsumerResultMetadata_, result);
-                needReturn = true;
-                return SUCCESS;
-            }
-        }
     }
+
+    result = resultMetadata_;
+    needReturn = true;
     return SUCCESS;
 }
 
@@ -423,37 +441,159 @@ DCamRetCode DMetadataProcessor::SaveResultMetadata(std::string resultStr)
         return INVALID_ARGUMENT;
     }
 
-    latestProducerResultMetadata_ = CameraStandard::MetadataUtils::DecodeFromString(resultStr)->get();
-    if (latestProducerResultMetadata_ == nullptr) {
-        DHLOGE("Failed to decode metadata setting from string.");
+    uint32_t generation = 0;
+    bool isSnapshot = false;
+    std::string metadataStr;
+    if (!UnpackResultMetadata(resultStr, generation, isSnapshot, metadataStr)) {
+        DHLOGE("Failed to unpack result metadata.");
         return INVALID_ARGUMENT;
     }
 
-    if (!CameraStandard::GetCameraMetadataItemCount(latestProducerResultMetadata_)) {
-        DHLOGE("Input result metadata item is empty.");
+    std::shared_ptr<CameraStandard::CameraMetadata> metadata =
+        CameraStandard::MetadataUtils::DecodeFromString(Base64Decode(metadataStr));
+    if (metadata == nullptr || metadata->get() == nullptr) {
+        DHLOGE("Failed to decode result metadata from string.");
         return INVALID_ARGUMENT;
     }
 
+    std::lock_guard<std::mutex> autoLock(resultLock_);
+    if (resultMetadata_ == nullptr) {
+        DHLOGE("Result metadata store is not init.");
+        return DEVICE_NOT_INIT;
+    }
+    if (isSnapshot) {
+        DCamRetCode ret = ApplyResultSnapshot(metadata);
+        if (ret != SUCCESS) {
+            DHLOGE("Apply result metadata snapshot %u failed, ret = %d.", generation, ret);
+            isResultSynced_ = false;
+            return ret;
+        }
+        resultGeneration_ = generation;
+        isResultSynced_ = true;
+        return SUCCESS;
+    }
+
+    if (!isResultSynced_ || generation != resultGeneration_ + 1) {
+        DHLOGI("Drop result metadata delta %u, expect %u, wait for the next snapshot.", generation,
+            resultGeneration_ + 1);
+        isResultSynced_ = false;
+        return SUCCESS;
+    }
+
+    DCamRetCode ret = ApplyResultDelta(metadata);
+    if (ret != SUCCESS) {
+        DHLOGE("Apply result metadata delta %u failed, ret = %d.", generation, ret);
+        isResultSynced_ = false;
+        return ret;
+    }
+    resultGeneration_ = generation;
     return SUCCESS;
 }
 
-void DMetadataProcessor::ConvertToCameraMetadata(common_metadata_header_t *&input,
-    std::shared_ptr<CameraStandard::CameraMetadata> &output)
+DCamRetCode DMetadataProcessor::ApplyResultSnapshot(const std::shared_ptr<CameraStandard::CameraMetadata> &snapshot)
 {
-    auto ret = CameraStandard::CopyCameraMetadataItems(output->get(), input);
-    if (ret != CAM_META_SUCCESS) {
-        DHLOGE("Failed to copy the old metadata to new metadata.");
-        output = nullptr;
+    common_metadata_header_t *header = resultMetadata_->get();
+    uint32_t count = CameraStandard::GetCameraMetadataItemCount(header);
+    bool isTagRemoved = false;
+    for (uint32_t i = 0; i < count; i++) {
+        camera_metadata_item_t item;
+        camera_metadata_item_t anoItem;
+        if (CameraStandard::GetCameraMetadataItem(header, i, &item) == CAM_META_SUCCESS &&
+            CameraStandard::FindCameraMetadataItem(snapshot->get(), item.item, &anoItem) != CAM_META_SUCCESS) {
+            SetResultBit(dirtyResultBits_, item.item, true);
+            isTagRemoved = true;
+        }
+    }
+    if (isTagRemoved) {
+        // Entries cannot be removed in place, start over from an empty store of the same size.
+        uint32_t itemCapacity = CameraStandard::GetCameraMetadataItemCapacity(header);
+        uint32_t dataCapacity = CameraStandard::GetCameraMetadataDataSize(header);
+        resultMetadata_ = std::make_shared<CameraStandard::CameraMetadata>(itemCapacity, dataCapacity);
+    }
+    return ApplyResultDelta(snapshot);
+}
+
+DCamRetCode DMetadataProcessor::ApplyResultDelta(const std::shared_ptr<CameraStandard::CameraMetadata> &delta)
+{
+    if (resultMetadata_ == nullptr) {
+        return DEVICE_NOT_INIT;
+    }
+
+    common_metadata_header_t *header = delta->get();
+    uint32_t count = CameraStandard::GetCameraMetadataItemCount(header);
+    for (uint32_t i = 0; i < count; i++) {
+        camera_metadata_item_t item;
+        if (CameraStandard::GetCameraMetadataItem(header, i, &item) != CAM_META_SUCCESS) {
+            return INVALID_ARGUMENT;
+        }
+        DCamRetCode ret = UpdateResultEntry(item);
+        if (ret != SUCCESS) {
+            return ret;
+        }
     }
+    return SUCCESS;
+}
+
+DCamRetCode DMetadataProcessor::UpdateResultEntry(const camera_metadata_item_t &item)
+{
+    camera_metadata_item_t anoItem;
+    bool isExist = (CameraStandard::FindCameraMetadataItem(resultMetadata_->get(), item.item, &anoItem) ==
+        CAM_META_SUCCESS);
+    if (isExist && IsSameMetadataItem(item, anoItem)) {
+        return SUCCESS;
+    }
+
+    uint32_t itemCapacity = CameraStandard::GetCameraMetadataItemCapacity(resultMetadata_->get());
+    uint32_t dataCapacity = CameraStandard::GetCameraMetadataDataSize(resultMetadata_->get());
+    if (resultMetadata_.use_count() > 1) {
+        // The current result is still held by the camera service, never modify it in place.
+        DCamRetCode ret = CloneResultMetadata(itemCapacity, dataCapacity, resultMetadata_->get());
+        if (ret != SUCCESS) {
+            return ret;
+        }
+    }
+
+    uint32_t dataSize = GetDataSize(item.data_type) * static_cast<uint32_t>(item.count);
+    bool isUpdated = isExist ? resultMetadata_->updateEntry(item.item, item.data.u8, item.count) :
+        resultMetadata_->addEntry(item.item, item.data.u8, item.count);
+    if (!isUpdated) {
+        DCamRetCode ret = CloneResultMetadata(itemCapacity + 1,
+            (dataCapacity + dataSize) * RESULT_METADATA_CAPACITY_FACTOR, resultMetadata_->get());
+        if (ret != SUCCESS) {
+            return ret;
+        }
+        isUpdated = isExist ? resultMetadata_->updateEntry(item.item, item.data.u8, item.count) :
+            resultMetadata_->addEntry(item.item, item.data.u8, item.count);
+    }
+    if (!isUpdated) {
+        DHLOGE("Update result tag %d failed.", item.item);
+        return FAILED;
+    }
+    SetResultBit(dirtyResultBits_, item.item, true);
+    return SUCCESS;
+}
+
+DCamRetCode DMetadataProcessor::CloneResultMetadata(uint32_t itemCapacity, uint32_t dataCapacity,
+    const common_metadata_header_t *source)
+{
+    std::shared_ptr<CameraStandard::CameraMetadata> metadata =
+        std::make_shared<CameraStandard::CameraMetadata>(itemCapacity, dataCapacity);
+    if (metadata->get() == nullptr ||
+        CameraStandard::CopyCameraMetadataItems(metadata->get(), source) != CAM_META_SUCCESS) {
+        DHLOGE("Failed to copy result metadata, item capacity: %u, data capacity: %u.", itemCapacity, dataCapacity);
+        return FAILED;
+    }
+    resultMetadata_ = metadata;
+    return SUCCESS;
 }
 
-void DMetadataProcessor::ResizeMetadataHeader(common_metadata_header_t *header,
-    uint32_t itemCapacity, uint32_t dataCapacity)
+bool DMetadataProcessor::IsSameMetadataItem(const camera_metadata_item_t &item, const camera_metadata_item_t &anoItem)
 {
-    if (header) {
-        header = nullptr;
+    if (item.data_type != anoItem.data_type || item.count != anoItem.count) {
+        return false;
     }
-    header = CameraStandard::AllocateCameraMetadataBuffer(itemCapacity, dataCapacity);
+    size_t size = GetDataSize(item.data_type) * static_cast<size_t>(item.count);
+    return memcmp(item.data.u8, anoItem.data.u8, size) == 0;
 }
 
 uint32_t DMetadataProcessor::GetDataSize(uint32_t type)
@@ -544,13 +684,14 @@ std::map<int, std::vector<DCResolution>> DMetadataProcessor::GetDCameraSupported
                 std::sort(resolutionVec.begin(), resolutionVec.end());
                 supportedFormats[format] = resolutionVec;
 
-                if (!isPhotoFormat && (maxPreviewResolution_ < resolutionVec[0])) {
-                    maxPreviewResolution_.width_ = resolutionVec[0].width_;
-                    maxPreviewResolution_.height_ = resolutionVec[0].height_;
+                const DCResolution &maxResolution = resolutionVec.back();
+                if (!isPhotoFormat && (maxPreviewResolution_ < maxResolution)) {
+                    maxPreviewResolution_.width_ = maxResolution.width_;
+                    maxPreviewResolution_.height_ = maxResolution.height_;
                 }
-                if (isPhotoFormat && (maxPhotoResolution_ < resolutionVec[0])) {
-                    maxPhotoResolution_.width_ = resolutionVec[0].width_;
-                    maxPhotoResolution_.height_ = resolutionVec[0].height_;
+                if (isPhotoFormat && (maxPhotoResolution_ < maxResolution)) {
+                    maxPhotoResolution_.width_ = maxResolution.width_;
+                    maxPhotoResolution_.height_ = maxResolution.height_;
                 }
             }
         }
@@ -14,6 +14,9 @@
  */
 
 #include "dcamera_provider.h"
+
+#include <algorithm>
+
 #include "anonymous_string.h"
 #include "constants.h"
 #include "dcamera_device.h"
@@ -84,6 +87,7 @@ DCamRetCode DCameraProvider::DisableDCameraDevice(const std::shared_ptr<DHBase>
         DHLOGE("DCameraProvider::DisableDCameraDevice, dcamera host is null.");
         return DCamRetCode::DEVICE_NOT_INIT;
     }
+    RemoveStreamBindings(dhBase);
     DCamRetCode ret = dCameraHost->RemoveDCameraDevice(dhBase);
     if (ret != DCamRetCode::SUCCESS) {
         DHLOGE("DCameraProvider::DisableDCameraDevice failed, ret = %d.", ret);
@@ -127,6 +131,109 @@ DCamRetCode DCameraProvider::ShutterBuffer(const std::shared_ptr<DHBase> &dhBase
     return device->ShutterBuffer(streamId, buffer);
 }
 
+DCamRetCode DCameraProvider::RegisterStream(const std::shared_ptr<DHBase> &dhBase, int streamId,
+    int32_t &streamHandle)
+{
+    DHLOGI("DCameraProvider::RegisterStream for {devId: %s, dhId: %s}, streamId: %d.",
+        GetAnonyString(dhBase->deviceId_).c_str(), dhBase->dhId_.c_str(), streamId);
+
+    OHOS::sptr<DCameraDevice> device = GetDCameraDevice(dhBase);
+    if (device == nullptr) {
+        DHLOGE("DCameraProvider::RegisterStream failed, dcamera device not found.");
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> autoLock(streamLock_);
+    for (auto &binding : streamBindings_) {
+        if (binding.second.device == device && binding.second.streamId == streamId) {
+            streamHandle = binding.first;
+            return DCamRetCode::SUCCESS;
+        }
+    }
+    streamHandle = nextStreamHandle_++;
+    streamBindings_[streamHandle] = { DHBase(dhBase->deviceId_, dhBase->dhId_), device, streamId };
+    DHLOGI("DCameraProvider::RegisterStream streamId: %d, streamHandle: %d.", streamId, streamHandle);
+    return DCamRetCode::SUCCESS;
+}
+
+DCamRetCode DCameraProvider::UnregisterStream(int32_t streamHandle)
+{
+    DHLOGI("DCameraProvider::UnregisterStream streamHandle: %d.", streamHandle);
+    std::lock_guard<std::mutex> autoLock(streamLock_);
+    if (streamBindings_.erase(streamHandle) == 0) {
+        DHLOGE("DCameraProvider::UnregisterStream, stream handle %d not found.", streamHandle);
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+    return DCamRetCode::SUCCESS;
+}
+
+DCamRetCode DCameraProvider::AcquireBuffers(int32_t streamHandle, uint32_t count,
+    std::vector<std::shared_ptr<DCameraBuffer>> &buffers)
+{
+    int streamId = 0;
+    OHOS::sptr<DCameraDevice> device = GetStreamDevice(streamHandle, streamId);
+    if (device == nullptr) {
+        DHLOGE("DCameraProvider::AcquireBuffers failed, stream handle %d not found.", streamHandle);
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+
+    DCamRetCode ret = DCamRetCode::SUCCESS;
+    count = std::min(count, BUFFER_QUEUE_SIZE);
+    for (uint32_t i = 0; i < count; i++) {
+        std::shared_ptr<DCameraBuffer> buffer = std::make_shared<DCameraBuffer>();
+        ret = device->AcquireBuffer(streamId, buffer);
+        if (ret != DCamRetCode::SUCCESS) {
+            break;
+        }
+        buffers.push_back(buffer);
+    }
+    return buffers.empty() ? ret : DCamRetCode::SUCCESS;
+}
+
+DCamRetCode DCameraProvider::ShutterAndAcquireBuffer(int32_t streamHandle,
+    const std::shared_ptr<DCameraBuffer> &buffer, std::shared_ptr<DCameraBuffer> &nextBuffer)
+{
+    if (buffer == nullptr) {
+        DHLOGE("DCameraProvider::ShutterAndAcquireBuffer, input distributed camera buffer is null.");
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+    int streamId = 0;
+    OHOS::sptr<DCameraDevice> device = GetStreamDevice(streamHandle, streamId);
+    if (device == nullptr) {
+        DHLOGE("DCameraProvider::ShutterAndAcquireBuffer failed, stream handle %d not found.", streamHandle);
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+
+    DCamRetCode ret = device->ShutterBuffer(streamId, buffer);
+    if (ret != DCamRetCode::SUCCESS) {
+        return ret;
+    }
+    std::shared_ptr<DCameraBuffer> next = std::make_shared<DCameraBuffer>();
+    if (device->AcquireBuffer(streamId, next) == DCamRetCode::SUCCESS) {
+        nextBuffer = next;
+    }
+    return DCamRetCode::SUCCESS;
+}
+
+void DCameraProvider::ReturnBuffers(int32_t streamHandle, const std::vector<std::shared_ptr<DCameraBuffer>> &buffers)
+{
+    if (buffers.empty()) {
+        return;
+    }
+    int streamId = 0;
+    OHOS::sptr<DCameraDevice> device = GetStreamDevice(streamHandle, streamId);
+    if (device == nullptr) {
+        DHLOGE("DCameraProvider::ReturnBuffers failed, stream handle %d not found.", streamHandle);
+        return;
+    }
+    DHLOGI("DCameraProvider::ReturnBuffers streamHandle: %d, count: %zu.", streamHandle, buffers.size());
+    for (auto &buffer : buffers) {
+        // an empty buffer goes back to the idle queue without being reported as a frame
+        buffer->size_ = 0;
+        device->ShutterBuffer(streamId, buffer);
+    }
+}
+
 DCamRetCode DCameraProvider::OnSettingsResult(const std::shared_ptr<DHBase> &dhBase,
     const std::shared_ptr<DCameraSettings> &result)
 {
@@ -277,6 +384,16 @@ DCamRetCode DCameraProvider::UpdateSettings(const std::shared_ptr<DHBase> &dhBas
     return callback->UpdateSettings(dhBase, settings);
 }
 
+void DCameraProvider::NotifyBufferAvailable(const std::shared_ptr<DHBase> &dhBase, int streamId)
+{
+    sptr<IDCameraProviderCallback> callback = GetCallbackBydhBase(dhBase);
+    if (callback == nullptr) {
+        DHLOGE("DCameraProvider::NotifyBufferAvailable, dcamera provider callback not found.");
+        return;
+    }
+    callback->NotifyBufferAvailable(dhBase, streamId);
+}
+
 bool DCameraProvider::IsDhBaseInfoInvalid(const std::shared_ptr<DHBase> &dhBase)
 {
     return dhBase->deviceId_.empty() || (dhBase->deviceId_.size() > DEVID_MAX_LENGTH) ||
@@ -302,5 +419,29 @@ OHOS::sptr<DCameraDevice> DCameraProvider::GetDCameraDevice(const std::shared_pt
     }
     return dCameraHost->GetDCameraDeviceByDHBase(dhBase);
 }
+
+OHOS::sptr<DCameraDevice> DCameraProvider::GetStreamDevice(int32_t streamHandle, int &streamId)
+{
+    std::lock_guard<std::mutex> autoLock(streamLock_);
+    auto iter = streamBindings_.find(streamHandle);
+    if (iter == streamBindings_.end()) {
+        return nullptr;
+    }
+    streamId = iter->second.streamId;
+    return iter->second.device;
+}
+
+void DCameraProvider::RemoveStreamBindings(const std::shared_ptr<DHBase> &dhBase)
+{
+    std::lock_guard<std::mutex> autoLock(streamLock_);
+    auto iter = streamBindings_.begin();
+    while (iter != streamBindings_.end()) {
+        if (iter->second.dhBase.deviceId_ == dhBase->deviceId_ && iter->second.dhBase.dhId_ == dhBase->dhId_) {
+            iter = streamBindings_.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+}
 } // namespace DistributedHardware
 } // namespace OHOS
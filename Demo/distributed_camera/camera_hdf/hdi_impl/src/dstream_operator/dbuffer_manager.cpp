@@ -14,51 +14,122 @@
  */
 
 #include "dbuffer_manager.h"
+#include <algorithm>
 #include <buffer_handle_utils.h>
 #include "distributed_camera_constants.h"
 #include "distributed_hardware_log.h"
 
 namespace OHOS {
 namespace DistributedHardware {
-std::shared_ptr<DImageBuffer> DBufferManager::AcquireBuffer()
+DBufferManager::DBufferManager(uint32_t capacity)
+    : capacity_(std::min(std::max(capacity, 1U), MAX_SLOT_COUNT)),
+      slots_(std::make_unique<BufferSlot[]>(capacity_)),
+      freeMask_(capacity_ == MAX_SLOT_COUNT ? ~0ULL : ((1ULL << capacity_) - 1))
+{
+}
+
+int32_t DBufferManager::ClaimLowestBit(std::atomic<uint64_t> &mask)
+{
+    uint64_t bits = mask.load(std::memory_order_acquire);
+    while (bits != 0) {
+        uint64_t lowest = bits & (~bits + 1);
+        if (mask.compare_exchange_weak(bits, bits & ~lowest, std::memory_order_acq_rel,
+            std::memory_order_acquire)) {
+            return __builtin_ctzll(lowest);
+        }
+    }
+    return -1;
+}
+
+bool DBufferManager::IsValidIndex(int32_t index) const
 {
-    std::unique_lock<std::mutex> l(lock_);
+    return index >= 0 && static_cast<uint32_t>(index) < capacity_;
+}
 
-    if (!idleList_.empty()) {
-        auto it = idleList_.begin();
-        busyList_.splice(busyList_.begin(), idleList_, it);
-        DHLOGI("Acquire buffer success, index = %d", (*it)->GetIndex());
-        return *it;
+bool DBufferManager::SwitchSlotState(int32_t index, DBufferSlotState from, DBufferSlotState to)
+{
+    uint32_t expected = static_cast<uint32_t>(from);
+    return slots_[index].state.compare_exchange_strong(expected, static_cast<uint32_t>(to),
+        std::memory_order_acq_rel);
+}
+
+int32_t DBufferManager::ReserveSlot()
+{
+    int32_t index = ClaimLowestBit(freeMask_);
+    if (index < 0) {
+        return -1;
     }
-    return nullptr;
+    slots_[index].state.store(static_cast<uint32_t>(DBufferSlotState::SLOT_REQUESTED), std::memory_order_release);
+    return index;
 }
 
 RetCode DBufferManager::AddBuffer(std::shared_ptr<DImageBuffer>& buffer)
 {
-    std::unique_lock<std::mutex> l(lock_);
-    if (idleList_.size() + busyList_.size() >= BUFFER_QUEUE_SIZE) {
-        DHLOGI("Buffer list is full, cannot add buffer.");
+    if (buffer == nullptr) {
         return RC_ERROR;
     }
-    idleList_.emplace_back(buffer);
-
+    int32_t index = buffer->GetIndex();
+    if (!IsValidIndex(index) || GetSlotState(index) != DBufferSlotState::SLOT_REQUESTED ||
+        slots_[index].buffer != nullptr) {
+        DHLOGE("Slot %d is not reserved, cannot add buffer.", index);
+        return RC_ERROR;
+    }
+    slots_[index].buffer = buffer;
+    readyMask_.fetch_or(1ULL << index, std::memory_order_release);
     return RC_OK;
 }
 
-RetCode DBufferManager::RemoveBuffer(std::shared_ptr<DImageBuffer>& buffer)
+std::shared_ptr<DImageBuffer> DBufferManager::AcquireBuffer()
 {
-    std::unique_lock<std::mutex> l(lock_);
+    int32_t index = ClaimLowestBit(readyMask_);
+    if (index < 0) {
+        return nullptr;
+    }
+    slots_[index].state.store(static_cast<uint32_t>(DBufferSlotState::SLOT_FILLED), std::memory_order_release);
+    DHLOGD("Acquire buffer success, index = %d", index);
+    return slots_[index].buffer;
+}
 
-    auto it = std::find(busyList_.begin(), busyList_.end(), buffer);
-    if (it == busyList_.end()) {
-        DHLOGE("Busy list is empty, cannot remove buffer.");
-        return RC_ERROR;
+std::shared_ptr<DImageBuffer> DBufferManager::RemoveBuffer(int32_t index)
+{
+    if (!IsValidIndex(index) ||
+        !SwitchSlotState(index, DBufferSlotState::SLOT_FILLED, DBufferSlotState::SLOT_FLUSHED)) {
+        DHLOGE("Buffer %d is not in use, cannot remove buffer.", index);
+        return nullptr;
     }
-    busyList_.erase(it);
+    return slots_[index].buffer;
+}
 
+RetCode DBufferManager::ReleaseSlot(int32_t index)
+{
+    if (!IsValidIndex(index)) {
+        return RC_ERROR;
+    }
+    DBufferSlotState state = GetSlotState(index);
+    bool isReady = (readyMask_.load(std::memory_order_acquire) & (1ULL << index)) != 0;
+    if (state == DBufferSlotState::SLOT_IDLE || state == DBufferSlotState::SLOT_FILLED || isReady) {
+        DHLOGE("Slot %d state %u cannot be released.", index, static_cast<uint32_t>(state));
+        return RC_ERROR;
+    }
+    slots_[index].buffer = nullptr;
+    slots_[index].state.store(static_cast<uint32_t>(DBufferSlotState::SLOT_IDLE), std::memory_order_release);
+    freeMask_.fetch_or(1ULL << index, std::memory_order_release);
     return RC_OK;
 }
 
+DBufferSlotState DBufferManager::GetSlotState(int32_t index) const
+{
+    if (!IsValidIndex(index)) {
+        return DBufferSlotState::SLOT_IDLE;
+    }
+    return static_cast<DBufferSlotState>(slots_[index].state.load(std::memory_order_acquire));
+}
+
+uint32_t DBufferManager::GetCapacity() const
+{
+    return capacity_;
+}
+
 void DBufferManager::NotifyStop(bool state)
 {
     streamStop_ = state;
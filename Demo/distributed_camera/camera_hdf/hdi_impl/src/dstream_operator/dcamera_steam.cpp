@@ -82,7 +82,17 @@ DCamRetCode DCameraStream::InitDCameraBufferManager()
         DHLOGE("Distributed camera stream producer is invalid.");
         return DCamRetCode::INVALID_ARGUMENT;
     }
-    dcStreamBufferMgr_ = std::make_shared<DBufferManager>();
+    dcStreamBufferMgr_ = std::make_shared<DBufferManager>(BUFFER_QUEUE_SIZE);
+    bufferConfigs_.assign(dcStreamBufferMgr_->GetCapacity(), DSurfaceBufferConfig());
+    // A buffer the consumer releases back to the surface can be requested again right away.
+    std::weak_ptr<DCameraStream> weakStream = shared_from_this();
+    dcStreamProducer_->RegisterReleaseListener([weakStream](OHOS::sptr<OHOS::SurfaceBuffer> &buffer) {
+        std::shared_ptr<DCameraStream> stream = weakStream.lock();
+        if (stream != nullptr) {
+            stream->NotifyBufferAvailable();
+        }
+        return OHOS::SURFACE_ERROR_OK;
+    });
 
     DCamRetCode ret = DCamRetCode::SUCCESS;
     if (!isBufferMgrInited_) {
@@ -173,6 +183,11 @@ DCamRetCode DCameraStream::GetNextRequest()
         return DCamRetCode::INVALID_ARGUMENT;
     }
 
+    int32_t index = dcStreamBufferMgr_->ReserveSlot();
+    if (index < 0) {
+        return DCamRetCode::EXCEED_MAX_NUMBER;
+    }
+
     OHOS::sptr<OHOS::SurfaceBuffer> surfaceBuffer = nullptr;
     int32_t fence = -1;
     int32_t usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE | HBM_USE_MEM_DMA;
@@ -188,11 +203,13 @@ DCamRetCode DCameraStream::GetNextRequest()
     OHOS::SurfaceError surfaceError = dcStreamProducer_->RequestBuffer(surfaceBuffer, fence, config);
     if (surfaceError == OHOS::SURFACE_ERROR_NO_BUFFER) {
         DHLOGE("No availiable buffer to request in surface.");
+        dcStreamBufferMgr_->ReleaseSlot(index);
         return DCamRetCode::EXCEED_MAX_NUMBER;
     }
 
     if (surfaceError != OHOS::SURFACE_ERROR_OK || surfaceBuffer == nullptr) {
         DHLOGE("Get producer buffer failed. [streamId = %d] [sfError = %d]", dcStreamInfo_->streamId_, surfaceError);
+        dcStreamBufferMgr_->ReleaseSlot(index);
         return DCamRetCode::EXCEED_MAX_NUMBER;
     }
 
@@ -200,36 +217,44 @@ DCamRetCode DCameraStream::GetNextRequest()
     RetCode ret = DBufferManager::SurfaceBufferToDImageBuffer(surfaceBuffer, imageBuffer);
     if (ret != RC_OK) {
         DHLOGE("Convert surface buffer to image buffer failed, streamId = %d.", dcStreamInfo_->streamId_);
+        dcStreamProducer_->CancelBuffer(surfaceBuffer);
+        dcStreamBufferMgr_->ReleaseSlot(index);
         return DCamRetCode::EXCEED_MAX_NUMBER;
     }
 
-    imageBuffer->SetIndex(++index_);
+    imageBuffer->SetIndex(index);
     imageBuffer->SetFenceId(fence);
+    bufferConfigs_[index] = { surfaceBuffer, fence, usage };
     ret = dcStreamBufferMgr_->AddBuffer(imageBuffer);
     if (ret != RC_OK) {
         DHLOGE("Add buffer to buffer manager failed. [streamId = %d]", dcStreamInfo_->streamId_);
+        FlushSurfaceBuffer(index, true);
+        dcStreamBufferMgr_->ReleaseSlot(index);
         return DCamRetCode::EXCEED_MAX_NUMBER;
     }
-    DHLOGI("Add new image buffer success: index = %d, fence = %d", imageBuffer->GetIndex(), fence);
-
-    auto itr = bufferConfigMap_.find(imageBuffer);
-    if (itr == bufferConfigMap_.end()) {
-        auto bufferCfg = std::make_tuple(surfaceBuffer, fence, usage);
-        bufferConfigMap_.insert(std::make_pair(imageBuffer, bufferCfg));
-    }
-
+    DHLOGI("Add new image buffer success: index = %d, fence = %d", index, fence);
     return DCamRetCode::SUCCESS;
 }
 
 DCamRetCode DCameraStream::GetDCameraBuffer(shared_ptr<DCameraBuffer> &buffer)
 {
-    DCamRetCode retCode = GetNextRequest();
-    if (retCode != DCamRetCode::SUCCESS && retCode != DCamRetCode::EXCEED_MAX_NUMBER) {
-        DHLOGE("Get next request failed.");
-        return retCode;
+    if (dcStreamBufferMgr_ == nullptr) {
+        DHLOGE("BufferManager not be init.");
+        return DCamRetCode::INVALID_ARGUMENT;
     }
 
+    // Only go to the surface when no requested buffer is left in the slot table.
     std::shared_ptr<DImageBuffer> imageBuffer = dcStreamBufferMgr_->AcquireBuffer();
+    if (imageBuffer == nullptr) {
+        // Ask for the notification before the last look, so a buffer freed in between is not missed.
+        isBufferWanted_ = true;
+        DCamRetCode retCode = GetNextRequest();
+        if (retCode != DCamRetCode::SUCCESS && retCode != DCamRetCode::EXCEED_MAX_NUMBER) {
+            DHLOGE("Get next request failed.");
+            return retCode;
+        }
+        imageBuffer = dcStreamBufferMgr_->AcquireBuffer();
+    }
     if (imageBuffer == nullptr) {
         DHLOGE("Cannot get idle buffer.");
         return DCamRetCode::EXCEED_MAX_NUMBER;
@@ -238,11 +263,19 @@ DCamRetCode DCameraStream::GetDCameraBuffer(shared_ptr<DCameraBuffer> &buffer)
     RetCode ret = DBufferManager::DImageBufferToDCameraBuffer(imageBuffer, buffer);
     if (ret != RC_OK) {
         DHLOGE("Convert image buffer to distributed camera buffer failed.");
+        // The slot was already handed out, give it and its surface buffer back or it never frees again.
+        int32_t index = imageBuffer->GetIndex();
+        dcStreamBufferMgr_->RemoveBuffer(index);
+        FlushSurfaceBuffer(index, true);
+        dcStreamBufferMgr_->ReleaseSlot(index);
         return DCamRetCode::FAILED;
     }
-    captureBufferCount_++;
+    {
+        std::lock_guard<std::mutex> l(lock_);
+        captureBufferCount_++;
+    }
 
-    DHLOGI("Get buffer success. address = %p, index = %d, size = %d", buffer->bufferHandle_->virAddr,
+    DHLOGD("Get buffer success. address = %p, index = %d, size = %d", buffer->bufferHandle_->virAddr,
         buffer->index_, buffer->size_);
     return DCamRetCode::SUCCESS;
 }
@@ -253,55 +286,56 @@ DCamRetCode DCameraStream::ReturnDCameraBuffer(const shared_ptr<DCameraBuffer> &
         DHLOGE("result buffer is null. [streamId = %d]", dcStreamInfo_->streamId_);
         return DCamRetCode::INVALID_ARGUMENT;
     }
-
-    shared_ptr<DImageBuffer> imageBuffer = nullptr;
-    map<shared_ptr<DImageBuffer>, tuple<OHOS::sptr<OHOS::SurfaceBuffer>, int, int>>::iterator iter;
-    for (iter = bufferConfigMap_.begin(); iter != bufferConfigMap_.end(); ++iter) {
-        if (buffer->index_ == iter->first->GetIndex()) {
-            imageBuffer = iter->first;
-            break;
-        }
+    if (dcStreamBufferMgr_ == nullptr) {
+        DHLOGE("BufferManager not be init.");
+        return DCamRetCode::INVALID_ARGUMENT;
     }
+
+    shared_ptr<DImageBuffer> imageBuffer = dcStreamBufferMgr_->RemoveBuffer(buffer->index_);
     if (imageBuffer == nullptr) {
         DHLOGE("Cannot found image buffer, buffer index = %d.", buffer->index_);
         return DCamRetCode::INVALID_ARGUMENT;
     }
 
-    RetCode ret = dcStreamBufferMgr_->RemoveBuffer(imageBuffer);
-    if (ret != RC_OK) {
-        DHLOGE("Buffer manager remove buffer failed: %d", ret);
+    // An empty buffer is one the source gives back unused, it goes back to the surface without a frame.
+    FlushSurfaceBuffer(buffer->index_, buffer->size_ == 0);
+    dcStreamBufferMgr_->ReleaseSlot(buffer->index_);
+    {
+        std::lock_guard<std::mutex> l(lock_);
+        captureBufferCount_--;
     }
+    cv_.notify_one();
+    NotifyBufferAvailable();
+    return DCamRetCode::SUCCESS;
+}
 
-    auto bufCfg = bufferConfigMap_.find(imageBuffer);
-    if (bufCfg == bufferConfigMap_.end()) {
-        DHLOGE("Cannot get bufferConfig.");
-        return INVALID_ARGUMENT;
+void DCameraStream::FlushSurfaceBuffer(int32_t index, bool isCancel)
+{
+    DSurfaceBufferConfig bufCfg = bufferConfigs_[index];
+    bufferConfigs_[index] = DSurfaceBufferConfig();
+    if (dcStreamProducer_ == nullptr || bufCfg.surfaceBuffer == nullptr) {
+        return;
+    }
+    if (isCancel) {
+        dcStreamProducer_->CancelBuffer(bufCfg.surfaceBuffer);
+        return;
     }
-    auto surfaceBuffer = std::get<0>(bufCfg->second);
-    int32_t fence = std::get<1>(bufCfg->second);
+
     OHOS::BufferFlushConfig flushConf = {
         .damage = { .x = 0, .y = 0, .w = dcStreamInfo_->width_, .h = dcStreamInfo_->height_ },
         .timestamp = 0
     };
-    if (dcStreamProducer_ != nullptr) {
-        if (dcStreamInfo_->intent_ == StreamIntent::VIDEO) {
-            int32_t size = (dcStreamInfo_->width_) * (dcStreamInfo_->height_) * YUV_WIDTH_RATIO / YUV_HEIGHT_RATIO;
-            int64_t timeStamp = static_cast<int64_t>(GetCurrentLocalTimeStamp());
-            surfaceBuffer->ExtraSet("dataSize", size);
-            surfaceBuffer->ExtraSet("isKeyFrame", (int32_t)0);
-            surfaceBuffer->ExtraSet("timeStamp", timeStamp);
-        }
-        int ret = dcStreamProducer_->FlushBuffer(surfaceBuffer, fence, flushConf);
-        if (ret != 0) {
-            DHLOGI("FlushBuffer error: %d", ret);
-        }
+    if (dcStreamInfo_->intent_ == StreamIntent::VIDEO) {
+        int32_t size = (dcStreamInfo_->width_) * (dcStreamInfo_->height_) * YUV_WIDTH_RATIO / YUV_HEIGHT_RATIO;
+        int64_t timeStamp = static_cast<int64_t>(GetCurrentLocalTimeStamp());
+        bufCfg.surfaceBuffer->ExtraSet("dataSize", size);
+        bufCfg.surfaceBuffer->ExtraSet("isKeyFrame", (int32_t)0);
+        bufCfg.surfaceBuffer->ExtraSet("timeStamp", timeStamp);
     }
-    bufferConfigMap_.erase(bufCfg);
-    {
-        captureBufferCount_--;
-        cv_.notify_one();
+    int ret = dcStreamProducer_->FlushBuffer(bufCfg.surfaceBuffer, bufCfg.fence, flushConf);
+    if (ret != 0) {
+        DHLOGI("FlushBuffer error: %d", ret);
     }
-    return DCamRetCode::SUCCESS;
 }
 
 DCamRetCode DCameraStream::FlushDCameraBuffer()
@@ -311,46 +345,55 @@ DCamRetCode DCameraStream::FlushDCameraBuffer()
         return DCamRetCode::SUCCESS;
     }
 
-    if (captureBufferCount_ != 0) {
-        DHLOGI("StreamId:%d has request that not return, captureBufferCount=%d",
-            dcStreamInfo_->streamId_, captureBufferCount_);
-    }
     {
         std::unique_lock<std::mutex> l(lock_);
+        if (captureBufferCount_ != 0) {
+            DHLOGI("StreamId:%d has request that not return, captureBufferCount=%d",
+                dcStreamInfo_->streamId_, captureBufferCount_);
+        }
         cv_.wait(l, [this] { return !captureBufferCount_; });
     }
+    return FlushIdleDCameraBuffer();
+}
 
-    while (true) {
-        std::shared_ptr<DImageBuffer> imageBuffer = dcStreamBufferMgr_->AcquireBuffer();
-        if (imageBuffer == nullptr) {
-            auto bufCfg = bufferConfigMap_.find(imageBuffer);
-            if (bufCfg == bufferConfigMap_.end()) {
-                DHLOGE("Buffer not in map.");
-                return DCamRetCode::INVALID_ARGUMENT;
-            }
-            auto surfaceBuffer = std::get<0>(bufCfg->second);
-            int32_t fence = std::get<1>(bufCfg->second);
-            OHOS::BufferFlushConfig flushConf = {
-                .damage = {
-                    .x = 0,
-                    .y = 0,
-                    .w = dcStreamInfo_->width_,
-                    .h = dcStreamInfo_->height_ },
-                .timestamp = 0
-            };
-            if (dcStreamProducer_ != nullptr) {
-                dcStreamProducer_->FlushBuffer(surfaceBuffer, fence, flushConf);
-            }
-            bufferConfigMap_.erase(bufCfg);
-        } else {
-            break;
-        }
+DCamRetCode DCameraStream::FlushIdleDCameraBuffer()
+{
+    if (dcStreamBufferMgr_ == nullptr || dcStreamProducer_ == nullptr) {
+        DHLOGE("BufferManager or Producer is null.");
+        return DCamRetCode::SUCCESS;
+    }
+
+    // Give the buffers that were requested but never filled back to the surface.
+    std::shared_ptr<DImageBuffer> imageBuffer = nullptr;
+    while ((imageBuffer = dcStreamBufferMgr_->AcquireBuffer()) != nullptr) {
+        int32_t index = imageBuffer->GetIndex();
+        dcStreamBufferMgr_->RemoveBuffer(index);
+        FlushSurfaceBuffer(index, true);
+        dcStreamBufferMgr_->ReleaseSlot(index);
     }
-    captureBufferCount_ = 0;
-    index_ = -1;
     return DCamRetCode::SUCCESS;
 }
 
+void DCameraStream::SetBufferAvailableNotifier(const DBufferAvailableNotifier &notifier)
+{
+    bufferNotifier_ = notifier;
+}
+
+void DCameraStream::NotifyBufferAvailable()
+{
+    if (bufferNotifier_ == nullptr || !isBufferWanted_.exchange(false)) {
+        return;
+    }
+    DHLOGD("Notify buffer available, streamId = %d.", dcStreamId_);
+    bufferNotifier_(dcStreamId_);
+}
+
+bool DCameraStream::HasCaptureBuffer()
+{
+    std::lock_guard<std::mutex> l(lock_);
+    return captureBufferCount_ != 0;
+}
+
 bool DCameraStream::HasBufferQueue()
 {
     if (dcStreamProducer_ == nullptr || isBufferMgrInited_ == false) {
@@ -18,21 +18,220 @@
 
 namespace OHOS {
 namespace DistributedHardware {
+DOfflineStreamOperator::DOfflineStreamOperator(const OHOS::sptr<IStreamOperatorCallback> &callback)
+    : callback_(callback)
+{
+    DHLOGI("DOfflineStreamOperator::ctor, instance = %p", this);
+}
+
 CamRetCode DOfflineStreamOperator::CancelCapture(int captureId)
 {
-    (void)captureId;
-    return CamRetCode::METHOD_NOT_SUPPORTED;
+    DHLOGI("DOfflineStreamOperator::CancelCapture, captureId = %d.", captureId);
+    std::vector<int> streamIds;
+    {
+        std::lock_guard<std::mutex> autoLock(offlineLock_);
+        for (auto &iter : offlineStreams_) {
+            if (iter.second.captureId == captureId) {
+                streamIds.push_back(iter.first);
+            }
+        }
+    }
+    if (streamIds.empty()) {
+        DHLOGE("Offline capture %d is not found.", captureId);
+        return CamRetCode::INVALID_ARGUMENT;
+    }
+    EndStreams(streamIds);
+    return CamRetCode::NO_ERROR;
 }
 
 CamRetCode DOfflineStreamOperator::ReleaseStreams(const std::vector<int>& streamIds)
 {
-    (void)streamIds;
-    return CamRetCode::METHOD_NOT_SUPPORTED;
+    DHLOGI("DOfflineStreamOperator::ReleaseStreams, stream id list size = %zu.", streamIds.size());
+    for (int id : streamIds) {
+        if (!HasStream(id)) {
+            DHLOGE("Offline stream %d is not found.", id);
+            return CamRetCode::INVALID_ARGUMENT;
+        }
+    }
+    EndStreams(streamIds);
+    return CamRetCode::NO_ERROR;
 }
 
 CamRetCode DOfflineStreamOperator::Release()
 {
-    return CamRetCode::METHOD_NOT_SUPPORTED;
+    DHLOGI("DOfflineStreamOperator::Release, begin release offline stream operator.");
+    std::vector<int> streamIds;
+    {
+        std::lock_guard<std::mutex> autoLock(offlineLock_);
+        for (auto &iter : offlineStreams_) {
+            streamIds.push_back(iter.first);
+        }
+    }
+    EndStreams(streamIds);
+    return CamRetCode::NO_ERROR;
+}
+
+DCamRetCode DOfflineStreamOperator::AddOfflineStream(int streamId, int32_t captureId,
+    const std::shared_ptr<DCameraStream> &stream, const std::shared_ptr<std::atomic<uint32_t>> &frameCount,
+    uint32_t captureDepth, bool enableShutterCbk)
+{
+    if (stream == nullptr || frameCount == nullptr) {
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+    std::lock_guard<std::mutex> autoLock(offlineLock_);
+    OfflineStream &offlineStream = offlineStreams_[streamId];
+    offlineStream.captureId = captureId;
+    offlineStream.stream = stream;
+    offlineStream.frameCount = frameCount;
+    offlineStream.captureDepth = captureDepth;
+    offlineStream.enableShutterCbk = enableShutterCbk;
+    // A burst that already delivered its last picture was reported ended by the stream operator.
+    offlineStream.isEnded = (captureDepth != 0) && (frameCount->load() >= captureDepth);
+    DHLOGI("DOfflineStreamOperator::AddOfflineStream, captureId = %d, streamId = %d.", captureId, streamId);
+    return DCamRetCode::SUCCESS;
+}
+
+DCamRetCode DOfflineStreamOperator::AcquireBuffer(int streamId, std::shared_ptr<DCameraBuffer> &buffer)
+{
+    // Held across the acquire, so a stream is never drained while a buffer is on its way to the source.
+    std::lock_guard<std::mutex> autoLock(offlineLock_);
+    auto iter = offlineStreams_.find(streamId);
+    if (iter == offlineStreams_.end() || iter->second.isEnded) {
+        DHLOGE("Offline stream %d is not capturing, can not acquire buffer.", streamId);
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+    return iter->second.stream->GetDCameraBuffer(buffer);
+}
+
+DCamRetCode DOfflineStreamOperator::ShutterBuffer(int streamId, const std::shared_ptr<DCameraBuffer> &buffer)
+{
+    OfflineStream offlineStream;
+    {
+        std::lock_guard<std::mutex> autoLock(offlineLock_);
+        auto iter = offlineStreams_.find(streamId);
+        if (iter == offlineStreams_.end()) {
+            DHLOGE("Offline stream %d is not found, can not shutter buffer.", streamId);
+            return DCamRetCode::INVALID_ARGUMENT;
+        }
+        offlineStream = iter->second;
+    }
+
+    DCamRetCode ret = offlineStream.stream->ReturnDCameraBuffer(buffer);
+    if (ret != DCamRetCode::SUCCESS) {
+        DHLOGE("Flush offline stream %d buffer failed.", streamId);
+        return ret;
+    }
+    std::vector<int> streamIds;
+    streamIds.push_back(streamId);
+    if (buffer->size_ != 0 && !offlineStream.isEnded) {
+        uint32_t frameCount = ++(*offlineStream.frameCount);
+        if (offlineStream.enableShutterCbk && callback_ != nullptr) {
+            callback_->OnFrameShutter(offlineStream.captureId, streamIds, GetCurrentLocalTimeStamp());
+        }
+        if (frameCount == offlineStream.captureDepth) {
+            EndStreams(streamIds);
+        }
+    }
+    // The source gives back what it still holds of an ended capture, the stream goes once all is back.
+    DrainStreams(streamIds);
+    return DCamRetCode::SUCCESS;
+}
+
+bool DOfflineStreamOperator::HasStream(int streamId)
+{
+    std::lock_guard<std::mutex> autoLock(offlineLock_);
+    return offlineStreams_.find(streamId) != offlineStreams_.end();
+}
+
+bool DOfflineStreamOperator::IsEmpty()
+{
+    std::lock_guard<std::mutex> autoLock(offlineLock_);
+    return offlineStreams_.empty();
+}
+
+bool DOfflineStreamOperator::IsCapturing()
+{
+    std::lock_guard<std::mutex> autoLock(offlineLock_);
+    return IsCapturingLocked();
+}
+
+bool DOfflineStreamOperator::SetFinishedCallback(const std::function<void()> &callback)
+{
+    std::lock_guard<std::mutex> autoLock(offlineLock_);
+    if (!IsCapturingLocked()) {
+        return false;
+    }
+    finishedCallback_ = callback;
+    return true;
+}
+
+bool DOfflineStreamOperator::IsCapturingLocked()
+{
+    for (auto &iter : offlineStreams_) {
+        if (!iter.second.isEnded) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DOfflineStreamOperator::EndStreams(const std::vector<int> &streamIds)
+{
+    std::map<int32_t, std::vector<std::shared_ptr<CaptureEndedInfo>>> endedInfos;
+    std::vector<std::shared_ptr<DCameraStream>> streams;
+    std::function<void()> finishedCallback = nullptr;
+    {
+        std::lock_guard<std::mutex> autoLock(offlineLock_);
+        for (int id : streamIds) {
+            auto iter = offlineStreams_.find(id);
+            if (iter == offlineStreams_.end() || iter->second.isEnded) {
+                continue;
+            }
+            std::shared_ptr<CaptureEndedInfo> info = std::make_shared<CaptureEndedInfo>();
+            info->streamId_ = id;
+            info->frameCount_ = static_cast<int>(iter->second.frameCount->load());
+            endedInfos[iter->second.captureId].push_back(info);
+            streams.push_back(iter->second.stream);
+            iter->second.isEnded = true;
+        }
+        if (!streams.empty() && !IsCapturingLocked()) {
+            finishedCallback = finishedCallback_;
+            finishedCallback_ = nullptr;
+        }
+    }
+
+    // Buffers the source still holds are not waited for, they come back through ShutterBuffer.
+    for (auto &stream : streams) {
+        stream->FlushIdleDCameraBuffer();
+    }
+    if (callback_ != nullptr) {
+        for (auto &iter : endedInfos) {
+            callback_->OnCaptureEnded(iter.first, iter.second);
+        }
+    }
+    DrainStreams(streamIds);
+    if (finishedCallback) {
+        finishedCallback();
+    }
+}
+
+void DOfflineStreamOperator::DrainStreams(const std::vector<int> &streamIds)
+{
+    std::vector<std::shared_ptr<DCameraStream>> streams;
+    {
+        std::lock_guard<std::mutex> autoLock(offlineLock_);
+        for (int id : streamIds) {
+            auto iter = offlineStreams_.find(id);
+            if (iter == offlineStreams_.end() || !iter->second.isEnded || iter->second.stream->HasCaptureBuffer()) {
+                continue;
+            }
+            streams.push_back(iter->second.stream);
+            offlineStreams_.erase(iter);
+        }
+    }
+    for (auto &stream : streams) {
+        stream->ReleaseDCameraBufferQueue();
+    }
 }
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dstream_callback_dispatcher.h"
+
+#include <algorithm>
+#include "dcamera_thread_policy.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+DStreamCallbackDispatcher::DStreamCallbackDispatcher(uint32_t capacity)
+    : capacity_(capacity == 0 ? CALLBACK_QUEUE_CAPACITY : capacity)
+{
+}
+
+DStreamCallbackDispatcher::~DStreamCallbackDispatcher()
+{
+    Stop();
+}
+
+void DStreamCallbackDispatcher::SetCallback(const OHOS::sptr<IStreamOperatorCallback> &callback)
+{
+    std::lock_guard<std::mutex> autoLock(eventLock_);
+    callback_ = callback;
+}
+
+void DStreamCallbackDispatcher::OnCaptureStarted(int32_t captureId, const std::vector<int32_t> &streamIds)
+{
+    DCallbackEvent event;
+    event.type = DCallbackType::CAPTURE_STARTED;
+    event.captureId = captureId;
+    event.streamIds = streamIds;
+    Post(event);
+}
+
+void DStreamCallbackDispatcher::OnCaptureEnded(int32_t captureId,
+    const std::vector<std::shared_ptr<CaptureEndedInfo>> &infos)
+{
+    DCallbackEvent event;
+    event.type = DCallbackType::CAPTURE_ENDED;
+    event.captureId = captureId;
+    event.endedInfos = infos;
+    Post(event);
+}
+
+void DStreamCallbackDispatcher::OnFrameShutter(int32_t captureId, int32_t streamId, uint64_t timestamp)
+{
+    DCallbackEvent event;
+    event.type = DCallbackType::FRAME_SHUTTER;
+    event.captureId = captureId;
+    event.streamIds.push_back(streamId);
+    event.timestamp = timestamp;
+    Post(event);
+}
+
+void DStreamCallbackDispatcher::Stop()
+{
+    {
+        std::lock_guard<std::mutex> autoLock(eventLock_);
+        if (!isRunning_) {
+            return;
+        }
+        isStopped_ = true;
+        isRunning_ = false;
+    }
+    eventCond_.notify_one();
+    if (dispatchThread_.joinable()) {
+        dispatchThread_.join();
+    }
+    {
+        // the operator outlives a Release on error, the next Post starts a new dispatch thread
+        std::lock_guard<std::mutex> autoLock(eventLock_);
+        isStopped_ = false;
+    }
+    DStreamCallbackMetrics metrics = GetMetrics();
+    DHLOGI("DStreamCallbackDispatcher stopped, shutter: %llu, coalesced: %llu, dropped: %llu, avg latency: %llu us, " \
+        "max latency: %llu us, max backlog: %u", (unsigned long long)metrics.shutterCount,
+        (unsigned long long)metrics.coalescedCount, (unsigned long long)metrics.droppedCount,
+        (unsigned long long)metrics.avgShutterLatencyUs, (unsigned long long)metrics.maxShutterLatencyUs,
+        metrics.maxBacklog);
+}
+
+DStreamCallbackMetrics DStreamCallbackDispatcher::GetMetrics()
+{
+    std::lock_guard<std::mutex> autoLock(eventLock_);
+    DStreamCallbackMetrics metrics = metrics_;
+    metrics.backlog = static_cast<uint32_t>(events_.size());
+    metrics.avgShutterLatencyUs = (deliveredShutterCount_ == 0) ? 0 :
+        totalShutterLatencyUs_ / deliveredShutterCount_;
+    return metrics;
+}
+
+void DStreamCallbackDispatcher::Post(DCallbackEvent &event)
+{
+    std::lock_guard<std::mutex> autoLock(eventLock_);
+    if (callback_ == nullptr || isStopped_) {
+        return;
+    }
+    if (!isRunning_) {
+        isRunning_ = true;
+        dispatchThread_ = std::thread(&DStreamCallbackDispatcher::DispatchLoop, this);
+    }
+
+    event.postTime = std::chrono::steady_clock::now();
+    if (event.type == DCallbackType::FRAME_SHUTTER) {
+        metrics_.shutterCount++;
+        if (CoalesceShutter(event)) {
+            return;
+        }
+        if (events_.size() >= capacity_) {
+            DropOldestShutter();
+        }
+    }
+    events_.push_back(event);
+    metrics_.maxBacklog = std::max(metrics_.maxBacklog, static_cast<uint32_t>(events_.size()));
+    eventCond_.notify_one();
+}
+
+bool DStreamCallbackDispatcher::CoalesceShutter(const DCallbackEvent &event)
+{
+    if (events_.empty()) {
+        return false;
+    }
+    DCallbackEvent &last = events_.back();
+    if (last.type != DCallbackType::FRAME_SHUTTER || last.captureId != event.captureId) {
+        return false;
+    }
+    for (int32_t streamId : event.streamIds) {
+        if (std::find(last.streamIds.begin(), last.streamIds.end(), streamId) == last.streamIds.end()) {
+            last.streamIds.push_back(streamId);
+        }
+    }
+    last.timestamp = event.timestamp;
+    metrics_.coalescedCount++;
+    return true;
+}
+
+void DStreamCallbackDispatcher::DropOldestShutter()
+{
+    auto iter = std::find_if(events_.begin(), events_.end(),
+        [](const DCallbackEvent &event) { return event.type == DCallbackType::FRAME_SHUTTER; });
+    if (iter != events_.end()) {
+        events_.erase(iter);
+        metrics_.droppedCount++;
+    }
+}
+
+void DStreamCallbackDispatcher::Deliver(const OHOS::sptr<IStreamOperatorCallback> &callback,
+    const DCallbackEvent &event)
+{
+    switch (event.type) {
+        case DCallbackType::CAPTURE_STARTED:
+            callback->OnCaptureStarted(event.captureId, event.streamIds);
+            break;
+        case DCallbackType::CAPTURE_ENDED:
+            callback->OnCaptureEnded(event.captureId, event.endedInfos);
+            break;
+        case DCallbackType::FRAME_SHUTTER:
+            callback->OnFrameShutter(event.captureId, event.streamIds, event.timestamp);
+            break;
+        default:
+            break;
+    }
+}
+
+void DStreamCallbackDispatcher::DispatchLoop()
+{
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamCbDispatch", DCAMERA_TASK_TIER_FRAME);
+    while (true) {
+        DCallbackEvent event;
+        OHOS::sptr<IStreamOperatorCallback> callback = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(eventLock_);
+            eventCond_.wait(lock, [this] { return !isRunning_ || !events_.empty(); });
+            // Whatever was posted before Stop is still delivered, capture end notifications must not get lost.
+            if (events_.empty()) {
+                break;
+            }
+            event = std::move(events_.front());
+            events_.pop_front();
+            callback = callback_;
+        }
+        if (callback == nullptr) {
+            continue;
+        }
+        Deliver(callback, event);
+        if (event.type != DCallbackType::FRAME_SHUTTER) {
+            continue;
+        }
+        uint64_t latencyUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - event.postTime).count());
+        std::lock_guard<std::mutex> autoLock(eventLock_);
+        totalShutterLatencyUs_ += latencyUs;
+        deliveredShutterCount_++;
+        metrics_.maxShutterLatencyUs = std::max(metrics_.maxShutterLatencyUs, latencyUs);
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
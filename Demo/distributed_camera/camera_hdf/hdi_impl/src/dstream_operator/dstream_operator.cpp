@@ -14,9 +14,14 @@
  */
 
 #include "dstream_operator.h"
+
+#include <algorithm>
+
 #include "dbuffer_manager.h"
 #include "dcamera_provider.h"
+#include "dcamera_thread_policy.h"
 #include "dcamera_utils_tools.h"
+#include "distributed_camera_constants.h"
 #include "distributed_hardware_log.h"
 #include "json/json.h"
 #include "metadata_utils.h"
@@ -29,6 +34,12 @@ DStreamOperator::DStreamOperator(std::shared_ptr<DMetadataProcessor> &dMetadataP
     DHLOGI("DStreamOperator::ctor, instance = %p", this);
 }
 
+DStreamOperator::~DStreamOperator()
+{
+    StopResultThread();
+    callbackDispatcher_.Stop();
+}
+
 CamRetCode DStreamOperator::IsStreamsSupported(OperationMode mode,
     const std::shared_ptr<CameraStandard::CameraMetadata> &modeSetting,
     const std::vector<std::shared_ptr<StreamInfo>> &info,
@@ -74,6 +85,13 @@ CamRetCode DStreamOperator::CreateStreams(const std::vector<std::shared_ptr<Stre
             DHLOGE("Create distributed camera stream failed.");
             return CamRetCode::INSUFFICIENT_RESOURCES;
         }
+        std::shared_ptr<DHBase> dhBase = dhBase_;
+        dcStream->SetBufferAvailableNotifier([dhBase](int streamId) {
+            std::shared_ptr<DCameraProvider> provider = DCameraProvider::GetInstance();
+            if (provider != nullptr) {
+                provider->NotifyBufferAvailable(dhBase, streamId);
+            }
+        });
         DCamRetCode ret = dcStream->InitDCameraStream(info);
         if (ret != SUCCESS) {
             DHLOGE("Init distributed camera stream failed.");
@@ -119,6 +137,7 @@ CamRetCode DStreamOperator::ReleaseStreams(const std::vector<int>& streamIds)
             return CamRetCode::INVALID_ARGUMENT;
         }
     }
+    RebuildRouteTable();
 
     std::shared_ptr<DCameraProvider> provider = DCameraProvider::GetInstance();
     if (provider == nullptr) {
@@ -267,11 +286,11 @@ CamRetCode DStreamOperator::Capture(int captureId, const std::shared_ptr<Capture
             DHLOGE("Stream %d has not bufferQueue.", iter->first);
             return CamRetCode::INVALID_ARGUMENT;
         }
-        enableShutterCbkMap_[id] = captureInfo->enableShutterCallback_;
         DHLOGI("DStreamOperator::Capture info: captureId=%d, streamId=%d, isStreaming=%d", captureId, id, isStreaming);
     }
 
-    DCamRetCode ret = NegotiateSuitableCaptureInfo(captureInfo, isStreaming);
+    uint32_t captureDepth = 0;
+    DCamRetCode ret = NegotiateSuitableCaptureInfo(captureInfo, isStreaming, captureDepth);
     if (ret != SUCCESS) {
         DHLOGE("Negotiate suitable capture info failed.");
         return MapToExternalRetCode(ret);
@@ -288,10 +307,10 @@ CamRetCode DStreamOperator::Capture(int captureId, const std::shared_ptr<Capture
         return MapToExternalRetCode(ret);
     }
     halCaptureInfoMap_[captureId] = captureInfo;
+    captureDepthMap_[captureId] = captureDepth;
+    RebuildRouteTable();
 
-    if (dcStreamOperatorCallback_) {
-        dcStreamOperatorCallback_->OnCaptureStarted(captureId, captureInfo->streamIds_);
-    }
+    callbackDispatcher_.OnCaptureStarted(captureId, captureInfo->streamIds_);
     SetCapturing(true);
     DHLOGI("DStreamOperator::Capture, start distributed camera capture success.");
 
@@ -320,6 +339,7 @@ CamRetCode DStreamOperator::CancelCapture(int captureId)
         return MapToExternalRetCode(ret);
     }
 
+    std::shared_ptr<const DStreamRouteTable> routeTable = std::atomic_load(&routeTable_);
     std::vector<std::shared_ptr<CaptureEndedInfo>> info;
     for (auto id : halCaptureInfoMap_[captureId]->streamIds_) {
         auto iter = halStreamMap_.find(id);
@@ -327,16 +347,23 @@ CamRetCode DStreamOperator::CancelCapture(int captureId)
             iter->second->FlushDCameraBuffer();
         }
         std::shared_ptr<CaptureEndedInfo> tmp = std::make_shared<CaptureEndedInfo>();
-        tmp->frameCount_ = acceptedBufferNum_[std::make_pair(captureId, id)];
+        auto route = routeTable->find(id);
+        if (route != routeTable->end() && route->second.captureId == captureId) {
+            if (IsCaptureEnded(route->second)) {
+                continue;
+            }
+            tmp->frameCount_ = static_cast<int>(route->second.frameCount->load());
+        }
         tmp->streamId_ = id;
         info.push_back(tmp);
-        acceptedBufferNum_.erase(std::make_pair(captureId, id));
     }
-    if (dcStreamOperatorCallback_) {
-        dcStreamOperatorCallback_->OnCaptureEnded(captureId, info);
+    if (!info.empty()) {
+        callbackDispatcher_.OnCaptureEnded(captureId, info);
     }
     cachedDCaptureInfoList_.clear();
     halCaptureInfoMap_.erase(captureId);
+    captureDepthMap_.erase(captureId);
+    RebuildRouteTable();
 
     return CamRetCode::NO_ERROR;
 }
@@ -344,10 +371,65 @@ CamRetCode DStreamOperator::CancelCapture(int captureId)
 CamRetCode DStreamOperator::ChangeToOfflineStream(const std::vector<int>& streamIds,
     OHOS::sptr<IStreamOperatorCallback>& callback, OHOS::sptr<IOfflineStreamOperator>& offlineOperator)
 {
-    (void)streamIds;
-    (void)callback;
+    DHLOGI("DStreamOperator::ChangeToOfflineStream, input stream id list size=%zu.", streamIds.size());
     offlineOperator = nullptr;
-    return CamRetCode::METHOD_NOT_SUPPORTED;
+    if (streamIds.empty() || callback == nullptr) {
+        DHLOGE("Input stream id list or callback is invalid.");
+        return CamRetCode::INVALID_ARGUMENT;
+    }
+
+    std::unique_lock<std::mutex> lock(requestLock_);
+    std::shared_ptr<const DStreamRouteTable> routeTable = std::atomic_load(&routeTable_);
+    for (int id : streamIds) {
+        auto route = routeTable->find(id);
+        if (route == routeTable->end()) {
+            DHLOGE("Stream %d is not capturing, can not change to offline.", id);
+            return CamRetCode::INVALID_ARGUMENT;
+        }
+        if (!route->second.isSnapshot) {
+            DHLOGE("Only snapshot streams can change to offline, streamId=%d.", id);
+            return CamRetCode::METHOD_NOT_SUPPORTED;
+        }
+    }
+
+    if (offlineStreamOperator_ == nullptr) {
+        offlineStreamOperator_ = new (std::nothrow) DOfflineStreamOperator(callback);
+        if (offlineStreamOperator_ == nullptr) {
+            DHLOGE("Create offline stream operator failed.");
+            return CamRetCode::DEVICE_ERROR;
+        }
+    }
+
+    // The offline operator takes the streams with their buffers, they are no longer part of this session.
+    for (int id : streamIds) {
+        const DStreamRoute &route = routeTable->at(id);
+        offlineStreamOperator_->AddOfflineStream(id, route.captureId, route.stream, route.frameCount,
+            route.captureDepth, route.enableShutterCbk);
+        halStreamMap_.erase(id);
+        dcStreamInfoMap_.erase(id);
+        auto capture = halCaptureInfoMap_.find(route.captureId);
+        if (capture == halCaptureInfoMap_.end()) {
+            continue;
+        }
+        std::vector<int> &captureStreamIds = capture->second->streamIds_;
+        captureStreamIds.erase(std::remove(captureStreamIds.begin(), captureStreamIds.end(), id),
+            captureStreamIds.end());
+        if (captureStreamIds.empty()) {
+            halCaptureInfoMap_.erase(capture);
+            captureDepthMap_.erase(route.captureId);
+        }
+    }
+    RebuildRouteTable();
+
+    offlineOperator = offlineStreamOperator_;
+    DHLOGI("DStreamOperator::ChangeToOfflineStream success.");
+    return CamRetCode::NO_ERROR;
+}
+
+OHOS::sptr<DOfflineStreamOperator> DStreamOperator::GetOfflineStreamOperator()
+{
+    std::unique_lock<std::mutex> lock(requestLock_);
+    return offlineStreamOperator_;
 }
 
 DCamRetCode DStreamOperator::InitOutputConfigurations(const std::shared_ptr<DHBase> &dhBase,
@@ -374,6 +456,11 @@ DCamRetCode DStreamOperator::InitOutputConfigurations(const std::shared_ptr<DHBa
         }
     }
 
+    if (rootValue.isMember("MaxFps") && rootValue["MaxFps"].isUInt()) {
+        uint32_t maxFps = rootValue["MaxFps"].asUInt();
+        dcSupportedMaxFps_ = std::max(MIN_SUPPORT_DEFAULT_FPS, std::min(maxFps, MAX_SUPPORT_FPS));
+    }
+
     std::set<int> allFormats;
     if (rootValue["OutputFormat"]["Preview"].isArray() && (rootValue["OutputFormat"]["Preview"].size() > 0)) {
         std::vector<int> previewFormats;
@@ -446,12 +533,15 @@ DCamRetCode DStreamOperator::InitOutputConfigurations(const std::shared_ptr<DHBa
 DCamRetCode DStreamOperator::AcquireBuffer(int streamId, std::shared_ptr<DCameraBuffer> &buffer)
 {
     std::unique_lock<std::mutex> lock(requestLock_);
+    auto iter = halStreamMap_.find(streamId);
+    if (iter == halStreamMap_.end() && offlineStreamOperator_ != nullptr &&
+        offlineStreamOperator_->HasStream(streamId)) {
+        return offlineStreamOperator_->AcquireBuffer(streamId, buffer);
+    }
     if (!IsCapturing()) {
         DHLOGE("Not in capturing state, can not acquire buffer.");
         return DCamRetCode::CAMERA_OFFLINE;
     }
-
-    auto iter = halStreamMap_.find(streamId);
     if (iter == halStreamMap_.end()) {
         DHLOGE("streamId %d is invalid, can not acquire buffer.", streamId);
         return DCamRetCode::INVALID_ARGUMENT;
@@ -468,62 +558,149 @@ DCamRetCode DStreamOperator::AcquireBuffer(int streamId, std::shared_ptr<DCamera
 
 DCamRetCode DStreamOperator::ShutterBuffer(int streamId, const std::shared_ptr<DCameraBuffer> &buffer)
 {
-    DHLOGI("DStreamOperator::ShutterBuffer begin shutter buffer for streamId = %d", streamId);
-
-    int32_t captureId = -1;
-    for (auto iter = halCaptureInfoMap_.begin(); iter != halCaptureInfoMap_.end(); iter++) {
-        std::shared_ptr<CaptureInfo> captureInfo = iter->second;
-        std::vector<int> streamIds = captureInfo->streamIds_;
-        if (std::find(streamIds.begin(), streamIds.end(), streamId) != streamIds.end()) {
-            captureId = iter->first;
-            break;
+    DHLOGD("DStreamOperator::ShutterBuffer begin shutter buffer for streamId = %d", streamId);
+
+    std::shared_ptr<const DStreamRouteTable> routeTable = std::atomic_load(&routeTable_);
+    auto iter = routeTable->find(streamId);
+    if (iter == routeTable->end()) {
+        OHOS::sptr<DOfflineStreamOperator> offlineOperator = GetOfflineStreamOperator();
+        if (offlineOperator != nullptr && offlineOperator->HasStream(streamId)) {
+            return offlineOperator->ShutterBuffer(streamId, buffer);
         }
-    }
-    if (captureId == -1) {
         DHLOGE("ShutterBuffer falied, invalid streamId = %d", streamId);
         return DCamRetCode::INVALID_ARGUMENT;
     }
+    const DStreamRoute &route = iter->second;
 
-    auto iter = halStreamMap_.find(streamId);
-    if (iter != halStreamMap_.end()) {
-        DCamRetCode ret = iter->second->ReturnDCameraBuffer(buffer);
-        if (ret != DCamRetCode::SUCCESS) {
-            DHLOGE("Flush distributed camera buffer failed.");
-            return ret;
-        }
-        acceptedBufferNum_[std::make_pair(captureId, streamId)]++;
-
-        SnapShotStreamOnCaptureEnded(captureId, streamId);
-    }
-
-    uint64_t resultTimestamp = GetCurrentLocalTimeStamp();
-    bool needReturn = false;
-    std::shared_ptr<CameraStandard::CameraMetadata> result = nullptr;
-    DCamRetCode ret = dMetadataProcessor_->UpdateResultMetadata(needReturn, result);
+    DCamRetCode ret = route.stream->ReturnDCameraBuffer(buffer);
     if (ret != DCamRetCode::SUCCESS) {
-        DHLOGE("Cannot handle result metadata.");
+        DHLOGE("Flush distributed camera buffer failed.");
         return ret;
     }
-    if (needReturn) {
-        resultCallback_(resultTimestamp, result);
+    if (buffer->size_ == 0) {
+        return DCamRetCode::SUCCESS;
     }
+    // Every picture of a burst gets its shutter, the capture ends once with the last one.
+    uint32_t frameCount = ++(*route.frameCount);
+    if (route.isSnapshot && frameCount == route.captureDepth) {
+        SnapShotStreamOnCaptureEnded(route.captureId, streamId, frameCount);
+    }
+
+    uint64_t resultTimestamp = GetCurrentLocalTimeStamp();
+    PostResultMetadata(resultTimestamp);
 
-    auto anIter = enableShutterCbkMap_.find(streamId);
-    if (anIter->second) {
+    if (route.enableShutterCbk) {
         if (dcStreamOperatorCallback_ == nullptr) {
             DHLOGE("DStreamOperator::ShutterBuffer failed, need shutter frame, but stream operator callback is null.");
             return DCamRetCode::FAILED;
         }
-        std::vector<int32_t> streamIds;
-        streamIds.push_back(anIter->first);
-        dcStreamOperatorCallback_->OnFrameShutter(captureId, streamIds, resultTimestamp);
+        callbackDispatcher_.OnFrameShutter(route.captureId, streamId, resultTimestamp);
     }
     return DCamRetCode::SUCCESS;
 }
 
+void DStreamOperator::RebuildRouteTable()
+{
+    std::shared_ptr<const DStreamRouteTable> oldTable = std::atomic_load(&routeTable_);
+    std::shared_ptr<DStreamRouteTable> newTable = std::make_shared<DStreamRouteTable>();
+    for (auto &capture : halCaptureInfoMap_) {
+        for (int streamId : capture.second->streamIds_) {
+            auto stream = halStreamMap_.find(streamId);
+            if (stream == halStreamMap_.end()) {
+                continue;
+            }
+            DStreamRoute route;
+            route.captureId = capture.first;
+            route.stream = stream->second;
+            route.enableShutterCbk = capture.second->enableShutterCallback_;
+            auto dcStreamInfo = dcStreamInfoMap_.find(streamId);
+            route.isSnapshot = (dcStreamInfo != dcStreamInfoMap_.end()) &&
+                (dcStreamInfo->second->type_ == DCStreamType::SNAPSHOT_FRAME);
+            auto captureDepth = captureDepthMap_.find(capture.first);
+            route.captureDepth = (captureDepth != captureDepthMap_.end()) ? captureDepth->second : 0;
+            auto oldRoute = oldTable->find(streamId);
+            if (oldRoute != oldTable->end() && oldRoute->second.captureId == capture.first) {
+                route.frameCount = oldRoute->second.frameCount;
+            } else {
+                route.frameCount = std::make_shared<std::atomic<uint32_t>>(0);
+            }
+            (*newTable)[streamId] = route;
+        }
+    }
+    std::atomic_store(&routeTable_, std::shared_ptr<const DStreamRouteTable>(newTable));
+}
+
+void DStreamOperator::PostResultMetadata(uint64_t resultTimestamp)
+{
+    std::lock_guard<std::mutex> autoLock(resultLock_);
+    if (isResultStopped_) {
+        return;
+    }
+    if (!isResultRunning_) {
+        isResultRunning_ = true;
+        resultThread_ = std::thread(&DStreamOperator::ResultLoop, this);
+    }
+    if (resultQueue_.size() >= BUFFER_QUEUE_SIZE) {
+        resultQueue_.pop();
+    }
+    resultQueue_.push(resultTimestamp);
+    resultCond_.notify_one();
+}
+
+void DStreamOperator::ResultLoop()
+{
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamResult", DCAMERA_TASK_TIER_CONTROL);
+    while (true) {
+        uint64_t resultTimestamp = 0;
+        {
+            std::unique_lock<std::mutex> lock(resultLock_);
+            resultCond_.wait(lock, [this] { return !isResultRunning_ || !resultQueue_.empty(); });
+            if (!isResultRunning_) {
+                break;
+            }
+            resultTimestamp = resultQueue_.front();
+            resultQueue_.pop();
+        }
+
+        bool needReturn = false;
+        std::shared_ptr<CameraStandard::CameraMetadata> result = nullptr;
+        DCamRetCode ret = dMetadataProcessor_->UpdateResultMetadata(needReturn, result);
+        if (ret != DCamRetCode::SUCCESS) {
+            DHLOGE("Cannot handle result metadata.");
+            continue;
+        }
+        if (needReturn && resultCallback_) {
+            resultCallback_(resultTimestamp, result);
+        }
+    }
+}
+
+void DStreamOperator::StopResultThread()
+{
+    {
+        std::lock_guard<std::mutex> autoLock(resultLock_);
+        if (!isResultRunning_) {
+            return;
+        }
+        isResultStopped_ = true;
+        isResultRunning_ = false;
+        std::queue<uint64_t>().swap(resultQueue_);
+    }
+    resultCond_.notify_one();
+    if (resultThread_.joinable()) {
+        resultThread_.join();
+    }
+    {
+        // a shutter racing the join must not start a thread over the one being joined
+        std::lock_guard<std::mutex> autoLock(resultLock_);
+        isResultStopped_ = false;
+    }
+}
+
 DCamRetCode DStreamOperator::SetCallBack(OHOS::sptr<IStreamOperatorCallback> const &callback)
 {
     dcStreamOperatorCallback_ = callback;
+    callbackDispatcher_.SetCallback(callback);
     return SUCCESS;
 }
 
@@ -536,24 +713,19 @@ DCamRetCode DStreamOperator::SetDeviceCallback(
     return SUCCESS;
 }
 
-void DStreamOperator::SnapShotStreamOnCaptureEnded(int32_t captureId, int streamId)
+bool DStreamOperator::IsCaptureEnded(const DStreamRoute &route)
+{
+    return route.isSnapshot && route.captureDepth != 0 && route.frameCount->load() >= route.captureDepth;
+}
+
+void DStreamOperator::SnapShotStreamOnCaptureEnded(int32_t captureId, int streamId, uint32_t frameCount)
 {
-    auto dcStreamInfo = dcStreamInfoMap_.find(streamId);
-    if (dcStreamInfo == dcStreamInfoMap_.end()) {
-        return;
-    }
-    if (dcStreamInfo->second->type_ != DCStreamType::SNAPSHOT_FRAME) {
-        return;
-    }
-    if (dcStreamOperatorCallback_ == nullptr) {
-        return;
-    }
     std::vector<std::shared_ptr<CaptureEndedInfo>> info;
     std::shared_ptr<CaptureEndedInfo> tmp = std::make_shared<CaptureEndedInfo>();
-    tmp->frameCount_ = acceptedBufferNum_[std::make_pair(captureId, streamId)];
+    tmp->frameCount_ = static_cast<int>(frameCount);
     tmp->streamId_ = streamId;
     info.push_back(tmp);
-    dcStreamOperatorCallback_->OnCaptureEnded(captureId, info);
+    callbackDispatcher_.OnCaptureEnded(captureId, info);
     DHLOGD("snapshot stream successfully reported captureId = %d streamId = %d.", captureId, streamId);
 }
 
@@ -571,15 +743,22 @@ void DStreamOperator::Release()
         latestStreamSetting_ = nullptr;
     }
     SetCapturing(false);
+    StopResultThread();
+    callbackDispatcher_.Stop();
     halStreamMap_.clear();
     dcStreamInfoMap_.clear();
     halCaptureInfoMap_.clear();
-    enableShutterCbkMap_.clear();
-    acceptedBufferNum_.clear();
+    captureDepthMap_.clear();
+    RebuildRouteTable();
     cachedDCaptureInfoList_.clear();
     dcStreamOperatorCallback_ = nullptr;
 }
 
+DStreamCallbackMetrics DStreamOperator::GetCallbackMetrics()
+{
+    return callbackDispatcher_.GetMetrics();
+}
+
 bool DStreamOperator::IsCapturing()
 {
     std::unique_lock<mutex> lock(isCapturingLock_);
@@ -613,7 +792,7 @@ void DStreamOperator::ConvertStreamInfo(std::shared_ptr<StreamInfo> &srcInfo, st
 }
 
 DCamRetCode DStreamOperator::NegotiateSuitableCaptureInfo(const std::shared_ptr<CaptureInfo>& srcCaptureInfo,
-    bool isStreaming)
+    bool isStreaming, uint32_t &captureDepth)
 {
     std::vector<std::shared_ptr<DCStreamInfo>> srcStreamInfo;
     for (auto &id : srcCaptureInfo->streamIds_) {
@@ -627,30 +806,44 @@ DCamRetCode DStreamOperator::NegotiateSuitableCaptureInfo(const std::shared_ptr<
         return INVALID_ARGUMENT;
     }
 
+    // a streamed snapshot request becomes a burst only when its settings ask for one
+    uint32_t burstDepth = 0;
+    bool isBurst = isStreaming && ((srcStreamInfo.at(0))->type_ == DCStreamType::SNAPSHOT_FRAME) &&
+        GetRequestedBurstDepth(srcCaptureInfo, burstDepth);
+    bool isContinuous = isStreaming && !isBurst;
     std::shared_ptr<DCCaptureInfo> inputCaptureInfo = BuildSuitableCaptureInfo(srcCaptureInfo, srcStreamInfo);
-    inputCaptureInfo->type_ = isStreaming ? DCStreamType::CONTINUOUS_FRAME : DCStreamType::SNAPSHOT_FRAME;
+    inputCaptureInfo->type_ = isContinuous ? DCStreamType::CONTINUOUS_FRAME : DCStreamType::SNAPSHOT_FRAME;
     inputCaptureInfo->isCapture_ = true;
+    captureDepth = isStreaming ? 0 : 1;
+    if (isBurst) {
+        captureDepth = GetBurstDepth(inputCaptureInfo->width_, inputCaptureInfo->height_, burstDepth);
+        std::shared_ptr<DCameraSettings> burstSetting = std::make_shared<DCameraSettings>();
+        burstSetting->type_ = DCSettingsType::SNAPSHOT_BURST;
+        burstSetting->value_ = std::to_string(captureDepth);
+        inputCaptureInfo->captureSettings_.push_back(burstSetting);
+        DHLOGI("Choose snapshot burst depth %s.", burstSetting->value_.c_str());
+    }
 
     std::shared_ptr<DCCaptureInfo> appendCaptureInfo = nullptr;
     if (cachedDCaptureInfoList_.empty()) {
         std::vector<std::shared_ptr<DCStreamInfo>> appendStreamInfo;
         auto iter = dcStreamInfoMap_.begin();
         while (iter != dcStreamInfoMap_.end()) {
-            if ((isStreaming && (iter->second->type_ == DCStreamType::SNAPSHOT_FRAME)) ||
-                (!isStreaming && (iter->second->type_ == DCStreamType::CONTINUOUS_FRAME))) {
+            if ((isContinuous && (iter->second->type_ == DCStreamType::SNAPSHOT_FRAME)) ||
+                (!isContinuous && (iter->second->type_ == DCStreamType::CONTINUOUS_FRAME))) {
                 appendStreamInfo.push_back(iter->second);
             }
             iter++;
         }
         if (!appendStreamInfo.empty()) {
             appendCaptureInfo = BuildSuitableCaptureInfo(srcCaptureInfo, appendStreamInfo);
-            appendCaptureInfo->type_ = isStreaming ? DCStreamType::SNAPSHOT_FRAME : DCStreamType::CONTINUOUS_FRAME;
+            appendCaptureInfo->type_ = isContinuous ? DCStreamType::SNAPSHOT_FRAME : DCStreamType::CONTINUOUS_FRAME;
             appendCaptureInfo->isCapture_ = false;
         }
     } else {
         for (auto cacheCapture : cachedDCaptureInfoList_) {
-            if ((isStreaming && (cacheCapture->type_ == DCStreamType::SNAPSHOT_FRAME)) ||
-                (!isStreaming && (cacheCapture->type_ == DCStreamType::CONTINUOUS_FRAME))) {
+            if ((isContinuous && (cacheCapture->type_ == DCStreamType::SNAPSHOT_FRAME)) ||
+                (!isContinuous && (cacheCapture->type_ == DCStreamType::CONTINUOUS_FRAME))) {
                 cacheCapture->isCapture_ = false;
                 appendCaptureInfo = cacheCapture;
                 break;
@@ -674,6 +867,8 @@ std::shared_ptr<DCCaptureInfo> DStreamOperator::BuildSuitableCaptureInfo(const s
     ChooseSuitableResolution(srcStreamInfo, captureInfo);
     ChooseSuitableDataSpace(srcStreamInfo, captureInfo);
     ChooseSuitableEncodeType(srcStreamInfo, captureInfo);
+    ChooseSuitableFps(srcCaptureInfo, srcStreamInfo, captureInfo);
+    ChooseSuitableThumbnail(srcStreamInfo, captureInfo);
 
     std::shared_ptr<DCameraSettings> dcSetting = std::make_shared<DCameraSettings>();
     dcSetting->type_ = DCSettingsType::UPDATE_METADATA;
@@ -729,7 +924,10 @@ void DStreamOperator::ChooseSuitableResolution(std::vector<std::shared_ptr<DCStr
         captureInfo->streamIds_.push_back(stream->streamId_);
     };
 
-    if ((tempResolution.width_ == 0) || (tempResolution.height_ == 0)) {
+    if (((tempResolution.width_ == 0) || (tempResolution.height_ == 0)) && !supportedResolutionList.empty()) {
+        captureInfo->width_ = supportedResolutionList.back().width_;
+        captureInfo->height_ = supportedResolutionList.back().height_;
+    } else if ((tempResolution.width_ == 0) || (tempResolution.height_ == 0)) {
         captureInfo->width_ = MAX_SUPPORT_PREVIEW_WIDTH;
         captureInfo->height_ = MAX_SUPPORT_PREVIEW_HEIGHT;
     } else {
@@ -744,6 +942,54 @@ void DStreamOperator::ChooseSuitableDataSpace(std::vector<std::shared_ptr<DCStre
     captureInfo->dataspace_ = (streamInfo.at(0))->dataspace_;
 }
 
+void DStreamOperator::ChooseSuitableFps(const shared_ptr<CaptureInfo>& srcCaptureInfo,
+    std::vector<std::shared_ptr<DCStreamInfo>> &streamInfo, std::shared_ptr<DCCaptureInfo> &captureInfo)
+{
+    if ((streamInfo.at(0))->type_ != DCStreamType::CONTINUOUS_FRAME) {
+        return;
+    }
+
+    uint32_t maxFps = GetMaxFrameRate(captureInfo->width_, captureInfo->height_, dcSupportedMaxFps_);
+    uint32_t minFps = std::min(MIN_SUPPORT_DEFAULT_FPS, maxFps);
+    camera_metadata_item_t item;
+    if ((srcCaptureInfo->captureSetting_ != nullptr) &&
+        (CameraStandard::FindCameraMetadataItem(srcCaptureInfo->captureSetting_->get(),
+        OHOS_CONTROL_AE_TARGET_FPS_RANGE, &item) == CAM_META_SUCCESS) && (item.count == FPS_RANGE_SIZE)) {
+        uint32_t requestMinFps = static_cast<uint32_t>(item.data.i32[0]);
+        uint32_t requestMaxFps = static_cast<uint32_t>(item.data.i32[1]);
+        if ((requestMaxFps > 0) && (requestMaxFps < maxFps)) {
+            maxFps = requestMaxFps;
+        }
+        if ((requestMinFps > 0) && (requestMinFps <= maxFps)) {
+            minFps = requestMinFps;
+        }
+    }
+    minFps = std::min(minFps, maxFps);
+
+    std::shared_ptr<DCameraSettings> fpsSetting = std::make_shared<DCameraSettings>();
+    fpsSetting->type_ = DCSettingsType::FPS_RANGE;
+    fpsSetting->value_ = FpsRangeToString(minFps, maxFps);
+    captureInfo->captureSettings_.push_back(fpsSetting);
+    DHLOGI("Choose fps range [%d, %d] for resolution %d*%d.", minFps, maxFps, captureInfo->width_,
+        captureInfo->height_);
+}
+
+bool DStreamOperator::GetRequestedBurstDepth(const shared_ptr<CaptureInfo>& srcCaptureInfo, uint32_t &depth)
+{
+    camera_metadata_item_t item;
+    if ((srcCaptureInfo->captureSetting_ == nullptr) ||
+        (CameraStandard::FindCameraMetadataItem(srcCaptureInfo->captureSetting_->get(),
+        DCAMERA_SNAPSHOT_BURST_DEPTH, &item) != CAM_META_SUCCESS) || (item.count != 1)) {
+        return false;
+    }
+    if (item.data.i32[0] <= 0) {
+        DHLOGE("Invalid snapshot burst depth %d.", item.data.i32[0]);
+        return false;
+    }
+    depth = static_cast<uint32_t>(item.data.i32[0]);
+    return true;
+}
+
 void DStreamOperator::ChooseSuitableEncodeType(std::vector<std::shared_ptr<DCStreamInfo>> &streamInfo,
     std::shared_ptr<DCCaptureInfo> &captureInfo)
 {
@@ -760,6 +1006,29 @@ void DStreamOperator::ChooseSuitableEncodeType(std::vector<std::shared_ptr<DCStr
     }
 }
 
+void DStreamOperator::ChooseSuitableThumbnail(std::vector<std::shared_ptr<DCStreamInfo>> &streamInfo,
+    std::shared_ptr<DCCaptureInfo> &captureInfo)
+{
+    if ((streamInfo.at(0))->type_ != DCStreamType::SNAPSHOT_FRAME) {
+        return;
+    }
+
+    // a small snapshot stream next to the full one opts in to an early preview-quality picture
+    for (auto stream : streamInfo) {
+        if (IsThumbnailSize(stream->width_, stream->height_) &&
+            (stream->width_ * stream->height_ < captureInfo->width_ * captureInfo->height_)) {
+            std::shared_ptr<DCameraSettings> thumbnailSetting = std::make_shared<DCameraSettings>();
+            thumbnailSetting->type_ = DCSettingsType::SNAPSHOT_THUMBNAIL;
+            thumbnailSetting->value_ = std::to_string(stream->width_) + STAR_SEPARATOR +
+                std::to_string(stream->height_);
+            captureInfo->captureSettings_.push_back(thumbnailSetting);
+            DHLOGI("Choose snapshot thumbnail for stream %d, resolution %d*%d.", stream->streamId_, stream->width_,
+                stream->height_);
+            return;
+        }
+    }
+}
+
 DCEncodeType DStreamOperator::ConvertDCEncodeType(std::string &srcEncodeType)
 {
     if (srcEncodeType == ENCODE_TYPE_STR_H264) {
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "dbuffer_manager.h"
+
+using namespace std;
+using namespace OHOS::DistributedHardware;
+
+namespace {
+const uint32_t BENCH_ITERATIONS = 200000;
+const uint32_t BENCH_BUFFER_COUNTS[] = { 8, 16, 32 };
+const uint32_t BENCH_STREAM_COUNTS[] = { 1, 4 };
+const uint32_t BENCH_SHARED_THREAD_COUNTS[] = { 2, 4 };
+
+/*
+ * Reference of the previous bookkeeping: idle and busy lists behind one
+ * mutex, a linear search on remove and a linear scan of the buffer map to
+ * find a returned buffer by its index.
+ */
+class ListBufferManager {
+public:
+    void AddBuffer(const shared_ptr<DImageBuffer> &buffer)
+    {
+        unique_lock<mutex> l(lock_);
+        idleList_.emplace_back(buffer);
+        configMap_[buffer] = buffer->GetIndex();
+    }
+
+    shared_ptr<DImageBuffer> AcquireBuffer()
+    {
+        unique_lock<mutex> l(lock_);
+        if (idleList_.empty()) {
+            return nullptr;
+        }
+        auto it = idleList_.begin();
+        busyList_.splice(busyList_.begin(), idleList_, it);
+        return *it;
+    }
+
+    shared_ptr<DImageBuffer> ReturnBuffer(int32_t index)
+    {
+        unique_lock<mutex> l(lock_);
+        shared_ptr<DImageBuffer> buffer = nullptr;
+        for (auto &config : configMap_) {
+            if (config.first->GetIndex() == index) {
+                buffer = config.first;
+                break;
+            }
+        }
+        auto it = find(busyList_.begin(), busyList_.end(), buffer);
+        if (it != busyList_.end()) {
+            busyList_.erase(it);
+        }
+        return buffer;
+    }
+
+private:
+    mutex lock_;
+    list<shared_ptr<DImageBuffer>> idleList_;
+    list<shared_ptr<DImageBuffer>> busyList_;
+    map<shared_ptr<DImageBuffer>, int32_t> configMap_;
+};
+
+void RunListStream(uint32_t bufferCount)
+{
+    ListBufferManager manager;
+    for (uint32_t i = 0; i < bufferCount; i++) {
+        shared_ptr<DImageBuffer> buffer = make_shared<DImageBuffer>();
+        buffer->SetIndex(static_cast<int32_t>(i));
+        manager.AddBuffer(buffer);
+    }
+    // Keep all but one buffer in flight, as a stream with a full queue does.
+    vector<int32_t> inFlight;
+    for (uint32_t i = 0; i + 1 < bufferCount; i++) {
+        inFlight.push_back(manager.AcquireBuffer()->GetIndex());
+    }
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        shared_ptr<DImageBuffer> buffer = manager.AcquireBuffer();
+        inFlight.push_back(buffer->GetIndex());
+        shared_ptr<DImageBuffer> returned = manager.ReturnBuffer(inFlight.front());
+        inFlight.erase(inFlight.begin());
+        manager.AddBuffer(returned);
+    }
+}
+
+void RunSlotStream(uint32_t bufferCount)
+{
+    DBufferManager manager(bufferCount);
+    for (uint32_t i = 0; i < bufferCount; i++) {
+        shared_ptr<DImageBuffer> buffer = make_shared<DImageBuffer>();
+        buffer->SetIndex(manager.ReserveSlot());
+        manager.AddBuffer(buffer);
+    }
+    vector<int32_t> inFlight;
+    for (uint32_t i = 0; i + 1 < bufferCount; i++) {
+        inFlight.push_back(manager.AcquireBuffer()->GetIndex());
+    }
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        shared_ptr<DImageBuffer> buffer = manager.AcquireBuffer();
+        inFlight.push_back(buffer->GetIndex());
+        shared_ptr<DImageBuffer> returned = manager.RemoveBuffer(inFlight.front());
+        manager.ReleaseSlot(inFlight.front());
+        inFlight.erase(inFlight.begin());
+        returned->SetIndex(manager.ReserveSlot());
+        manager.AddBuffer(returned);
+    }
+}
+
+/*
+ * One stream whose buffers are acquired and returned from several threads at once, as the source request
+ * thread and the return path do, so every operation contends on the same manager.
+ */
+void RunListShared(ListBufferManager &manager)
+{
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        shared_ptr<DImageBuffer> buffer = nullptr;
+        while ((buffer = manager.AcquireBuffer()) == nullptr) {
+            this_thread::yield();
+        }
+        manager.AddBuffer(manager.ReturnBuffer(buffer->GetIndex()));
+    }
+}
+
+void RunSlotShared(DBufferManager &manager)
+{
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        shared_ptr<DImageBuffer> buffer = nullptr;
+        while ((buffer = manager.AcquireBuffer()) == nullptr) {
+            this_thread::yield();
+        }
+        int32_t index = buffer->GetIndex();
+        shared_ptr<DImageBuffer> returned = manager.RemoveBuffer(index);
+        manager.ReleaseSlot(index);
+        returned->SetIndex(manager.ReserveSlot());
+        manager.AddBuffer(returned);
+    }
+}
+
+template<typename Manager>
+double RunSharedBench(void (*runShared)(Manager &), Manager &manager, uint32_t threadCount)
+{
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (uint32_t i = 0; i < threadCount; i++) {
+        threads.emplace_back(runShared, ref(manager));
+    }
+    for (auto &runner : threads) {
+        runner.join();
+    }
+    auto cost = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    return static_cast<double>(cost) / (static_cast<double>(BENCH_ITERATIONS) * threadCount);
+}
+
+double RunBench(void (*runStream)(uint32_t), uint32_t streamCount, uint32_t bufferCount)
+{
+    auto start = chrono::steady_clock::now();
+    vector<thread> streams;
+    for (uint32_t i = 0; i < streamCount; i++) {
+        streams.emplace_back(runStream, bufferCount);
+    }
+    for (auto &stream : streams) {
+        stream.join();
+    }
+    auto cost = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    return static_cast<double>(cost) / (static_cast<double>(BENCH_ITERATIONS) * streamCount);
+}
+}
+
+int main()
+{
+    cout << "distributed camera buffer manager benchmark, " << BENCH_ITERATIONS << " frames per stream" << endl;
+    for (uint32_t streamCount : BENCH_STREAM_COUNTS) {
+        for (uint32_t bufferCount : BENCH_BUFFER_COUNTS) {
+            double listCost = RunBench(RunListStream, streamCount, bufferCount);
+            double slotCost = RunBench(RunSlotStream, streamCount, bufferCount);
+            cout << "streams: " << streamCount << " buffers: " << bufferCount << " list: " << listCost <<
+                " ns/frame slot table: " << slotCost << " ns/frame" << endl;
+        }
+    }
+    for (uint32_t threadCount : BENCH_SHARED_THREAD_COUNTS) {
+        for (uint32_t bufferCount : BENCH_BUFFER_COUNTS) {
+            ListBufferManager listManager;
+            DBufferManager slotManager(bufferCount);
+            for (uint32_t i = 0; i < bufferCount; i++) {
+                shared_ptr<DImageBuffer> listBuffer = make_shared<DImageBuffer>();
+                listBuffer->SetIndex(static_cast<int32_t>(i));
+                listManager.AddBuffer(listBuffer);
+                shared_ptr<DImageBuffer> slotBuffer = make_shared<DImageBuffer>();
+                slotBuffer->SetIndex(slotManager.ReserveSlot());
+                slotManager.AddBuffer(slotBuffer);
+            }
+            double listCost = RunSharedBench(RunListShared, listManager, threadCount);
+            double slotCost = RunSharedBench(RunSlotShared, slotManager, threadCount);
+            cout << "shared threads: " << threadCount << " buffers: " << bufferCount << " list: " << listCost <<
+                " ns/frame slot table: " << slotCost << " ns/frame" << endl;
+        }
+    }
+    return 0;
+}
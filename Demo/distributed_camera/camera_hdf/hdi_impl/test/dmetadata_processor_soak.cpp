@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "dcamera_utils_tools.h"
+#include "dmetadata_processor.h"
+#include "metadata_utils.h"
+
+using namespace std;
+using namespace OHOS::DistributedHardware;
+
+namespace {
+const uint32_t SOAK_FRAMES = 1000000;
+const uint32_t SOAK_WARMUP_FRAMES = 10000;
+const uint32_t SOAK_SNAPSHOT_INTERVAL = 30;
+const uint32_t SOAK_AE_MODE_INTERVAL = 100;
+const uint32_t SOAK_ENTRY_CAPACITY = 4;
+const uint32_t SOAK_DATA_CAPACITY = 64;
+const long SOAK_MAX_RSS_GROWTH_KB = 1024;
+const std::string SOAK_ABILITY = R"({"CodecType":["avenc_mpeg4"],
+    "OutputFormat":{"Photo":[4],"Preview":[2,3],"Video":[2,3]},
+    "Position":"BACK",
+    "ProtocolVer":"1.0",
+    "MetaData":"",
+    "Resolution":{"2":["1920*1080","1280*720"],"3":["1920*1080","1280*720"],"4":["3840*2160","1920*1080"]}})";
+
+long GetResidentSetSizeKb()
+{
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return stol(line.substr(6));
+        }
+    }
+    return -1;
+}
+
+std::string BuildResultMetadata(uint32_t frame, bool isSnapshot)
+{
+    std::shared_ptr<OHOS::CameraStandard::CameraMetadata> metadata =
+        std::make_shared<OHOS::CameraStandard::CameraMetadata>(SOAK_ENTRY_CAPACITY, SOAK_DATA_CAPACITY);
+    int64_t exposureTime = static_cast<int64_t>(frame);
+    metadata->addEntry(OHOS_SENSOR_EXPOSURE_TIME, &exposureTime, 1);
+    if (isSnapshot || frame % SOAK_AE_MODE_INTERVAL == 0) {
+        uint8_t aeMode = (frame / SOAK_AE_MODE_INTERVAL) % 2 == 0 ? OHOS_CAMERA_AE_MODE_OFF : OHOS_CAMERA_AE_MODE_ON;
+        metadata->addEntry(OHOS_CONTROL_AE_MODE, &aeMode, 1);
+    }
+    std::string encoded = OHOS::CameraStandard::MetadataUtils::EncodeToString(metadata);
+    return PackResultMetadata(frame, isSnapshot,
+        Base64Encode(reinterpret_cast<const unsigned char *>(encoded.c_str()), encoded.length()));
+}
+}
+
+int main()
+{
+    cout << "distributed camera result metadata soak, " << SOAK_FRAMES << " frames" << endl;
+    DMetadataProcessor processor;
+    if (processor.InitDCameraAbility(SOAK_ABILITY) != SUCCESS) {
+        cout << "init ability failed" << endl;
+        return 1;
+    }
+    processor.ResetEnableResults();
+    processor.SetMetadataResultMode(ResultCallbackMode::ON_CHANGED);
+
+    long warmupRss = 0;
+    uint32_t resultCount = 0;
+    for (uint32_t frame = 0; frame < SOAK_FRAMES; frame++) {
+        if (frame == SOAK_WARMUP_FRAMES) {
+            warmupRss = GetResidentSetSizeKb();
+        }
+        bool isSnapshot = (frame % SOAK_SNAPSHOT_INTERVAL == 0);
+        if (processor.SaveResultMetadata(BuildResultMetadata(frame, isSnapshot)) != SUCCESS) {
+            cout << "save result metadata failed at frame " << frame << endl;
+            return 1;
+        }
+        bool needReturn = false;
+        std::shared_ptr<OHOS::CameraStandard::CameraMetadata> result = nullptr;
+        processor.UpdateResultMetadata(needReturn, result);
+        resultCount += needReturn ? 1 : 0;
+    }
+
+    long endRss = GetResidentSetSizeKb();
+    cout << "results: " << resultCount << " rss after warmup: " << warmupRss << " KB rss at end: " << endRss <<
+        " KB" << endl;
+    if (endRss - warmupRss > SOAK_MAX_RSS_GROWTH_KB) {
+        cout << "result metadata memory is not bounded" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "distributed_camera_constants.h"
+#include "ipc_data_utils.h"
+
+using namespace std;
+using namespace OHOS;
+using namespace OHOS::DistributedHardware;
+
+namespace {
+const uint32_t BENCH_ITERATIONS = 20000;
+const uint32_t BENCH_STREAM_COUNT = 4;
+const uint32_t BENCH_SETTINGS_COUNT = 2;
+const uint32_t BENCH_VALUE_SIZES[] = { 256, 4096, 65536 };
+
+/*
+ * Reference of the previous field by field encoding, used both to check that the
+ * decoders still accept it and as the baseline of the round-trip benchmark.
+ */
+bool LegacyEncodeSettingsList(const vector<shared_ptr<DCameraSettings>> &settings, MessageParcel &parcel)
+{
+    bool bRet = parcel.WriteInt32(static_cast<int32_t>(settings.size()));
+    for (auto &setting : settings) {
+        bRet = (bRet && parcel.WriteInt32(setting->type_));
+        bRet = (bRet && parcel.WriteString(setting->value_));
+    }
+    return bRet;
+}
+
+bool LegacyEncodeStreamInfos(const vector<shared_ptr<DCStreamInfo>> &streamInfos, MessageParcel &parcel)
+{
+    bool bRet = parcel.WriteInt32(static_cast<int32_t>(streamInfos.size()));
+    for (auto &streamInfo : streamInfos) {
+        bRet = (bRet && parcel.WriteBuffer((void *)streamInfo.get(), sizeof(DCStreamInfo)));
+    }
+    return bRet;
+}
+
+bool LegacyEncodeCaptureInfos(const vector<shared_ptr<DCCaptureInfo>> &captureInfos, MessageParcel &parcel)
+{
+    bool bRet = parcel.WriteInt32(static_cast<int32_t>(captureInfos.size()));
+    for (auto &captureInfo : captureInfos) {
+        bRet = (bRet && parcel.WriteInt32Vector(captureInfo->streamIds_));
+        bRet = (bRet && parcel.WriteInt32(captureInfo->width_));
+        bRet = (bRet && parcel.WriteInt32(captureInfo->height_));
+        bRet = (bRet && parcel.WriteInt32(captureInfo->stride_));
+        bRet = (bRet && parcel.WriteInt32(captureInfo->format_));
+        bRet = (bRet && parcel.WriteInt32(captureInfo->dataspace_));
+        bRet = (bRet && parcel.WriteBool(captureInfo->isCapture_));
+        bRet = (bRet && parcel.WriteInt32(captureInfo->encodeType_));
+        bRet = (bRet && parcel.WriteInt32(captureInfo->type_));
+        bRet = (bRet && LegacyEncodeSettingsList(captureInfo->captureSettings_, parcel));
+    }
+    return bRet;
+}
+
+bool LegacyEncodeEvent(const shared_ptr<DCameraHDFEvent> &event, MessageParcel &parcel)
+{
+    return parcel.WriteInt32(event->type_) && parcel.WriteInt32(event->result_) && parcel.WriteString(event->content_);
+}
+
+vector<shared_ptr<DCameraSettings>> BuildSettings(uint32_t valueSize)
+{
+    vector<shared_ptr<DCameraSettings>> settings;
+    for (uint32_t i = 0; i < BENCH_SETTINGS_COUNT; i++) {
+        shared_ptr<DCameraSettings> setting = make_shared<DCameraSettings>();
+        setting->type_ = (i == 0) ? DCSettingsType::UPDATE_METADATA : DCSettingsType::ENABLE_METADATA;
+        setting->value_ = string(valueSize, static_cast<char>('a' + i));
+        settings.push_back(setting);
+    }
+    return settings;
+}
+
+vector<shared_ptr<DCStreamInfo>> BuildStreamInfos()
+{
+    vector<shared_ptr<DCStreamInfo>> streamInfos;
+    for (uint32_t i = 0; i < BENCH_STREAM_COUNT; i++) {
+        shared_ptr<DCStreamInfo> streamInfo = make_shared<DCStreamInfo>();
+        streamInfo->streamId_ = static_cast<int>(i);
+        streamInfo->width_ = 1920;
+        streamInfo->height_ = 1080;
+        streamInfo->stride_ = 1920;
+        streamInfo->format_ = static_cast<int>(i + 1);
+        streamInfo->dataspace_ = static_cast<int>(i);
+        streamInfo->encodeType_ = DCEncodeType::ENCODE_TYPE_H264;
+        streamInfo->type_ = (i == 0) ? DCStreamType::SNAPSHOT_FRAME : DCStreamType::CONTINUOUS_FRAME;
+        streamInfos.push_back(streamInfo);
+    }
+    return streamInfos;
+}
+
+vector<shared_ptr<DCCaptureInfo>> BuildCaptureInfos(uint32_t valueSize)
+{
+    vector<shared_ptr<DCCaptureInfo>> captureInfos;
+    for (auto &streamInfo : BuildStreamInfos()) {
+        shared_ptr<DCCaptureInfo> captureInfo = make_shared<DCCaptureInfo>();
+        captureInfo->streamIds_.push_back(streamInfo->streamId_);
+        captureInfo->width_ = streamInfo->width_;
+        captureInfo->height_ = streamInfo->height_;
+        captureInfo->stride_ = streamInfo->stride_;
+        captureInfo->format_ = streamInfo->format_;
+        captureInfo->dataspace_ = streamInfo->dataspace_;
+        captureInfo->isCapture_ = true;
+        captureInfo->encodeType_ = streamInfo->encodeType_;
+        captureInfo->type_ = streamInfo->type_;
+        captureInfo->captureSettings_ = BuildSettings(valueSize);
+        captureInfos.push_back(captureInfo);
+    }
+    return captureInfos;
+}
+
+bool IsSameSettings(const vector<shared_ptr<DCameraSettings>> &lhs, const vector<shared_ptr<DCameraSettings>> &rhs)
+{
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); i++) {
+        if (lhs[i]->type_ != rhs[i]->type_ || lhs[i]->value_ != rhs[i]->value_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IsSameStreamInfos(const vector<shared_ptr<DCStreamInfo>> &lhs, const vector<shared_ptr<DCStreamInfo>> &rhs)
+{
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); i++) {
+        if (lhs[i]->streamId_ != rhs[i]->streamId_ || lhs[i]->width_ != rhs[i]->width_ ||
+            lhs[i]->height_ != rhs[i]->height_ || lhs[i]->stride_ != rhs[i]->stride_ ||
+            lhs[i]->format_ != rhs[i]->format_ || lhs[i]->dataspace_ != rhs[i]->dataspace_ ||
+            lhs[i]->encodeType_ != rhs[i]->encodeType_ || lhs[i]->type_ != rhs[i]->type_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IsSameCaptureInfos(const vector<shared_ptr<DCCaptureInfo>> &lhs, const vector<shared_ptr<DCCaptureInfo>> &rhs)
+{
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); i++) {
+        if (lhs[i]->streamIds_ != rhs[i]->streamIds_ || lhs[i]->width_ != rhs[i]->width_ ||
+            lhs[i]->height_ != rhs[i]->height_ || lhs[i]->isCapture_ != rhs[i]->isCapture_ ||
+            lhs[i]->encodeType_ != rhs[i]->encodeType_ || lhs[i]->type_ != rhs[i]->type_ ||
+            !IsSameSettings(lhs[i]->captureSettings_, rhs[i]->captureSettings_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CheckCompatibility(uint32_t valueSize)
+{
+    vector<shared_ptr<DCameraSettings>> settings = BuildSettings(valueSize);
+    vector<shared_ptr<DCStreamInfo>> streamInfos = BuildStreamInfos();
+    vector<shared_ptr<DCCaptureInfo>> captureInfos = BuildCaptureInfos(valueSize);
+    shared_ptr<DCameraHDFEvent> event = make_shared<DCameraHDFEvent>();
+    event->type_ = DCameraEventType::DCAMERA_MESSAGE;
+    event->result_ = DCameraEventResult::DCAMERA_EVENT_CHANNEL_CONNECTED;
+    event->content_ = string(valueSize, 'e');
+
+    for (bool isLegacy : { true, false }) {
+        MessageParcel parcel;
+        bool bRet = isLegacy ?
+            (LegacyEncodeSettingsList(settings, parcel) && LegacyEncodeStreamInfos(streamInfos, parcel) &&
+            LegacyEncodeCaptureInfos(captureInfos, parcel) && LegacyEncodeEvent(event, parcel)) :
+            (IpcDataUtils::EncodeDCameraSettingsList(settings, parcel) &&
+            IpcDataUtils::EncodeDCStreamInfos(streamInfos, parcel) &&
+            IpcDataUtils::EncodeDCCaptureInfos(captureInfos, parcel) &&
+            IpcDataUtils::EncodeDCameraHDFEvent(event, parcel));
+        if (!bRet) {
+            cout << "encode failed, legacy: " << isLegacy << " value size: " << valueSize << endl;
+            return false;
+        }
+
+        vector<shared_ptr<DCameraSettings>> decodedSettings;
+        vector<shared_ptr<DCStreamInfo>> decodedStreamInfos;
+        vector<shared_ptr<DCCaptureInfo>> decodedCaptureInfos;
+        shared_ptr<DCameraHDFEvent> decodedEvent = make_shared<DCameraHDFEvent>();
+        bRet = IpcDataUtils::DecodeDCameraSettingsList(parcel, decodedSettings) &&
+            IpcDataUtils::DecodeDCStreamInfos(parcel, decodedStreamInfos) &&
+            IpcDataUtils::DecodeDCCaptureInfos(parcel, decodedCaptureInfos) &&
+            IpcDataUtils::DecodeDCameraHDFEvent(parcel, decodedEvent);
+        if (!bRet || !IsSameSettings(settings, decodedSettings) || !IsSameStreamInfos(streamInfos, decodedStreamInfos) ||
+            !IsSameCaptureInfos(captureInfos, decodedCaptureInfos) || decodedEvent->type_ != event->type_ ||
+            decodedEvent->result_ != event->result_ || decodedEvent->content_ != event->content_) {
+            cout << "decode mismatch, legacy: " << isLegacy << " value size: " << valueSize << endl;
+            return false;
+        }
+    }
+
+    MessageParcel parcel;
+    parcel.WriteUint32(IPC_DATA_LAYOUT_MAGIC | (IPC_DATA_LAYOUT_VERSION + 1));
+    parcel.WriteUint32(0);
+    vector<shared_ptr<DCStreamInfo>> decodedStreamInfos;
+    if (IpcDataUtils::DecodeDCStreamInfos(parcel, decodedStreamInfos)) {
+        cout << "a newer layout version must be rejected" << endl;
+        return false;
+    }
+    return true;
+}
+
+template<typename Func>
+double MeasureNs(Func func)
+{
+    auto start = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        func();
+    }
+    auto end = chrono::steady_clock::now();
+    return static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(end - start).count()) / BENCH_ITERATIONS;
+}
+}
+
+int main()
+{
+    for (uint32_t valueSize : BENCH_VALUE_SIZES) {
+        if (!CheckCompatibility(valueSize)) {
+            return 1;
+        }
+    }
+    cout << "compatibility with the legacy encoding: ok" << endl;
+
+    cout << "parcel round-trip, " << BENCH_STREAM_COUNT << " streams, " << BENCH_SETTINGS_COUNT <<
+        " settings per capture" << endl;
+    for (uint32_t valueSize : BENCH_VALUE_SIZES) {
+        vector<shared_ptr<DCStreamInfo>> streamInfos = BuildStreamInfos();
+        vector<shared_ptr<DCCaptureInfo>> captureInfos = BuildCaptureInfos(valueSize);
+        double legacyNs = MeasureNs([&]() {
+            MessageParcel parcel;
+            LegacyEncodeStreamInfos(streamInfos, parcel);
+            LegacyEncodeCaptureInfos(captureInfos, parcel);
+            vector<shared_ptr<DCStreamInfo>> decodedStreamInfos;
+            vector<shared_ptr<DCCaptureInfo>> decodedCaptureInfos;
+            IpcDataUtils::DecodeDCStreamInfos(parcel, decodedStreamInfos);
+            IpcDataUtils::DecodeDCCaptureInfos(parcel, decodedCaptureInfos);
+        });
+        double layoutNs = MeasureNs([&]() {
+            MessageParcel parcel;
+            IpcDataUtils::EncodeDCStreamInfos(streamInfos, parcel);
+            IpcDataUtils::EncodeDCCaptureInfos(captureInfos, parcel);
+            vector<shared_ptr<DCStreamInfo>> decodedStreamInfos;
+            vector<shared_ptr<DCCaptureInfo>> decodedCaptureInfos;
+            IpcDataUtils::DecodeDCStreamInfos(parcel, decodedStreamInfos);
+            IpcDataUtils::DecodeDCCaptureInfos(parcel, decodedCaptureInfos);
+        });
+        cout << "value size " << valueSize << ": legacy " << legacyNs << " ns, fixed layout " << layoutNs <<
+            " ns" << endl;
+    }
+    return 0;
+}
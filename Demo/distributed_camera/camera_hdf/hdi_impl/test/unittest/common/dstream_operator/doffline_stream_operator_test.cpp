@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define private public
+#include "doffline_stream_operator.h"
+#undef private
+#include "iremote_stub.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DOfflineStreamOperatorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const int TEST_STREAM_ID = 1;
+const int TEST_CAPTURE_ID = 10;
+const uint32_t TEST_BURST_DEPTH = 2;
+
+class MockOfflineStreamCallback : public IRemoteStub<IStreamOperatorCallback> {
+public:
+    void OnCaptureStarted(int32_t captureId, const std::vector<int32_t> &streamIds) override
+    {
+        (void)captureId;
+        (void)streamIds;
+    }
+
+    void OnCaptureEnded(int32_t captureId, const std::vector<std::shared_ptr<CaptureEndedInfo>> &infos) override
+    {
+        (void)captureId;
+        (void)infos;
+        std::lock_guard<std::mutex> autoLock(lock_);
+        endedTimes_++;
+    }
+
+    void OnCaptureError(int32_t captureId, const std::vector<std::shared_ptr<CaptureErrorInfo>> &infos) override
+    {
+        (void)captureId;
+        (void)infos;
+    }
+
+    void OnFrameShutter(int32_t captureId, const std::vector<int32_t> &streamIds, uint64_t timestamp) override
+    {
+        (void)captureId;
+        (void)streamIds;
+        (void)timestamp;
+    }
+
+    int32_t GetEndedTimes()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return endedTimes_;
+    }
+
+private:
+    std::mutex lock_;
+    int32_t endedTimes_ = 0;
+};
+
+std::shared_ptr<DCameraStream> CreateSnapshotStream()
+{
+    std::shared_ptr<DCameraStream> stream = std::make_shared<DCameraStream>();
+    stream->dcStreamId_ = TEST_STREAM_ID;
+    stream->dcStreamInfo_ = std::make_shared<StreamInfo>();
+    stream->dcStreamInfo_->streamId_ = TEST_STREAM_ID;
+    stream->dcStreamBufferMgr_ = std::make_shared<DBufferManager>(BUFFER_QUEUE_SIZE);
+    stream->bufferConfigs_.resize(stream->dcStreamBufferMgr_->GetCapacity());
+    return stream;
+}
+
+std::shared_ptr<DCameraBuffer> AcquireFrame(const std::shared_ptr<DCameraStream> &stream)
+{
+    int32_t index = stream->dcStreamBufferMgr_->ReserveSlot();
+    std::shared_ptr<DImageBuffer> imageBuffer = std::make_shared<DImageBuffer>();
+    imageBuffer->SetIndex(index);
+    stream->dcStreamBufferMgr_->AddBuffer(imageBuffer);
+    stream->dcStreamBufferMgr_->AcquireBuffer();
+    stream->captureBufferCount_++;
+
+    std::shared_ptr<DCameraBuffer> buffer = std::make_shared<DCameraBuffer>();
+    buffer->index_ = index;
+    buffer->size_ = 1;
+    return buffer;
+}
+}
+
+void DOfflineStreamOperatorTest::SetUpTestCase(void)
+{
+}
+
+void DOfflineStreamOperatorTest::TearDownTestCase(void)
+{
+}
+
+void DOfflineStreamOperatorTest::SetUp(void)
+{
+}
+
+void DOfflineStreamOperatorTest::TearDown(void)
+{
+}
+
+/**
+ * @tc.name: doffline_stream_operator_test_001
+ * @tc.desc: Verify an offline burst ends with its last picture without waiting for the buffer the source
+ *           still holds, and the stream goes once that buffer is back.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DOfflineStreamOperatorTest, doffline_stream_operator_test_001, TestSize.Level1)
+{
+    OHOS::sptr<MockOfflineStreamCallback> callback = new MockOfflineStreamCallback();
+    OHOS::sptr<DOfflineStreamOperator> offlineOperator = new DOfflineStreamOperator(callback);
+    std::shared_ptr<DCameraStream> stream = CreateSnapshotStream();
+    std::shared_ptr<std::atomic<uint32_t>> frameCount = std::make_shared<std::atomic<uint32_t>>(0);
+    offlineOperator->AddOfflineStream(TEST_STREAM_ID, TEST_CAPTURE_ID, stream, frameCount, TEST_BURST_DEPTH, true);
+    int32_t finishedTimes = 0;
+    EXPECT_TRUE(offlineOperator->SetFinishedCallback([&finishedTimes]() { finishedTimes++; }));
+
+    std::shared_ptr<DCameraBuffer> prefetched = AcquireFrame(stream);
+    EXPECT_EQ(DCamRetCode::SUCCESS, offlineOperator->ShutterBuffer(TEST_STREAM_ID, AcquireFrame(stream)));
+    EXPECT_EQ(0, callback->GetEndedTimes());
+    EXPECT_EQ(DCamRetCode::SUCCESS, offlineOperator->ShutterBuffer(TEST_STREAM_ID, AcquireFrame(stream)));
+    EXPECT_EQ(1, callback->GetEndedTimes());
+    EXPECT_EQ(1, finishedTimes);
+    EXPECT_FALSE(offlineOperator->IsCapturing());
+    EXPECT_TRUE(offlineOperator->HasStream(TEST_STREAM_ID));
+
+    std::shared_ptr<DCameraBuffer> buffer = nullptr;
+    EXPECT_EQ(DCamRetCode::INVALID_ARGUMENT, offlineOperator->AcquireBuffer(TEST_STREAM_ID, buffer));
+
+    prefetched->size_ = 0;
+    EXPECT_EQ(DCamRetCode::SUCCESS, offlineOperator->ShutterBuffer(TEST_STREAM_ID, prefetched));
+    EXPECT_FALSE(offlineOperator->HasStream(TEST_STREAM_ID));
+    EXPECT_EQ(1, callback->GetEndedTimes());
+    EXPECT_EQ(1, finishedTimes);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define private public
+#include "dstream_operator.h"
+#undef private
+#include "iremote_stub.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DStreamOperatorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    OHOS::sptr<DStreamOperator> streamOperator_ = nullptr;
+};
+
+namespace {
+const int TEST_STREAM_ID = 1;
+const int TEST_CAPTURE_ID = 10;
+const uint32_t TEST_BURST_DEPTH = 3;
+
+class MockStreamOperatorCallback : public IRemoteStub<IStreamOperatorCallback> {
+public:
+    void OnCaptureStarted(int32_t captureId, const std::vector<int32_t> &streamIds) override
+    {
+        (void)captureId;
+        (void)streamIds;
+    }
+
+    void OnCaptureEnded(int32_t captureId, const std::vector<std::shared_ptr<CaptureEndedInfo>> &infos) override
+    {
+        (void)captureId;
+        std::lock_guard<std::mutex> autoLock(lock_);
+        endedTimes_++;
+        for (auto &info : infos) {
+            endedFrameCount_ = info->frameCount_;
+        }
+    }
+
+    void OnCaptureError(int32_t captureId, const std::vector<std::shared_ptr<CaptureErrorInfo>> &infos) override
+    {
+        (void)captureId;
+        (void)infos;
+    }
+
+    void OnFrameShutter(int32_t captureId, const std::vector<int32_t> &streamIds, uint64_t timestamp) override
+    {
+        (void)captureId;
+        (void)streamIds;
+        (void)timestamp;
+    }
+
+    int32_t GetEndedTimes()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return endedTimes_;
+    }
+
+    int32_t GetEndedFrameCount()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return endedFrameCount_;
+    }
+
+private:
+    std::mutex lock_;
+    int32_t endedTimes_ = 0;
+    int32_t endedFrameCount_ = 0;
+};
+
+// A snapshot stream whose buffers live only in the slot table, without a surface behind them.
+std::shared_ptr<DCameraStream> CreateSnapshotStream()
+{
+    std::shared_ptr<DCameraStream> stream = std::make_shared<DCameraStream>();
+    stream->dcStreamId_ = TEST_STREAM_ID;
+    stream->dcStreamInfo_ = std::make_shared<StreamInfo>();
+    stream->dcStreamInfo_->streamId_ = TEST_STREAM_ID;
+    stream->dcStreamBufferMgr_ = std::make_shared<DBufferManager>(BUFFER_QUEUE_SIZE);
+    stream->bufferConfigs_.resize(stream->dcStreamBufferMgr_->GetCapacity());
+    return stream;
+}
+
+std::shared_ptr<DCameraBuffer> AcquireFrame(const std::shared_ptr<DCameraStream> &stream)
+{
+    int32_t index = stream->dcStreamBufferMgr_->ReserveSlot();
+    std::shared_ptr<DImageBuffer> imageBuffer = std::make_shared<DImageBuffer>();
+    imageBuffer->SetIndex(index);
+    stream->dcStreamBufferMgr_->AddBuffer(imageBuffer);
+    stream->dcStreamBufferMgr_->AcquireBuffer();
+    stream->captureBufferCount_++;
+
+    std::shared_ptr<DCameraBuffer> buffer = std::make_shared<DCameraBuffer>();
+    buffer->index_ = index;
+    buffer->size_ = 1;
+    return buffer;
+}
+}
+
+void DStreamOperatorTest::SetUpTestCase(void)
+{
+}
+
+void DStreamOperatorTest::TearDownTestCase(void)
+{
+}
+
+void DStreamOperatorTest::SetUp(void)
+{
+    std::shared_ptr<DMetadataProcessor> metadataProcessor = std::make_shared<DMetadataProcessor>();
+    streamOperator_ = new DStreamOperator(metadataProcessor);
+}
+
+void DStreamOperatorTest::TearDown(void)
+{
+    streamOperator_ = nullptr;
+}
+
+/**
+ * @tc.name: dstream_operator_test_001
+ * @tc.desc: Verify a 3-deep burst reports its capture end once, with the last picture.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DStreamOperatorTest, dstream_operator_test_001, TestSize.Level1)
+{
+    OHOS::sptr<MockStreamOperatorCallback> callback = new MockStreamOperatorCallback();
+    streamOperator_->SetCallBack(callback);
+
+    std::shared_ptr<DCameraStream> stream = CreateSnapshotStream();
+    std::shared_ptr<DCStreamInfo> dcStreamInfo = std::make_shared<DCStreamInfo>();
+    dcStreamInfo->streamId_ = TEST_STREAM_ID;
+    dcStreamInfo->type_ = DCStreamType::SNAPSHOT_FRAME;
+    std::shared_ptr<CaptureInfo> captureInfo = std::make_shared<CaptureInfo>();
+    captureInfo->streamIds_ = { TEST_STREAM_ID };
+    captureInfo->enableShutterCallback_ = true;
+    streamOperator_->halStreamMap_[TEST_STREAM_ID] = stream;
+    streamOperator_->dcStreamInfoMap_[TEST_STREAM_ID] = dcStreamInfo;
+    streamOperator_->halCaptureInfoMap_[TEST_CAPTURE_ID] = captureInfo;
+    streamOperator_->captureDepthMap_[TEST_CAPTURE_ID] = TEST_BURST_DEPTH;
+    streamOperator_->RebuildRouteTable();
+
+    for (uint32_t i = 0; i < TEST_BURST_DEPTH; i++) {
+        DCamRetCode ret = streamOperator_->ShutterBuffer(TEST_STREAM_ID, AcquireFrame(stream));
+        EXPECT_EQ(DCamRetCode::SUCCESS, ret);
+    }
+    streamOperator_->callbackDispatcher_.Stop();
+
+    EXPECT_EQ(1, callback->GetEndedTimes());
+    EXPECT_EQ(static_cast<int32_t>(TEST_BURST_DEPTH), callback->GetEndedFrameCount());
+}
+
+/**
+ * @tc.name: dstream_operator_test_002
+ * @tc.desc: Verify a buffer that cannot be handed to the source goes back to its slot.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DStreamOperatorTest, dstream_operator_test_002, TestSize.Level1)
+{
+    std::shared_ptr<DCameraStream> stream = CreateSnapshotStream();
+    int32_t index = stream->dcStreamBufferMgr_->ReserveSlot();
+    std::shared_ptr<DImageBuffer> imageBuffer = std::make_shared<DImageBuffer>();
+    imageBuffer->SetIndex(index);
+    stream->dcStreamBufferMgr_->AddBuffer(imageBuffer);
+
+    // without a buffer handle the conversion fails after the slot was acquired
+    std::shared_ptr<DCameraBuffer> buffer = std::make_shared<DCameraBuffer>();
+    EXPECT_EQ(DCamRetCode::FAILED, stream->GetDCameraBuffer(buffer));
+    EXPECT_EQ(DBufferSlotState::SLOT_IDLE, stream->dcStreamBufferMgr_->GetSlotState(index));
+    EXPECT_EQ(0, stream->captureBufferCount_);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_buffer_handle_cache.h"
+#include <buffer_handle_utils.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+const std::string DEVICE_KEY_SEPARATOR = "#";
+
+int GetMapFd(const BufferHandle *buffer)
+{
+#ifdef BALTIMORE_CAMERA
+    return (buffer->reserveFds > 0) ? buffer->reserve[0] : -1;
+#else
+    return buffer->fd;
+#endif
+}
+}
+
+DCameraBufferHandleCache& DCameraBufferHandleCache::GetInstance()
+{
+    static DCameraBufferHandleCache instance;
+    return instance;
+}
+
+DCameraBufferHandleCache::~DCameraBufferHandleCache()
+{
+    std::lock_guard<std::mutex> autoLock(cacheLock_);
+    for (auto &stream : streamBuffers_) {
+        ReleaseBuffers(stream.second);
+    }
+    streamBuffers_.clear();
+}
+
+BufferHandle* DCameraBufferHandleCache::MapBuffer(const std::string &devId, const std::string &dhId, int streamId,
+    int32_t index, BufferHandle *handle)
+{
+    if (handle == nullptr) {
+        DHLOGE("Map buffer failed, the buffer handle is null.");
+        return nullptr;
+    }
+    struct stat fdStat;
+    int fd = GetMapFd(handle);
+    if (fd < 0 || fstat(fd, &fdStat) != 0) {
+        DHLOGE("Get buffer fd stat failed, fd: %d, index: %d.", fd, index);
+        FreeBufferHandle(handle);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> autoLock(cacheLock_);
+    std::map<int32_t, MappedBuffer> &buffers = streamBuffers_[StreamKey(GetDeviceKey(devId, dhId), streamId)];
+    auto iter = buffers.find(index);
+    if (iter != buffers.end()) {
+        MappedBuffer &mapped = iter->second;
+        if (mapped.dev == fdStat.st_dev && mapped.ino == fdStat.st_ino && mapped.handle->size == handle->size) {
+            FreeBufferHandle(handle);
+            return mapped.handle;
+        }
+        DHLOGI("Buffer %d of stream %d changed, remap it.", index, streamId);
+        MemoryUnmap(mapped.handle);
+        buffers.erase(iter);
+    }
+
+    handle->virAddr = MemoryMap(handle);
+    if (handle->virAddr == nullptr) {
+        FreeBufferHandle(handle);
+        return nullptr;
+    }
+    buffers[index] = { handle, fdStat.st_dev, fdStat.st_ino };
+    return handle;
+}
+
+void DCameraBufferHandleCache::ReleaseStream(const std::string &devId, const std::string &dhId, int streamId)
+{
+    std::lock_guard<std::mutex> autoLock(cacheLock_);
+    auto iter = streamBuffers_.find(StreamKey(GetDeviceKey(devId, dhId), streamId));
+    if (iter == streamBuffers_.end()) {
+        return;
+    }
+    ReleaseBuffers(iter->second);
+    streamBuffers_.erase(iter);
+}
+
+void DCameraBufferHandleCache::ReleaseDevice(const std::string &devId, const std::string &dhId)
+{
+    std::lock_guard<std::mutex> autoLock(cacheLock_);
+    std::string deviceKey = GetDeviceKey(devId, dhId);
+    auto iter = streamBuffers_.lower_bound(StreamKey(deviceKey, INT32_MIN));
+    while (iter != streamBuffers_.end() && iter->first.first == deviceKey) {
+        ReleaseBuffers(iter->second);
+        iter = streamBuffers_.erase(iter);
+    }
+}
+
+std::string DCameraBufferHandleCache::GetDeviceKey(const std::string &devId, const std::string &dhId)
+{
+    return devId + DEVICE_KEY_SEPARATOR + dhId;
+}
+
+void DCameraBufferHandleCache::ReleaseBuffers(std::map<int32_t, MappedBuffer> &buffers)
+{
+    for (auto &buffer : buffers) {
+        MemoryUnmap(buffer.second.handle);
+    }
+    buffers.clear();
+}
+
+void* DCameraBufferHandleCache::MemoryMap(const BufferHandle *buffer)
+{
+    if (buffer == nullptr) {
+        DHLOGE("mmap the buffer handle is NULL");
+        return nullptr;
+    }
+    int fd = GetMapFd(buffer);
+    if (fd < 0) {
+        DHLOGE("invalid file descriptor : %d", fd);
+        return nullptr;
+    }
+    void* virAddr = mmap(NULL, buffer->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (virAddr == MAP_FAILED) {
+        DHLOGE("mmap failed errno %s, fd : %d", strerror(errno), fd);
+        return nullptr;
+    }
+    return virAddr;
+}
+
+void DCameraBufferHandleCache::MemoryUnmap(BufferHandle *buffer)
+{
+    if (buffer == nullptr) {
+        DHLOGE("unmmap the buffer handle is NULL");
+        return;
+    }
+    if (buffer->virAddr != nullptr) {
+        int ret = munmap(buffer->virAddr, buffer->size);
+        if (ret != 0) {
+            DHLOGE("munmap failed err: %s", strerror(errno));
+        }
+        buffer->virAddr = nullptr;
+    }
+    FreeBufferHandle(buffer);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTED_CAMERA_BUFFER_HANDLE_CACHE_H
+#define DISTRIBUTED_CAMERA_BUFFER_HANDLE_CACHE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include "buffer_handle.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+/*
+ * Keeps the driver buffers of every stream mapped for the stream's lifetime.
+ * The stream reuses a small set of buffers, so a handle received for a known
+ * buffer index is matched by the identity of its memory (device and inode of
+ * the fd) and the existing mapping is reused instead of mapping it again.
+ */
+class DCameraBufferHandleCache {
+public:
+    static DCameraBufferHandleCache& GetInstance();
+
+    // Takes the ownership of handle, returns the mapped handle that stays owned by the cache.
+    BufferHandle* MapBuffer(const std::string &devId, const std::string &dhId, int streamId, int32_t index,
+        BufferHandle *handle);
+    void ReleaseStream(const std::string &devId, const std::string &dhId, int streamId);
+    void ReleaseDevice(const std::string &devId, const std::string &dhId);
+
+    static void* MemoryMap(const BufferHandle *buffer);
+    static void MemoryUnmap(BufferHandle *buffer);
+
+private:
+    DCameraBufferHandleCache() = default;
+    ~DCameraBufferHandleCache();
+    DCameraBufferHandleCache(const DCameraBufferHandleCache &other) = delete;
+    DCameraBufferHandleCache& operator=(const DCameraBufferHandleCache &other) = delete;
+
+    struct MappedBuffer {
+        BufferHandle *handle;
+        dev_t dev;
+        ino_t ino;
+    };
+    using StreamKey = std::pair<std::string, int>;
+
+    static std::string GetDeviceKey(const std::string &devId, const std::string &dhId);
+    static void ReleaseBuffers(std::map<int32_t, MappedBuffer> &buffers);
+
+    std::mutex cacheLock_;
+    std::map<StreamKey, std::map<int32_t, MappedBuffer>> streamBuffers_;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // DISTRIBUTED_CAMERA_BUFFER_HANDLE_CACHE_H
@@ -63,5 +63,10 @@ DCamRetCode DCameraProviderCallback::UpdateSettings(const std::shared_ptr<DHBase
     DHLOGW("DCameraProviderCallback::UpdateSettings enter.");
     return DCamRetCode::SUCCESS;
 }
+
+void DCameraProviderCallback::NotifyBufferAvailable(const std::shared_ptr<DHBase> &dhBase, int streamId)
+{
+    DHLOGW("DCameraProviderCallback::NotifyBufferAvailable enter.");
+}
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -37,6 +37,7 @@ public:
     virtual DCamRetCode StopCapture(const std::shared_ptr<DHBase> &dhBase) override;
     virtual DCamRetCode UpdateSettings(const std::shared_ptr<DHBase> &dhBase,
                                        const std::vector<std::shared_ptr<DCameraSettings>> &settings) override;
+    virtual void NotifyBufferAvailable(const std::shared_ptr<DHBase> &dhBase, int streamId) override;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -54,6 +54,10 @@ int32_t DCameraProviderCallbackStub::OnRemoteRequest(uint32_t code, MessageParce
             ret = DCProviderUpdateSettingsStub(data, reply, option);
             break;
         }
+        case CMD_DISTRIBUTED_CAMERA_PROVIDER_CALLBACK_NOTIFY_BUFFER_AVAILABLE: {
+            ret = DCProviderNotifyBufferAvailableStub(data, reply, option);
+            break;
+        }
         default: {
             ret = IPCObjectStub::OnRemoteRequest(code, data, reply, option);
         }
@@ -107,25 +111,10 @@ int32_t DCameraProviderCallbackStub::DCProviderConfigureStreamsStub(MessageParce
 
     std::shared_ptr<DHBase> dhBase = std::make_shared<DHBase>(data.ReadString(), data.ReadString());
 
-    int32_t count = data.ReadInt32();
     std::vector<std::shared_ptr<DCStreamInfo>> streamInfos;
-    for (int32_t i = 0; i < count; i++) {
-        const DCStreamInfo *pInfo = reinterpret_cast<const DCStreamInfo *>(
-            data.ReadBuffer(sizeof(DCStreamInfo)));
-        if (pInfo == nullptr) {
-            DHLOGE("Read distributed camera stream info failed.");
-            return HDF_FAILURE;
-        }
-        std::shared_ptr<DCStreamInfo> streamInfo = std::make_shared<DCStreamInfo>();
-        streamInfo->streamId_ = pInfo->streamId_;
-        streamInfo->width_ = pInfo->width_;
-        streamInfo->height_ = pInfo->height_;
-        streamInfo->stride_ = pInfo->stride_;
-        streamInfo->format_ = pInfo->format_;
-        streamInfo->dataspace_ = pInfo->dataspace_;
-        streamInfo->encodeType_ = pInfo->encodeType_;
-        streamInfo->type_ = pInfo->type_;
-        streamInfos.push_back(streamInfo);
+    if (!IpcDataUtils::DecodeDCStreamInfos(data, streamInfos)) {
+        DHLOGE("Read distributed camera stream info failed.");
+        return HDF_FAILURE;
     }
 
     DCamRetCode ret = ConfigureStreams(dhBase, streamInfos);
@@ -170,34 +159,10 @@ int32_t DCameraProviderCallbackStub::DCProviderStartCaptureStub(MessageParcel &d
 
     std::shared_ptr<DHBase> dhBase = std::make_shared<DHBase>(data.ReadString(), data.ReadString());
 
-    int32_t count = data.ReadInt32();
     std::vector<std::shared_ptr<DCCaptureInfo>> captureInfos;
-    for (int32_t i = 0; i < count; i++) {
-        std::shared_ptr<DCCaptureInfo> captureInfo = std::make_shared<DCCaptureInfo>();
-        std::vector<int32_t> streamIds;
-        if (!data.ReadInt32Vector(&streamIds)) {
-            DHLOGE("Read streamIds failed.");
-            return HDF_FAILURE;
-        }
-        captureInfo->streamIds_ = streamIds;
-        captureInfo->width_ = static_cast<int>(data.ReadInt32());
-        captureInfo->height_ = static_cast<int>(data.ReadInt32());
-        captureInfo->stride_ = static_cast<int>(data.ReadInt32());
-        captureInfo->format_ = static_cast<int>(data.ReadInt32());
-        captureInfo->dataspace_ = static_cast<int>(data.ReadInt32());
-        captureInfo->isCapture_ = data.ReadBool();
-        captureInfo->encodeType_ = static_cast<DCEncodeType>(data.ReadInt32());
-        captureInfo->type_ = static_cast<DCStreamType>(data.ReadInt32());
-
-        int32_t settingsSize = data.ReadInt32();
-        std::vector<std::shared_ptr<DCameraSettings>> capSettings;
-        for (int32_t k = 0; k < settingsSize; k++) {
-            std::shared_ptr<DCameraSettings> metadata = std::make_shared<DCameraSettings>();
-            IpcDataUtils::DecodeDCameraSettings(data, metadata);
-            capSettings.push_back(metadata);
-        }
-        captureInfo->captureSettings_ = capSettings;
-        captureInfos.push_back(captureInfo);
+    if (!IpcDataUtils::DecodeDCCaptureInfos(data, captureInfos)) {
+        DHLOGE("Read distributed camera capture info failed.");
+        return HDF_FAILURE;
     }
 
     DCamRetCode ret = StartCapture(dhBase, captureInfos);
@@ -236,12 +201,10 @@ int32_t DCameraProviderCallbackStub::DCProviderUpdateSettingsStub(MessageParcel
 
     std::shared_ptr<DHBase> dhBase = std::make_shared<DHBase>(data.ReadString(), data.ReadString());
 
-    int32_t count = data.ReadInt32();
     std::vector<std::shared_ptr<DCameraSettings>> settings;
-    for (int32_t i = 0; i < count; i++) {
-        std::shared_ptr<DCameraSettings> metadata = std::make_shared<DCameraSettings>();
-        IpcDataUtils::DecodeDCameraSettings(data, metadata);
-        settings.push_back(metadata);
+    if (!IpcDataUtils::DecodeDCameraSettingsList(data, settings)) {
+        DHLOGE("Read distributed camera settings failed.");
+        return HDF_FAILURE;
     }
 
     DCamRetCode ret = UpdateSettings(dhBase, settings);
@@ -251,5 +214,20 @@ int32_t DCameraProviderCallbackStub::DCProviderUpdateSettingsStub(MessageParcel
     }
     return HDF_SUCCESS;
 }
+
+int32_t DCameraProviderCallbackStub::DCProviderNotifyBufferAvailableStub(MessageParcel &data, MessageParcel &reply,
+    MessageOption &option)
+{
+    if (data.ReadInterfaceToken() != DCameraProviderCallbackStub::GetDescriptor()) {
+        DHLOGE("NotifyBufferAvailable invalid token.");
+        return HDF_FAILURE;
+    }
+
+    std::shared_ptr<DHBase> dhBase = std::make_shared<DHBase>(data.ReadString(), data.ReadString());
+    int streamId = data.ReadInt32();
+
+    NotifyBufferAvailable(dhBase, streamId);
+    return HDF_SUCCESS;
+}
 } // namespace DistributedHardware
 } // namespace OHOS
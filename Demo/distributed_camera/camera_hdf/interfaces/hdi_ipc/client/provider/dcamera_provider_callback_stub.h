@@ -38,6 +38,7 @@ private:
     int32_t DCProviderStartCaptureStub(MessageParcel &data, MessageParcel &reply, MessageOption &option);
     int32_t DCProviderStopCaptureStub(MessageParcel &data, MessageParcel &reply, MessageOption &option);
     int32_t DCProviderUpdateSettingsStub(MessageParcel &data, MessageParcel &reply, MessageOption &option);
+    int32_t DCProviderNotifyBufferAvailableStub(MessageParcel &data, MessageParcel &reply, MessageOption &option);
 };
 } // namespace DistributedHardware
 } // namespace OHOS
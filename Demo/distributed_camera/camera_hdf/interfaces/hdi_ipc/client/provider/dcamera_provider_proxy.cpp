@@ -18,7 +18,7 @@
 #include <buffer_handle_utils.h>
 #include <hdf_base.h>
 #include <message_parcel.h>
-#include <sys/mman.h>
+#include "dcamera_buffer_handle_cache.h"
 #include "distributed_hardware_log.h"
 #include "ipc_data_utils.h"
 #include "iservmgr_hdi.h"
@@ -96,6 +96,18 @@ DCamRetCode DCameraProviderProxy::DisableDCameraDevice(const std::shared_ptr<DHB
         return DCamRetCode::INVALID_ARGUMENT;
     }
 
+    {
+        std::lock_guard<std::mutex> autoLock(streamLock_);
+        auto iter = streams_.begin();
+        while (iter != streams_.end()) {
+            if (iter->second.devId == dhBase->deviceId_ && iter->second.dhId == dhBase->dhId_) {
+                iter = streams_.erase(iter);
+            } else {
+                iter++;
+            }
+        }
+    }
+    DCameraBufferHandleCache::GetInstance().ReleaseDevice(dhBase->deviceId_, dhBase->dhId_);
     int32_t ret = Remote()->SendRequest(CMD_DISTRIBUTED_CAMERA_PROVIDER_DISABLE_DEVICE, data, reply, option);
     if (ret != HDF_SUCCESS) {
         DHLOGE("SendRequest failed, error code is %d.", ret);
@@ -144,11 +156,14 @@ DCamRetCode DCameraProviderProxy::AcquireBuffer(const std::shared_ptr<DHBase> &d
     BufferHandle* retHandle = ReadBufferHandle(reply);
     if (retHandle == nullptr) {
         DHLOGE("Read retrun buffer handle failed.");
-        FreeBufferHandle(buffer->bufferHandle_);
         return DCamRetCode::INVALID_ARGUMENT;
     }
-    retHandle->virAddr = DCameraMemoryMap(retHandle);
-    buffer->bufferHandle_ = retHandle;
+    buffer->bufferHandle_ = DCameraBufferHandleCache::GetInstance().MapBuffer(dhBase->deviceId_, dhBase->dhId_,
+        streamId, buffer->index_, retHandle);
+    if (buffer->bufferHandle_ == nullptr) {
+        DHLOGE("Map return buffer handle failed.");
+        return DCamRetCode::FAILED;
+    }
 
     return DCamRetCode::SUCCESS;
 }
@@ -199,7 +214,6 @@ DCamRetCode DCameraProviderProxy::ShutterBuffer(const std::shared_ptr<DHBase> &d
         }
     } while (0);
 
-    DCameraMemoryUnmap(buffer->bufferHandle_);
     if (ret != DCamRetCode::SUCCESS) {
         return ret;
     }
@@ -276,57 +290,183 @@ DCamRetCode DCameraProviderProxy::Notify(const std::shared_ptr<DHBase> &dhBase,
     return static_cast<DCamRetCode>(reply.ReadInt32());
 }
 
-#ifdef BALTIMORE_CAMERA
-void* DCameraProviderProxy::DCameraMemoryMap(const BufferHandle *buffer)
+DCamRetCode DCameraProviderProxy::RegisterStream(const std::shared_ptr<DHBase> &dhBase, int streamId,
+    int32_t &streamHandle)
 {
-    if (buffer == nullptr) {
-        DHLOGE("mmap the buffer handle is NULL");
-        return nullptr;
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(DCameraProviderProxy::GetDescriptor())) {
+        DHLOGE("Write token failed.");
+        return DCamRetCode::INVALID_ARGUMENT;
     }
-    if (buffer->reserveFds <= 0) {
-        DHLOGE("invalid file descriptor num : %d", buffer->reserveFds);
-        return nullptr;
+
+    if (!data.WriteString(dhBase->deviceId_) || !data.WriteString(dhBase->dhId_) ||
+        !data.WriteInt32(static_cast<int32_t>(streamId))) {
+        DHLOGE("Write distributed camera base info or streamId failed.");
+        return DCamRetCode::INVALID_ARGUMENT;
     }
-    void* virAddr = mmap(NULL, buffer->size, PROT_READ | PROT_WRITE, MAP_SHARED, buffer->reserve[0], 0);
-    if (virAddr == MAP_FAILED) {
-        DHLOGE("mmap failed errno %s, fd : %d", strerror(errno), buffer->fd);
-        return nullptr;
+
+    int32_t ret = Remote()->SendRequest(CMD_DISTRIBUTED_CAMERA_PROVIDER_REGISTER_STREAM, data, reply, option);
+    if (ret != HDF_SUCCESS) {
+        DHLOGE("SendRequest failed, error code is %d.", ret);
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+    int32_t retCode = reply.ReadInt32();
+    if (retCode != DCamRetCode::SUCCESS) {
+        DHLOGE("Register stream %d failed, ret: %d.", streamId, retCode);
+        return static_cast<DCamRetCode>(retCode);
     }
-    return virAddr;
+
+    streamHandle = reply.ReadInt32();
+    std::lock_guard<std::mutex> autoLock(streamLock_);
+    streams_[streamHandle] = { dhBase->deviceId_, dhBase->dhId_, streamId };
+    return DCamRetCode::SUCCESS;
 }
-#else
-void* DCameraProviderProxy::DCameraMemoryMap(const BufferHandle *buffer)
+
+DCamRetCode DCameraProviderProxy::UnregisterStream(int32_t streamHandle)
 {
-    if (buffer == nullptr) {
-        DHLOGE("mmap the buffer handle is NULL");
-        return nullptr;
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    {
+        std::lock_guard<std::mutex> autoLock(streamLock_);
+        streams_.erase(streamHandle);
     }
 
-    void* virAddr = mmap(NULL, buffer->size, PROT_READ | PROT_WRITE, MAP_SHARED, buffer->fd, 0);
-    if (virAddr == MAP_FAILED) {
-        DHLOGE("mmap failed errno %s, fd : %d", strerror(errno), buffer->fd);
-        return nullptr;
+    if (!data.WriteInterfaceToken(DCameraProviderProxy::GetDescriptor())) {
+        DHLOGE("Write token failed.");
+        return DCamRetCode::INVALID_ARGUMENT;
     }
-    return virAddr;
+
+    if (!data.WriteInt32(streamHandle)) {
+        DHLOGE("Write stream handle failed.");
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+
+    int32_t ret = Remote()->SendRequest(CMD_DISTRIBUTED_CAMERA_PROVIDER_UNREGISTER_STREAM, data, reply, option);
+    if (ret != HDF_SUCCESS) {
+        DHLOGE("SendRequest failed, error code is %d.", ret);
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+    return static_cast<DCamRetCode>(reply.ReadInt32());
 }
-#endif
 
-void DCameraProviderProxy::DCameraMemoryUnmap(BufferHandle *buffer)
+DCamRetCode DCameraProviderProxy::AcquireBuffers(int32_t streamHandle, uint32_t count,
+    std::vector<std::shared_ptr<DCameraBuffer>> &buffers)
 {
-    if (buffer == nullptr) {
-        DHLOGE("unmmap the buffer handle is NULL");
-        return;
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    StreamInfo info;
+    if (!GetStreamInfo(streamHandle, info)) {
+        DHLOGE("Stream handle %d is not registered.", streamHandle);
+        return DCamRetCode::INVALID_ARGUMENT;
     }
-    if (buffer->virAddr == nullptr) {
-        DHLOGE("virAddr is NULL , has not map the buffer");
-        return;
+
+    if (!data.WriteInterfaceToken(DCameraProviderProxy::GetDescriptor())) {
+        DHLOGE("Write token failed.");
+        return DCamRetCode::INVALID_ARGUMENT;
     }
-    int ret = munmap(buffer->virAddr, buffer->size);
-    if (ret != 0) {
-        DHLOGE("munmap failed err: %s", strerror(errno));
+
+    if (!data.WriteInt32(streamHandle) || !data.WriteUint32(count)) {
+        DHLOGE("Write stream handle or buffer count failed.");
+        return DCamRetCode::INVALID_ARGUMENT;
     }
-    buffer->virAddr = nullptr;
-    FreeBufferHandle(buffer);
+
+    int32_t ret = Remote()->SendRequest(CMD_DISTRIBUTED_CAMERA_PROVIDER_ACQUIRE_BUFFERS, data, reply, option);
+    if (ret != HDF_SUCCESS) {
+        DHLOGE("SendRequest failed, error code is %d.", ret);
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+    int32_t retCode = reply.ReadInt32();
+    if (retCode != DCamRetCode::SUCCESS) {
+        DHLOGE("Acquire avaliable buffers from stub failed.");
+        return static_cast<DCamRetCode>(retCode);
+    }
+
+    uint32_t size = reply.ReadUint32();
+    for (uint32_t i = 0; i < size; i++) {
+        std::shared_ptr<DCameraBuffer> buffer = nullptr;
+        DCamRetCode readRet = ReadDCameraBuffer(reply, info, buffer);
+        if (readRet != DCamRetCode::SUCCESS) {
+            return readRet;
+        }
+        buffers.push_back(buffer);
+    }
+    return DCamRetCode::SUCCESS;
+}
+
+DCamRetCode DCameraProviderProxy::ShutterAndAcquireBuffer(int32_t streamHandle,
+    const std::shared_ptr<DCameraBuffer> &buffer, std::shared_ptr<DCameraBuffer> &nextBuffer)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    StreamInfo info;
+    if (buffer == nullptr || !GetStreamInfo(streamHandle, info)) {
+        DHLOGE("Invalid buffer or stream handle %d is not registered.", streamHandle);
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+
+    if (!data.WriteInterfaceToken(DCameraProviderProxy::GetDescriptor())) {
+        DHLOGE("Write token failed.");
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+
+    if (!data.WriteInt32(streamHandle) || !data.WriteInt32(buffer->index_) || !data.WriteInt32(buffer->size_)) {
+        DHLOGE("Write stream handle, buffer index and size parameter failed.");
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+
+    int32_t ret = Remote()->SendRequest(CMD_DISTRIBUTED_CAMERA_PROVIDER_SHUTTER_AND_ACQUIRE_BUFFER, data, reply,
+        option);
+    if (ret != HDF_SUCCESS) {
+        DHLOGE("SendRequest failed, error code is %d.", ret);
+        return DCamRetCode::FAILED;
+    }
+    DCamRetCode retCode = static_cast<DCamRetCode>(reply.ReadInt32());
+    bool hasNext = reply.ReadBool();
+    if (hasNext && ReadDCameraBuffer(reply, info, nextBuffer) != DCamRetCode::SUCCESS) {
+        nextBuffer = nullptr;
+    }
+    return retCode;
+}
+
+bool DCameraProviderProxy::GetStreamInfo(int32_t streamHandle, StreamInfo &info)
+{
+    std::lock_guard<std::mutex> autoLock(streamLock_);
+    auto iter = streams_.find(streamHandle);
+    if (iter == streams_.end()) {
+        return false;
+    }
+    info = iter->second;
+    return true;
+}
+
+DCamRetCode DCameraProviderProxy::ReadDCameraBuffer(MessageParcel &reply, const StreamInfo &info,
+    std::shared_ptr<DCameraBuffer> &buffer)
+{
+    buffer = std::make_shared<DCameraBuffer>();
+    buffer->index_ = reply.ReadInt32();
+    buffer->size_ = reply.ReadInt32();
+
+    BufferHandle* retHandle = ReadBufferHandle(reply);
+    if (retHandle == nullptr) {
+        DHLOGE("Read retrun buffer handle failed.");
+        return DCamRetCode::INVALID_ARGUMENT;
+    }
+    buffer->bufferHandle_ = DCameraBufferHandleCache::GetInstance().MapBuffer(info.devId, info.dhId,
+        info.streamId, buffer->index_, retHandle);
+    if (buffer->bufferHandle_ == nullptr) {
+        DHLOGE("Map return buffer handle failed.");
+        return DCamRetCode::FAILED;
+    }
+    return DCamRetCode::SUCCESS;
 }
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -16,6 +16,8 @@
 #ifndef DISTRIBUTED_CAMERA_PROVIDER_CLIENT_PROXY_H
 #define DISTRIBUTED_CAMERA_PROVIDER_CLIENT_PROXY_H
 
+#include <map>
+#include <mutex>
 #include "iremote_proxy.h"
 #include "buffer_handle.h"
 #include "idistributed_camera_provider.h"
@@ -39,18 +41,37 @@ public:
                                          const std::shared_ptr<DCameraSettings> &result) override;
     virtual DCamRetCode Notify(const std::shared_ptr<DHBase> &dhBase,
                                const std::shared_ptr<DCameraHDFEvent> &event) override;
+    virtual DCamRetCode RegisterStream(const std::shared_ptr<DHBase> &dhBase, int streamId,
+                                       int32_t &streamHandle) override;
+    virtual DCamRetCode UnregisterStream(int32_t streamHandle) override;
+    virtual DCamRetCode AcquireBuffers(int32_t streamHandle, uint32_t count,
+                                       std::vector<std::shared_ptr<DCameraBuffer>> &buffers) override;
+    virtual DCamRetCode ShutterAndAcquireBuffer(int32_t streamHandle, const std::shared_ptr<DCameraBuffer> &buffer,
+                                                std::shared_ptr<DCameraBuffer> &nextBuffer) override;
 
 private:
-    static void* DCameraMemoryMap(const BufferHandle *buffer);
-    static void DCameraMemoryUnmap(BufferHandle *buffer);
+    struct StreamInfo {
+        std::string devId;
+        std::string dhId;
+        int streamId;
+    };
+    bool GetStreamInfo(int32_t streamHandle, StreamInfo &info);
+    DCamRetCode ReadDCameraBuffer(MessageParcel &reply, const StreamInfo &info,
+                                  std::shared_ptr<DCameraBuffer> &buffer);
 
-private:
     static constexpr int CMD_DISTRIBUTED_CAMERA_PROVIDER_ENABLE_DEVICE = 0;
     static constexpr int CMD_DISTRIBUTED_CAMERA_PROVIDER_DISABLE_DEVICE = 1;
     static constexpr int CMD_DISTRIBUTED_CAMERA_PROVIDER_ACQUIRE_BUFFER = 2;
     static constexpr int CMD_DISTRIBUTED_CAMERA_PROVIDER_SHUTTER_BUFFER = 3;
     static constexpr int CMD_DISTRIBUTED_CAMERA_PROVIDER_ON_SETTINGS_RESULT = 4;
     static constexpr int CMD_DISTRIBUTED_CAMERA_PROVIDER_NOTIFY = 5;
+    static constexpr int CMD_DISTRIBUTED_CAMERA_PROVIDER_REGISTER_STREAM = 6;
+    static constexpr int CMD_DISTRIBUTED_CAMERA_PROVIDER_UNREGISTER_STREAM = 7;
+    static constexpr int CMD_DISTRIBUTED_CAMERA_PROVIDER_ACQUIRE_BUFFERS = 8;
+    static constexpr int CMD_DISTRIBUTED_CAMERA_PROVIDER_SHUTTER_AND_ACQUIRE_BUFFER = 9;
+
+    std::mutex streamLock_;
+    std::map<int32_t, StreamInfo> streams_;
 
     static inline BrokerDelegator<DCameraProviderProxy> delegator_;
 };
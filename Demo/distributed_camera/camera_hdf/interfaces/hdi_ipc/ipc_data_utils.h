@@ -19,6 +19,7 @@
 #include <list>
 #include <map>
 #include <vector>
+#include <ashmem.h>
 #include <message_parcel.h>
 #include <iostream>
 #include <iservmgr_hdi.h>
@@ -33,6 +34,56 @@
 
 namespace OHOS {
 namespace DistributedHardware {
+/*
+ * Versioned, fixed-layout wire records of the distributed camera provider interface.
+ * Each encoded group starts with IPC_DATA_LAYOUT_TAG (magic | version), followed by
+ * a record count and the records of the group as one unpadded block. Variable sized
+ * values follow the block in record order, inline up to IPC_DATA_INLINE_MAX_SIZE and
+ * in an ashmem region above it. The legacy field-by-field encoding always starts with
+ * a small count or enum value, so decoders tell both encodings apart by the first word.
+ */
+const uint32_t IPC_DATA_LAYOUT_MAGIC = 0x44430000;
+const uint32_t IPC_DATA_LAYOUT_MAGIC_MASK = 0xFFFF0000;
+const uint32_t IPC_DATA_LAYOUT_V1 = 1;
+const uint32_t IPC_DATA_LAYOUT_VERSION = IPC_DATA_LAYOUT_V1;
+const uint32_t IPC_DATA_LAYOUT_TAG = IPC_DATA_LAYOUT_MAGIC | IPC_DATA_LAYOUT_VERSION;
+const uint32_t IPC_DATA_MAX_RECORD_COUNT = 1024;
+const uint32_t IPC_DATA_INLINE_MAX_SIZE = 16 * 1024;
+const uint32_t IPC_DATA_MAX_BLOB_SIZE = 64 * 1024 * 1024;
+
+struct IpcDCStreamInfoRecord {
+    int32_t streamId;
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+    int32_t format;
+    int32_t dataspace;
+    int32_t encodeType;
+    int32_t type;
+};
+
+struct IpcDCCaptureInfoRecord {
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+    int32_t format;
+    int32_t dataspace;
+    int32_t isCapture;
+    int32_t encodeType;
+    int32_t type;
+};
+
+struct IpcBlobRecord {
+    int32_t type;
+    int32_t result;
+    uint32_t size;
+    uint32_t isAshmem;
+};
+
+static_assert(sizeof(IpcDCStreamInfoRecord) == 32, "IpcDCStreamInfoRecord layout changed");
+static_assert(sizeof(IpcDCCaptureInfoRecord) == 32, "IpcDCCaptureInfoRecord layout changed");
+static_assert(sizeof(IpcBlobRecord) == 16, "IpcBlobRecord layout changed");
+
 class IpcDataUtils {
 static const uint32_t RATIONAL_TYPE_STEP = 2;
 public:
@@ -74,32 +125,362 @@ public:
 
     static bool EncodeDCameraSettings(const std::shared_ptr<DCameraSettings> &pSettings, MessageParcel &parcel)
     {
-        bool bRet = true;
-        bRet = (bRet && parcel.WriteInt32(pSettings->type_));
-        bRet = (bRet && parcel.WriteString(pSettings->value_));
-        return bRet;
+        std::vector<std::shared_ptr<DCameraSettings>> settings;
+        settings.push_back(pSettings);
+        return EncodeDCameraSettingsList(settings, parcel);
+    }
+
+    static bool DecodeDCameraSettings(MessageParcel &parcel, std::shared_ptr<DCameraSettings> &pSettings)
+    {
+        size_t position = parcel.GetReadPosition();
+        if (!IsLayoutTag(parcel.ReadUint32())) {
+            parcel.RewindRead(position);
+            pSettings->type_ = (DCSettingsType)(parcel.ReadInt32());
+            pSettings->value_ = parcel.ReadString();
+            return true;
+        }
+        parcel.RewindRead(position);
+        std::vector<std::shared_ptr<DCameraSettings>> settings;
+        if (!DecodeDCameraSettingsList(parcel, settings) || settings.size() != 1) {
+            return false;
+        }
+        pSettings = settings[0];
+        return true;
+    }
+
+    static bool EncodeDCameraSettingsList(const std::vector<std::shared_ptr<DCameraSettings>> &settings,
+        MessageParcel &parcel)
+    {
+        std::vector<IpcBlobRecord> records(settings.size());
+        for (size_t i = 0; i < settings.size(); i++) {
+            records[i].type = static_cast<int32_t>(settings[i]->type_);
+            records[i].result = 0;
+            records[i].size = static_cast<uint32_t>(settings[i]->value_.size());
+            records[i].isAshmem = (records[i].size > IPC_DATA_INLINE_MAX_SIZE) ? 1 : 0;
+        }
+        if (!WriteRecords(records, parcel)) {
+            return false;
+        }
+        for (size_t i = 0; i < settings.size(); i++) {
+            if (!WriteBlob(settings[i]->value_, records[i], parcel)) {
+                return false;
+            }
+        }
+        return true;
     }
 
-    static void DecodeDCameraSettings(MessageParcel &parcel, std::shared_ptr<DCameraSettings> &pSettings)
+    static bool DecodeDCameraSettingsList(MessageParcel &parcel,
+        std::vector<std::shared_ptr<DCameraSettings>> &settings)
     {
-        pSettings->type_ = (DCSettingsType)(parcel.ReadInt32());
-        pSettings->value_ = parcel.ReadString();
+        size_t position = parcel.GetReadPosition();
+        if (!IsLayoutTag(parcel.ReadUint32())) {
+            parcel.RewindRead(position);
+            int32_t count = parcel.ReadInt32();
+            if (count < 0 || static_cast<uint32_t>(count) > IPC_DATA_MAX_RECORD_COUNT) {
+                return false;
+            }
+            for (int32_t i = 0; i < count; i++) {
+                std::shared_ptr<DCameraSettings> setting = std::make_shared<DCameraSettings>();
+                setting->type_ = (DCSettingsType)(parcel.ReadInt32());
+                setting->value_ = parcel.ReadString();
+                settings.push_back(setting);
+            }
+            return true;
+        }
+        parcel.RewindRead(position);
+        std::vector<IpcBlobRecord> records;
+        if (!ReadRecords(parcel, records)) {
+            return false;
+        }
+        for (auto &record : records) {
+            std::shared_ptr<DCameraSettings> setting = std::make_shared<DCameraSettings>();
+            setting->type_ = static_cast<DCSettingsType>(record.type);
+            if (!ReadBlob(parcel, record, setting->value_)) {
+                return false;
+            }
+            settings.push_back(setting);
+        }
+        return true;
     }
 
     static bool EncodeDCameraHDFEvent(const std::shared_ptr<DCameraHDFEvent> &pEvent, MessageParcel &parcel)
     {
-        bool bRet = true;
-        bRet = (bRet && parcel.WriteInt32(pEvent->type_));
-        bRet = (bRet && parcel.WriteInt32(pEvent->result_));
-        bRet = (bRet && parcel.WriteString(pEvent->content_));
+        std::vector<IpcBlobRecord> records(1);
+        records[0].type = pEvent->type_;
+        records[0].result = pEvent->result_;
+        records[0].size = static_cast<uint32_t>(pEvent->content_.size());
+        records[0].isAshmem = (records[0].size > IPC_DATA_INLINE_MAX_SIZE) ? 1 : 0;
+        return WriteRecords(records, parcel) && WriteBlob(pEvent->content_, records[0], parcel);
+    }
+
+    static bool DecodeDCameraHDFEvent(MessageParcel &parcel, std::shared_ptr<DCameraHDFEvent> &pEvent)
+    {
+        size_t position = parcel.GetReadPosition();
+        if (!IsLayoutTag(parcel.ReadUint32())) {
+            parcel.RewindRead(position);
+            pEvent->type_ = parcel.ReadInt32();
+            pEvent->result_ = parcel.ReadInt32();
+            pEvent->content_ = parcel.ReadString();
+            return true;
+        }
+        parcel.RewindRead(position);
+        std::vector<IpcBlobRecord> records;
+        if (!ReadRecords(parcel, records) || records.size() != 1) {
+            return false;
+        }
+        pEvent->type_ = records[0].type;
+        pEvent->result_ = records[0].result;
+        return ReadBlob(parcel, records[0], pEvent->content_);
+    }
+
+    static bool EncodeDCStreamInfos(const std::vector<std::shared_ptr<DCStreamInfo>> &streamInfos,
+        MessageParcel &parcel)
+    {
+        std::vector<IpcDCStreamInfoRecord> records(streamInfos.size());
+        for (size_t i = 0; i < streamInfos.size(); i++) {
+            records[i].streamId = streamInfos[i]->streamId_;
+            records[i].width = streamInfos[i]->width_;
+            records[i].height = streamInfos[i]->height_;
+            records[i].stride = streamInfos[i]->stride_;
+            records[i].format = streamInfos[i]->format_;
+            records[i].dataspace = streamInfos[i]->dataspace_;
+            records[i].encodeType = static_cast<int32_t>(streamInfos[i]->encodeType_);
+            records[i].type = static_cast<int32_t>(streamInfos[i]->type_);
+        }
+        return WriteRecords(records, parcel);
+    }
+
+    static bool DecodeDCStreamInfos(MessageParcel &parcel, std::vector<std::shared_ptr<DCStreamInfo>> &streamInfos)
+    {
+        size_t position = parcel.GetReadPosition();
+        if (!IsLayoutTag(parcel.ReadUint32())) {
+            parcel.RewindRead(position);
+            return DecodeLegacyDCStreamInfos(parcel, streamInfos);
+        }
+        parcel.RewindRead(position);
+        std::vector<IpcDCStreamInfoRecord> records;
+        if (!ReadRecords(parcel, records)) {
+            return false;
+        }
+        for (auto &record : records) {
+            std::shared_ptr<DCStreamInfo> streamInfo = std::make_shared<DCStreamInfo>();
+            streamInfo->streamId_ = record.streamId;
+            streamInfo->width_ = record.width;
+            streamInfo->height_ = record.height;
+            streamInfo->stride_ = record.stride;
+            streamInfo->format_ = record.format;
+            streamInfo->dataspace_ = record.dataspace;
+            streamInfo->encodeType_ = static_cast<DCEncodeType>(record.encodeType);
+            streamInfo->type_ = static_cast<DCStreamType>(record.type);
+            streamInfos.push_back(streamInfo);
+        }
+        return true;
+    }
+
+    static bool EncodeDCCaptureInfos(const std::vector<std::shared_ptr<DCCaptureInfo>> &captureInfos,
+        MessageParcel &parcel)
+    {
+        std::vector<IpcDCCaptureInfoRecord> records(captureInfos.size());
+        for (size_t i = 0; i < captureInfos.size(); i++) {
+            records[i].width = captureInfos[i]->width_;
+            records[i].height = captureInfos[i]->height_;
+            records[i].stride = captureInfos[i]->stride_;
+            records[i].format = captureInfos[i]->format_;
+            records[i].dataspace = captureInfos[i]->dataspace_;
+            records[i].isCapture = captureInfos[i]->isCapture_ ? 1 : 0;
+            records[i].encodeType = static_cast<int32_t>(captureInfos[i]->encodeType_);
+            records[i].type = static_cast<int32_t>(captureInfos[i]->type_);
+        }
+        if (!WriteRecords(records, parcel)) {
+            return false;
+        }
+        for (auto &captureInfo : captureInfos) {
+            if (!parcel.WriteInt32Vector(captureInfo->streamIds_) ||
+                !EncodeDCameraSettingsList(captureInfo->captureSettings_, parcel)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool DecodeDCCaptureInfos(MessageParcel &parcel,
+        std::vector<std::shared_ptr<DCCaptureInfo>> &captureInfos)
+    {
+        size_t position = parcel.GetReadPosition();
+        if (!IsLayoutTag(parcel.ReadUint32())) {
+            parcel.RewindRead(position);
+            return DecodeLegacyDCCaptureInfos(parcel, captureInfos);
+        }
+        parcel.RewindRead(position);
+        std::vector<IpcDCCaptureInfoRecord> records;
+        if (!ReadRecords(parcel, records)) {
+            return false;
+        }
+        for (auto &record : records) {
+            std::shared_ptr<DCCaptureInfo> captureInfo = std::make_shared<DCCaptureInfo>();
+            captureInfo->width_ = record.width;
+            captureInfo->height_ = record.height;
+            captureInfo->stride_ = record.stride;
+            captureInfo->format_ = record.format;
+            captureInfo->dataspace_ = record.dataspace;
+            captureInfo->isCapture_ = (record.isCapture != 0);
+            captureInfo->encodeType_ = static_cast<DCEncodeType>(record.encodeType);
+            captureInfo->type_ = static_cast<DCStreamType>(record.type);
+            if (!parcel.ReadInt32Vector(&captureInfo->streamIds_) ||
+                !DecodeDCameraSettingsList(parcel, captureInfo->captureSettings_)) {
+                return false;
+            }
+            captureInfos.push_back(captureInfo);
+        }
+        return true;
+    }
+
+private:
+    static bool IsLayoutTag(uint32_t tag)
+    {
+        return (tag & IPC_DATA_LAYOUT_MAGIC_MASK) == IPC_DATA_LAYOUT_MAGIC;
+    }
+
+    template<typename T>
+    static bool WriteRecords(const std::vector<T> &records, MessageParcel &parcel)
+    {
+        if (records.size() > IPC_DATA_MAX_RECORD_COUNT) {
+            return false;
+        }
+        if (!parcel.WriteUint32(IPC_DATA_LAYOUT_TAG) || !parcel.WriteUint32(static_cast<uint32_t>(records.size()))) {
+            return false;
+        }
+        return records.empty() || parcel.WriteUnpadBuffer(records.data(), records.size() * sizeof(T));
+    }
+
+    template<typename T>
+    static bool ReadRecords(MessageParcel &parcel, std::vector<T> &records)
+    {
+        uint32_t tag = parcel.ReadUint32();
+        if (!IsLayoutTag(tag) || (tag & ~IPC_DATA_LAYOUT_MAGIC_MASK) > IPC_DATA_LAYOUT_VERSION) {
+            return false;
+        }
+        uint32_t count = parcel.ReadUint32();
+        if (count > IPC_DATA_MAX_RECORD_COUNT) {
+            return false;
+        }
+        if (count == 0) {
+            return true;
+        }
+        const T *data = reinterpret_cast<const T *>(parcel.ReadUnpadBuffer(count * sizeof(T)));
+        if (data == nullptr) {
+            return false;
+        }
+        records.assign(data, data + count);
+        return true;
+    }
+
+    static bool WriteBlob(const std::string &value, const IpcBlobRecord &record, MessageParcel &parcel)
+    {
+        if (record.size == 0) {
+            return true;
+        }
+        if (record.isAshmem == 0) {
+            return parcel.WriteUnpadBuffer(value.data(), value.size());
+        }
+        if (record.size > IPC_DATA_MAX_BLOB_SIZE) {
+            return false;
+        }
+        // The parcel keeps its own descriptor of the region, the local mapping is released on return.
+        sptr<Ashmem> ashmem = Ashmem::CreateAshmem("dcamera_ipc_data", static_cast<int32_t>(record.size));
+        if (ashmem == nullptr || !ashmem->MapReadAndWriteAshmem()) {
+            return false;
+        }
+        bool bRet = ashmem->WriteToAshmem(value.data(), static_cast<int32_t>(record.size), 0) &&
+            parcel.WriteAshmem(ashmem);
+        ashmem->UnmapAshmem();
+        ashmem->CloseAshmem();
         return bRet;
     }
 
-    static void DecodeDCameraHDFEvent(MessageParcel &parcel, std::shared_ptr<DCameraHDFEvent> &pEvent)
+    static bool ReadBlob(MessageParcel &parcel, const IpcBlobRecord &record, std::string &value)
+    {
+        value.clear();
+        if (record.size == 0) {
+            return true;
+        }
+        if (record.isAshmem == 0) {
+            const char *data = reinterpret_cast<const char *>(parcel.ReadUnpadBuffer(record.size));
+            if (data == nullptr) {
+                return false;
+            }
+            value.assign(data, record.size);
+            return true;
+        }
+        if (record.size > IPC_DATA_MAX_BLOB_SIZE) {
+            return false;
+        }
+        sptr<Ashmem> ashmem = parcel.ReadAshmem();
+        if (ashmem == nullptr || ashmem->GetAshmemSize() < static_cast<int32_t>(record.size) ||
+            !ashmem->MapReadOnlyAshmem()) {
+            return false;
+        }
+        const char *data = reinterpret_cast<const char *>(ashmem->ReadFromAshmem(static_cast<int32_t>(record.size), 0));
+        if (data != nullptr) {
+            value.assign(data, record.size);
+        }
+        ashmem->UnmapAshmem();
+        ashmem->CloseAshmem();
+        return data != nullptr;
+    }
+
+    static bool DecodeLegacyDCStreamInfos(MessageParcel &parcel,
+        std::vector<std::shared_ptr<DCStreamInfo>> &streamInfos)
     {
-        pEvent->type_ = parcel.ReadInt32();
-        pEvent->result_ = parcel.ReadInt32();
-        pEvent->content_ = parcel.ReadString();
+        int32_t count = parcel.ReadInt32();
+        if (count < 0 || static_cast<uint32_t>(count) > IPC_DATA_MAX_RECORD_COUNT) {
+            return false;
+        }
+        for (int32_t i = 0; i < count; i++) {
+            const DCStreamInfo *pInfo = reinterpret_cast<const DCStreamInfo *>(parcel.ReadBuffer(sizeof(DCStreamInfo)));
+            if (pInfo == nullptr) {
+                return false;
+            }
+            std::shared_ptr<DCStreamInfo> streamInfo = std::make_shared<DCStreamInfo>();
+            streamInfo->streamId_ = pInfo->streamId_;
+            streamInfo->width_ = pInfo->width_;
+            streamInfo->height_ = pInfo->height_;
+            streamInfo->stride_ = pInfo->stride_;
+            streamInfo->format_ = pInfo->format_;
+            streamInfo->dataspace_ = pInfo->dataspace_;
+            streamInfo->encodeType_ = pInfo->encodeType_;
+            streamInfo->type_ = pInfo->type_;
+            streamInfos.push_back(streamInfo);
+        }
+        return true;
+    }
+
+    static bool DecodeLegacyDCCaptureInfos(MessageParcel &parcel,
+        std::vector<std::shared_ptr<DCCaptureInfo>> &captureInfos)
+    {
+        int32_t count = parcel.ReadInt32();
+        if (count < 0 || static_cast<uint32_t>(count) > IPC_DATA_MAX_RECORD_COUNT) {
+            return false;
+        }
+        for (int32_t i = 0; i < count; i++) {
+            std::shared_ptr<DCCaptureInfo> captureInfo = std::make_shared<DCCaptureInfo>();
+            if (!parcel.ReadInt32Vector(&captureInfo->streamIds_)) {
+                return false;
+            }
+            captureInfo->width_ = static_cast<int>(parcel.ReadInt32());
+            captureInfo->height_ = static_cast<int>(parcel.ReadInt32());
+            captureInfo->stride_ = static_cast<int>(parcel.ReadInt32());
+            captureInfo->format_ = static_cast<int>(parcel.ReadInt32());
+            captureInfo->dataspace_ = static_cast<int>(parcel.ReadInt32());
+            captureInfo->isCapture_ = parcel.ReadBool();
+            captureInfo->encodeType_ = static_cast<DCEncodeType>(parcel.ReadInt32());
+            captureInfo->type_ = static_cast<DCStreamType>(parcel.ReadInt32());
+            if (!DecodeDCameraSettingsList(parcel, captureInfo->captureSettings_)) {
+                return false;
+            }
+            captureInfos.push_back(captureInfo);
+        }
+        return true;
     }
 };
 } // namespace DistributedHardware
@@ -58,7 +58,7 @@ void DCameraDeviceCallbackProxy::OnResult(uint64_t timestamp,
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(DCameraDeviceCallbackProxy::GetDescriptor())) {
         DHLOGE("Write token failed.");
@@ -28,7 +28,7 @@ void DStreamOperatorCallbackProxy::OnCaptureStarted(int32_t captureId, const std
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(DStreamOperatorCallbackProxy::GetDescriptor())) {
         DHLOGE("Write token failed.");
@@ -56,7 +56,7 @@ void DStreamOperatorCallbackProxy::OnCaptureEnded(int32_t captureId,
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(DStreamOperatorCallbackProxy::GetDescriptor())) {
         DHLOGE("Write token failed.");
@@ -94,7 +94,7 @@ void DStreamOperatorCallbackProxy::OnCaptureError(int32_t captureId,
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(DStreamOperatorCallbackProxy::GetDescriptor())) {
         DHLOGE("Write token failed.");
@@ -132,7 +132,7 @@ void DStreamOperatorCallbackProxy::OnFrameShutter(int32_t captureId,
 {
     MessageParcel data;
     MessageParcel reply;
-    MessageOption option;
+    MessageOption option(MessageOption::TF_ASYNC);
 
     if (!data.WriteInterfaceToken(DStreamOperatorCallbackProxy::GetDescriptor())) {
         DHLOGE("Write token failed.");
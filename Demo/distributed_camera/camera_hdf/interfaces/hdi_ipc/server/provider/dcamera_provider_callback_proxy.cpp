@@ -86,19 +86,10 @@ DCamRetCode DCameraProviderCallbackProxy::ConfigureStreams(const std::shared_ptr
         return DCamRetCode::INVALID_ARGUMENT;
     }
 
-    size_t size = streamInfos.size();
-    if (!data.WriteInt32(static_cast<int32_t>(size))) {
-        DHLOGE("Write stream info size failed.");
+    if (!IpcDataUtils::EncodeDCStreamInfos(streamInfos, data)) {
+        DHLOGE("Write stream infos failed.");
         return INVALID_ARGUMENT;
     }
-    for (size_t i = 0; i < size; i++) {
-        auto streamInfo = streamInfos.at(i);
-        bool bRet = data.WriteBuffer((void *)streamInfo.get(), sizeof(DCStreamInfo));
-        if (!bRet) {
-            DHLOGE("Write stream info index = %d failed.", i);
-            return INVALID_ARGUMENT;
-        }
-    }
 
     int32_t ret = Remote()->SendRequest(CMD_DISTRIBUTED_CAMERA_PROVIDER_CALLBACK_CONFIGURE_STREAMS,
         data, reply, option);
@@ -158,40 +149,10 @@ DCamRetCode DCameraProviderCallbackProxy::StartCapture(const std::shared_ptr<DHB
         return DCamRetCode::INVALID_ARGUMENT;
     }
 
-    size_t size = captureInfos.size();
-    if (!data.WriteInt32(static_cast<int32_t>(size))) {
-        DHLOGE("Write distributed camera capture info size failed.");
+    if (!IpcDataUtils::EncodeDCCaptureInfos(captureInfos, data)) {
+        DHLOGE("Write distributed camera capture infos failed.");
         return INVALID_ARGUMENT;
     }
-    for (size_t i = 0; i < size; i++) {
-        auto captureInfo = captureInfos.at(i);
-        if (!data.WriteInt32Vector(captureInfo->streamIds_)) {
-            DHLOGE("Write streamIds vector failed.");
-            return INVALID_ARGUMENT;
-        }
-        data.WriteInt32(static_cast<int32_t>(captureInfo->width_));
-        data.WriteInt32(static_cast<int32_t>(captureInfo->height_));
-        data.WriteInt32(static_cast<int32_t>(captureInfo->stride_));
-        data.WriteInt32(static_cast<int32_t>(captureInfo->format_));
-        data.WriteInt32(static_cast<int32_t>(captureInfo->dataspace_));
-        data.WriteBool(static_cast<int32_t>(captureInfo->isCapture_));
-        data.WriteInt32(static_cast<int32_t>(captureInfo->encodeType_));
-        data.WriteInt32(static_cast<int32_t>(captureInfo->type_));
-
-        std::vector<std::shared_ptr<DCameraSettings>> capSettings = captureInfo->captureSettings_;
-        size_t settingsSize = capSettings.size();
-        if (!data.WriteInt32(static_cast<int32_t>(settingsSize))) {
-            DHLOGE("Write distributed camera capture settings size failed.");
-            return INVALID_ARGUMENT;
-        }
-        for (size_t k = 0; k < settingsSize; k++) {
-            bool bRet = IpcDataUtils::EncodeDCameraSettings(capSettings.at(k), data);
-            if (!bRet) {
-                DHLOGE("Write distributed camera capture settings failed.");
-                return INVALID_ARGUMENT;
-            }
-        }
-    }
 
     int32_t ret = Remote()->SendRequest(CMD_DISTRIBUTED_CAMERA_PROVIDER_CALLBACK_START_CAPTURE, data, reply, option);
     if (ret != HDF_SUCCESS) {
@@ -242,18 +203,10 @@ DCamRetCode DCameraProviderCallbackProxy::UpdateSettings(const std::shared_ptr<D
         return DCamRetCode::INVALID_ARGUMENT;
     }
 
-    size_t size = settings.size();
-    if (!data.WriteInt32(static_cast<int32_t>(size))) {
-        DHLOGE("Write distributed camera settings size failed.");
+    if (!IpcDataUtils::EncodeDCameraSettingsList(settings, data)) {
+        DHLOGE("Write distributed camera settings failed.");
         return INVALID_ARGUMENT;
     }
-    for (size_t i = 0; i < size; i++) {
-        bool bRet = IpcDataUtils::EncodeDCameraSettings(settings.at(i), data);
-        if (!bRet) {
-            DHLOGE("Write distributed camera settings index = %d failed.", i);
-            return INVALID_ARGUMENT;
-        }
-    }
 
     int32_t ret = Remote()->SendRequest(CMD_DISTRIBUTED_CAMERA_PROVIDER_CALLBACK_UPDATE_SETTINGS,
         data, reply, option);
@@ -263,5 +216,28 @@ DCamRetCode DCameraProviderCallbackProxy::UpdateSettings(const std::shared_ptr<D
     }
     return static_cast<DCamRetCode>(reply.ReadInt32());
 }
+
+void DCameraProviderCallbackProxy::NotifyBufferAvailable(const std::shared_ptr<DHBase> &dhBase, int streamId)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+
+    if (!data.WriteInterfaceToken(DCameraProviderCallbackProxy::GetDescriptor())) {
+        DHLOGE("Write token failed.");
+        return;
+    }
+
+    if (!data.WriteString(dhBase->deviceId_) || !data.WriteString(dhBase->dhId_) || !data.WriteInt32(streamId)) {
+        DHLOGE("Write distributed camera base info or stream id failed.");
+        return;
+    }
+
+    int32_t ret = Remote()->SendRequest(CMD_DISTRIBUTED_CAMERA_PROVIDER_CALLBACK_NOTIFY_BUFFER_AVAILABLE, data, reply,
+        option);
+    if (ret != HDF_SUCCESS) {
+        DHLOGE("SendRequest failed, error code is %d.", ret);
+    }
+}
 } // namespace DistributedHardware
 } // namespace OHOS
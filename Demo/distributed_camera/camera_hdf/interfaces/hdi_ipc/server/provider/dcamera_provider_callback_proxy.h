@@ -39,6 +39,7 @@ public:
     virtual DCamRetCode StopCapture(const std::shared_ptr<DHBase> &dhBase);
     virtual DCamRetCode UpdateSettings(const std::shared_ptr<DHBase> &dhBase,
                                        const std::vector<std::shared_ptr<DCameraSettings>> &settings);
+    virtual void NotifyBufferAvailable(const std::shared_ptr<DHBase> &dhBase, int streamId);
 
 private:
     static inline BrokerDelegator<DCameraProviderCallbackProxy> delegator_;
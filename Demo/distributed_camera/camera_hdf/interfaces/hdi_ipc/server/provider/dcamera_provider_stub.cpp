@@ -169,8 +169,7 @@ int32_t DCameraProviderStub::DCProviderStubOnSettingsResult(MessageParcel& data,
     std::shared_ptr<DCameraSettings> dCameraSettings = std::make_shared<DCameraSettings>();
     bool flag = data.ReadBool();
     if (flag) {
-        IpcDataUtils::DecodeDCameraSettings(data, dCameraSettings);
-        if (dCameraSettings == nullptr) {
+        if (!IpcDataUtils::DecodeDCameraSettings(data, dCameraSettings)) {
             DHLOGE("Read distributed camera settings failed.");
             return HDF_FAILURE;
         }
@@ -195,8 +194,7 @@ int32_t DCameraProviderStub::DCProviderStubNotify(MessageParcel& data, MessagePa
     std::shared_ptr<DCameraHDFEvent> dCameraEvent = std::make_shared<DCameraHDFEvent>();
     bool flag = data.ReadBool();
     if (flag) {
-        IpcDataUtils::DecodeDCameraHDFEvent(data, dCameraEvent);
-        if (dCameraEvent == nullptr) {
+        if (!IpcDataUtils::DecodeDCameraHDFEvent(data, dCameraEvent)) {
             DHLOGE("Read distributed camera hdf event failed.");
             return HDF_FAILURE;
         }
@@ -209,6 +207,139 @@ int32_t DCameraProviderStub::DCProviderStubNotify(MessageParcel& data, MessagePa
     return HDF_SUCCESS;
 }
 
+int32_t DCameraProviderStub::DCProviderStubRegisterStream(MessageParcel& data, MessageParcel& reply,
+    MessageOption& option)
+{
+    if (data.ReadInterfaceToken() != DCameraProviderStub::GetDescriptor()) {
+        DHLOGE("invalid token.");
+        return HDF_FAILURE;
+    }
+
+    std::shared_ptr<DHBase> dhBase = std::make_shared<DHBase>(data.ReadString(), data.ReadString());
+    int32_t streamId = data.ReadInt32();
+
+    int32_t streamHandle = 0;
+    DCamRetCode ret = dcameraProvider_->RegisterStream(dhBase, streamId, streamHandle);
+    if (!reply.WriteInt32(static_cast<int32_t>(ret))) {
+        DHLOGE("Write retcode failed.");
+        if (ret == DCamRetCode::SUCCESS) {
+            dcameraProvider_->UnregisterStream(streamHandle);
+        }
+        return HDF_FAILURE;
+    }
+    if (ret != DCamRetCode::SUCCESS) {
+        DHLOGE("Register stream %d failed.", streamId);
+        return HDF_SUCCESS;
+    }
+    if (!reply.WriteInt32(streamHandle)) {
+        DHLOGE("Write stream handle failed.");
+        dcameraProvider_->UnregisterStream(streamHandle);
+        return HDF_FAILURE;
+    }
+    return HDF_SUCCESS;
+}
+
+int32_t DCameraProviderStub::DCProviderStubUnregisterStream(MessageParcel& data, MessageParcel& reply,
+    MessageOption& option)
+{
+    if (data.ReadInterfaceToken() != DCameraProviderStub::GetDescriptor()) {
+        DHLOGE("invalid token.");
+        return HDF_FAILURE;
+    }
+
+    int32_t streamHandle = data.ReadInt32();
+    DCamRetCode ret = dcameraProvider_->UnregisterStream(streamHandle);
+    if (!reply.WriteInt32(static_cast<int32_t>(ret))) {
+        DHLOGE("Write retcode failed.");
+        return HDF_FAILURE;
+    }
+    return HDF_SUCCESS;
+}
+
+int32_t DCameraProviderStub::DCProviderStubAcquireBuffers(MessageParcel& data, MessageParcel& reply,
+    MessageOption& option)
+{
+    if (data.ReadInterfaceToken() != DCameraProviderStub::GetDescriptor()) {
+        DHLOGE("invalid token.");
+        return HDF_FAILURE;
+    }
+
+    int32_t streamHandle = data.ReadInt32();
+    uint32_t count = data.ReadUint32();
+
+    std::vector<std::shared_ptr<DCameraBuffer>> buffers;
+    DCamRetCode ret = dcameraProvider_->AcquireBuffers(streamHandle, count, buffers);
+    if (!reply.WriteInt32(static_cast<int32_t>(ret))) {
+        DHLOGE("Write retcode failed.");
+        dcameraProvider_->ReturnBuffers(streamHandle, buffers);
+        return HDF_FAILURE;
+    }
+    if (ret != DCamRetCode::SUCCESS) {
+        DHLOGE("Acquire avaliable buffers failed.");
+        return HDF_SUCCESS;
+    }
+    if (!reply.WriteUint32(static_cast<uint32_t>(buffers.size()))) {
+        DHLOGE("Write buffer count failed.");
+        dcameraProvider_->ReturnBuffers(streamHandle, buffers);
+        return HDF_FAILURE;
+    }
+    for (auto &buffer : buffers) {
+        if (!WriteDCameraBuffer(reply, buffer)) {
+            // the caller never sees any of these buffers, give them all back to the stream
+            dcameraProvider_->ReturnBuffers(streamHandle, buffers);
+            return HDF_ERR_INVALID_PARAM;
+        }
+    }
+    return HDF_SUCCESS;
+}
+
+int32_t DCameraProviderStub::DCProviderStubShutterAndAcquireBuffer(MessageParcel& data, MessageParcel& reply,
+    MessageOption& option)
+{
+    if (data.ReadInterfaceToken() != DCameraProviderStub::GetDescriptor()) {
+        DHLOGE("invalid token.");
+        return HDF_FAILURE;
+    }
+
+    int32_t streamHandle = data.ReadInt32();
+    std::shared_ptr<DCameraBuffer> buffer = std::make_shared<DCameraBuffer>();
+    buffer->index_ = data.ReadInt32();
+    buffer->size_ = data.ReadInt32();
+    buffer->bufferHandle_ = nullptr;
+
+    std::shared_ptr<DCameraBuffer> nextBuffer = nullptr;
+    DCamRetCode ret = dcameraProvider_->ShutterAndAcquireBuffer(streamHandle, buffer, nextBuffer);
+    std::vector<std::shared_ptr<DCameraBuffer>> acquired;
+    if (nextBuffer != nullptr) {
+        acquired.push_back(nextBuffer);
+    }
+    if (!reply.WriteInt32(static_cast<int32_t>(ret)) || !reply.WriteBool(nextBuffer != nullptr)) {
+        DHLOGE("Write retcode failed.");
+        dcameraProvider_->ReturnBuffers(streamHandle, acquired);
+        return HDF_FAILURE;
+    }
+    if (nextBuffer != nullptr && !WriteDCameraBuffer(reply, nextBuffer)) {
+        dcameraProvider_->ReturnBuffers(streamHandle, acquired);
+        return HDF_ERR_INVALID_PARAM;
+    }
+    return HDF_SUCCESS;
+}
+
+bool DCameraProviderStub::WriteDCameraBuffer(MessageParcel& reply, const std::shared_ptr<DCameraBuffer>& buffer)
+{
+    if (!reply.WriteInt32(buffer->index_) || !reply.WriteInt32(buffer->size_)) {
+        DHLOGE("write buffer index and size parameter failed.");
+        return false;
+    }
+
+    BufferHandle* bufferHandle = buffer->bufferHandle_;
+    if (bufferHandle == nullptr || !WriteBufferHandle(reply, *bufferHandle)) {
+        DHLOGE("Write buffer handle failed.");
+        return false;
+    }
+    return true;
+}
+
 int32_t DCameraProviderStub::OnRemoteRequest(uint32_t code, MessageParcel& data, MessageParcel& reply,
     MessageOption& option)
 {
@@ -238,6 +369,22 @@ int32_t DCameraProviderStub::OnRemoteRequest(uint32_t code, MessageParcel& data,
             ret = DCProviderStubNotify(data, reply, option);
             break;
         }
+        case CMD_DISTRIBUTED_CAMERA_PROVIDER_REGISTER_STREAM: {
+            ret = DCProviderStubRegisterStream(data, reply, option);
+            break;
+        }
+        case CMD_DISTRIBUTED_CAMERA_PROVIDER_UNREGISTER_STREAM: {
+            ret = DCProviderStubUnregisterStream(data, reply, option);
+            break;
+        }
+        case CMD_DISTRIBUTED_CAMERA_PROVIDER_ACQUIRE_BUFFERS: {
+            ret = DCProviderStubAcquireBuffers(data, reply, option);
+            break;
+        }
+        case CMD_DISTRIBUTED_CAMERA_PROVIDER_SHUTTER_AND_ACQUIRE_BUFFER: {
+            ret = DCProviderStubShutterAndAcquireBuffer(data, reply, option);
+            break;
+        }
         default: {
             DHLOGE("Unknown remote request code=%d.", code);
         }
@@ -39,6 +39,12 @@ private:
     int32_t DCProviderStubShutterBuffer(MessageParcel& data, MessageParcel& reply, MessageOption& option);
     int32_t DCProviderStubOnSettingsResult(MessageParcel& data, MessageParcel& reply, MessageOption& option);
     int32_t DCProviderStubNotify(MessageParcel& data, MessageParcel& reply, MessageOption& option);
+    int32_t DCProviderStubRegisterStream(MessageParcel& data, MessageParcel& reply, MessageOption& option);
+    int32_t DCProviderStubUnregisterStream(MessageParcel& data, MessageParcel& reply, MessageOption& option);
+    int32_t DCProviderStubAcquireBuffers(MessageParcel& data, MessageParcel& reply, MessageOption& option);
+    int32_t DCProviderStubShutterAndAcquireBuffer(MessageParcel& data, MessageParcel& reply,
+                                                  MessageOption& option);
+    bool WriteDCameraBuffer(MessageParcel& reply, const std::shared_ptr<DCameraBuffer>& buffer);
     static inline const std::u16string metaDescriptor_ = u"HDI.DCamera.V1_0.Provider";
     static inline const std::u16string &GetDescriptor()
     {
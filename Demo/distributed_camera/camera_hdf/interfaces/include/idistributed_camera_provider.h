@@ -37,6 +37,10 @@ enum {
     CMD_DISTRIBUTED_CAMERA_PROVIDER_SHUTTER_BUFFER,
     CMD_DISTRIBUTED_CAMERA_PROVIDER_ON_SETTINGS_RESULT,
     CMD_DISTRIBUTED_CAMERA_PROVIDER_NOTIFY,
+    CMD_DISTRIBUTED_CAMERA_PROVIDER_REGISTER_STREAM,
+    CMD_DISTRIBUTED_CAMERA_PROVIDER_UNREGISTER_STREAM,
+    CMD_DISTRIBUTED_CAMERA_PROVIDER_ACQUIRE_BUFFERS,
+    CMD_DISTRIBUTED_CAMERA_PROVIDER_SHUTTER_AND_ACQUIRE_BUFFER,
 };
 
 class IDCameraProvider : public IRemoteBroker {
@@ -126,6 +130,74 @@ public:
     virtual DCamRetCode ShutterBuffer(const std::shared_ptr<DHBase> &dhBase, int streamId,
         const std::shared_ptr<DCameraBuffer> &buffer) = 0;
 
+    /**
+     * @brief Register a stream for frame delivery and obtain a compact handle for it.
+     * The handle replaces the device base info and stream ID in the per frame calls.
+     *
+     * @param dhBase [in] Distributed hardware device base info
+     *
+     * @param streamId [in] Indicates the ID of the stream to be registered.
+     *
+     * @param streamHandle [out] Handle of the registered stream
+     *
+     * @return Returns <b>NO_ERROR</b> if the operation is successful,
+     * returns an error code defined in {@link DCamRetCode} otherwise.
+     *
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual DCamRetCode RegisterStream(const std::shared_ptr<DHBase> &dhBase, int streamId,
+        int32_t &streamHandle) = 0;
+
+    /**
+     * @brief Unregister a stream handle obtained by {@link RegisterStream}.
+     *
+     * @param streamHandle [in] Handle of the registered stream
+     *
+     * @return Returns <b>NO_ERROR</b> if the operation is successful,
+     * returns an error code defined in {@link DCamRetCode} otherwise.
+     *
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual DCamRetCode UnregisterStream(int32_t streamHandle) = 0;
+
+    /**
+     * @brief Acquire up to count frame buffers of a registered stream in one call.
+     *
+     * @param streamHandle [in] Handle of the registered stream
+     *
+     * @param count [in] Maximum number of buffers to acquire
+     *
+     * @param buffers [out] The acquired frame buffers, at least one on success
+     *
+     * @return Returns <b>NO_ERROR</b> if the operation is successful,
+     * returns an error code defined in {@link DCamRetCode} otherwise.
+     *
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual DCamRetCode AcquireBuffers(int32_t streamHandle, uint32_t count,
+        std::vector<std::shared_ptr<DCameraBuffer>> &buffers) = 0;
+
+    /**
+     * @brief Submit a filled frame buffer of a registered stream and acquire the next one in one call.
+     *
+     * @param streamHandle [in] Handle of the registered stream
+     *
+     * @param buffer [in] The filled frame buffer
+     *
+     * @param nextBuffer [out] The next frame buffer, null if none is available yet
+     *
+     * @return Returns <b>NO_ERROR</b> if the filled buffer is submitted successfully,
+     * returns an error code defined in {@link DCamRetCode} otherwise.
+     *
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual DCamRetCode ShutterAndAcquireBuffer(int32_t streamHandle, const std::shared_ptr<DCameraBuffer> &buffer,
+        std::shared_ptr<DCameraBuffer> &nextBuffer) = 0;
+
     /**
      * @brief Called to report metadata related to the distributed camera device.
      *
@@ -39,6 +39,7 @@ enum {
     CMD_DISTRIBUTED_CAMERA_PROVIDER_CALLBACK_START_CAPTURE,
     CMD_DISTRIBUTED_CAMERA_PROVIDER_CALLBACK_STOP_CAPTURE,
     CMD_DISTRIBUTED_CAMERA_PROVIDER_CALLBACK_UPDATE_SETTINGS,
+    CMD_DISTRIBUTED_CAMERA_PROVIDER_CALLBACK_NOTIFY_BUFFER_AVAILABLE,
 };
 
 class IDCameraProviderCallback : public IRemoteBroker {
@@ -154,6 +155,19 @@ public:
      */
     virtual DCamRetCode UpdateSettings(const std::shared_ptr<DHBase> &dhBase,
         const std::vector<std::shared_ptr<DCameraSettings>> &settings) = 0;
+
+    /**
+     * @brief Notify that a frame buffer of the stream became available after an acquire found none.
+     * Sent once per failed acquire, the source retries the acquire instead of polling for the buffer.
+     *
+     * @param dhBase [in] Distributed hardware device base info
+     *
+     * @param streamId [in] Indicates the ID of the stream whose buffer is available.
+     *
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual void NotifyBufferAvailable(const std::shared_ptr<DHBase> &dhBase, int streamId) = 0;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
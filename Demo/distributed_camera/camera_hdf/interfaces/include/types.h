@@ -58,7 +58,23 @@ using DCSettingsType = enum _DCSettingsType : int32_t {
     /**
      * Set fps range.
      */
-    FPS_RANGE = 5
+    FPS_RANGE = 5,
+    /**
+     * Send the embedded thumbnail of a snapshot ahead of the full picture.
+     */
+    SNAPSHOT_THUMBNAIL = 6,
+    /**
+     * Capture a burst of snapshots back to back, the value is the requested depth.
+     */
+    SNAPSHOT_BURST = 7,
+    /**
+     * Ask the sink to send fewer frames while the source frame path is over its memory budget, value is 1 or 0.
+     */
+    FLOW_CONTROL = 8,
+    /**
+     * Step the sink frame rate and encoder quality down or back up, the value is the degradation level.
+     */
+    DEGRADE_LEVEL = 9
 };
 
 /**
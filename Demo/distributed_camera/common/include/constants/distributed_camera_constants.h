@@ -68,15 +68,58 @@ typedef enum {
     OHOS_CAMERA_FORMAT_JPEG,
 } DCameraFormat;
 
+typedef enum {
+    DCAMERA_FRAME_TYPE_FULL = 0,
+    DCAMERA_FRAME_TYPE_THUMBNAIL = 1,
+} DCameraFrameType;
+
 const uint32_t DCAMERA_MAX_NUM = 1;
+const uint32_t DCAMERA_SOURCE_DEV_MAX_NUM = 8;
+const uint32_t DCAMERA_FEED_BATCH_MAX_NUM = 8;
+const uint32_t DCAMERA_EXECUTOR_FRAME_THREAD_NUM = 2;
+const uint32_t DCAMERA_EXECUTOR_CONTROL_THREAD_NUM = 1;
+const uint32_t DCAMERA_EXECUTOR_BACKGROUND_THREAD_NUM = 1;
+const uint32_t DCAMERA_EXECUTOR_TIER_MAX_THREAD_NUM = 8;
+const uint32_t DCAMERA_EXECUTOR_IDLE_TIMEOUT_MS = 1000;
+const uint32_t DCAMERA_PENDING_FRAME_MAX_NUM = 8;
+const uint32_t DCAMERA_STANDBY_IDLE_TIMEOUT_MS = 30000;
+const uint32_t DCAMERA_STANDBY_BUFFER_NUM = 6;
+const uint64_t DCAMERA_STANDBY_MEMORY_MAX = 64ULL * 1024ULL * 1024ULL;
+const uint32_t DCAMERA_SESSION_POOL_IDLE_TIMEOUT_MS = 10000;
+const uint32_t DCAMERA_SESSION_REUSE_ACK_TIMEOUT_MS = 500;
+const uint32_t DCAMERA_SESSION_POOL_MAX_NUM = 8;
+const uint64_t DCAMERA_THUMBNAIL_MAX_PIXELS = 640ULL * 480ULL;
+const uint32_t DCAMERA_BURST_MAX_DEPTH = 16;
+const uint64_t DCAMERA_BURST_MEMORY_MAX = 96ULL * 1024ULL * 1024ULL;
+const uint64_t DCAMERA_MEMORY_BUDGET_DEFAULT = 128ULL * 1024ULL * 1024ULL;
+const uint64_t DCAMERA_MEMORY_THROTTLE_PERCENT = 75;
+const uint64_t DCAMERA_MEMORY_RESUME_PERCENT = 50;
+const uint32_t DCAMERA_FLOW_CONTROL_KEEP_INTERVAL = 2;
+const uint32_t DCAMERA_DEGRADE_PERCENT_FULL = 100;
+const int64_t DCAMERA_DEGRADE_WINDOW_US = 1000000;
+const int64_t DCAMERA_DEGRADE_LATENCY_HIGH_US = 100000;
+const int64_t DCAMERA_DEGRADE_LATENCY_LOW_US = 40000;
+const uint32_t DCAMERA_DEGRADE_QUEUE_HIGH_PERCENT = 50;
+const uint32_t DCAMERA_DEGRADE_QUEUE_LOW_PERCENT = 20;
+const uint32_t DCAMERA_DEGRADE_CPU_HIGH_PERCENT = 85;
+const uint32_t DCAMERA_DEGRADE_CPU_LOW_PERCENT = 60;
+const uint32_t DCAMERA_DEGRADE_STEP_DOWN_WINDOWS = 2;
+const uint32_t DCAMERA_DEGRADE_STEP_UP_WINDOWS = 5;
+const int32_t DCAMERA_THREAD_NICE_FRAME = -10;
+const int32_t DCAMERA_THREAD_NICE_CONTROL = 0;
+const int32_t DCAMERA_THREAD_NICE_BACKGROUND = 10;
 const uint32_t DCAMERA_PRODUCER_ONE_MINUTE_MS = 1000;
 const uint32_t DCAMERA_PRODUCER_FPS_DEFAULT = 30;
+const uint32_t DCAMERA_PRODUCER_FPS_MIN = 15;
+const uint32_t DCAMERA_PRODUCER_FPS_MAX = 60;
+const uint64_t DCAMERA_MAX_PIXEL_RATE = 3840ULL * 2160ULL * 30ULL;
 const uint32_t DCAMERA_MAX_RECV_DATA_LEN = 104857600;
 const uint32_t DISTRIBUTED_HARDWARE_CAMERA_SOURCE_SA_ID = 4803;
 const uint32_t DISTRIBUTED_HARDWARE_CAMERA_SINK_SA_ID = 4804;
 const std::string DCAMERA_PKG_NAME = "ohos.dhardware";
 const std::string SNAP_SHOT_SESSION_FLAG = "dataSnapshot";
 const std::string CONTINUE_SESSION_FLAG = "dataContinue";
+const std::string DCAMERA_THREAD_POLICY_CONFIG_PATH = "/system/etc/distributedhardware/dcamera_thread_policy.json";
 
 const std::string DISTRIBUTED_HARDWARE_ID_KEY = "dhID";
 const std::string CAMERA_ID_PREFIX = "Camera_";
@@ -93,12 +136,14 @@ const std::string CAMERA_FORMAT_PREVIEW = "Preview";
 const std::string CAMERA_FORMAT_VIDEO = "Video";
 const std::string CAMERA_FORMAT_PHOTO = "Photo";
 const std::string CAMERA_RESOLUTION_KEY = "Resolution";
+const std::string CAMERA_MAX_FPS_KEY = "MaxFps";
 const std::string CAMERA_SURFACE_FORMAT = "CAMERA_SURFACE_FORMAT";
+const std::string CAMERA_WARM_STANDBY_KEY = "WarmStandby";
 
 const int32_t RESOLUTION_MAX_WIDTH_SNAPSHOT = 4096;
 const int32_t RESOLUTION_MAX_HEIGHT_SNAPSHOT = 3072;
-const int32_t RESOLUTION_MAX_WIDTH_CONTINUOUS = 1920;
-const int32_t RESOLUTION_MAX_HEIGHT_CONTINUOUS = 1080;
+const int32_t RESOLUTION_MAX_WIDTH_CONTINUOUS = 3840;
+const int32_t RESOLUTION_MAX_HEIGHT_CONTINUOUS = 2160;
 const int32_t RESOLUTION_MIN_WIDTH = 320;
 const int32_t RESOLUTION_MIN_HEIGHT = 240;
 
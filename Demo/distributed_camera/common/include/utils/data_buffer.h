@@ -16,6 +16,7 @@
 #ifndef OHOS_DATA_BUFFER_H
 #define OHOS_DATA_BUFFER_H
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -24,9 +25,13 @@ using std::map;
 
 namespace OHOS {
 namespace DistributedHardware {
+using DataBufferReleaser = std::function<void()>;
+
 class DataBuffer {
 public:
     DataBuffer(size_t capacity);
+    // Wraps memory owned elsewhere without copying it; the releaser runs once the last reference is gone.
+    DataBuffer(uint8_t *data, size_t capacity, const DataBufferReleaser& releaser);
 
     size_t Size() const;
     size_t Offset() const;
@@ -48,6 +53,8 @@ private:
     size_t rangeOffset_ = 0;
     size_t rangeLength_ = 0;
     uint8_t *data_ = nullptr;
+    DataBufferReleaser releaser_ = nullptr;
+    bool isOwner_ = true;
 
     map<string, int32_t> int32Map_;
     map<string, int64_t> int64Map_;
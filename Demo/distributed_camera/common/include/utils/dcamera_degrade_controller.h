@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_DEGRADE_CONTROLLER_H
+#define OHOS_DCAMERA_DEGRADE_CONTROLLER_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+typedef enum {
+    DCAMERA_DEGRADE_STAGE_DECODE = 0,
+    DCAMERA_DEGRADE_STAGE_DELIVER = 1,
+    DCAMERA_DEGRADE_STAGE_BUTT = 2,
+} DCameraDegradeStage;
+
+// One rung of the degradation ladder, frame rate gives way first and encoder quality after it.
+struct DCameraDegradeStep {
+    uint32_t fpsPercent;
+    uint32_t bitratePercent;
+};
+
+struct DCameraPressureSample {
+    int64_t latencyUs[DCAMERA_DEGRADE_STAGE_BUTT] = { 0 };
+    uint32_t queuePercent = 0;
+    uint32_t cpuPercent = 0;
+};
+
+// Called outside the controller lock with the level the camera has just moved to.
+using DCameraDegradeListener = std::function<void(int32_t level)>;
+
+/*
+ * Watches per camera how long frames spend in each source stage, how full the frame path is against its
+ * memory budget and how busy its busiest frame thread is, and walks the camera up and down the degradation ladder.
+ * A step down needs several overloaded windows in a row and a step up needs a longer run of idle ones,
+ * so a single slow frame or a short spike never makes the level flap.
+ */
+class DCameraDegradeController {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraDegradeController);
+
+public:
+    void AddCamera(const std::string& key, const DCameraDegradeListener& listener);
+    void RemoveCamera(const std::string& key);
+    void OnStageLatency(const std::string& key, DCameraDegradeStage stage, int64_t latencyUs);
+    int32_t Evaluate(const std::string& key, const DCameraPressureSample& sample);
+    int32_t GetLevel(const std::string& key);
+
+    static int32_t GetMaxLevel();
+    static DCameraDegradeStep GetStep(int32_t level);
+    static bool ParseLevel(const std::string& value, int32_t& level);
+
+private:
+    DCameraDegradeController() = default;
+    ~DCameraDegradeController() = default;
+
+    struct CameraState {
+        DCameraDegradeListener listener;
+        int32_t level = 0;
+        uint32_t overloadTimes = 0;
+        uint32_t idleTimes = 0;
+        uint32_t transitions = 0;
+        int64_t windowStartUs = 0;
+        std::map<pid_t, int64_t> windowThreadCpuUs;
+        int64_t latencySumUs[DCAMERA_DEGRADE_STAGE_BUTT] = { 0 };
+        uint32_t latencyCount[DCAMERA_DEGRADE_STAGE_BUTT] = { 0 };
+    };
+
+    bool IsOverloaded(const DCameraPressureSample& sample);
+    bool IsIdle(const DCameraPressureSample& sample);
+    void CloseWindowLocked(CameraState& state, int64_t nowUs, DCameraPressureSample& sample);
+    uint32_t GetQueuePercent(const std::string& key);
+    void DumpEvent(const std::string& key, int32_t fromLevel, int32_t toLevel, const DCameraPressureSample& sample);
+
+    std::mutex stateLock_;
+    std::map<std::string, CameraState> states_;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_DEGRADE_CONTROLLER_H
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_EXECUTOR_H
+#define OHOS_DCAMERA_EXECUTOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+// Each tier has its own workers, so frame work never waits behind control or background work.
+typedef enum {
+    DCAMERA_TASK_TIER_FRAME = 0,
+    DCAMERA_TASK_TIER_CONTROL = 1,
+    DCAMERA_TASK_TIER_BACKGROUND = 2,
+    DCAMERA_TASK_TIER_BUTT = 3,
+} DCameraTaskTier;
+
+using DCameraTask = std::function<void()>;
+
+struct DCameraTierStats {
+    uint32_t threadCount = 0;
+    uint32_t maxThreadCount = 0;
+    uint32_t backlog = 0;
+    uint32_t maxBacklog = 0;
+    uint64_t postedCount = 0;
+    uint64_t executedCount = 0;
+    uint64_t maxWaitUs = 0;
+};
+
+// Runs posted tasks one at a time and in order on the workers of its tier, without owning a thread. Each open
+// queue raises the worker limit of its tier by one, up to DCAMERA_EXECUTOR_TIER_MAX_THREAD_NUM, so a queue
+// blocked in a long call never holds up another one.
+class DCameraSerialQueue : public std::enable_shared_from_this<DCameraSerialQueue> {
+public:
+    DCameraSerialQueue(const std::string& name, DCameraTaskTier tier);
+    ~DCameraSerialQueue();
+
+    bool PostTask(const DCameraTask& task);
+    void Close();
+    const std::string& GetName() const;
+    DCameraTaskTier GetTier() const;
+
+private:
+    bool Schedule();
+    void RunNext();
+
+    std::string name_;
+    DCameraTaskTier tier_;
+    std::mutex queueLock_;
+    std::condition_variable idleCond_;
+    std::deque<DCameraTask> tasks_;
+    std::thread::id runningThread_;
+    bool isScheduled_ = false;
+    bool isRunning_ = false;
+    bool isClosed_ = false;
+};
+
+class DCameraExecutor {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraExecutor);
+
+public:
+    bool PostTask(DCameraTaskTier tier, const DCameraTask& task);
+    std::shared_ptr<DCameraSerialQueue> CreateSerialQueue(const std::string& name, DCameraTaskTier tier);
+    int32_t GetTierStats(DCameraTaskTier tier, DCameraTierStats& stats);
+    uint32_t GetThreadCount();
+    void DumpStats();
+
+private:
+    friend class DCameraSerialQueue;
+
+    DCameraExecutor();
+    ~DCameraExecutor() = default;
+    void AddQueue(DCameraTaskTier tier);
+    void RemoveQueue(DCameraTaskTier tier);
+    void UpdateThreadLimitLocked(DCameraTaskTier tier);
+
+    struct PendingTask {
+        DCameraTask task;
+        std::chrono::steady_clock::time_point postTime;
+    };
+
+    struct WorkerPool {
+        std::mutex poolLock;
+        std::condition_variable taskCond;
+        std::deque<PendingTask> tasks;
+        // a retired worker leaves its slot detached, the next worker started takes it over
+        std::vector<std::thread> workers;
+        uint32_t workerCount = 0;
+        uint32_t idleCount = 0;
+        uint32_t queueCount = 0;
+        DCameraTierStats stats;
+    };
+
+    void StartWorkerLocked(DCameraTaskTier tier);
+    void WorkerLoop(DCameraTaskTier tier, uint32_t index);
+
+    WorkerPool pools_[DCAMERA_TASK_TIER_BUTT];
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_EXECUTOR_H
@@ -15,6 +15,8 @@
 #ifndef OHOS_DCAMERA_INDEX_H
 #define OHOS_DCAMERA_INDEX_H
 
+#include <cstdint>
+#include <functional>
 #include <string>
 
 namespace OHOS {
@@ -32,12 +34,26 @@ public:
 
     bool operator < (const DCameraIndex& index) const
     {
-        return (this->devId_ + this->dhId_) < (index.devId_ + index.dhId_);
+        int32_t ret = this->devId_.compare(index.devId_);
+        return (ret != 0) ? (ret < 0) : (this->dhId_ < index.dhId_);
     }
 
     std::string devId_;
     std::string dhId_;
 };
+
+struct DCameraIndexHash {
+    size_t operator()(const DCameraIndex& index) const
+    {
+        size_t devHash = std::hash<std::string>()(index.devId_);
+        size_t dhHash = std::hash<std::string>()(index.dhId_);
+        return devHash ^ (dhHash + HASH_SEED + (devHash << HASH_LEFT_SHIFT) + (devHash >> HASH_RIGHT_SHIFT));
+    }
+
+    static constexpr size_t HASH_SEED = 0x9e3779b9;
+    static constexpr uint32_t HASH_LEFT_SHIFT = 6;
+    static constexpr uint32_t HASH_RIGHT_SHIFT = 2;
+};
 } // namespace DistributedHardware
 } // namespace OHOS
 #endif // OHOS_DCAMERA_INDEX_H
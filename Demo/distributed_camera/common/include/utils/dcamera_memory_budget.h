@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_MEMORY_BUDGET_H
+#define OHOS_DCAMERA_MEMORY_BUDGET_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+typedef enum {
+    DCAMERA_MEMORY_STAGE_ASSEMBLE = 0,
+    DCAMERA_MEMORY_STAGE_DECODE = 1,
+    DCAMERA_MEMORY_STAGE_PRODUCER = 2,
+    DCAMERA_MEMORY_STAGE_BUTT = 3,
+} DCameraMemoryStage;
+
+struct DCameraMemoryReport {
+    uint64_t budgetBytes = 0;
+    uint64_t inFlightBytes = 0;
+    uint64_t highWaterBytes = 0;
+    uint64_t stageBytes[DCAMERA_MEMORY_STAGE_BUTT] = { 0 };
+    uint64_t stageHighWaterBytes[DCAMERA_MEMORY_STAGE_BUTT] = { 0 };
+    uint64_t droppedFrames = 0;
+    bool isThrottled = false;
+};
+
+// Called outside the budget lock, one call at a time, when a camera crosses the throttle or the resume mark.
+using DCameraBackpressureListener = std::function<void(bool isThrottled)>;
+
+/*
+ * Bytes held per camera by every stage of the source frame path, checked against one budget.
+ * A stage at the head of the path asks with Acquire and drops the frame when it is refused,
+ * a stage that already holds the data accounts it with Charge. Crossing the throttle mark
+ * asks the sink to slow down, the listener is told again once usage falls to the resume mark.
+ */
+class DCameraMemoryBudget {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraMemoryBudget);
+
+public:
+    void AddCamera(const std::string& key, uint64_t budgetBytes, const DCameraBackpressureListener& listener);
+    void RemoveCamera(const std::string& key);
+    bool Acquire(const std::string& key, DCameraMemoryStage stage, uint64_t bytes);
+    void Charge(const std::string& key, DCameraMemoryStage stage, uint64_t bytes);
+    void Release(const std::string& key, DCameraMemoryStage stage, uint64_t bytes);
+    void OnFrameDropped(const std::string& key);
+    int32_t GetReport(const std::string& key, DCameraMemoryReport& report);
+
+private:
+    DCameraMemoryBudget() = default;
+    ~DCameraMemoryBudget() = default;
+
+    struct CameraBudget {
+        DCameraMemoryReport report;
+        DCameraBackpressureListener listener;
+        bool isNotifiedThrottled = false;
+    };
+
+    // Returns true when the throttle state changed, the new state is in report.isThrottled.
+    bool ChargeLocked(CameraBudget& budget, DCameraMemoryStage stage, uint64_t bytes);
+    void Notify(const std::string& key);
+    void DumpReport(const std::string& key, const DCameraMemoryReport& report);
+
+    std::mutex budgetLock_;
+    std::mutex notifyLock_;
+    std::map<std::string, CameraBudget> budgets_;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_MEMORY_BUDGET_H
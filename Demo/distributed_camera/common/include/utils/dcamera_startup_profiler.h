@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_STARTUP_PROFILER_H
+#define OHOS_DCAMERA_STARTUP_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+typedef enum {
+    DCAMERA_STARTUP_PHASE_OPEN_CHANNEL = 0,
+    DCAMERA_STARTUP_PHASE_CONFIG_STREAMS = 1,
+    DCAMERA_STARTUP_PHASE_CHANNEL_NEG = 2,
+    DCAMERA_STARTUP_PHASE_OPEN_DATA_CHANNEL = 3,
+    DCAMERA_STARTUP_PHASE_CAPTURE_REQUEST = 4,
+    DCAMERA_STARTUP_PHASE_CREATE_CODEC = 5,
+    DCAMERA_STARTUP_PHASE_CAMERA_SESSION = 6,
+    DCAMERA_STARTUP_PHASE_START_CAMERA = 7,
+    DCAMERA_STARTUP_PHASE_FIRST_PACKET = 8,
+    DCAMERA_STARTUP_PHASE_BUTT = 9,
+} DCameraStartupPhase;
+
+// Offsets in microseconds from the start of the camera open, -1 when the phase was not seen.
+struct DCameraPhaseSpan {
+    int64_t beginUs = -1;
+    int64_t endUs = -1;
+};
+
+struct DCameraStartupReport {
+    bool isFinished = false;
+    int64_t firstFrameUs = -1;
+    DCameraPhaseSpan phases[DCAMERA_STARTUP_PHASE_BUTT];
+};
+
+class DCameraStartupProfiler {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraStartupProfiler);
+
+public:
+    void Start(const std::string& key);
+    void BeginPhase(const std::string& key, DCameraStartupPhase phase);
+    void EndPhase(const std::string& key, DCameraStartupPhase phase);
+    void MarkPhase(const std::string& key, DCameraStartupPhase phase);
+    void OnFirstFrame(const std::string& key);
+    int32_t GetReport(const std::string& key, DCameraStartupReport& report);
+    void Remove(const std::string& key);
+
+private:
+    DCameraStartupProfiler() = default;
+    ~DCameraStartupProfiler() = default;
+
+    struct StartupRecord {
+        std::chrono::steady_clock::time_point startTime;
+        DCameraStartupReport report;
+    };
+
+    int64_t ElapsedUs(const StartupRecord& record);
+    void DumpReport(const std::string& key, const DCameraStartupReport& report);
+
+    std::mutex recordLock_;
+    std::map<std::string, StartupRecord> records_;
+};
+
+class DCameraStartupPhaseScope {
+public:
+    DCameraStartupPhaseScope(const std::string& key, DCameraStartupPhase phase) : key_(key), phase_(phase)
+    {
+        DCameraStartupProfiler::GetInstance().BeginPhase(key_, phase_);
+    }
+
+    ~DCameraStartupPhaseScope()
+    {
+        DCameraStartupProfiler::GetInstance().EndPhase(key_, phase_);
+    }
+
+private:
+    std::string key_;
+    DCameraStartupPhase phase_;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_STARTUP_PROFILER_H
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_THREAD_POLICY_H
+#define OHOS_DCAMERA_THREAD_POLICY_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+#include "dcamera_executor.h"
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+struct DCameraThreadInfo {
+    std::string name;
+    DCameraTaskTier tier = DCAMERA_TASK_TIER_CONTROL;
+    int32_t nice = 0;
+    std::string cpus;
+    bool isApplied = false;
+};
+
+/*
+ * Scheduling policy of the service threads. A thread names itself and states its tier once it runs, the tier
+ * picks its nice value and, when the config file gives one, the CPUs it is pinned to. CPUs configured for a
+ * thread name prefix win over those of the tier. Only threads the service creates apply it: a thread without a
+ * name of its own, such as a codec or IPC callback thread, is left untouched.
+ *
+ * {
+ *     "tiers": { "frame": { "nice": -10, "cpus": [4, 5, 6, 7] }, "background": { "nice": 10, "cpus": [0, 1] } },
+ *     "threads": { "DCamProducer": [6, 7] }
+ * }
+ */
+class DCameraThreadPolicy {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraThreadPolicy);
+
+public:
+    int32_t LoadConfig(const std::string& path);
+    int32_t ParseConfig(const std::string& jsonStr);
+    // Cheap once the calling thread is up to date, so event handlers may call it for every event.
+    void ApplyCurrentThread(const std::string& name, DCameraTaskTier tier);
+    int32_t GetThreadInfo(pid_t tid, DCameraThreadInfo& info);
+    std::vector<pid_t> GetTierThreads(DCameraTaskTier tier);
+    void DumpThreads();
+
+private:
+    DCameraThreadPolicy();
+    ~DCameraThreadPolicy() = default;
+
+    struct TierPolicy {
+        int32_t nice = 0;
+        std::vector<uint32_t> cpus;
+    };
+
+    std::vector<uint32_t> GetCpusLocked(const std::string& name, DCameraTaskTier tier);
+    void PruneThreadsLocked();
+
+    std::mutex policyLock_;
+    std::atomic<uint32_t> generation_ = 1;
+    TierPolicy tierPolicies_[DCAMERA_TASK_TIER_BUTT];
+    std::map<std::string, std::vector<uint32_t>> threadCpus_;
+    std::map<pid_t, DCameraThreadInfo> threads_;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_THREAD_POLICY_H
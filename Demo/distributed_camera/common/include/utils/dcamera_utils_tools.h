@@ -22,6 +22,10 @@
 
 namespace OHOS {
 namespace DistributedHardware {
+const std::string FPS_RANGE_SEPARATOR = ",";
+const std::string RESULT_METADATA_SEPARATOR = ",";
+const std::string RESULT_METADATA_SNAPSHOT = "F";
+const std::string RESULT_METADATA_DELTA = "D";
 const std::string BASE_64_CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
 int32_t GetLocalDeviceNetworkId(std::string& networkId);
@@ -30,6 +34,16 @@ int64_t GetNowTimeStampUs();
 std::string Base64Encode(const unsigned char *toEncode, unsigned int len);
 std::string Base64Decode(const std::string& basicString);
 bool IsBase64(unsigned char c);
+uint32_t GetMaxFrameRate(int32_t width, int32_t height, uint32_t maxFps);
+std::string FpsRangeToString(uint32_t minFps, uint32_t maxFps);
+bool ParseFpsRange(const std::string& fpsRange, uint32_t& minFps, uint32_t& maxFps);
+std::string PackResultMetadata(uint32_t generation, bool isSnapshot, const std::string& metadata);
+bool UnpackResultMetadata(const std::string& value, uint32_t& generation, bool& isSnapshot, std::string& metadata);
+size_t GetJpegSize(const uint8_t *data, size_t size);
+bool GetJpegThumbnail(const uint8_t *data, size_t size, size_t& offset, size_t& length);
+bool IsThumbnailSize(int32_t width, int32_t height);
+uint32_t GetBurstDepth(int32_t width, int32_t height, uint32_t depth);
+bool ParseBurstDepth(const std::string& value, uint32_t& depth);
 } // namespace DistributedHardware
 } // namespace OHOS
 #endif // OHOS_DCAMERA_UTILS_TOOL_H
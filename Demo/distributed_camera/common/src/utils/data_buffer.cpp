@@ -29,6 +29,16 @@ DataBuffer::DataBuffer(size_t capacity)
     }
 }
 
+DataBuffer::DataBuffer(uint8_t *data, size_t capacity, const DataBufferReleaser& releaser)
+    : releaser_(releaser), isOwner_(false)
+{
+    if (data != nullptr && capacity != 0) {
+        data_ = data;
+        capacity_ = capacity;
+        rangeLength_ = capacity;
+    }
+}
+
 size_t DataBuffer::Capacity() const
 {
     return capacity_;
@@ -110,6 +120,13 @@ bool DataBuffer::FindString(const string& name, string& value)
 
 DataBuffer::~DataBuffer()
 {
+    if (!isOwner_) {
+        data_ = nullptr;
+        if (releaser_ != nullptr) {
+            releaser_();
+        }
+        return;
+    }
     if (data_ != nullptr) {
         delete[] data_;
         data_ = nullptr;
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_degrade_controller.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#include "anonymous_string.h"
+#include "dcamera_memory_budget.h"
+#include "dcamera_thread_policy.h"
+#include "dcamera_utils_tools.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+// resolution stays put, the source stream buffers are sized for the negotiated picture and nothing rescales it
+const DCameraDegradeStep DEGRADE_STEPS[] = {
+    { 100, 100 }, { 67, 100 }, { 50, 100 }, { 50, 60 }, { 50, 35 }
+};
+const int32_t DEGRADE_LEVEL_MAX = static_cast<int32_t>(sizeof(DEGRADE_STEPS) / sizeof(DEGRADE_STEPS[0])) - 1;
+const std::string STAGE_NAMES[DCAMERA_DEGRADE_STAGE_BUTT] = { "decode", "deliver" };
+const int64_t PERCENT_BASE = 100;
+const int64_t US_PER_SECOND = 1000000;
+// utime and stime are the 14th and 15th fields of the stat line, the 12th and 13th after the comm field
+const int32_t STAT_UTIME_FIELD = 12;
+
+bool IsValidStage(DCameraDegradeStage stage)
+{
+    return stage >= DCAMERA_DEGRADE_STAGE_DECODE && stage < DCAMERA_DEGRADE_STAGE_BUTT;
+}
+
+int64_t GetThreadCpuUs(pid_t tid)
+{
+    std::ifstream statFile("/proc/self/task/" + std::to_string(tid) + "/stat");
+    std::string statLine;
+    if (!statFile.is_open() || !std::getline(statFile, statLine)) {
+        return -1;
+    }
+    // the thread name may hold spaces, the fields start after its closing parenthesis
+    size_t commEnd = statLine.rfind(')');
+    if (commEnd == std::string::npos) {
+        return -1;
+    }
+    std::istringstream fields(statLine.substr(commEnd + 1));
+    std::string field;
+    for (int32_t i = 1; i < STAT_UTIME_FIELD; i++) {
+        if (!(fields >> field)) {
+            return -1;
+        }
+    }
+    int64_t utime = 0;
+    int64_t stime = 0;
+    int64_t ticks = static_cast<int64_t>(sysconf(_SC_CLK_TCK));
+    if (!(fields >> utime >> stime) || ticks <= 0) {
+        return -1;
+    }
+    return (utime + stime) * US_PER_SECOND / ticks;
+}
+
+std::map<pid_t, int64_t> GetFrameThreadCpuUs()
+{
+    std::map<pid_t, int64_t> threadCpuUs;
+    for (pid_t tid : DCameraThreadPolicy::GetInstance().GetTierThreads(DCAMERA_TASK_TIER_FRAME)) {
+        int64_t cpuUs = GetThreadCpuUs(tid);
+        if (cpuUs >= 0) {
+            threadCpuUs[tid] = cpuUs;
+        }
+    }
+    return threadCpuUs;
+}
+}
+
+IMPLEMENT_SINGLE_INSTANCE(DCameraDegradeController);
+
+void DCameraDegradeController::AddCamera(const std::string& key, const DCameraDegradeListener& listener)
+{
+    std::lock_guard<std::mutex> autoLock(stateLock_);
+    CameraState state;
+    state.listener = listener;
+    states_[key] = state;
+}
+
+void DCameraDegradeController::RemoveCamera(const std::string& key)
+{
+    std::lock_guard<std::mutex> autoLock(stateLock_);
+    auto iter = states_.find(key);
+    if (iter == states_.end()) {
+        return;
+    }
+    DHLOGI("DCameraDegradeController %s remove, level: %d, transitions: %d", GetAnonyString(key).c_str(),
+        iter->second.level, iter->second.transitions);
+    states_.erase(iter);
+}
+
+void DCameraDegradeController::OnStageLatency(const std::string& key, DCameraDegradeStage stage, int64_t latencyUs)
+{
+    if (!IsValidStage(stage) || latencyUs < 0) {
+        return;
+    }
+    DCameraPressureSample sample;
+    {
+        std::lock_guard<std::mutex> autoLock(stateLock_);
+        auto iter = states_.find(key);
+        if (iter == states_.end()) {
+            return;
+        }
+        CameraState& state = iter->second;
+        int64_t nowUs = GetNowTimeStampUs();
+        if (state.windowStartUs == 0) {
+            state.windowStartUs = nowUs;
+            state.windowThreadCpuUs = GetFrameThreadCpuUs();
+        }
+        state.latencySumUs[stage] += latencyUs;
+        state.latencyCount[stage]++;
+        if (nowUs - state.windowStartUs < DCAMERA_DEGRADE_WINDOW_US) {
+            return;
+        }
+        CloseWindowLocked(state, nowUs, sample);
+    }
+    sample.queuePercent = GetQueuePercent(key);
+    Evaluate(key, sample);
+}
+
+int32_t DCameraDegradeController::Evaluate(const std::string& key, const DCameraPressureSample& sample)
+{
+    DCameraDegradeListener listener;
+    int32_t fromLevel = 0;
+    int32_t toLevel = 0;
+    {
+        std::lock_guard<std::mutex> autoLock(stateLock_);
+        auto iter = states_.find(key);
+        if (iter == states_.end()) {
+            return DCAMERA_NOT_FOUND;
+        }
+        CameraState& state = iter->second;
+        fromLevel = state.level;
+        if (IsOverloaded(sample)) {
+            state.idleTimes = 0;
+            state.overloadTimes++;
+            if (state.overloadTimes >= DCAMERA_DEGRADE_STEP_DOWN_WINDOWS && state.level < DEGRADE_LEVEL_MAX) {
+                state.level++;
+                state.overloadTimes = 0;
+            }
+        } else if (IsIdle(sample)) {
+            state.overloadTimes = 0;
+            state.idleTimes++;
+            if (state.idleTimes >= DCAMERA_DEGRADE_STEP_UP_WINDOWS && state.level > 0) {
+                state.level--;
+                state.idleTimes = 0;
+            }
+        } else {
+            state.overloadTimes = 0;
+            state.idleTimes = 0;
+        }
+        toLevel = state.level;
+        if (toLevel == fromLevel) {
+            return toLevel;
+        }
+        state.transitions++;
+        listener = state.listener;
+    }
+    DumpEvent(key, fromLevel, toLevel, sample);
+    if (listener != nullptr) {
+        listener(toLevel);
+    }
+    return toLevel;
+}
+
+int32_t DCameraDegradeController::GetLevel(const std::string& key)
+{
+    std::lock_guard<std::mutex> autoLock(stateLock_);
+    auto iter = states_.find(key);
+    if (iter == states_.end()) {
+        return 0;
+    }
+    return iter->second.level;
+}
+
+int32_t DCameraDegradeController::GetMaxLevel()
+{
+    return DEGRADE_LEVEL_MAX;
+}
+
+DCameraDegradeStep DCameraDegradeController::GetStep(int32_t level)
+{
+    if (level < 0 || level > DEGRADE_LEVEL_MAX) {
+        return DEGRADE_STEPS[0];
+    }
+    return DEGRADE_STEPS[level];
+}
+
+bool DCameraDegradeController::ParseLevel(const std::string& value, int32_t& level)
+{
+    if (value.empty() || value.size() > 1 || value[0] < '0' || value[0] - '0' > DEGRADE_LEVEL_MAX) {
+        return false;
+    }
+    level = value[0] - '0';
+    return true;
+}
+
+bool DCameraDegradeController::IsOverloaded(const DCameraPressureSample& sample)
+{
+    for (int32_t stage = DCAMERA_DEGRADE_STAGE_DECODE; stage < DCAMERA_DEGRADE_STAGE_BUTT; stage++) {
+        if (sample.latencyUs[stage] > DCAMERA_DEGRADE_LATENCY_HIGH_US) {
+            return true;
+        }
+    }
+    return sample.queuePercent > DCAMERA_DEGRADE_QUEUE_HIGH_PERCENT ||
+        sample.cpuPercent > DCAMERA_DEGRADE_CPU_HIGH_PERCENT;
+}
+
+bool DCameraDegradeController::IsIdle(const DCameraPressureSample& sample)
+{
+    for (int32_t stage = DCAMERA_DEGRADE_STAGE_DECODE; stage < DCAMERA_DEGRADE_STAGE_BUTT; stage++) {
+        if (sample.latencyUs[stage] >= DCAMERA_DEGRADE_LATENCY_LOW_US) {
+            return false;
+        }
+    }
+    return sample.queuePercent < DCAMERA_DEGRADE_QUEUE_LOW_PERCENT &&
+        sample.cpuPercent < DCAMERA_DEGRADE_CPU_LOW_PERCENT;
+}
+
+void DCameraDegradeController::CloseWindowLocked(CameraState& state, int64_t nowUs, DCameraPressureSample& sample)
+{
+    for (int32_t stage = DCAMERA_DEGRADE_STAGE_DECODE; stage < DCAMERA_DEGRADE_STAGE_BUTT; stage++) {
+        if (state.latencyCount[stage] != 0) {
+            sample.latencyUs[stage] = state.latencySumUs[stage] / state.latencyCount[stage];
+        }
+        state.latencySumUs[stage] = 0;
+        state.latencyCount[stage] = 0;
+    }
+    // the busiest frame thread against the wall time, one saturated core is overload whatever the core count
+    std::map<pid_t, int64_t> threadCpuUs = GetFrameThreadCpuUs();
+    int64_t maxBusyUs = 0;
+    for (const auto& thread : threadCpuUs) {
+        auto iter = state.windowThreadCpuUs.find(thread.first);
+        if (iter != state.windowThreadCpuUs.end() && thread.second - iter->second > maxBusyUs) {
+            maxBusyUs = thread.second - iter->second;
+        }
+    }
+    int64_t wallUs = nowUs - state.windowStartUs;
+    sample.cpuPercent = static_cast<uint32_t>(std::min(maxBusyUs * PERCENT_BASE / wallUs, PERCENT_BASE));
+    state.windowStartUs = nowUs;
+    state.windowThreadCpuUs = threadCpuUs;
+}
+
+uint32_t DCameraDegradeController::GetQueuePercent(const std::string& key)
+{
+    DCameraMemoryReport report;
+    if (DCameraMemoryBudget::GetInstance().GetReport(key, report) != DCAMERA_OK || report.budgetBytes == 0) {
+        return 0;
+    }
+    return static_cast<uint32_t>(report.inFlightBytes * PERCENT_BASE / report.budgetBytes);
+}
+
+void DCameraDegradeController::DumpEvent(const std::string& key, int32_t fromLevel, int32_t toLevel,
+    const DCameraPressureSample& sample)
+{
+    DCameraDegradeStep step = GetStep(toLevel);
+    DHLOGI("DCameraDegradeController event %s level: %d -> %d, fps: %d%%, bitrate: %d%%, queue: %d%%, cpu: %d%%",
+        GetAnonyString(key).c_str(), fromLevel, toLevel, step.fpsPercent, step.bitratePercent, sample.queuePercent,
+        sample.cpuPercent);
+    for (int32_t stage = DCAMERA_DEGRADE_STAGE_DECODE; stage < DCAMERA_DEGRADE_STAGE_BUTT; stage++) {
+        DHLOGI("DCameraDegradeController event %s stage %s latency: %lld us", GetAnonyString(key).c_str(),
+            STAGE_NAMES[stage].c_str(), (long long)sample.latencyUs[stage]);
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
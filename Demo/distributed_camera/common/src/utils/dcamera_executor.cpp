@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_executor.h"
+
+#include <algorithm>
+
+#include "dcamera_thread_policy.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+const std::string TIER_THREAD_NAMES[DCAMERA_TASK_TIER_BUTT] = { "DCamFrame", "DCamControl", "DCamBackground" };
+const uint32_t TIER_THREAD_NUMS[DCAMERA_TASK_TIER_BUTT] = {
+    DCAMERA_EXECUTOR_FRAME_THREAD_NUM, DCAMERA_EXECUTOR_CONTROL_THREAD_NUM, DCAMERA_EXECUTOR_BACKGROUND_THREAD_NUM
+};
+
+bool IsValidTier(DCameraTaskTier tier)
+{
+    return tier >= DCAMERA_TASK_TIER_FRAME && tier < DCAMERA_TASK_TIER_BUTT;
+}
+}
+
+DCameraSerialQueue::DCameraSerialQueue(const std::string& name, DCameraTaskTier tier) : name_(name), tier_(tier)
+{
+    DCameraExecutor::GetInstance().AddQueue(tier_);
+}
+
+DCameraSerialQueue::~DCameraSerialQueue()
+{
+    if (!isClosed_) {
+        DCameraExecutor::GetInstance().RemoveQueue(tier_);
+    }
+}
+
+bool DCameraSerialQueue::PostTask(const DCameraTask& task)
+{
+    if (task == nullptr) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> autoLock(queueLock_);
+        if (isClosed_) {
+            return false;
+        }
+        tasks_.push_back(task);
+        if (isScheduled_) {
+            return true;
+        }
+        isScheduled_ = true;
+    }
+    return Schedule();
+}
+
+void DCameraSerialQueue::Close()
+{
+    std::unique_lock<std::mutex> lock(queueLock_);
+    if (!isClosed_) {
+        DCameraExecutor::GetInstance().RemoveQueue(tier_);
+    }
+    isClosed_ = true;
+    tasks_.clear();
+    // a task closing its own queue cannot wait for itself
+    if (runningThread_ == std::this_thread::get_id()) {
+        return;
+    }
+    idleCond_.wait(lock, [this] { return !isRunning_; });
+}
+
+const std::string& DCameraSerialQueue::GetName() const
+{
+    return name_;
+}
+
+DCameraTaskTier DCameraSerialQueue::GetTier() const
+{
+    return tier_;
+}
+
+void DCameraSerialQueue::RunNext()
+{
+    DCameraTask task = nullptr;
+    {
+        std::lock_guard<std::mutex> autoLock(queueLock_);
+        if (isClosed_ || tasks_.empty()) {
+            isScheduled_ = false;
+            return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+        isRunning_ = true;
+        runningThread_ = std::this_thread::get_id();
+    }
+
+    task();
+
+    bool hasMore = false;
+    {
+        std::lock_guard<std::mutex> autoLock(queueLock_);
+        isRunning_ = false;
+        runningThread_ = std::thread::id();
+        hasMore = !isClosed_ && !tasks_.empty();
+        isScheduled_ = hasMore;
+    }
+    idleCond_.notify_all();
+    if (!hasMore) {
+        return;
+    }
+
+    // one task per turn, so queues sharing a tier take turns instead of starving each other
+    Schedule();
+}
+
+bool DCameraSerialQueue::Schedule()
+{
+    std::weak_ptr<DCameraSerialQueue> weakQueue = shared_from_this();
+    return DCameraExecutor::GetInstance().PostTask(tier_, [weakQueue]() {
+        std::shared_ptr<DCameraSerialQueue> queue = weakQueue.lock();
+        if (queue != nullptr) {
+            queue->RunNext();
+        }
+    });
+}
+
+IMPLEMENT_SINGLE_INSTANCE(DCameraExecutor);
+
+DCameraExecutor::DCameraExecutor()
+{
+    for (int32_t tier = DCAMERA_TASK_TIER_FRAME; tier < DCAMERA_TASK_TIER_BUTT; tier++) {
+        pools_[tier].stats.maxThreadCount = TIER_THREAD_NUMS[tier];
+    }
+}
+
+bool DCameraExecutor::PostTask(DCameraTaskTier tier, const DCameraTask& task)
+{
+    if (!IsValidTier(tier) || task == nullptr) {
+        DHLOGE("DCameraExecutor PostTask invalid task, tier: %d", tier);
+        return false;
+    }
+
+    WorkerPool& pool = pools_[tier];
+    {
+        std::lock_guard<std::mutex> autoLock(pool.poolLock);
+        pool.tasks.push_back({ task, std::chrono::steady_clock::now() });
+        pool.stats.postedCount++;
+        pool.stats.maxBacklog = std::max(pool.stats.maxBacklog, static_cast<uint32_t>(pool.tasks.size()));
+        if (pool.idleCount == 0 && pool.workerCount < pool.stats.maxThreadCount) {
+            StartWorkerLocked(tier);
+        }
+    }
+    pool.taskCond.notify_one();
+    return true;
+}
+
+void DCameraExecutor::AddQueue(DCameraTaskTier tier)
+{
+    if (!IsValidTier(tier)) {
+        return;
+    }
+    WorkerPool& pool = pools_[tier];
+    std::lock_guard<std::mutex> autoLock(pool.poolLock);
+    pool.queueCount++;
+    UpdateThreadLimitLocked(tier);
+}
+
+void DCameraExecutor::RemoveQueue(DCameraTaskTier tier)
+{
+    if (!IsValidTier(tier)) {
+        return;
+    }
+    // workers above the lower limit retire once they have been idle for DCAMERA_EXECUTOR_IDLE_TIMEOUT_MS
+    WorkerPool& pool = pools_[tier];
+    std::lock_guard<std::mutex> autoLock(pool.poolLock);
+    pool.queueCount = (pool.queueCount == 0) ? 0 : pool.queueCount - 1;
+    UpdateThreadLimitLocked(tier);
+}
+
+void DCameraExecutor::UpdateThreadLimitLocked(DCameraTaskTier tier)
+{
+    WorkerPool& pool = pools_[tier];
+    pool.stats.maxThreadCount = std::min(TIER_THREAD_NUMS[tier] + pool.queueCount,
+        std::max(TIER_THREAD_NUMS[tier], DCAMERA_EXECUTOR_TIER_MAX_THREAD_NUM));
+}
+
+void DCameraExecutor::StartWorkerLocked(DCameraTaskTier tier)
+{
+    WorkerPool& pool = pools_[tier];
+    auto slot = std::find_if(pool.workers.begin(), pool.workers.end(),
+        [](const std::thread& worker) { return !worker.joinable(); });
+    uint32_t index = static_cast<uint32_t>(slot - pool.workers.begin());
+    if (slot == pool.workers.end()) {
+        pool.workers.emplace_back(&DCameraExecutor::WorkerLoop, this, tier, index);
+    } else {
+        *slot = std::thread(&DCameraExecutor::WorkerLoop, this, tier, index);
+    }
+    pool.workerCount++;
+    pool.stats.threadCount = pool.workerCount;
+    DHLOGI("DCameraExecutor start worker %s%u", TIER_THREAD_NAMES[tier].c_str(), index);
+}
+
+std::shared_ptr<DCameraSerialQueue> DCameraExecutor::CreateSerialQueue(const std::string& name,
+    DCameraTaskTier tier)
+{
+    if (!IsValidTier(tier)) {
+        DHLOGE("DCameraExecutor CreateSerialQueue %s invalid tier: %d", name.c_str(), tier);
+        return nullptr;
+    }
+    return std::make_shared<DCameraSerialQueue>(name, tier);
+}
+
+int32_t DCameraExecutor::GetTierStats(DCameraTaskTier tier, DCameraTierStats& stats)
+{
+    if (!IsValidTier(tier)) {
+        return DCAMERA_BAD_VALUE;
+    }
+    WorkerPool& pool = pools_[tier];
+    std::lock_guard<std::mutex> autoLock(pool.poolLock);
+    stats = pool.stats;
+    stats.backlog = static_cast<uint32_t>(pool.tasks.size());
+    return DCAMERA_OK;
+}
+
+uint32_t DCameraExecutor::GetThreadCount()
+{
+    uint32_t threadCount = 0;
+    for (auto& pool : pools_) {
+        std::lock_guard<std::mutex> autoLock(pool.poolLock);
+        threadCount += pool.workerCount;
+    }
+    return threadCount;
+}
+
+void DCameraExecutor::DumpStats()
+{
+    for (int32_t tier = DCAMERA_TASK_TIER_FRAME; tier < DCAMERA_TASK_TIER_BUTT; tier++) {
+        DCameraTierStats stats;
+        GetTierStats(static_cast<DCameraTaskTier>(tier), stats);
+        DHLOGI("DCameraExecutor %s threads: %u/%u, backlog: %u, max backlog: %u, posted: %llu, executed: %llu, " \
+            "max wait: %llu us", TIER_THREAD_NAMES[tier].c_str(), stats.threadCount, stats.maxThreadCount,
+            stats.backlog, stats.maxBacklog, (unsigned long long)stats.postedCount,
+            (unsigned long long)stats.executedCount, (unsigned long long)stats.maxWaitUs);
+    }
+}
+
+void DCameraExecutor::WorkerLoop(DCameraTaskTier tier, uint32_t index)
+{
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread(TIER_THREAD_NAMES[tier] + std::to_string(index), tier);
+
+    WorkerPool& pool = pools_[tier];
+    while (true) {
+        PendingTask pending;
+        {
+            std::unique_lock<std::mutex> lock(pool.poolLock);
+            pool.idleCount++;
+            bool hasTask = pool.taskCond.wait_for(lock, std::chrono::milliseconds(DCAMERA_EXECUTOR_IDLE_TIMEOUT_MS),
+                [&pool] { return !pool.tasks.empty(); });
+            pool.idleCount--;
+            if (!hasTask && pool.workerCount > pool.stats.maxThreadCount) {
+                pool.workers[index].detach();
+                pool.workerCount--;
+                pool.stats.threadCount = pool.workerCount;
+                DHLOGI("DCameraExecutor retire idle worker %s%u", TIER_THREAD_NAMES[tier].c_str(), index);
+                return;
+            }
+            if (!hasTask) {
+                continue;
+            }
+            pending = std::move(pool.tasks.front());
+            pool.tasks.pop_front();
+            uint64_t waitUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - pending.postTime).count());
+            pool.stats.maxWaitUs = std::max(pool.stats.maxWaitUs, waitUs);
+            pool.stats.executedCount++;
+        }
+        pending.task();
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_memory_budget.h"
+
+#include <algorithm>
+
+#include "anonymous_string.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+const std::string STAGE_NAMES[DCAMERA_MEMORY_STAGE_BUTT] = { "assemble", "decode", "producer" };
+const uint64_t PERCENT_BASE = 100;
+const uint64_t BYTES_PER_KB = 1024;
+
+bool IsValidStage(DCameraMemoryStage stage)
+{
+    return stage >= DCAMERA_MEMORY_STAGE_ASSEMBLE && stage < DCAMERA_MEMORY_STAGE_BUTT;
+}
+}
+
+IMPLEMENT_SINGLE_INSTANCE(DCameraMemoryBudget);
+
+void DCameraMemoryBudget::AddCamera(const std::string& key, uint64_t budgetBytes,
+    const DCameraBackpressureListener& listener)
+{
+    std::lock_guard<std::mutex> autoLock(budgetLock_);
+    CameraBudget budget;
+    budget.report.budgetBytes = budgetBytes;
+    budget.listener = listener;
+    budgets_[key] = budget;
+    DHLOGI("DCameraMemoryBudget add %s budget: %llu KB", GetAnonyString(key).c_str(),
+        (unsigned long long)(budgetBytes / BYTES_PER_KB));
+}
+
+void DCameraMemoryBudget::RemoveCamera(const std::string& key)
+{
+    DCameraMemoryReport report;
+    {
+        std::lock_guard<std::mutex> autoLock(budgetLock_);
+        auto iter = budgets_.find(key);
+        if (iter == budgets_.end()) {
+            return;
+        }
+        report = iter->second.report;
+        budgets_.erase(iter);
+    }
+    DumpReport(key, report);
+}
+
+bool DCameraMemoryBudget::Acquire(const std::string& key, DCameraMemoryStage stage, uint64_t bytes)
+{
+    if (!IsValidStage(stage)) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> autoLock(budgetLock_);
+        auto iter = budgets_.find(key);
+        if (iter == budgets_.end()) {
+            return true;
+        }
+        DCameraMemoryReport& report = iter->second.report;
+        if (report.inFlightBytes + bytes > report.budgetBytes) {
+            return false;
+        }
+        if (!ChargeLocked(iter->second, stage, bytes)) {
+            return true;
+        }
+    }
+    Notify(key);
+    return true;
+}
+
+void DCameraMemoryBudget::Charge(const std::string& key, DCameraMemoryStage stage, uint64_t bytes)
+{
+    if (!IsValidStage(stage)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> autoLock(budgetLock_);
+        auto iter = budgets_.find(key);
+        if (iter == budgets_.end() || !ChargeLocked(iter->second, stage, bytes)) {
+            return;
+        }
+    }
+    Notify(key);
+}
+
+void DCameraMemoryBudget::Release(const std::string& key, DCameraMemoryStage stage, uint64_t bytes)
+{
+    if (!IsValidStage(stage)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> autoLock(budgetLock_);
+        auto iter = budgets_.find(key);
+        if (iter == budgets_.end()) {
+            return;
+        }
+        DCameraMemoryReport& report = iter->second.report;
+        // a stage that outlives RemoveCamera and AddCamera may release what the new entry never charged
+        bytes = std::min(bytes, report.stageBytes[stage]);
+        report.stageBytes[stage] -= bytes;
+        report.inFlightBytes -= bytes;
+        if (!report.isThrottled ||
+            report.inFlightBytes * PERCENT_BASE > report.budgetBytes * DCAMERA_MEMORY_RESUME_PERCENT) {
+            return;
+        }
+        report.isThrottled = false;
+        DHLOGI("DCameraMemoryBudget %s resume, in flight: %llu KB", GetAnonyString(key).c_str(),
+            (unsigned long long)(report.inFlightBytes / BYTES_PER_KB));
+    }
+    Notify(key);
+}
+
+void DCameraMemoryBudget::OnFrameDropped(const std::string& key)
+{
+    std::lock_guard<std::mutex> autoLock(budgetLock_);
+    auto iter = budgets_.find(key);
+    if (iter != budgets_.end()) {
+        iter->second.report.droppedFrames++;
+    }
+}
+
+int32_t DCameraMemoryBudget::GetReport(const std::string& key, DCameraMemoryReport& report)
+{
+    std::lock_guard<std::mutex> autoLock(budgetLock_);
+    auto iter = budgets_.find(key);
+    if (iter == budgets_.end()) {
+        return DCAMERA_NOT_FOUND;
+    }
+    report = iter->second.report;
+    return DCAMERA_OK;
+}
+
+bool DCameraMemoryBudget::ChargeLocked(CameraBudget& budget, DCameraMemoryStage stage, uint64_t bytes)
+{
+    DCameraMemoryReport& report = budget.report;
+    report.stageBytes[stage] += bytes;
+    report.inFlightBytes += bytes;
+    report.stageHighWaterBytes[stage] = std::max(report.stageHighWaterBytes[stage], report.stageBytes[stage]);
+    report.highWaterBytes = std::max(report.highWaterBytes, report.inFlightBytes);
+    if (report.isThrottled ||
+        report.inFlightBytes * PERCENT_BASE < report.budgetBytes * DCAMERA_MEMORY_THROTTLE_PERCENT) {
+        return false;
+    }
+    report.isThrottled = true;
+    DHLOGI("DCameraMemoryBudget throttle at stage %s, in flight: %llu KB", STAGE_NAMES[stage].c_str(),
+        (unsigned long long)(report.inFlightBytes / BYTES_PER_KB));
+    return true;
+}
+
+void DCameraMemoryBudget::Notify(const std::string& key)
+{
+    // a change made under budgetLock_ is told after it is released, where a later change may overtake it.
+    // Every teller sends the state current once it holds notifyLock_, and only when that differs from what
+    // was told last, so the last notification always carries the latest state.
+    std::lock_guard<std::mutex> notifyLock(notifyLock_);
+    DCameraBackpressureListener listener;
+    bool isThrottled = false;
+    {
+        std::lock_guard<std::mutex> autoLock(budgetLock_);
+        auto iter = budgets_.find(key);
+        if (iter == budgets_.end() || iter->second.report.isThrottled == iter->second.isNotifiedThrottled) {
+            return;
+        }
+        isThrottled = iter->second.report.isThrottled;
+        iter->second.isNotifiedThrottled = isThrottled;
+        listener = iter->second.listener;
+    }
+    if (listener != nullptr) {
+        listener(isThrottled);
+    }
+}
+
+void DCameraMemoryBudget::DumpReport(const std::string& key, const DCameraMemoryReport& report)
+{
+    DHLOGI("DCameraMemoryBudget %s budget: %llu KB, high water: %llu KB, dropped frames: %llu",
+        GetAnonyString(key).c_str(), (unsigned long long)(report.budgetBytes / BYTES_PER_KB),
+        (unsigned long long)(report.highWaterBytes / BYTES_PER_KB), (unsigned long long)report.droppedFrames);
+    for (int32_t stage = DCAMERA_MEMORY_STAGE_ASSEMBLE; stage < DCAMERA_MEMORY_STAGE_BUTT; stage++) {
+        DHLOGI("DCameraMemoryBudget %s stage %s high water: %llu KB", GetAnonyString(key).c_str(),
+            STAGE_NAMES[stage].c_str(), (unsigned long long)(report.stageHighWaterBytes[stage] / BYTES_PER_KB));
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_startup_profiler.h"
+
+#include "anonymous_string.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+const std::string PHASE_NAMES[DCAMERA_STARTUP_PHASE_BUTT] = {
+    "open_channel", "config_streams", "channel_neg", "open_data_channel", "capture_request", "create_codec",
+    "camera_session", "start_camera", "first_packet"
+};
+const int64_t US_PER_MS = 1000;
+
+bool IsValidPhase(DCameraStartupPhase phase)
+{
+    return phase >= DCAMERA_STARTUP_PHASE_OPEN_CHANNEL && phase < DCAMERA_STARTUP_PHASE_BUTT;
+}
+}
+
+IMPLEMENT_SINGLE_INSTANCE(DCameraStartupProfiler);
+
+void DCameraStartupProfiler::Start(const std::string& key)
+{
+    std::lock_guard<std::mutex> autoLock(recordLock_);
+    StartupRecord record;
+    record.startTime = std::chrono::steady_clock::now();
+    records_[key] = record;
+}
+
+void DCameraStartupProfiler::BeginPhase(const std::string& key, DCameraStartupPhase phase)
+{
+    if (!IsValidPhase(phase)) {
+        return;
+    }
+    std::lock_guard<std::mutex> autoLock(recordLock_);
+    auto iter = records_.find(key);
+    if (iter == records_.end() || iter->second.report.isFinished) {
+        return;
+    }
+    DCameraPhaseSpan& span = iter->second.report.phases[phase];
+    if (span.beginUs < 0) {
+        span.beginUs = ElapsedUs(iter->second);
+    }
+}
+
+void DCameraStartupProfiler::EndPhase(const std::string& key, DCameraStartupPhase phase)
+{
+    if (!IsValidPhase(phase)) {
+        return;
+    }
+    std::lock_guard<std::mutex> autoLock(recordLock_);
+    auto iter = records_.find(key);
+    if (iter == records_.end() || iter->second.report.isFinished) {
+        return;
+    }
+    DCameraPhaseSpan& span = iter->second.report.phases[phase];
+    if (span.beginUs >= 0 && span.endUs < 0) {
+        span.endUs = ElapsedUs(iter->second);
+    }
+}
+
+void DCameraStartupProfiler::MarkPhase(const std::string& key, DCameraStartupPhase phase)
+{
+    BeginPhase(key, phase);
+    EndPhase(key, phase);
+}
+
+void DCameraStartupProfiler::OnFirstFrame(const std::string& key)
+{
+    DCameraStartupReport report;
+    {
+        std::lock_guard<std::mutex> autoLock(recordLock_);
+        auto iter = records_.find(key);
+        if (iter == records_.end() || iter->second.report.isFinished) {
+            return;
+        }
+        iter->second.report.firstFrameUs = ElapsedUs(iter->second);
+        iter->second.report.isFinished = true;
+        report = iter->second.report;
+    }
+    DumpReport(key, report);
+}
+
+int32_t DCameraStartupProfiler::GetReport(const std::string& key, DCameraStartupReport& report)
+{
+    std::lock_guard<std::mutex> autoLock(recordLock_);
+    auto iter = records_.find(key);
+    if (iter == records_.end()) {
+        return DCAMERA_NOT_FOUND;
+    }
+    report = iter->second.report;
+    return DCAMERA_OK;
+}
+
+void DCameraStartupProfiler::Remove(const std::string& key)
+{
+    std::lock_guard<std::mutex> autoLock(recordLock_);
+    records_.erase(key);
+}
+
+int64_t DCameraStartupProfiler::ElapsedUs(const StartupRecord& record)
+{
+    return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - record.startTime).count());
+}
+
+void DCameraStartupProfiler::DumpReport(const std::string& key, const DCameraStartupReport& report)
+{
+    DHLOGI("DCameraStartupProfiler %s time to first frame: %lld ms", GetAnonyString(key).c_str(),
+        (long long)(report.firstFrameUs / US_PER_MS));
+    for (int32_t phase = DCAMERA_STARTUP_PHASE_OPEN_CHANNEL; phase < DCAMERA_STARTUP_PHASE_BUTT; phase++) {
+        const DCameraPhaseSpan& span = report.phases[phase];
+        if (span.beginUs < 0) {
+            continue;
+        }
+        int64_t endUs = (span.endUs < 0) ? span.beginUs : span.endUs;
+        DHLOGI("DCameraStartupProfiler %s phase %s: [%lld, %lld] ms, cost %lld ms", GetAnonyString(key).c_str(),
+            PHASE_NAMES[phase].c_str(), (long long)(span.beginUs / US_PER_MS), (long long)(endUs / US_PER_MS),
+            (long long)((endUs - span.beginUs) / US_PER_MS));
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
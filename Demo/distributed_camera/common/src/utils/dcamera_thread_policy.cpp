@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_thread_policy.h"
+
+#include <cerrno>
+#include <fstream>
+#include <memory>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "json/json.h"
+
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+const std::string TIER_CONFIG_NAMES[DCAMERA_TASK_TIER_BUTT] = { "frame", "control", "background" };
+const int32_t TIER_DEFAULT_NICES[DCAMERA_TASK_TIER_BUTT] = {
+    DCAMERA_THREAD_NICE_FRAME, DCAMERA_THREAD_NICE_CONTROL, DCAMERA_THREAD_NICE_BACKGROUND
+};
+const int32_t THREAD_NICE_MIN = -20;
+const int32_t THREAD_NICE_MAX = 19;
+const size_t THREAD_NAME_MAX_LEN = 15;
+const size_t THREAD_POLICY_CONFIG_MAX_SIZE = 64 * 1024;
+
+// generation of the policy the calling thread last applied, 0 when it never did
+thread_local uint32_t g_appliedGeneration = 0;
+
+bool IsValidTier(DCameraTaskTier tier)
+{
+    return tier >= DCAMERA_TASK_TIER_FRAME && tier < DCAMERA_TASK_TIER_BUTT;
+}
+
+pid_t GetCurrentTid()
+{
+    return static_cast<pid_t>(syscall(SYS_gettid));
+}
+
+bool ParseCpus(const Json::Value& cpusJson, std::vector<uint32_t>& cpus)
+{
+    if (!cpusJson.isArray()) {
+        return false;
+    }
+    for (const auto& cpuJson : cpusJson) {
+        if (!cpuJson.isUInt() || cpuJson.asUInt() >= CPU_SETSIZE) {
+            return false;
+        }
+        cpus.push_back(cpuJson.asUInt());
+    }
+    return true;
+}
+
+bool ParseTier(const Json::Value& tierJson, int32_t& nice, std::vector<uint32_t>& cpus)
+{
+    if (!tierJson.isObject()) {
+        return false;
+    }
+    if (tierJson.isMember("nice")) {
+        if (!tierJson["nice"].isInt() || tierJson["nice"].asInt() < THREAD_NICE_MIN ||
+            tierJson["nice"].asInt() > THREAD_NICE_MAX) {
+            return false;
+        }
+        nice = tierJson["nice"].asInt();
+    }
+    if (tierJson.isMember("cpus")) {
+        cpus.clear();
+        return ParseCpus(tierJson["cpus"], cpus);
+    }
+    return true;
+}
+
+std::string CpusToString(const std::vector<uint32_t>& cpus)
+{
+    std::string cpusStr;
+    for (uint32_t cpu : cpus) {
+        cpusStr += (cpusStr.empty() ? "" : ",") + std::to_string(cpu);
+    }
+    return cpusStr.empty() ? "all" : cpusStr;
+}
+}
+
+IMPLEMENT_SINGLE_INSTANCE(DCameraThreadPolicy);
+
+DCameraThreadPolicy::DCameraThreadPolicy()
+{
+    for (int32_t tier = DCAMERA_TASK_TIER_FRAME; tier < DCAMERA_TASK_TIER_BUTT; tier++) {
+        tierPolicies_[tier].nice = TIER_DEFAULT_NICES[tier];
+    }
+    LoadConfig(DCAMERA_THREAD_POLICY_CONFIG_PATH);
+}
+
+int32_t DCameraThreadPolicy::LoadConfig(const std::string& path)
+{
+    std::ifstream configFile(path);
+    if (!configFile.is_open()) {
+        DHLOGI("DCameraThreadPolicy no config %s, tier defaults only", path.c_str());
+        return DCAMERA_NOT_FOUND;
+    }
+    std::stringstream content;
+    content << configFile.rdbuf();
+    std::string jsonStr = content.str();
+    if (jsonStr.size() > THREAD_POLICY_CONFIG_MAX_SIZE) {
+        DHLOGE("DCameraThreadPolicy config %s too large, size: %zu", path.c_str(), jsonStr.size());
+        return DCAMERA_BAD_VALUE;
+    }
+    int32_t ret = ParseConfig(jsonStr);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraThreadPolicy config %s invalid, tier defaults kept", path.c_str());
+    }
+    return ret;
+}
+
+int32_t DCameraThreadPolicy::ParseConfig(const std::string& jsonStr)
+{
+    JSONCPP_STRING errs;
+    Json::CharReaderBuilder readerBuilder;
+    Json::Value rootValue;
+
+    std::unique_ptr<Json::CharReader> const jsonReader(readerBuilder.newCharReader());
+    if (!jsonReader->parse(jsonStr.c_str(), jsonStr.c_str() + jsonStr.length(), &rootValue, &errs) ||
+        !rootValue.isObject()) {
+        return DCAMERA_BAD_VALUE;
+    }
+
+    TierPolicy tierPolicies[DCAMERA_TASK_TIER_BUTT];
+    for (int32_t tier = DCAMERA_TASK_TIER_FRAME; tier < DCAMERA_TASK_TIER_BUTT; tier++) {
+        tierPolicies[tier].nice = TIER_DEFAULT_NICES[tier];
+    }
+    if (rootValue.isMember("tiers")) {
+        const Json::Value& tiersJson = rootValue["tiers"];
+        if (!tiersJson.isObject()) {
+            return DCAMERA_BAD_VALUE;
+        }
+        for (const auto& tierName : tiersJson.getMemberNames()) {
+            int32_t tier = DCAMERA_TASK_TIER_FRAME;
+            while (tier < DCAMERA_TASK_TIER_BUTT && TIER_CONFIG_NAMES[tier] != tierName) {
+                tier++;
+            }
+            if (tier == DCAMERA_TASK_TIER_BUTT ||
+                !ParseTier(tiersJson[tierName], tierPolicies[tier].nice, tierPolicies[tier].cpus)) {
+                return DCAMERA_BAD_VALUE;
+            }
+        }
+    }
+
+    std::map<std::string, std::vector<uint32_t>> threadCpus;
+    if (rootValue.isMember("threads")) {
+        const Json::Value& threadsJson = rootValue["threads"];
+        if (!threadsJson.isObject()) {
+            return DCAMERA_BAD_VALUE;
+        }
+        for (const auto& threadName : threadsJson.getMemberNames()) {
+            if (threadName.empty() || threadName.size() > THREAD_NAME_MAX_LEN ||
+                !ParseCpus(threadsJson[threadName], threadCpus[threadName])) {
+                return DCAMERA_BAD_VALUE;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> autoLock(policyLock_);
+        for (int32_t tier = DCAMERA_TASK_TIER_FRAME; tier < DCAMERA_TASK_TIER_BUTT; tier++) {
+            tierPolicies_[tier] = tierPolicies[tier];
+        }
+        threadCpus_ = threadCpus;
+    }
+    // threads pick the new policy up the next time they apply it
+    generation_++;
+    for (int32_t tier = DCAMERA_TASK_TIER_FRAME; tier < DCAMERA_TASK_TIER_BUTT; tier++) {
+        DHLOGI("DCameraThreadPolicy tier %s nice: %d, cpus: %s", TIER_CONFIG_NAMES[tier].c_str(),
+            tierPolicies[tier].nice, CpusToString(tierPolicies[tier].cpus).c_str());
+    }
+    return DCAMERA_OK;
+}
+
+void DCameraThreadPolicy::ApplyCurrentThread(const std::string& name, DCameraTaskTier tier)
+{
+    uint32_t generation = generation_.load();
+    if (name.empty() || !IsValidTier(tier) || g_appliedGeneration == generation) {
+        return;
+    }
+    g_appliedGeneration = generation;
+
+    pthread_setname_np(pthread_self(), name.substr(0, THREAD_NAME_MAX_LEN).c_str());
+    char threadName[THREAD_NAME_MAX_LEN + 1] = { 0 };
+    prctl(PR_GET_NAME, threadName);
+
+    DCameraThreadInfo info;
+    info.name = threadName;
+    info.tier = tier;
+    std::vector<uint32_t> cpus;
+    {
+        std::lock_guard<std::mutex> autoLock(policyLock_);
+        info.nice = tierPolicies_[tier].nice;
+        cpus = GetCpusLocked(info.name, tier);
+    }
+    info.cpus = CpusToString(cpus);
+    info.isApplied = true;
+
+    pid_t tid = GetCurrentTid();
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(tid), info.nice) != 0) {
+        DHLOGE("DCameraThreadPolicy %s set nice %d failed, errno: %d", threadName, info.nice, errno);
+        info.isApplied = false;
+    }
+    if (!cpus.empty()) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (uint32_t cpu : cpus) {
+            CPU_SET(cpu, &cpuSet);
+        }
+        if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+            DHLOGE("DCameraThreadPolicy %s pin to cpus %s failed, errno: %d", threadName, info.cpus.c_str(), errno);
+            info.isApplied = false;
+        }
+    }
+
+    DHLOGI("DCameraThreadPolicy apply %s tid: %d, tier: %s, nice: %d, cpus: %s", threadName, tid,
+        TIER_CONFIG_NAMES[tier].c_str(), info.nice, info.cpus.c_str());
+    std::lock_guard<std::mutex> autoLock(policyLock_);
+    PruneThreadsLocked();
+    threads_[tid] = info;
+}
+
+int32_t DCameraThreadPolicy::GetThreadInfo(pid_t tid, DCameraThreadInfo& info)
+{
+    std::lock_guard<std::mutex> autoLock(policyLock_);
+    PruneThreadsLocked();
+    auto iter = threads_.find(tid);
+    if (iter == threads_.end()) {
+        return DCAMERA_NOT_FOUND;
+    }
+    info = iter->second;
+    return DCAMERA_OK;
+}
+
+std::vector<pid_t> DCameraThreadPolicy::GetTierThreads(DCameraTaskTier tier)
+{
+    std::vector<pid_t> tids;
+    std::lock_guard<std::mutex> autoLock(policyLock_);
+    PruneThreadsLocked();
+    for (const auto& thread : threads_) {
+        if (thread.second.tier == tier) {
+            tids.push_back(thread.first);
+        }
+    }
+    return tids;
+}
+
+void DCameraThreadPolicy::DumpThreads()
+{
+    std::lock_guard<std::mutex> autoLock(policyLock_);
+    PruneThreadsLocked();
+    for (const auto& thread : threads_) {
+        const DCameraThreadInfo& info = thread.second;
+        DHLOGI("DCameraThreadPolicy thread %s tid: %d, tier: %s, nice: %d, cpus: %s, applied: %d",
+            info.name.c_str(), thread.first, TIER_CONFIG_NAMES[info.tier].c_str(), info.nice, info.cpus.c_str(),
+            info.isApplied);
+    }
+}
+
+std::vector<uint32_t> DCameraThreadPolicy::GetCpusLocked(const std::string& name, DCameraTaskTier tier)
+{
+    // the longest configured prefix wins, so "DCamFrame1" can be pinned apart from the other frame workers
+    const std::vector<uint32_t>* cpus = &tierPolicies_[tier].cpus;
+    size_t matchLen = 0;
+    for (const auto& threadCpus : threadCpus_) {
+        if (threadCpus.first.size() > matchLen && name.compare(0, threadCpus.first.size(), threadCpus.first) == 0) {
+            cpus = &threadCpus.second;
+            matchLen = threadCpus.first.size();
+        }
+    }
+    return *cpus;
+}
+
+void DCameraThreadPolicy::PruneThreadsLocked()
+{
+    for (auto iter = threads_.begin(); iter != threads_.end();) {
+        std::string taskPath = "/proc/self/task/" + std::to_string(iter->first);
+        if (access(taskPath.c_str(), F_OK) != 0) {
+            iter = threads_.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
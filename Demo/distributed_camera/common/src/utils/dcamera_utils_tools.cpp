@@ -15,6 +15,10 @@
 
 #include "dcamera_utils_tools.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
@@ -24,12 +28,24 @@
 namespace OHOS {
 namespace DistributedHardware {
 const int OFFSET2 = 2;
-const int OFFSET4 = 4;
-const int OFFSET6 = 6;
 const int INDEX_FIRST = 0;
 const int INDEX_SECOND = 1;
 const int INDEX_THIRD = 2;
 const int INDEX_FORTH = 3;
+const int DECIMAL_BASE = 10;
+const size_t JPEG_MARKER_LEN = 2;
+const uint8_t JPEG_MARKER_PREFIX = 0xFF;
+const uint8_t JPEG_MARKER_EOI = 0xD9;
+const uint8_t JPEG_MARKER_SOI = 0xD8;
+const uint8_t JPEG_MARKER_SOS = 0xDA;
+const uint8_t JPEG_MARKER_APP1 = 0xE1;
+const uint8_t JPEG_MARKER_RST0 = 0xD0;
+const uint8_t JPEG_MARKER_RST7 = 0xD7;
+const uint8_t JPEG_MARKER_TEM = 0x01;
+const uint8_t JPEG_STUFFED_BYTE = 0x00;
+const size_t JPEG_SEGMENT_HEADER_LEN = 4;
+const uint64_t YUV_BYTES_NUMERATOR = 3;
+const uint64_t YUV_BYTES_DENOMINATOR = 2;
 int32_t GetLocalDeviceNetworkId(std::string& networkId)
 {
     NodeBasicInfo basicInfo = { { 0 } };
@@ -57,45 +73,71 @@ int64_t GetNowTimeStampUs()
     return nowUs.count();
 }
 
-std::string Base64Encode(const unsigned char *toEncode, unsigned int len)
+namespace {
+const uint32_t BASE64_GROUP_BYTES = 3;
+const uint32_t BASE64_GROUP_CHARS = 4;
+const uint32_t BASE64_SEXTET_BITS = 6;
+const uint32_t BASE64_SEXTET_MASK = 0x3f;
+const uint32_t BASE64_BYTE_MASK = 0xff;
+const uint32_t BASE64_SHIFT_FIRST = 18;
+const uint32_t BASE64_SHIFT_SECOND = 12;
+const uint32_t BASE64_SHIFT_BYTE_FIRST = 16;
+const uint32_t BASE64_SHIFT_BYTE_SECOND = 8;
+const uint8_t BASE64_INVALID = 0xff;
+const uint8_t BASE64_INVALID_MASK = 0xc0;
+const uint8_t BASE64_PAD_ONE_MASK = 0x03;
+const uint8_t BASE64_PAD_TWO_MASK = 0x0f;
+const char BASE64_PAD = '=';
+
+const uint8_t *GetBase64DecodeTable()
 {
-    std::string ret;
-    uint32_t i = 0;
-    unsigned char charArray3[3];
-    unsigned char charArray4[4];
-
-    while (len--) {
-        charArray3[i++] = *(toEncode++);
-        if (i == sizeof(charArray3)) {
-            charArray4[INDEX_FIRST] = (charArray3[INDEX_FIRST] & 0xfc) >> OFFSET2;
-            charArray4[INDEX_SECOND] = ((charArray3[INDEX_FIRST] & 0x03) << OFFSET4) +
-                ((charArray3[INDEX_SECOND] & 0xf0) >> OFFSET4);
-            charArray4[INDEX_THIRD] = ((charArray3[INDEX_SECOND] & 0x0f) << OFFSET2) +
-                ((charArray3[INDEX_THIRD] & 0xc0) >> OFFSET6);
-            charArray4[INDEX_FORTH] = charArray3[INDEX_THIRD] & 0x3f;
-            for (i = 0; i < sizeof(charArray4); i++) {
-                ret += BASE_64_CHARS[charArray4[i]];
+    static const struct DecodeTable {
+        uint8_t value[UINT8_MAX + 1];
+        DecodeTable()
+        {
+            for (uint32_t i = 0; i <= UINT8_MAX; i++) {
+                value[i] = BASE64_INVALID;
+            }
+            for (uint32_t i = 0; i < BASE_64_CHARS.size(); i++) {
+                value[static_cast<unsigned char>(BASE_64_CHARS[i])] = static_cast<uint8_t>(i);
             }
-            i = 0;
         }
+    } table;
+    return table.value;
+}
+}
+
+std::string Base64Encode(const unsigned char *toEncode, unsigned int len)
+{
+    if (toEncode == nullptr || len == 0) {
+        return "";
+    }
+    const char *chars = BASE_64_CHARS.c_str();
+    std::string ret((len + BASE64_GROUP_BYTES - 1) / BASE64_GROUP_BYTES * BASE64_GROUP_CHARS, BASE64_PAD);
+    char *out = &ret[0];
+    const unsigned char *in = toEncode;
+    const unsigned char *blockEnd = toEncode + len / BASE64_GROUP_BYTES * BASE64_GROUP_BYTES;
+    while (in < blockEnd) {
+        uint32_t group = (static_cast<uint32_t>(in[INDEX_FIRST]) << BASE64_SHIFT_BYTE_FIRST) |
+            (static_cast<uint32_t>(in[INDEX_SECOND]) << BASE64_SHIFT_BYTE_SECOND) | in[INDEX_THIRD];
+        out[INDEX_FIRST] = chars[(group >> BASE64_SHIFT_FIRST) & BASE64_SEXTET_MASK];
+        out[INDEX_SECOND] = chars[(group >> BASE64_SHIFT_SECOND) & BASE64_SEXTET_MASK];
+        out[INDEX_THIRD] = chars[(group >> BASE64_SEXTET_BITS) & BASE64_SEXTET_MASK];
+        out[INDEX_FORTH] = chars[group & BASE64_SEXTET_MASK];
+        in += BASE64_GROUP_BYTES;
+        out += BASE64_GROUP_CHARS;
     }
 
-    if (i) {
-        uint32_t j = 0;
-        for (j = i; j < sizeof(charArray3); j++) {
-            charArray3[j] = '\0';
-        }
-        charArray4[INDEX_FIRST] = (charArray3[INDEX_FIRST] & 0xfc) >> OFFSET2;
-        charArray4[INDEX_SECOND] = ((charArray3[INDEX_FIRST] & 0x03) << OFFSET4) +
-            ((charArray3[INDEX_SECOND] & 0xf0) >> OFFSET4);
-        charArray4[INDEX_THIRD] = ((charArray3[INDEX_SECOND] & 0x0f) << OFFSET2) +
-            ((charArray3[INDEX_THIRD] & 0xc0) >> OFFSET6);
-        charArray4[INDEX_FORTH] = charArray3[INDEX_THIRD] & 0x3f;
-        for (j = 0; j < i + 1; j++) {
-            ret += BASE_64_CHARS[charArray4[j]];
+    uint32_t tail = len % BASE64_GROUP_BYTES;
+    if (tail != 0) {
+        uint32_t group = static_cast<uint32_t>(in[INDEX_FIRST]) << BASE64_SHIFT_BYTE_FIRST;
+        if (tail > 1) {
+            group |= static_cast<uint32_t>(in[INDEX_SECOND]) << BASE64_SHIFT_BYTE_SECOND;
         }
-        while (i++ < sizeof(charArray3)) {
-            ret += '=';
+        out[INDEX_FIRST] = chars[(group >> BASE64_SHIFT_FIRST) & BASE64_SEXTET_MASK];
+        out[INDEX_SECOND] = chars[(group >> BASE64_SHIFT_SECOND) & BASE64_SEXTET_MASK];
+        if (tail > 1) {
+            out[INDEX_THIRD] = chars[(group >> BASE64_SEXTET_BITS) & BASE64_SEXTET_MASK];
         }
     }
     return ret;
@@ -103,49 +145,61 @@ std::string Base64Encode(const unsigned char *toEncode, unsigned int len)
 
 std::string Base64Decode(const std::string& basicString)
 {
-    std::string ret;
-    uint32_t i = 0;
-    int index = 0;
-    int len = static_cast<int>(basicString.size());
-    unsigned char charArray3[3];
-    unsigned char charArray4[4];
-
-    while (len-- && (basicString[index] != '=') && IsBase64(basicString[index])) {
-        charArray4[i++] = basicString[index];
-        index++;
-        if (i == sizeof(charArray4)) {
-            for (i = 0; i < sizeof(charArray4); i++) {
-                charArray4[i] = BASE_64_CHARS.find(charArray4[i]);
-            }
-            charArray3[INDEX_FIRST] = (charArray4[INDEX_FIRST] << OFFSET2) +
-                ((charArray4[INDEX_SECOND] & 0x30) >> OFFSET4);
-            charArray3[INDEX_SECOND] = ((charArray4[INDEX_SECOND] & 0xf) << OFFSET4) +
-                ((charArray4[INDEX_THIRD] & 0x3c) >> OFFSET2);
-            charArray3[INDEX_THIRD] = ((charArray4[INDEX_THIRD] & 0x3) << OFFSET6) + charArray4[INDEX_FORTH];
-            for (i = 0; i < sizeof(charArray3); i++) {
-                ret += charArray3[i];
-            }
-            i = 0;
-        }
+    size_t len = basicString.size();
+    if (len == 0) {
+        return "";
+    }
+    if (len % BASE64_GROUP_CHARS != 0) {
+        DHLOGE("Base64Decode invalid length: %zu", len);
+        return "";
+    }
+    size_t padding = 0;
+    if (basicString[len - 1] == BASE64_PAD) {
+        padding = (basicString[len - OFFSET2] == BASE64_PAD) ? OFFSET2 : 1;
     }
 
-    if (i) {
-        uint32_t j = 0;
-        for (j = i; j < sizeof(charArray4); j++) {
-            charArray4[j] = 0;
-        }
-        for (j = 0; j < sizeof(charArray4); j++) {
-            charArray4[j] = BASE_64_CHARS.find(charArray4[j]);
+    const uint8_t *table = GetBase64DecodeTable();
+    const unsigned char *in = reinterpret_cast<const unsigned char *>(basicString.data());
+    std::string ret(len / BASE64_GROUP_CHARS * BASE64_GROUP_BYTES - padding, '\0');
+    char *out = &ret[0];
+    size_t fullGroups = (padding == 0) ? (len / BASE64_GROUP_CHARS) : (len / BASE64_GROUP_CHARS - 1);
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < fullGroups; i++) {
+        uint8_t a = table[in[INDEX_FIRST]];
+        uint8_t b = table[in[INDEX_SECOND]];
+        uint8_t c = table[in[INDEX_THIRD]];
+        uint8_t d = table[in[INDEX_FORTH]];
+        invalid |= (a | b | c | d);
+        uint32_t group = (static_cast<uint32_t>(a) << BASE64_SHIFT_FIRST) |
+            (static_cast<uint32_t>(b) << BASE64_SHIFT_SECOND) | (static_cast<uint32_t>(c) << BASE64_SEXTET_BITS) | d;
+        out[INDEX_FIRST] = static_cast<char>((group >> BASE64_SHIFT_BYTE_FIRST) & BASE64_BYTE_MASK);
+        out[INDEX_SECOND] = static_cast<char>((group >> BASE64_SHIFT_BYTE_SECOND) & BASE64_BYTE_MASK);
+        out[INDEX_THIRD] = static_cast<char>(group & BASE64_BYTE_MASK);
+        in += BASE64_GROUP_CHARS;
+        out += BASE64_GROUP_BYTES;
+    }
+
+    if (padding != 0) {
+        uint8_t a = table[in[INDEX_FIRST]];
+        uint8_t b = table[in[INDEX_SECOND]];
+        uint8_t c = (padding == 1) ? table[in[INDEX_THIRD]] : 0;
+        invalid |= (a | b | c);
+        uint8_t unusedBits = (padding == 1) ? (c & BASE64_PAD_ONE_MASK) : (b & BASE64_PAD_TWO_MASK);
+        if (unusedBits != 0) {
+            invalid |= BASE64_INVALID;
         }
-        charArray3[INDEX_FIRST] = (charArray4[INDEX_FIRST] << OFFSET2) +
-            ((charArray4[INDEX_SECOND] & 0x30) >> OFFSET4);
-        charArray3[INDEX_SECOND] = ((charArray4[INDEX_SECOND] & 0xf) << OFFSET4) +
-            ((charArray4[INDEX_THIRD] & 0x3c) >> OFFSET2);
-        charArray3[INDEX_THIRD] = ((charArray4[INDEX_THIRD] & 0x3) << OFFSET6) + charArray4[INDEX_FORTH];
-        for (j = 0; j < i - 1; j++) {
-            ret += charArray3[j];
+        uint32_t group = (static_cast<uint32_t>(a) << BASE64_SHIFT_FIRST) |
+            (static_cast<uint32_t>(b) << BASE64_SHIFT_SECOND) | (static_cast<uint32_t>(c) << BASE64_SEXTET_BITS);
+        out[INDEX_FIRST] = static_cast<char>((group >> BASE64_SHIFT_BYTE_FIRST) & BASE64_BYTE_MASK);
+        if (padding == 1) {
+            out[INDEX_SECOND] = static_cast<char>((group >> BASE64_SHIFT_BYTE_SECOND) & BASE64_BYTE_MASK);
         }
     }
+
+    if ((invalid & BASE64_INVALID_MASK) != 0) {
+        DHLOGE("Base64Decode invalid character in input");
+        return "";
+    }
     return ret;
 }
 
@@ -153,5 +207,294 @@ bool IsBase64(unsigned char c)
 {
     return (isalnum(c) || (c == '+') || (c == '/'));
 }
+
+uint32_t GetMaxFrameRate(int32_t width, int32_t height, uint32_t maxFps)
+{
+    if (width <= 0 || height <= 0) {
+        return maxFps;
+    }
+    uint64_t pixelRateFps = DCAMERA_MAX_PIXEL_RATE / (static_cast<uint64_t>(width) * static_cast<uint64_t>(height));
+    uint32_t fps = pixelRateFps < maxFps ? static_cast<uint32_t>(pixelRateFps) : maxFps;
+    return fps < DCAMERA_PRODUCER_FPS_MIN ? DCAMERA_PRODUCER_FPS_MIN : fps;
+}
+
+std::string FpsRangeToString(uint32_t minFps, uint32_t maxFps)
+{
+    return std::to_string(minFps) + FPS_RANGE_SEPARATOR + std::to_string(maxFps);
+}
+
+bool ParseFpsRange(const std::string& fpsRange, uint32_t& minFps, uint32_t& maxFps)
+{
+    size_t pos = fpsRange.find(FPS_RANGE_SEPARATOR);
+    if (pos == std::string::npos || pos == 0 || pos + FPS_RANGE_SEPARATOR.size() >= fpsRange.size()) {
+        return false;
+    }
+    char *end = nullptr;
+    std::string minStr = fpsRange.substr(0, pos);
+    std::string maxStr = fpsRange.substr(pos + FPS_RANGE_SEPARATOR.size());
+    unsigned long minValue = strtoul(minStr.c_str(), &end, DECIMAL_BASE);
+    if (end == nullptr || *end != '\0') {
+        return false;
+    }
+    unsigned long maxValue = strtoul(maxStr.c_str(), &end, DECIMAL_BASE);
+    if (end == nullptr || *end != '\0') {
+        return false;
+    }
+    if (minValue == 0 || minValue > maxValue || maxValue > DCAMERA_PRODUCER_FPS_MAX) {
+        return false;
+    }
+    minFps = static_cast<uint32_t>(minValue);
+    maxFps = static_cast<uint32_t>(maxValue);
+    return true;
+}
+
+/*
+ * METADATA_RESULT value: "<generation>,<F|D>,<base64 metadata>". A snapshot (F)
+ * carries every result tag and replaces the receiver's copy, a delta (D) only
+ * carries the tags changed since generation - 1.
+ */
+std::string PackResultMetadata(uint32_t generation, bool isSnapshot, const std::string& metadata)
+{
+    std::string value = std::to_string(generation);
+    value.append(RESULT_METADATA_SEPARATOR);
+    value.append(isSnapshot ? RESULT_METADATA_SNAPSHOT : RESULT_METADATA_DELTA);
+    value.append(RESULT_METADATA_SEPARATOR);
+    value.append(metadata);
+    return value;
+}
+
+bool UnpackResultMetadata(const std::string& value, uint32_t& generation, bool& isSnapshot, std::string& metadata)
+{
+    size_t typePos = value.find(RESULT_METADATA_SEPARATOR);
+    if (typePos == std::string::npos || typePos == 0) {
+        return false;
+    }
+    typePos += RESULT_METADATA_SEPARATOR.size();
+    size_t dataPos = value.find(RESULT_METADATA_SEPARATOR, typePos);
+    if (dataPos == std::string::npos) {
+        return false;
+    }
+
+    char *end = nullptr;
+    std::string genStr = value.substr(0, typePos - RESULT_METADATA_SEPARATOR.size());
+    unsigned long genValue = strtoul(genStr.c_str(), &end, DECIMAL_BASE);
+    if (end == nullptr || *end != '\0' || genValue > UINT32_MAX) {
+        return false;
+    }
+    std::string type = value.substr(typePos, dataPos - typePos);
+    if (type != RESULT_METADATA_SNAPSHOT && type != RESULT_METADATA_DELTA) {
+        return false;
+    }
+    generation = static_cast<uint32_t>(genValue);
+    isSnapshot = (type == RESULT_METADATA_SNAPSHOT);
+    metadata = value.substr(dataPos + RESULT_METADATA_SEPARATOR.size());
+    return !metadata.empty();
+}
+
+namespace {
+bool IsStandaloneMarker(uint8_t marker)
+{
+    return marker == JPEG_MARKER_TEM || (marker >= JPEG_MARKER_RST0 && marker <= JPEG_MARKER_RST7);
+}
+
+// Returns the position of the marker that ends the entropy coded data starting at pos, stuffed FF 00 bytes
+// and restart markers belong to the scan.
+size_t SkipEntropyData(const uint8_t *data, size_t size, size_t pos)
+{
+    while (pos + 1 < size) {
+        const void *found = memchr(data + pos, JPEG_MARKER_PREFIX, size - pos - 1);
+        if (found == nullptr) {
+            return size;
+        }
+        pos = static_cast<size_t>(static_cast<const uint8_t *>(found) - data);
+        uint8_t next = data[pos + 1];
+        if (next == JPEG_MARKER_PREFIX) {
+            pos++;
+        } else if (next == JPEG_STUFFED_BYTE || IsStandaloneMarker(next)) {
+            pos += JPEG_MARKER_LEN;
+        } else {
+            return pos;
+        }
+    }
+    return size;
+}
+}
+
+size_t GetJpegSize(const uint8_t *data, size_t size)
+{
+    // a jpeg surface buffer is allocated for the worst case and may still hold an older picture past the end
+    // of this one, so the picture ends at the first EOI reached by walking its segments and scans
+    if (data == nullptr || size < JPEG_MARKER_LEN || data[INDEX_FIRST] != JPEG_MARKER_PREFIX ||
+        data[INDEX_SECOND] != JPEG_MARKER_SOI) {
+        return size;
+    }
+    size_t pos = JPEG_MARKER_LEN;
+    while (pos + JPEG_MARKER_LEN <= size && data[pos] == JPEG_MARKER_PREFIX) {
+        uint8_t marker = data[pos + 1];
+        if (marker == JPEG_MARKER_EOI) {
+            return pos + JPEG_MARKER_LEN;
+        }
+        if (marker == JPEG_MARKER_PREFIX) {
+            pos++;
+            continue;
+        }
+        if (IsStandaloneMarker(marker)) {
+            pos += JPEG_MARKER_LEN;
+            continue;
+        }
+        if (pos + JPEG_SEGMENT_HEADER_LEN > size) {
+            break;
+        }
+        size_t segmentLen = (static_cast<size_t>(data[pos + OFFSET2]) << DCAMERA_SHIFT_8) | data[pos + INDEX_FORTH];
+        if (segmentLen < JPEG_MARKER_LEN || segmentLen > size - pos - JPEG_MARKER_LEN) {
+            break;
+        }
+        pos += JPEG_MARKER_LEN + segmentLen;
+        if (marker == JPEG_MARKER_SOS) {
+            pos = SkipEntropyData(data, size, pos);
+        }
+    }
+    return size;
+}
+
+namespace {
+const uint8_t EXIF_IDENTIFIER[] = { 'E', 'x', 'i', 'f', 0, 0 };
+const uint8_t TIFF_BYTE_ORDER_INTEL = 'I';
+const size_t TIFF_HEADER_LEN = 8;
+const size_t TIFF_IFD0_OFFSET_POS = 4;
+const size_t TIFF_IFD_COUNT_LEN = 2;
+const size_t TIFF_IFD_ENTRY_LEN = 12;
+const size_t TIFF_IFD_NEXT_LEN = 4;
+const size_t TIFF_ENTRY_VALUE_POS = 8;
+const uint16_t TIFF_TAG_THUMBNAIL_OFFSET = 0x0201;
+const uint16_t TIFF_TAG_THUMBNAIL_LENGTH = 0x0202;
+
+uint16_t TiffGet16(const uint8_t *ptr, bool isIntel)
+{
+    return isIntel ? static_cast<uint16_t>(ptr[INDEX_FIRST] | (ptr[INDEX_SECOND] << DCAMERA_SHIFT_8)) :
+        static_cast<uint16_t>((ptr[INDEX_FIRST] << DCAMERA_SHIFT_8) | ptr[INDEX_SECOND]);
+}
+
+uint32_t TiffGet32(const uint8_t *ptr, bool isIntel)
+{
+    uint32_t first = TiffGet16(ptr, isIntel);
+    uint32_t second = TiffGet16(ptr + OFFSET2, isIntel);
+    return isIntel ? (first | (second << DCAMERA_SHIFT_16)) : ((first << DCAMERA_SHIFT_16) | second);
+}
+
+// The thumbnail of an EXIF block is described by the JPEGInterchangeFormat tags of IFD1, with offsets
+// counted from the start of the TIFF header.
+bool GetExifThumbnail(const uint8_t *tiff, size_t size, size_t& offset, size_t& length)
+{
+    if (size < TIFF_HEADER_LEN) {
+        return false;
+    }
+    bool isIntel = (tiff[INDEX_FIRST] == TIFF_BYTE_ORDER_INTEL);
+    size_t ifdPos = TiffGet32(tiff + TIFF_IFD0_OFFSET_POS, isIntel);
+    if (ifdPos > size - TIFF_IFD_COUNT_LEN) {
+        return false;
+    }
+    size_t entryNum = TiffGet16(tiff + ifdPos, isIntel);
+    size_t nextPos = ifdPos + TIFF_IFD_COUNT_LEN + entryNum * TIFF_IFD_ENTRY_LEN;
+    if (nextPos > size - TIFF_IFD_NEXT_LEN) {
+        return false;
+    }
+    ifdPos = TiffGet32(tiff + nextPos, isIntel);
+    if (ifdPos == 0 || ifdPos > size - TIFF_IFD_COUNT_LEN) {
+        return false;
+    }
+    entryNum = TiffGet16(tiff + ifdPos, isIntel);
+    size_t thumbOffset = 0;
+    size_t thumbLength = 0;
+    for (size_t i = 0; i < entryNum; i++) {
+        size_t entryPos = ifdPos + TIFF_IFD_COUNT_LEN + i * TIFF_IFD_ENTRY_LEN;
+        if (entryPos > size - TIFF_IFD_ENTRY_LEN) {
+            return false;
+        }
+        uint16_t tag = TiffGet16(tiff + entryPos, isIntel);
+        if (tag == TIFF_TAG_THUMBNAIL_OFFSET) {
+            thumbOffset = TiffGet32(tiff + entryPos + TIFF_ENTRY_VALUE_POS, isIntel);
+        } else if (tag == TIFF_TAG_THUMBNAIL_LENGTH) {
+            thumbLength = TiffGet32(tiff + entryPos + TIFF_ENTRY_VALUE_POS, isIntel);
+        }
+    }
+    if (thumbLength < JPEG_MARKER_LEN || thumbLength > size || thumbOffset > size - thumbLength) {
+        return false;
+    }
+    if (tiff[thumbOffset] != JPEG_MARKER_PREFIX || tiff[thumbOffset + 1] != JPEG_MARKER_SOI) {
+        return false;
+    }
+    offset = thumbOffset;
+    length = thumbLength;
+    return true;
+}
+}
+
+bool GetJpegThumbnail(const uint8_t *data, size_t size, size_t& offset, size_t& length)
+{
+    // only the marker segments ahead of the scan data are walked, the picture itself is never touched
+    if (data == nullptr || size < JPEG_MARKER_LEN || data[INDEX_FIRST] != JPEG_MARKER_PREFIX ||
+        data[INDEX_SECOND] != JPEG_MARKER_SOI) {
+        return false;
+    }
+    size_t pos = JPEG_MARKER_LEN;
+    while (pos + JPEG_SEGMENT_HEADER_LEN <= size && data[pos] == JPEG_MARKER_PREFIX) {
+        uint8_t marker = data[pos + 1];
+        if (marker == JPEG_MARKER_SOS || marker == JPEG_MARKER_EOI) {
+            return false;
+        }
+        size_t segmentLen = (static_cast<size_t>(data[pos + OFFSET2]) << DCAMERA_SHIFT_8) | data[pos + INDEX_FORTH];
+        if (segmentLen < JPEG_MARKER_LEN || segmentLen > size - pos - JPEG_MARKER_LEN) {
+            return false;
+        }
+        size_t payloadPos = pos + JPEG_SEGMENT_HEADER_LEN;
+        size_t payloadLen = segmentLen - JPEG_MARKER_LEN;
+        if (marker == JPEG_MARKER_APP1 && payloadLen > sizeof(EXIF_IDENTIFIER) &&
+            std::equal(EXIF_IDENTIFIER, EXIF_IDENTIFIER + sizeof(EXIF_IDENTIFIER), data + payloadPos)) {
+            size_t tiffPos = payloadPos + sizeof(EXIF_IDENTIFIER);
+            if (!GetExifThumbnail(data + tiffPos, payloadLen - sizeof(EXIF_IDENTIFIER), offset, length)) {
+                return false;
+            }
+            offset += tiffPos;
+            return true;
+        }
+        pos += JPEG_MARKER_LEN + segmentLen;
+    }
+    return false;
+}
+
+bool IsThumbnailSize(int32_t width, int32_t height)
+{
+    return (width > 0) && (height > 0) &&
+        (static_cast<uint64_t>(width) * static_cast<uint64_t>(height) <= DCAMERA_THUMBNAIL_MAX_PIXELS);
+}
+
+uint32_t GetBurstDepth(int32_t width, int32_t height, uint32_t depth)
+{
+    // every picture of a burst may be in flight at once, sized for the worst case of an uncompressed frame
+    uint32_t maxDepth = DCAMERA_BURST_MAX_DEPTH;
+    if (width > 0 && height > 0) {
+        uint64_t photoBytes = static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * YUV_BYTES_NUMERATOR /
+            YUV_BYTES_DENOMINATOR;
+        uint64_t memDepth = DCAMERA_BURST_MEMORY_MAX / photoBytes;
+        maxDepth = memDepth < maxDepth ? static_cast<uint32_t>(memDepth) : maxDepth;
+    }
+    depth = depth < maxDepth ? depth : maxDepth;
+    return depth == 0 ? 1 : depth;
+}
+
+bool ParseBurstDepth(const std::string& value, uint32_t& depth)
+{
+    if (value.empty()) {
+        return false;
+    }
+    char *end = nullptr;
+    unsigned long depthValue = strtoul(value.c_str(), &end, DECIMAL_BASE);
+    if (end == nullptr || *end != '\0' || depthValue == 0 || depthValue > DCAMERA_BURST_MAX_DEPTH) {
+        return false;
+    }
+    depth = static_cast<uint32_t>(depthValue);
+    return true;
+}
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef OHOS_DCAMERA_CAPTURE_INFO_H
 #define OHOS_DCAMERA_CAPTURE_INFO_H
 
+#include "dcamera_protocol_codec.h"
 #include "distributed_camera_constants.h"
 #include "json/json.h"
 #include "types.h"
@@ -44,10 +45,14 @@ public:
 public:
     int32_t Marshal(std::string& jsonStr);
     int32_t Unmarshal(const std::string& jsonStr);
+    int32_t Unmarshal(const Json::Value& rootValue);
+    int32_t Marshal(std::vector<uint8_t>& data);
+    int32_t Unmarshal(const uint8_t *data, size_t size);
 
 private:
-    int32_t UmarshalValue(Json::Value& rootValue);
-    int32_t UmarshalSettings(Json::Value& valueJson, std::shared_ptr<DCameraCaptureInfo>& captureInfo);
+    int32_t UmarshalValue(const Json::Value& rootValue);
+    int32_t UmarshalSettings(const Json::Value& valueJson, std::shared_ptr<DCameraCaptureInfo>& captureInfo);
+    int32_t UmarshalCaptureInfo(DCameraProtocolReader& reader, std::shared_ptr<DCameraCaptureInfo>& captureInfo);
 };
 } // namespace DistributedHardware
 } // namespace OHOS
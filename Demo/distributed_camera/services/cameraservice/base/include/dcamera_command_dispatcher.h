@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_COMMAND_DISPATCHER_H
+#define OHOS_DCAMERA_COMMAND_DISPATCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+#include "json/json.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+/*
+ * A control message parsed exactly once. JSON messages keep their parsed
+ * document so typed commands unmarshal from it instead of re-reading the text,
+ * binary messages keep the raw frame for the command's binary decoder.
+ */
+class DCameraCommandPacket {
+public:
+    DCameraCommandPacket() = default;
+    ~DCameraCommandPacket() = default;
+
+    int32_t Parse(const uint8_t *data, size_t size);
+    const std::string& GetCommand() const;
+
+    template<typename T>
+    int32_t Unmarshal(T& cmd) const
+    {
+        return isBinary_ ? cmd.Unmarshal(data_, size_) : cmd.Unmarshal(rootValue_);
+    }
+
+private:
+    bool isBinary_ = false;
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    std::string command_;
+    Json::Value rootValue_;
+};
+
+class DCameraCommandDispatcher {
+public:
+    using CommandHandler = std::function<int32_t(const DCameraCommandPacket& packet)>;
+
+    DCameraCommandDispatcher() = default;
+    ~DCameraCommandDispatcher() = default;
+
+    void RegisterHandler(const std::string& command, CommandHandler handler);
+    int32_t Dispatch(const uint8_t *data, size_t size) const;
+
+private:
+    std::map<std::string, CommandHandler> handlers_;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_COMMAND_DISPATCHER_H
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_COMMAND_PACKER_H
+#define OHOS_DCAMERA_COMMAND_PACKER_H
+
+#include <memory>
+#include <securec.h>
+#include <string>
+#include <vector>
+
+#include "data_buffer.h"
+#include "dcamera_protocol_codec.h"
+#include "distributed_camera_errno.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+/*
+ * Packs a control command into a channel buffer with the negotiated codec. Binary frames are sent with
+ * their exact size, JSON keeps the trailing NUL the receivers of older versions expect.
+ */
+template<typename T>
+int32_t PackCommand(T& cmd, uint32_t codecVersion, std::shared_ptr<DataBuffer>& buffer)
+{
+    if (codecVersion != DCAMERA_CMD_CODEC_JSON) {
+        std::vector<uint8_t> data;
+        int32_t ret = cmd.Marshal(data);
+        if (ret != DCAMERA_OK) {
+            return ret;
+        }
+        buffer = std::make_shared<DataBuffer>(data.size());
+        ret = memcpy_s(buffer->Data(), buffer->Capacity(), data.data(), data.size());
+        return (ret == EOK) ? DCAMERA_OK : DCAMERA_MEMORY_OPT_ERROR;
+    }
+
+    std::string jsonStr;
+    int32_t ret = cmd.Marshal(jsonStr);
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+    buffer = std::make_shared<DataBuffer>(jsonStr.length() + 1);
+    ret = memcpy_s(buffer->Data(), buffer->Capacity(), (uint8_t *)jsonStr.c_str(), jsonStr.length());
+    return (ret == EOK) ? DCAMERA_OK : DCAMERA_MEMORY_OPT_ERROR;
+}
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_COMMAND_PACKER_H
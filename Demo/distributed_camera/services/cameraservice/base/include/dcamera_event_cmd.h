@@ -18,6 +18,9 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "json/json.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -38,6 +41,9 @@ public:
 public:
     int32_t Marshal(std::string& jsonStr);
     int32_t Unmarshal(const std::string& jsonStr);
+    int32_t Unmarshal(const Json::Value& rootValue);
+    int32_t Marshal(std::vector<uint8_t>& data);
+    int32_t Unmarshal(const uint8_t *data, size_t size);
 };
 } // namespace DistributedHardware
 } // namespace OHOS
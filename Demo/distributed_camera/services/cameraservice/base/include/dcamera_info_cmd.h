@@ -19,6 +19,9 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "json/json.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -42,6 +45,9 @@ public:
 public:
     int32_t Marshal(std::string& jsonStr);
     int32_t Unmarshal(const std::string& jsonStr);
+    int32_t Unmarshal(const Json::Value& rootValue);
+    int32_t Marshal(std::vector<uint8_t>& data);
+    int32_t Unmarshal(const uint8_t *data, size_t size);
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef OHOS_DCAMERA_METADATA_SETTING_H
 #define OHOS_DCAMERA_METADATA_SETTING_H
 
+#include "json/json.h"
 #include "types.h"
 
 namespace OHOS {
@@ -30,6 +31,9 @@ public:
 public:
     int32_t Marshal(std::string& jsonStr);
     int32_t Unmarshal(const std::string& jsonStr);
+    int32_t Unmarshal(const Json::Value& rootValue);
+    int32_t Marshal(std::vector<uint8_t>& data);
+    int32_t Unmarshal(const uint8_t *data, size_t size);
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -20,6 +20,8 @@
 #include <string>
 #include <vector>
 
+#include "json/json.h"
+
 namespace OHOS {
 namespace DistributedHardware {
 class DCameraOpenInfo {
@@ -28,6 +30,7 @@ public:
     DCameraOpenInfo(std::string sourceDevId) : sourceDevId_(sourceDevId) {}
     ~DCameraOpenInfo() = default;
     std::string sourceDevId_;
+    uint32_t cmdCodecVersion_ = 0;
 };
 
 class DCameraOpenInfoCmd {
@@ -40,6 +43,9 @@ public:
 public:
     int32_t Marshal(std::string& jsonStr);
     int32_t Unmarshal(const std::string& jsonStr);
+    int32_t Unmarshal(const Json::Value& rootValue);
+    int32_t Marshal(std::vector<uint8_t>& data);
+    int32_t Unmarshal(const uint8_t *data, size_t size);
 };
 } // namespace DistributedHardware
 } // namespace OHOS
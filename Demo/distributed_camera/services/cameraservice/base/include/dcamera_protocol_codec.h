@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_PROTOCOL_CODEC_H
+#define OHOS_DCAMERA_PROTOCOL_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace DistributedHardware {
+/*
+ * Binary command frame:
+ *   magic(1) | version(1) | payload length(4, little endian) | payload
+ * payload:
+ *   Type | dhId | Command | Value
+ * Integers in the payload are LEB128 varints (zigzag for signed values) and
+ * strings are a varint length followed by the raw bytes. The magic byte can
+ * never start a JSON document, so receivers tell both encodings apart by the
+ * first byte and JSON stays a valid fallback.
+ */
+const uint8_t DCAMERA_CMD_BINARY_MAGIC = 0xDC;
+const uint32_t DCAMERA_CMD_CODEC_JSON = 0;
+const uint32_t DCAMERA_CMD_CODEC_BINARY_V1 = 1;
+const uint32_t DCAMERA_CMD_CODEC_VERSION = DCAMERA_CMD_CODEC_BINARY_V1;
+const size_t DCAMERA_CMD_BINARY_HEADER_LEN = 6;
+
+class DCameraProtocolWriter {
+public:
+    DCameraProtocolWriter(const std::string& type, const std::string& dhId, const std::string& command);
+    ~DCameraProtocolWriter() = default;
+
+    void WriteUint32(uint32_t value);
+    void WriteInt32(int32_t value);
+    void WriteBool(bool value);
+    void WriteString(const std::string& value);
+    void Finish(std::vector<uint8_t>& data);
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+class DCameraProtocolReader {
+public:
+    DCameraProtocolReader(const uint8_t *data, size_t size);
+    ~DCameraProtocolReader() = default;
+
+    int32_t ReadHeader(std::string& type, std::string& dhId, std::string& command);
+    bool ReadUint32(uint32_t& value);
+    bool ReadInt32(int32_t& value);
+    bool ReadBool(bool& value);
+    bool ReadString(std::string& value);
+
+private:
+    const uint8_t *data_;
+    size_t size_;
+    size_t offset_;
+};
+
+bool IsBinaryCommand(const uint8_t *data, size_t size);
+int32_t GetBinaryCommand(const uint8_t *data, size_t size, std::string& command);
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_PROTOCOL_CODEC_H
@@ -40,6 +40,8 @@ public:
     virtual int32_t CloseChannel() = 0;
     virtual int32_t Init(std::vector<DCameraIndex>& indexs) = 0;
     virtual int32_t UnInit() = 0;
+    virtual int32_t EnableStandby() = 0;
+    virtual int32_t DisableStandby() = 0;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
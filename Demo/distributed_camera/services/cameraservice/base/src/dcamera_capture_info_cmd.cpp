@@ -68,6 +68,14 @@ int32_t DCameraCaptureInfoCmd::Unmarshal(const std::string& jsonStr)
         !rootValue.isObject()) {
         return DCAMERA_BAD_VALUE;
     }
+    return Unmarshal(rootValue);
+}
+
+int32_t DCameraCaptureInfoCmd::Unmarshal(const Json::Value& rootValue)
+{
+    if (!rootValue.isObject()) {
+        return DCAMERA_BAD_VALUE;
+    }
 
     if (!rootValue.isMember("Type") || !rootValue["Type"].isString()) {
         return DCAMERA_BAD_VALUE;
@@ -95,10 +103,10 @@ int32_t DCameraCaptureInfoCmd::Unmarshal(const std::string& jsonStr)
     return DCAMERA_OK;
 }
 
-int32_t DCameraCaptureInfoCmd::UmarshalValue(Json::Value& rootValue)
+int32_t DCameraCaptureInfoCmd::UmarshalValue(const Json::Value& rootValue)
 {
     for (Json::ArrayIndex i = 0; i < rootValue["Value"].size(); i++) {
-        Json::Value valueJson = rootValue["Value"][i];
+        const Json::Value& valueJson = rootValue["Value"][i];
         std::shared_ptr<DCameraCaptureInfo> captureInfo = std::make_shared<DCameraCaptureInfo>();
         if (!valueJson.isMember("Width") || !valueJson["Width"].isInt()) {
             return DCAMERA_BAD_VALUE;
@@ -148,11 +156,11 @@ int32_t DCameraCaptureInfoCmd::UmarshalValue(Json::Value& rootValue)
     return DCAMERA_OK;
 }
 
-int32_t DCameraCaptureInfoCmd::UmarshalSettings(Json::Value& valueJson,
+int32_t DCameraCaptureInfoCmd::UmarshalSettings(const Json::Value& valueJson,
     std::shared_ptr<DCameraCaptureInfo>& captureInfo)
 {
     for (Json::ArrayIndex j = 0; j < valueJson["CaptureSettings"].size(); j++) {
-        Json::Value settingJson = valueJson["CaptureSettings"][j];
+        const Json::Value& settingJson = valueJson["CaptureSettings"][j];
         if (!settingJson.isMember("SettingType") || !settingJson["SettingType"].isInt()) {
             return DCAMERA_BAD_VALUE;
         }
@@ -166,5 +174,79 @@ int32_t DCameraCaptureInfoCmd::UmarshalSettings(Json::Value& valueJson,
     }
     return DCAMERA_OK;
 }
+
+int32_t DCameraCaptureInfoCmd::Marshal(std::vector<uint8_t>& data)
+{
+    DCameraProtocolWriter writer(type_, dhId_, command_);
+    writer.WriteUint32(static_cast<uint32_t>(value_.size()));
+    for (auto iter = value_.begin(); iter != value_.end(); iter++) {
+        std::shared_ptr<DCameraCaptureInfo> capture = *iter;
+        writer.WriteInt32(capture->width_);
+        writer.WriteInt32(capture->height_);
+        writer.WriteInt32(capture->format_);
+        writer.WriteInt32(capture->dataspace_);
+        writer.WriteBool(capture->isCapture_);
+        writer.WriteInt32(capture->encodeType_);
+        writer.WriteInt32(capture->streamType_);
+        writer.WriteUint32(static_cast<uint32_t>(capture->captureSettings_.size()));
+        for (auto settingIter = capture->captureSettings_.begin();
+            settingIter != capture->captureSettings_.end(); settingIter++) {
+            writer.WriteInt32((*settingIter)->type_);
+            writer.WriteString((*settingIter)->value_);
+        }
+    }
+    writer.Finish(data);
+    return DCAMERA_OK;
+}
+
+int32_t DCameraCaptureInfoCmd::Unmarshal(const uint8_t *data, size_t size)
+{
+    DCameraProtocolReader reader(data, size);
+    int32_t ret = reader.ReadHeader(type_, dhId_, command_);
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+
+    uint32_t count = 0;
+    if (!reader.ReadUint32(count)) {
+        return DCAMERA_BAD_VALUE;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        std::shared_ptr<DCameraCaptureInfo> captureInfo = std::make_shared<DCameraCaptureInfo>();
+        ret = UmarshalCaptureInfo(reader, captureInfo);
+        if (ret != DCAMERA_OK) {
+            return ret;
+        }
+        value_.push_back(captureInfo);
+    }
+    return DCAMERA_OK;
+}
+
+int32_t DCameraCaptureInfoCmd::UmarshalCaptureInfo(DCameraProtocolReader& reader,
+    std::shared_ptr<DCameraCaptureInfo>& captureInfo)
+{
+    int32_t encodeType = 0;
+    int32_t streamType = 0;
+    uint32_t settingCount = 0;
+    if (!reader.ReadInt32(captureInfo->width_) || !reader.ReadInt32(captureInfo->height_) ||
+        !reader.ReadInt32(captureInfo->format_) || !reader.ReadInt32(captureInfo->dataspace_) ||
+        !reader.ReadBool(captureInfo->isCapture_) || !reader.ReadInt32(encodeType) ||
+        !reader.ReadInt32(streamType) || !reader.ReadUint32(settingCount)) {
+        return DCAMERA_BAD_VALUE;
+    }
+    captureInfo->encodeType_ = (DCEncodeType)encodeType;
+    captureInfo->streamType_ = (DCStreamType)streamType;
+
+    for (uint32_t i = 0; i < settingCount; i++) {
+        int32_t settingType = 0;
+        std::shared_ptr<DCameraSettings> setting = std::make_shared<DCameraSettings>();
+        if (!reader.ReadInt32(settingType) || !reader.ReadString(setting->value_)) {
+            return DCAMERA_BAD_VALUE;
+        }
+        setting->type_ = (DCSettingsType)settingType;
+        captureInfo->captureSettings_.push_back(setting);
+    }
+    return DCAMERA_OK;
+}
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -17,6 +17,7 @@
 
 #include "json/json.h"
 
+#include "dcamera_protocol_codec.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
@@ -57,6 +58,14 @@ int32_t DCameraChannelInfoCmd::Unmarshal(const std::string& jsonStr)
         !rootValue.isObject()) {
         return DCAMERA_BAD_VALUE;
     }
+    return Unmarshal(rootValue);
+}
+
+int32_t DCameraChannelInfoCmd::Unmarshal(const Json::Value& rootValue)
+{
+    if (!rootValue.isObject()) {
+        return DCAMERA_BAD_VALUE;
+    }
 
     if (!rootValue.isMember("Type") || !rootValue["Type"].isString()) {
         return DCAMERA_BAD_VALUE;
@@ -76,7 +85,7 @@ int32_t DCameraChannelInfoCmd::Unmarshal(const std::string& jsonStr)
     if (!rootValue.isMember("Value") || !rootValue["Value"].isObject()) {
         return DCAMERA_BAD_VALUE;
     }
-    Json::Value valueJson = rootValue["Value"];
+    const Json::Value& valueJson = rootValue["Value"];
 
     if (!valueJson.isMember("SourceDevId") || !valueJson["SourceDevId"].isString()) {
         return DCAMERA_BAD_VALUE;
@@ -104,5 +113,44 @@ int32_t DCameraChannelInfoCmd::Unmarshal(const std::string& jsonStr)
     value_ = channelInfo;
     return DCAMERA_OK;
 }
+
+int32_t DCameraChannelInfoCmd::Marshal(std::vector<uint8_t>& data)
+{
+    DCameraProtocolWriter writer(type_, dhId_, command_);
+    writer.WriteString(value_->sourceDevId_);
+    writer.WriteUint32(static_cast<uint32_t>(value_->detail_.size()));
+    for (auto iter = value_->detail_.begin(); iter != value_->detail_.end(); iter++) {
+        writer.WriteString(iter->dataSessionFlag_);
+        writer.WriteInt32(iter->streamType_);
+    }
+    writer.Finish(data);
+    return DCAMERA_OK;
+}
+
+int32_t DCameraChannelInfoCmd::Unmarshal(const uint8_t *data, size_t size)
+{
+    DCameraProtocolReader reader(data, size);
+    int32_t ret = reader.ReadHeader(type_, dhId_, command_);
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+
+    std::shared_ptr<DCameraChannelInfo> channelInfo = std::make_shared<DCameraChannelInfo>();
+    uint32_t count = 0;
+    if (!reader.ReadString(channelInfo->sourceDevId_) || !reader.ReadUint32(count)) {
+        return DCAMERA_BAD_VALUE;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        DCameraChannelDetail channelDetail;
+        int32_t streamType = 0;
+        if (!reader.ReadString(channelDetail.dataSessionFlag_) || !reader.ReadInt32(streamType)) {
+            return DCAMERA_BAD_VALUE;
+        }
+        channelDetail.streamType_ = (DCStreamType)streamType;
+        channelInfo->detail_.push_back(channelDetail);
+    }
+    value_ = channelInfo;
+    return DCAMERA_OK;
+}
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_command_dispatcher.h"
+
+#include <cstring>
+#include <memory>
+
+#include "dcamera_protocol_codec.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+int32_t DCameraCommandPacket::Parse(const uint8_t *data, size_t size)
+{
+    if (data == nullptr || size == 0) {
+        return DCAMERA_BAD_VALUE;
+    }
+
+    data_ = data;
+    size_ = size;
+    isBinary_ = IsBinaryCommand(data, size);
+    if (isBinary_) {
+        return GetBinaryCommand(data, size, command_);
+    }
+
+    const char *begin = reinterpret_cast<const char *>(data);
+    size_t len = strnlen(begin, size);
+    JSONCPP_STRING errs;
+    Json::CharReaderBuilder readerBuilder;
+    std::unique_ptr<Json::CharReader> const jsonReader(readerBuilder.newCharReader());
+    if (!jsonReader->parse(begin, begin + len, &rootValue_, &errs) || !rootValue_.isObject()) {
+        return DCAMERA_BAD_VALUE;
+    }
+
+    if (!rootValue_.isMember("Command") || !rootValue_["Command"].isString()) {
+        return DCAMERA_BAD_VALUE;
+    }
+    command_ = rootValue_["Command"].asString();
+    return DCAMERA_OK;
+}
+
+const std::string& DCameraCommandPacket::GetCommand() const
+{
+    return command_;
+}
+
+void DCameraCommandDispatcher::RegisterHandler(const std::string& command, CommandHandler handler)
+{
+    handlers_[command] = handler;
+}
+
+int32_t DCameraCommandDispatcher::Dispatch(const uint8_t *data, size_t size) const
+{
+    DCameraCommandPacket packet;
+    int32_t ret = packet.Parse(data, size);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraCommandDispatcher parse command failed, ret: %d", ret);
+        return ret;
+    }
+
+    auto iter = handlers_.find(packet.GetCommand());
+    if (iter == handlers_.end()) {
+        DHLOGD("DCameraCommandDispatcher no handler for command: %s", packet.GetCommand().c_str());
+        return DCAMERA_NOT_FOUND;
+    }
+    return iter->second(packet);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -17,6 +17,7 @@
 
 #include "json/json.h"
 
+#include "dcamera_protocol_codec.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
@@ -51,6 +52,14 @@ int32_t DCameraEventCmd::Unmarshal(const std::string& jsonStr)
         !rootValue.isObject()) {
         return DCAMERA_BAD_VALUE;
     }
+    return Unmarshal(rootValue);
+}
+
+int32_t DCameraEventCmd::Unmarshal(const Json::Value& rootValue)
+{
+    if (!rootValue.isObject()) {
+        return DCAMERA_BAD_VALUE;
+    }
 
     if (!rootValue.isMember("Type") || !rootValue["Type"].isString()) {
         return DCAMERA_BAD_VALUE;
@@ -70,7 +79,7 @@ int32_t DCameraEventCmd::Unmarshal(const std::string& jsonStr)
     if (!rootValue.isMember("Value") || !rootValue["Value"].isObject()) {
         return DCAMERA_BAD_VALUE;
     }
-    Json::Value valueJson = rootValue["Value"];
+    const Json::Value& valueJson = rootValue["Value"];
 
     if (!valueJson.isMember("EventType") || !valueJson["EventType"].isInt()) {
         return DCAMERA_BAD_VALUE;
@@ -91,5 +100,32 @@ int32_t DCameraEventCmd::Unmarshal(const std::string& jsonStr)
     value_ = event;
     return DCAMERA_OK;
 }
+
+int32_t DCameraEventCmd::Marshal(std::vector<uint8_t>& data)
+{
+    DCameraProtocolWriter writer(type_, dhId_, command_);
+    writer.WriteInt32(value_->eventType_);
+    writer.WriteInt32(value_->eventResult_);
+    writer.WriteString(value_->eventContent_);
+    writer.Finish(data);
+    return DCAMERA_OK;
+}
+
+int32_t DCameraEventCmd::Unmarshal(const uint8_t *data, size_t size)
+{
+    DCameraProtocolReader reader(data, size);
+    int32_t ret = reader.ReadHeader(type_, dhId_, command_);
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+
+    std::shared_ptr<DCameraEvent> event = std::make_shared<DCameraEvent>();
+    if (!reader.ReadInt32(event->eventType_) || !reader.ReadInt32(event->eventResult_) ||
+        !reader.ReadString(event->eventContent_)) {
+        return DCAMERA_BAD_VALUE;
+    }
+    value_ = event;
+    return DCAMERA_OK;
+}
 } // namespace DistributedHardware
 } // namespace OHOS
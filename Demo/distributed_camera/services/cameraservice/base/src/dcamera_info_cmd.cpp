@@ -17,6 +17,7 @@
 
 #include "json/json.h"
 
+#include "dcamera_protocol_codec.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
@@ -49,6 +50,14 @@ int32_t DCameraInfoCmd::Unmarshal(const std::string& jsonStr)
         !rootValue.isObject()) {
         return DCAMERA_BAD_VALUE;
     }
+    return Unmarshal(rootValue);
+}
+
+int32_t DCameraInfoCmd::Unmarshal(const Json::Value& rootValue)
+{
+    if (!rootValue.isObject()) {
+        return DCAMERA_BAD_VALUE;
+    }
 
     if (!rootValue.isMember("Type") || !rootValue["Type"].isString()) {
         return DCAMERA_BAD_VALUE;
@@ -68,7 +77,7 @@ int32_t DCameraInfoCmd::Unmarshal(const std::string& jsonStr)
     if (!rootValue.isMember("Value") || !rootValue["Value"].isObject()) {
         return DCAMERA_BAD_VALUE;
     }
-    Json::Value valueJson = rootValue["Value"];
+    const Json::Value& valueJson = rootValue["Value"];
 
     if (!valueJson.isMember("State") || !valueJson["State"].isInt()) {
         return DCAMERA_BAD_VALUE;
@@ -79,5 +88,29 @@ int32_t DCameraInfoCmd::Unmarshal(const std::string& jsonStr)
     value_ = info;
     return DCAMERA_OK;
 }
+
+int32_t DCameraInfoCmd::Marshal(std::vector<uint8_t>& data)
+{
+    DCameraProtocolWriter writer(type_, dhId_, command_);
+    writer.WriteInt32(value_->state_);
+    writer.Finish(data);
+    return DCAMERA_OK;
+}
+
+int32_t DCameraInfoCmd::Unmarshal(const uint8_t *data, size_t size)
+{
+    DCameraProtocolReader reader(data, size);
+    int32_t ret = reader.ReadHeader(type_, dhId_, command_);
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+
+    std::shared_ptr<DCameraInfo> info = std::make_shared<DCameraInfo>();
+    if (!reader.ReadInt32(info->state_)) {
+        return DCAMERA_BAD_VALUE;
+    }
+    value_ = info;
+    return DCAMERA_OK;
+}
 } // namespace DistributedHardware
 } // namespace OHOS
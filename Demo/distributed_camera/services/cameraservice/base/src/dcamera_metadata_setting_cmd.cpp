@@ -17,6 +17,7 @@
 
 #include "json/json.h"
 
+#include "dcamera_protocol_codec.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
@@ -54,6 +55,14 @@ int32_t DCameraMetadataSettingCmd::Unmarshal(const std::string& jsonStr)
         !rootValue.isObject()) {
         return DCAMERA_BAD_VALUE;
     }
+    return Unmarshal(rootValue);
+}
+
+int32_t DCameraMetadataSettingCmd::Unmarshal(const Json::Value& rootValue)
+{
+    if (!rootValue.isObject()) {
+        return DCAMERA_BAD_VALUE;
+    }
 
     if (!rootValue.isMember("Type") || !rootValue["Type"].isString()) {
         return DCAMERA_BAD_VALUE;
@@ -75,7 +84,7 @@ int32_t DCameraMetadataSettingCmd::Unmarshal(const std::string& jsonStr)
     }
 
     for (Json::ArrayIndex i = 0; i < rootValue["Value"].size(); i++) {
-        Json::Value valueJsonEle = rootValue["Value"][i];
+        const Json::Value& valueJsonEle = rootValue["Value"][i];
         if (!valueJsonEle.isMember("SettingType") || !valueJsonEle["SettingType"].isInt()) {
             return DCAMERA_BAD_VALUE;
         }
@@ -89,5 +98,41 @@ int32_t DCameraMetadataSettingCmd::Unmarshal(const std::string& jsonStr)
     }
     return DCAMERA_OK;
 }
+
+int32_t DCameraMetadataSettingCmd::Marshal(std::vector<uint8_t>& data)
+{
+    DCameraProtocolWriter writer(type_, dhId_, command_);
+    writer.WriteUint32(static_cast<uint32_t>(value_.size()));
+    for (auto iter = value_.begin(); iter != value_.end(); iter++) {
+        writer.WriteInt32((*iter)->type_);
+        writer.WriteString((*iter)->value_);
+    }
+    writer.Finish(data);
+    return DCAMERA_OK;
+}
+
+int32_t DCameraMetadataSettingCmd::Unmarshal(const uint8_t *data, size_t size)
+{
+    DCameraProtocolReader reader(data, size);
+    int32_t ret = reader.ReadHeader(type_, dhId_, command_);
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+
+    uint32_t count = 0;
+    if (!reader.ReadUint32(count)) {
+        return DCAMERA_BAD_VALUE;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t settingType = 0;
+        std::shared_ptr<DCameraSettings> setting = std::make_shared<DCameraSettings>();
+        if (!reader.ReadInt32(settingType) || !reader.ReadString(setting->value_)) {
+            return DCAMERA_BAD_VALUE;
+        }
+        setting->type_ = (DCSettingsType)settingType;
+        value_.push_back(setting);
+    }
+    return DCAMERA_OK;
+}
 } // namespace DistributedHardware
 } // namespace OHOS
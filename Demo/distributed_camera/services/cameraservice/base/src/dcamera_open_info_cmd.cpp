@@ -17,6 +17,7 @@
 
 #include "json/json.h"
 
+#include "dcamera_protocol_codec.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
@@ -32,6 +33,9 @@ int32_t DCameraOpenInfoCmd::Marshal(std::string& jsonStr)
 
     Json::Value openInfo;
     openInfo["SourceDevId"] = Json::Value(value_->sourceDevId_);
+    if (value_->cmdCodecVersion_ != DCAMERA_CMD_CODEC_JSON) {
+        openInfo["CmdCodecVersion"] = Json::Value(value_->cmdCodecVersion_);
+    }
     rootValue["Value"] = openInfo;
 
     jsonStr = rootValue.toStyledString();
@@ -49,6 +53,14 @@ int32_t DCameraOpenInfoCmd::Unmarshal(const std::string& jsonStr)
         !rootValue.isObject()) {
         return DCAMERA_BAD_VALUE;
     }
+    return Unmarshal(rootValue);
+}
+
+int32_t DCameraOpenInfoCmd::Unmarshal(const Json::Value& rootValue)
+{
+    if (!rootValue.isObject()) {
+        return DCAMERA_BAD_VALUE;
+    }
 
     if (!rootValue.isMember("Type") || !rootValue["Type"].isString()) {
         return DCAMERA_BAD_VALUE;
@@ -68,13 +80,41 @@ int32_t DCameraOpenInfoCmd::Unmarshal(const std::string& jsonStr)
     if (!rootValue.isMember("Value") || !rootValue["Value"].isObject()) {
         return DCAMERA_BAD_VALUE;
     }
-    Json::Value valueJson = rootValue["Value"];
+    const Json::Value& valueJson = rootValue["Value"];
 
     if (!valueJson.isMember("SourceDevId") || !valueJson["SourceDevId"].isString()) {
         return DCAMERA_BAD_VALUE;
     }
     std::shared_ptr<DCameraOpenInfo> openInfo = std::make_shared<DCameraOpenInfo>();
     openInfo->sourceDevId_ = valueJson["SourceDevId"].asString();
+    if (valueJson.isMember("CmdCodecVersion") && valueJson["CmdCodecVersion"].isUInt()) {
+        openInfo->cmdCodecVersion_ = valueJson["CmdCodecVersion"].asUInt();
+    }
+    value_ = openInfo;
+    return DCAMERA_OK;
+}
+
+int32_t DCameraOpenInfoCmd::Marshal(std::vector<uint8_t>& data)
+{
+    DCameraProtocolWriter writer(type_, dhId_, command_);
+    writer.WriteString(value_->sourceDevId_);
+    writer.WriteUint32(value_->cmdCodecVersion_);
+    writer.Finish(data);
+    return DCAMERA_OK;
+}
+
+int32_t DCameraOpenInfoCmd::Unmarshal(const uint8_t *data, size_t size)
+{
+    DCameraProtocolReader reader(data, size);
+    int32_t ret = reader.ReadHeader(type_, dhId_, command_);
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+
+    std::shared_ptr<DCameraOpenInfo> openInfo = std::make_shared<DCameraOpenInfo>();
+    if (!reader.ReadString(openInfo->sourceDevId_) || !reader.ReadUint32(openInfo->cmdCodecVersion_)) {
+        return DCAMERA_BAD_VALUE;
+    }
     value_ = openInfo;
     return DCAMERA_OK;
 }
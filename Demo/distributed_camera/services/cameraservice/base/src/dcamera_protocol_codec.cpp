@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_protocol_codec.h"
+
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+const size_t MAGIC_OFFSET = 0;
+const size_t VERSION_OFFSET = 1;
+const size_t LENGTH_OFFSET = 2;
+const uint32_t BYTE_BITS = 8;
+const uint32_t BYTE_MASK = 0xFF;
+const uint32_t VARINT_PAYLOAD_BITS = 7;
+const uint32_t VARINT_PAYLOAD_MASK = 0x7F;
+const uint32_t VARINT_CONTINUE_FLAG = 0x80;
+const uint32_t VARINT_MAX_SHIFT = 28;
+const uint32_t ZIGZAG_SIGN_SHIFT = 31;
+}
+
+DCameraProtocolWriter::DCameraProtocolWriter(const std::string& type, const std::string& dhId,
+    const std::string& command)
+{
+    data_.reserve(DCAMERA_CMD_BINARY_HEADER_LEN + type.size() + dhId.size() + command.size());
+    data_.resize(DCAMERA_CMD_BINARY_HEADER_LEN, 0);
+    data_[MAGIC_OFFSET] = DCAMERA_CMD_BINARY_MAGIC;
+    data_[VERSION_OFFSET] = static_cast<uint8_t>(DCAMERA_CMD_CODEC_VERSION);
+    WriteString(type);
+    WriteString(dhId);
+    WriteString(command);
+}
+
+void DCameraProtocolWriter::WriteUint32(uint32_t value)
+{
+    while (value > VARINT_PAYLOAD_MASK) {
+        data_.push_back(static_cast<uint8_t>((value & VARINT_PAYLOAD_MASK) | VARINT_CONTINUE_FLAG));
+        value >>= VARINT_PAYLOAD_BITS;
+    }
+    data_.push_back(static_cast<uint8_t>(value));
+}
+
+void DCameraProtocolWriter::WriteInt32(int32_t value)
+{
+    uint32_t zigzag = (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> ZIGZAG_SIGN_SHIFT);
+    WriteUint32(zigzag);
+}
+
+void DCameraProtocolWriter::WriteBool(bool value)
+{
+    data_.push_back(value ? 1 : 0);
+}
+
+void DCameraProtocolWriter::WriteString(const std::string& value)
+{
+    WriteUint32(static_cast<uint32_t>(value.size()));
+    data_.insert(data_.end(), value.begin(), value.end());
+}
+
+void DCameraProtocolWriter::Finish(std::vector<uint8_t>& data)
+{
+    uint32_t payloadLen = static_cast<uint32_t>(data_.size() - DCAMERA_CMD_BINARY_HEADER_LEN);
+    for (size_t i = 0; i < sizeof(uint32_t); i++) {
+        data_[LENGTH_OFFSET + i] = static_cast<uint8_t>((payloadLen >> (i * BYTE_BITS)) & BYTE_MASK);
+    }
+    data.swap(data_);
+    data_.clear();
+}
+
+DCameraProtocolReader::DCameraProtocolReader(const uint8_t *data, size_t size)
+    : data_(data), size_(size), offset_(0)
+{
+}
+
+int32_t DCameraProtocolReader::ReadHeader(std::string& type, std::string& dhId, std::string& command)
+{
+    if (!IsBinaryCommand(data_, size_)) {
+        return DCAMERA_BAD_VALUE;
+    }
+    uint32_t version = data_[VERSION_OFFSET];
+    if (version == DCAMERA_CMD_CODEC_JSON || version > DCAMERA_CMD_CODEC_VERSION) {
+        DHLOGE("DCameraProtocolReader unsupported codec version: %u", version);
+        return DCAMERA_BAD_VALUE;
+    }
+    uint32_t payloadLen = 0;
+    for (size_t i = 0; i < sizeof(uint32_t); i++) {
+        payloadLen |= static_cast<uint32_t>(data_[LENGTH_OFFSET + i]) << (i * BYTE_BITS);
+    }
+    if (payloadLen > size_ - DCAMERA_CMD_BINARY_HEADER_LEN) {
+        DHLOGE("DCameraProtocolReader truncated frame, payloadLen: %u, size: %zu", payloadLen, size_);
+        return DCAMERA_BAD_VALUE;
+    }
+    size_ = DCAMERA_CMD_BINARY_HEADER_LEN + payloadLen;
+    offset_ = DCAMERA_CMD_BINARY_HEADER_LEN;
+    if (!ReadString(type) || !ReadString(dhId) || !ReadString(command)) {
+        return DCAMERA_BAD_VALUE;
+    }
+    return DCAMERA_OK;
+}
+
+bool DCameraProtocolReader::ReadUint32(uint32_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift <= VARINT_MAX_SHIFT; shift += VARINT_PAYLOAD_BITS) {
+        if (offset_ >= size_) {
+            return false;
+        }
+        uint8_t byte = data_[offset_++];
+        value |= static_cast<uint32_t>(byte & VARINT_PAYLOAD_MASK) << shift;
+        if ((byte & VARINT_CONTINUE_FLAG) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DCameraProtocolReader::ReadInt32(int32_t& value)
+{
+    uint32_t zigzag = 0;
+    if (!ReadUint32(zigzag)) {
+        return false;
+    }
+    value = static_cast<int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+    return true;
+}
+
+bool DCameraProtocolReader::ReadBool(bool& value)
+{
+    if (offset_ >= size_) {
+        return false;
+    }
+    value = (data_[offset_++] != 0);
+    return true;
+}
+
+bool DCameraProtocolReader::ReadString(std::string& value)
+{
+    uint32_t len = 0;
+    if (!ReadUint32(len) || len > size_ - offset_) {
+        return false;
+    }
+    value.assign(reinterpret_cast<const char *>(data_ + offset_), len);
+    offset_ += len;
+    return true;
+}
+
+bool IsBinaryCommand(const uint8_t *data, size_t size)
+{
+    return (data != nullptr) && (size >= DCAMERA_CMD_BINARY_HEADER_LEN) &&
+        (data[MAGIC_OFFSET] == DCAMERA_CMD_BINARY_MAGIC);
+}
+
+int32_t GetBinaryCommand(const uint8_t *data, size_t size, std::string& command)
+{
+    std::string type;
+    std::string dhId;
+    DCameraProtocolReader reader(data, size);
+    return reader.ReadHeader(type, dhId, command);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
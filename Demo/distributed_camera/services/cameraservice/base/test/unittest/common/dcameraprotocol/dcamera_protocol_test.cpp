@@ -13,18 +13,23 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <gtest/gtest.h>
 #include <memory>
+#include <random>
 
 #include "anonymous_string.h"
 #include "distributed_hardware_log.h"
 
 #include "dcamera_capture_info_cmd.h"
 #include "dcamera_channel_info_cmd.h"
+#include "dcamera_command_dispatcher.h"
 #include "dcamera_event_cmd.h"
 #include "dcamera_info_cmd.h"
 #include "dcamera_metadata_setting_cmd.h"
+#include "dcamera_open_info_cmd.h"
 #include "dcamera_protocol.h"
+#include "dcamera_protocol_codec.h"
 #include "dcamera_utils_tools.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
@@ -81,6 +86,156 @@ static const std::string TEST_METADATA_SETTING_CMD_JSON = R"({
     "Value": [{"SettingType": 1, "SettingValue": "TestSetting"}]
 })";
 
+static const std::string TEST_OPEN_INFO_CMD_JSON = R"({
+    "Type": "MESSAGE",
+    "dhId": "camrea_0",
+    "Command": "OPEN_CHANNEL",
+    "Value": {"SourceDevId": "TestDevId", "CmdCodecVersion": 1}
+})";
+
+static const int32_t TEST_BENCHMARK_LOOPS = 1000;
+
+template<typename T>
+static void VerifyBinaryRoundTrip(const std::string& json)
+{
+    T srcCmd;
+    EXPECT_EQ(DCAMERA_OK, srcCmd.Unmarshal(json));
+    std::vector<uint8_t> data;
+    EXPECT_EQ(DCAMERA_OK, srcCmd.Marshal(data));
+    EXPECT_TRUE(IsBinaryCommand(data.data(), data.size()));
+
+    T dstCmd;
+    EXPECT_EQ(DCAMERA_OK, dstCmd.Unmarshal(data.data(), data.size()));
+    std::string srcJson;
+    std::string dstJson;
+    EXPECT_EQ(DCAMERA_OK, srcCmd.Marshal(srcJson));
+    EXPECT_EQ(DCAMERA_OK, dstCmd.Marshal(dstJson));
+    EXPECT_EQ(srcJson, dstJson);
+}
+
+template<typename T>
+static void BenchmarkCodec(const std::string& name, const std::string& json)
+{
+    T cmd;
+    EXPECT_EQ(DCAMERA_OK, cmd.Unmarshal(json));
+    std::string jsonStr;
+    std::vector<uint8_t> data;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < TEST_BENCHMARK_LOOPS; i++) {
+        cmd.Marshal(jsonStr);
+        T jsonCmd;
+        jsonCmd.Unmarshal(jsonStr);
+    }
+    auto jsonCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < TEST_BENCHMARK_LOOPS; i++) {
+        cmd.Marshal(data);
+        T binaryCmd;
+        binaryCmd.Unmarshal(data.data(), data.size());
+    }
+    auto binaryCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    DHLOGI("DCameraProtocolTest %s json: %zu bytes %lld us, binary: %zu bytes %lld us, loops: %d", name.c_str(),
+        jsonStr.length(), (long long)jsonCost.count(), data.size(), (long long)binaryCost.count(),
+        TEST_BENCHMARK_LOOPS);
+    EXPECT_LT(data.size(), jsonStr.length());
+}
+
+static const uint32_t TEST_BASE64_FUZZ_MAX_LEN = 512;
+static const uint32_t TEST_BASE64_BENCH_LEN = 64 * 1024;
+static const int32_t TEST_BASE64_BENCH_LOOPS = 100;
+static const uint32_t TEST_RANDOM_SEED = 20211019;
+
+static std::string LegacyBase64Encode(const unsigned char *toEncode, unsigned int len)
+{
+    std::string ret;
+    uint32_t i = 0;
+    unsigned char charArray3[3];
+    unsigned char charArray4[4];
+    while (len--) {
+        charArray3[i++] = *(toEncode++);
+        if (i == sizeof(charArray3)) {
+            charArray4[0] = (charArray3[0] & 0xfc) >> 2;
+            charArray4[1] = ((charArray3[0] & 0x03) << 4) + ((charArray3[1] & 0xf0) >> 4);
+            charArray4[2] = ((charArray3[1] & 0x0f) << 2) + ((charArray3[2] & 0xc0) >> 6);
+            charArray4[3] = charArray3[2] & 0x3f;
+            for (i = 0; i < sizeof(charArray4); i++) {
+                ret += BASE_64_CHARS[charArray4[i]];
+            }
+            i = 0;
+        }
+    }
+    if (i) {
+        uint32_t j = 0;
+        for (j = i; j < sizeof(charArray3); j++) {
+            charArray3[j] = '\0';
+        }
+        charArray4[0] = (charArray3[0] & 0xfc) >> 2;
+        charArray4[1] = ((charArray3[0] & 0x03) << 4) + ((charArray3[1] & 0xf0) >> 4);
+        charArray4[2] = ((charArray3[1] & 0x0f) << 2) + ((charArray3[2] & 0xc0) >> 6);
+        for (j = 0; j < i + 1; j++) {
+            ret += BASE_64_CHARS[charArray4[j]];
+        }
+        while (i++ < sizeof(charArray3)) {
+            ret += '=';
+        }
+    }
+    return ret;
+}
+
+static std::string LegacyBase64Decode(const std::string& basicString)
+{
+    std::string ret;
+    uint32_t i = 0;
+    int index = 0;
+    int len = static_cast<int>(basicString.size());
+    unsigned char charArray3[3];
+    unsigned char charArray4[4];
+    while (len-- && (basicString[index] != '=') && IsBase64(basicString[index])) {
+        charArray4[i++] = basicString[index];
+        index++;
+        if (i == sizeof(charArray4)) {
+            for (i = 0; i < sizeof(charArray4); i++) {
+                charArray4[i] = BASE_64_CHARS.find(charArray4[i]);
+            }
+            charArray3[0] = (charArray4[0] << 2) + ((charArray4[1] & 0x30) >> 4);
+            charArray3[1] = ((charArray4[1] & 0xf) << 4) + ((charArray4[2] & 0x3c) >> 2);
+            charArray3[2] = ((charArray4[2] & 0x3) << 6) + charArray4[3];
+            for (i = 0; i < sizeof(charArray3); i++) {
+                ret += charArray3[i];
+            }
+            i = 0;
+        }
+    }
+    if (i) {
+        uint32_t j = 0;
+        for (j = i; j < sizeof(charArray4); j++) {
+            charArray4[j] = 0;
+        }
+        for (j = 0; j < sizeof(charArray4); j++) {
+            charArray4[j] = BASE_64_CHARS.find(charArray4[j]);
+        }
+        charArray3[0] = (charArray4[0] << 2) + ((charArray4[1] & 0x30) >> 4);
+        charArray3[1] = ((charArray4[1] & 0xf) << 4) + ((charArray4[2] & 0x3c) >> 2);
+        for (j = 0; j < i - 1; j++) {
+            ret += charArray3[j];
+        }
+    }
+    return ret;
+}
+
+static std::string MakeRandomPayload(std::mt19937& engine, uint32_t len)
+{
+    std::uniform_int_distribution<int32_t> dist(0, UINT8_MAX);
+    std::string payload(len, '\0');
+    for (uint32_t i = 0; i < len; i++) {
+        payload[i] = static_cast<char>(dist(engine));
+    }
+    return payload;
+}
+
 void DCameraProtocolTest::SetUpTestCase(void)
 {
     GetLocalDeviceNetworkId(g_testDeviceId);
@@ -194,5 +349,246 @@ HWTEST_F(DCameraProtocolTest, dcamera_protocol_test_006, TestSize.Level1)
     ret = cmd.Marshal(jsonStr);
     EXPECT_EQ(DCAMERA_OK, ret);
 }
+
+/**
+ * @tc.name: dcamera_protocol_test_007
+ * @tc.desc: Verify OpenInfoCmd Json keeps the codec version optional.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MH
+ */
+HWTEST_F(DCameraProtocolTest, dcamera_protocol_test_007, TestSize.Level1)
+{
+    DCameraOpenInfoCmd cmd;
+    int32_t ret = cmd.Unmarshal(TEST_OPEN_INFO_CMD_JSON);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(DCAMERA_CMD_CODEC_BINARY_V1, cmd.value_->cmdCodecVersion_);
+
+    cmd.value_->cmdCodecVersion_ = DCAMERA_CMD_CODEC_JSON;
+    std::string jsonStr;
+    ret = cmd.Marshal(jsonStr);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(std::string::npos, jsonStr.find("CmdCodecVersion"));
+
+    DCameraOpenInfoCmd legacyCmd;
+    ret = legacyCmd.Unmarshal(jsonStr);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    EXPECT_EQ(DCAMERA_CMD_CODEC_JSON, legacyCmd.value_->cmdCodecVersion_);
+}
+
+/**
+ * @tc.name: dcamera_protocol_test_008
+ * @tc.desc: Verify all commands survive a binary round trip.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MH
+ */
+HWTEST_F(DCameraProtocolTest, dcamera_protocol_test_008, TestSize.Level1)
+{
+    VerifyBinaryRoundTrip<DCameraCaptureInfoCmd>(TEST_CAPTURE_INFO_CMD_JSON);
+    VerifyBinaryRoundTrip<DCameraChannelInfoCmd>(TEST_CHANNEL_INFO_CMD_JSON);
+    VerifyBinaryRoundTrip<DCameraEventCmd>(TEST_EVENT_CMD_JSON);
+    VerifyBinaryRoundTrip<DCameraInfoCmd>(TEST_INFO_CMD_JSON);
+    VerifyBinaryRoundTrip<DCameraMetadataSettingCmd>(TEST_METADATA_SETTING_CMD_JSON);
+    VerifyBinaryRoundTrip<DCameraOpenInfoCmd>(TEST_OPEN_INFO_CMD_JSON);
+}
+
+/**
+ * @tc.name: dcamera_protocol_test_009
+ * @tc.desc: Verify malformed binary frames are rejected and json is not taken for binary.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MH
+ */
+HWTEST_F(DCameraProtocolTest, dcamera_protocol_test_009, TestSize.Level1)
+{
+    EXPECT_FALSE(IsBinaryCommand(reinterpret_cast<const uint8_t *>(TEST_CAPTURE_INFO_CMD_JSON.c_str()),
+        TEST_CAPTURE_INFO_CMD_JSON.length()));
+
+    DCameraCaptureInfoCmd cmd;
+    EXPECT_EQ(DCAMERA_OK, cmd.Unmarshal(TEST_CAPTURE_INFO_CMD_JSON));
+    std::vector<uint8_t> data;
+    EXPECT_EQ(DCAMERA_OK, cmd.Marshal(data));
+
+    std::string command;
+    EXPECT_EQ(DCAMERA_OK, GetBinaryCommand(data.data(), data.size(), command));
+    EXPECT_EQ(DCAMERA_PROTOCOL_CMD_CAPTURE, command);
+
+    DCameraCaptureInfoCmd truncatedCmd;
+    EXPECT_NE(DCAMERA_OK, truncatedCmd.Unmarshal(data.data(), data.size() - 1));
+
+    std::vector<uint8_t> newerVersion = data;
+    newerVersion[1] = DCAMERA_CMD_CODEC_VERSION + 1;
+    DCameraCaptureInfoCmd newerCmd;
+    EXPECT_NE(DCAMERA_OK, newerCmd.Unmarshal(newerVersion.data(), newerVersion.size()));
+}
+
+/**
+ * @tc.name: dcamera_protocol_test_010
+ * @tc.desc: Benchmark json and binary codecs for size and cpu cost.
+ * @tc.type: PERF
+ * @tc.require: AR000GK6MH
+ */
+HWTEST_F(DCameraProtocolTest, dcamera_protocol_test_010, TestSize.Level1)
+{
+    BenchmarkCodec<DCameraCaptureInfoCmd>("CaptureInfoCmd", TEST_CAPTURE_INFO_CMD_JSON);
+    BenchmarkCodec<DCameraChannelInfoCmd>("ChannelInfoCmd", TEST_CHANNEL_INFO_CMD_JSON);
+    BenchmarkCodec<DCameraEventCmd>("EventCmd", TEST_EVENT_CMD_JSON);
+    BenchmarkCodec<DCameraInfoCmd>("InfoCmd", TEST_INFO_CMD_JSON);
+    BenchmarkCodec<DCameraMetadataSettingCmd>("MetadataSettingCmd", TEST_METADATA_SETTING_CMD_JSON);
+    BenchmarkCodec<DCameraOpenInfoCmd>("OpenInfoCmd", TEST_OPEN_INFO_CMD_JSON);
+}
+
+/**
+ * @tc.name: dcamera_protocol_test_011
+ * @tc.desc: Verify command dispatcher routes json and binary messages to typed handlers.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MH
+ */
+HWTEST_F(DCameraProtocolTest, dcamera_protocol_test_011, TestSize.Level1)
+{
+    int32_t handled = 0;
+    DCameraCommandDispatcher dispatcher;
+    dispatcher.RegisterHandler(DCAMERA_PROTOCOL_CMD_CAPTURE, [&handled](const DCameraCommandPacket& packet) {
+        DCameraCaptureInfoCmd cmd;
+        int32_t ret = packet.Unmarshal(cmd);
+        if (ret == DCAMERA_OK && cmd.value_.size() == 1 && cmd.value_[0]->width_ == 1920) {
+            handled++;
+        }
+        return ret;
+    });
+
+    const uint8_t *jsonData = reinterpret_cast<const uint8_t *>(TEST_CAPTURE_INFO_CMD_JSON.c_str());
+    EXPECT_EQ(DCAMERA_OK, dispatcher.Dispatch(jsonData, TEST_CAPTURE_INFO_CMD_JSON.length() + 1));
+
+    DCameraCaptureInfoCmd cmd;
+    EXPECT_EQ(DCAMERA_OK, cmd.Unmarshal(TEST_CAPTURE_INFO_CMD_JSON));
+    std::vector<uint8_t> data;
+    EXPECT_EQ(DCAMERA_OK, cmd.Marshal(data));
+    EXPECT_EQ(DCAMERA_OK, dispatcher.Dispatch(data.data(), data.size()));
+    EXPECT_EQ(2, handled);
+
+    const uint8_t *eventData = reinterpret_cast<const uint8_t *>(TEST_EVENT_CMD_JSON.c_str());
+    EXPECT_EQ(DCAMERA_NOT_FOUND, dispatcher.Dispatch(eventData, TEST_EVENT_CMD_JSON.length()));
+    EXPECT_EQ(DCAMERA_BAD_VALUE, dispatcher.Dispatch(nullptr, 0));
+}
+
+/**
+ * @tc.name: dcamera_protocol_test_012
+ * @tc.desc: Verify Base64 codec matches the legacy codec on random payloads.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MH
+ */
+HWTEST_F(DCameraProtocolTest, dcamera_protocol_test_012, TestSize.Level1)
+{
+    std::mt19937 engine(TEST_RANDOM_SEED);
+    for (uint32_t len = 0; len <= TEST_BASE64_FUZZ_MAX_LEN; len++) {
+        std::string payload = MakeRandomPayload(engine, len);
+        const unsigned char *data = reinterpret_cast<const unsigned char *>(payload.data());
+        std::string encoded = Base64Encode(data, len);
+        EXPECT_EQ(LegacyBase64Encode(data, len), encoded);
+        EXPECT_EQ(payload, Base64Decode(encoded));
+        EXPECT_EQ(LegacyBase64Decode(encoded), Base64Decode(encoded));
+    }
+}
+
+/**
+ * @tc.name: dcamera_protocol_test_013
+ * @tc.desc: Verify Base64 decoder rejects malformed input.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MH
+ */
+HWTEST_F(DCameraProtocolTest, dcamera_protocol_test_013, TestSize.Level1)
+{
+    EXPECT_EQ("", Base64Decode(""));
+    EXPECT_EQ("f", Base64Decode("Zg=="));
+    EXPECT_EQ("fo", Base64Decode("Zm8="));
+    EXPECT_EQ("foo", Base64Decode("Zm9v"));
+    EXPECT_EQ("", Base64Decode("Zm9"));
+    EXPECT_EQ("", Base64Decode("Zm$v"));
+    EXPECT_EQ("", Base64Decode("Z=9v"));
+    EXPECT_EQ("", Base64Decode("Z==="));
+    EXPECT_EQ("", Base64Decode("===="));
+    EXPECT_EQ("", Base64Decode("Zh=="));
+    EXPECT_EQ("", Base64Decode("Zm9="));
+    EXPECT_EQ("", Base64Decode("Zg==Zm9v"));
+}
+
+/**
+ * @tc.name: dcamera_protocol_test_014
+ * @tc.desc: Benchmark Base64 codec against the legacy codec on a metadata sized payload.
+ * @tc.type: PERF
+ * @tc.require: AR000GK6MH
+ */
+HWTEST_F(DCameraProtocolTest, dcamera_protocol_test_014, TestSize.Level1)
+{
+    std::mt19937 engine(TEST_RANDOM_SEED);
+    std::string payload = MakeRandomPayload(engine, TEST_BASE64_BENCH_LEN);
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(payload.data());
+    std::string encoded;
+    std::string decoded;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < TEST_BASE64_BENCH_LOOPS; i++) {
+        encoded = LegacyBase64Encode(data, TEST_BASE64_BENCH_LEN);
+        decoded = LegacyBase64Decode(encoded);
+    }
+    auto legacyCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_EQ(payload, decoded);
+
+    start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < TEST_BASE64_BENCH_LOOPS; i++) {
+        encoded = Base64Encode(data, TEST_BASE64_BENCH_LEN);
+        decoded = Base64Decode(encoded);
+    }
+    auto tableCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_EQ(payload, decoded);
+
+    DHLOGI("DCameraProtocolTest Base64 %d bytes x %d, legacy: %lld us, table: %lld us", TEST_BASE64_BENCH_LEN,
+        TEST_BASE64_BENCH_LOOPS, legacyCost.count(), tableCost.count());
+}
+
+/**
+ * @tc.name: dcamera_protocol_test_015
+ * @tc.desc: Verify METADATA_RESULT snapshot and delta values round trip.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MH
+ */
+HWTEST_F(DCameraProtocolTest, dcamera_protocol_test_015, TestSize.Level1)
+{
+    uint32_t generation = 0;
+    bool isSnapshot = false;
+    std::string metadata;
+    std::string value = PackResultMetadata(1, true, "AAECAw==");
+    EXPECT_EQ("1,F,AAECAw==", value);
+    EXPECT_TRUE(UnpackResultMetadata(value, generation, isSnapshot, metadata));
+    EXPECT_EQ(1u, generation);
+    EXPECT_TRUE(isSnapshot);
+    EXPECT_EQ("AAECAw==", metadata);
+
+    value = PackResultMetadata(UINT32_MAX, false, "Zm9v");
+    EXPECT_TRUE(UnpackResultMetadata(value, generation, isSnapshot, metadata));
+    EXPECT_EQ(UINT32_MAX, generation);
+    EXPECT_FALSE(isSnapshot);
+    EXPECT_EQ("Zm9v", metadata);
+}
+
+/**
+ * @tc.name: dcamera_protocol_test_016
+ * @tc.desc: Verify malformed METADATA_RESULT values are rejected.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MH
+ */
+HWTEST_F(DCameraProtocolTest, dcamera_protocol_test_016, TestSize.Level1)
+{
+    uint32_t generation = 0;
+    bool isSnapshot = false;
+    std::string metadata;
+    EXPECT_FALSE(UnpackResultMetadata("", generation, isSnapshot, metadata));
+    EXPECT_FALSE(UnpackResultMetadata("Zm9v", generation, isSnapshot, metadata));
+    EXPECT_FALSE(UnpackResultMetadata(",F,Zm9v", generation, isSnapshot, metadata));
+    EXPECT_FALSE(UnpackResultMetadata("1,F", generation, isSnapshot, metadata));
+    EXPECT_FALSE(UnpackResultMetadata("1,F,", generation, isSnapshot, metadata));
+    EXPECT_FALSE(UnpackResultMetadata("1,X,Zm9v", generation, isSnapshot, metadata));
+    EXPECT_FALSE(UnpackResultMetadata("1a,D,Zm9v", generation, isSnapshot, metadata));
+    EXPECT_FALSE(UnpackResultMetadata("4294967296,D,Zm9v", generation, isSnapshot, metadata));
+}
 } // namespace DistributedHardware
 } // namespace OHOS
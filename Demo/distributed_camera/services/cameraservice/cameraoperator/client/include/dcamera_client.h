@@ -29,6 +29,7 @@
 #include "video_output.h"
 
 #include "dcamera_photo_surface_listener.h"
+#include "dcamera_result_metadata_encoder.h"
 #include "dcamera_video_surface_listener.h"
 
 namespace OHOS {
@@ -41,6 +42,7 @@ public:
     int32_t Init() override;
     int32_t UnInit() override;
     int32_t UpdateSettings(std::vector<std::shared_ptr<DCameraSettings>>& settings) override;
+    int32_t PrepareCapture(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos) override;
     int32_t StartCapture(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos) override;
     int32_t StopCapture() override;
     int32_t SetStateCallback(std::shared_ptr<StateCallback>& callback) override;
@@ -49,12 +51,15 @@ public:
 private:
     int32_t ConfigCaptureSession(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos);
     int32_t ConfigCaptureSessionInner();
+    void SetFrameRate(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos);
     int32_t CreateCaptureOutput(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos);
     int32_t CreatePhotoOutput(std::shared_ptr<DCameraCaptureInfo>& info);
     int32_t CreateVideoOutput(std::shared_ptr<DCameraCaptureInfo>& info);
     int32_t StartCaptureInner(std::shared_ptr<DCameraCaptureInfo>& info);
     int32_t StartPhotoOutput(std::shared_ptr<DCameraCaptureInfo>& info);
+    uint32_t GetPhotoBurstDepth(std::shared_ptr<DCameraCaptureInfo>& info);
     int32_t StartVideoOutput();
+    void ReportMetadataResult(const std::string& metadataStr);
 
     bool isInit_;
     std::string cameraId_;
@@ -71,6 +76,7 @@ private:
     std::shared_ptr<ResultCallback> resultCallback_;
     std::shared_ptr<DCameraPhotoSurfaceListener> photoListener_;
     std::shared_ptr<DCameraVideoSurfaceListener> videoListener_;
+    DCameraResultMetadataEncoder resultEncoder_;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
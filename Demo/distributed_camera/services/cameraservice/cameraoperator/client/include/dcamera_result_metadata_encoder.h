@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_RESULT_METADATA_ENCODER_H
+#define OHOS_DCAMERA_RESULT_METADATA_ENCODER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "camera_metadata_info.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+/*
+ * Tracks the result metadata already reported to the source and encodes new
+ * results as METADATA_RESULT values: a full snapshot first and then every
+ * RESULT_SNAPSHOT_INTERVAL generations, otherwise only the changed tags.
+ */
+class DCameraResultMetadataEncoder {
+public:
+    DCameraResultMetadataEncoder() = default;
+    ~DCameraResultMetadataEncoder() = default;
+
+    std::string Encode(const std::shared_ptr<CameraStandard::CameraMetadata>& result);
+    void Reset();
+
+private:
+    bool MergeItem(const camera_metadata_item_t& item);
+    bool CloneResults(uint32_t itemCapacity, uint32_t dataCapacity);
+
+    std::shared_ptr<CameraStandard::CameraMetadata> results_;
+    uint32_t generation_ = 0;
+    uint32_t deltaCount_ = 0;
+    bool needSnapshot_ = true;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_RESULT_METADATA_ENCODER_H
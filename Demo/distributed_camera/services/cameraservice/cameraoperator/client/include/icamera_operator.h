@@ -34,7 +34,7 @@ public:
     virtual ~StateCallback() = default;
 
     virtual void OnStateChanged(std::shared_ptr<DCameraEvent>& event) = 0;
-    virtual void OnMetadataResult() = 0;
+    virtual void OnMetadataResult(std::vector<std::shared_ptr<DCameraSettings>>& settings) = 0;
 };
 
 class ResultCallback {
@@ -54,6 +54,7 @@ public:
     virtual int32_t Init() = 0;
     virtual int32_t UnInit() = 0;
     virtual int32_t UpdateSettings(std::vector<std::shared_ptr<DCameraSettings>>& settings) = 0;
+    virtual int32_t PrepareCapture(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos) = 0;
     virtual int32_t StartCapture(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos) = 0;
     virtual int32_t StopCapture() = 0;
     virtual int32_t SetStateCallback(std::shared_ptr<StateCallback>& callback) = 0;
@@ -29,6 +29,11 @@
 
 namespace OHOS {
 namespace DistributedHardware {
+namespace {
+const size_t FPS_SETTING_ITEM_CAPACITY = 1;
+const size_t FPS_SETTING_DATA_CAPACITY = 2 * sizeof(int32_t);
+}
+
 DCameraClient::DCameraClient(const std::string& dhId)
 {
     DHLOGI("DCameraClient Constructor dhId: %s", GetAnonyString(dhId).c_str());
@@ -83,6 +88,7 @@ int32_t DCameraClient::UnInit()
     isInit_ = false;
     cameraInfo_ = nullptr;
     cameraManager_ = nullptr;
+    resultEncoder_.Reset();
     DHLOGI("DCameraClient::UnInit %s success", GetAnonyString(cameraId_).c_str());
     return DCAMERA_OK;
 }
@@ -102,6 +108,7 @@ int32_t DCameraClient::UpdateSettings(std::vector<std::shared_ptr<DCameraSetting
                            GetAnonyString(cameraId_).c_str(), ret);
                     return ret;
                 }
+                ReportMetadataResult(metadataStr);
                 break;
             }
             default: {
@@ -114,6 +121,46 @@ int32_t DCameraClient::UpdateSettings(std::vector<std::shared_ptr<DCameraSetting
     return DCAMERA_OK;
 }
 
+void DCameraClient::ReportMetadataResult(const std::string& metadataStr)
+{
+    if (stateCallback_ == nullptr) {
+        return;
+    }
+    std::shared_ptr<CameraStandard::CameraMetadata> result =
+        CameraStandard::MetadataUtils::DecodeFromString(metadataStr);
+    std::string value = resultEncoder_.Encode(result);
+    if (value.empty()) {
+        return;
+    }
+
+    std::shared_ptr<DCameraSettings> setting = std::make_shared<DCameraSettings>();
+    setting->type_ = METADATA_RESULT;
+    setting->value_ = value;
+    std::vector<std::shared_ptr<DCameraSettings>> settings;
+    settings.push_back(setting);
+    DHLOGI("DCameraClient::ReportMetadataResult %s report metadata result, size: %d",
+           GetAnonyString(cameraId_).c_str(), value.length());
+    stateCallback_->OnMetadataResult(settings);
+}
+
+int32_t DCameraClient::PrepareCapture(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos)
+{
+    DHLOGI("DCameraClient::PrepareCapture cameraId: %s", GetAnonyString(cameraId_).c_str());
+    if ((photoOutput_ != nullptr) || (videoOutput_ != nullptr)) {
+        DHLOGI("DCameraClient::PrepareCapture %s capture session already configured",
+               GetAnonyString(cameraId_).c_str());
+        return DCAMERA_OK;
+    }
+    int32_t ret = ConfigCaptureSession(captureInfos);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraClient::PrepareCapture config capture session failed, cameraId: %s, ret: %d",
+               GetAnonyString(cameraId_).c_str(), ret);
+        return ret;
+    }
+    DHLOGI("DCameraClient::PrepareCapture %s success", GetAnonyString(cameraId_).c_str());
+    return DCAMERA_OK;
+}
+
 int32_t DCameraClient::StartCapture(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos)
 {
     DHLOGI("DCameraClient::StartCapture cameraId: %s", GetAnonyString(cameraId_).c_str());
@@ -223,7 +270,41 @@ int32_t DCameraClient::ConfigCaptureSession(std::vector<std::shared_ptr<DCameraC
         return ret;
     }
 
-    return ConfigCaptureSessionInner();
+    ret = ConfigCaptureSessionInner();
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+    SetFrameRate(captureInfos);
+    return DCAMERA_OK;
+}
+
+void DCameraClient::SetFrameRate(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos)
+{
+    for (auto& info : captureInfos) {
+        if (info->streamType_ != CONTINUOUS_FRAME) {
+            continue;
+        }
+        for (auto& setting : info->captureSettings_) {
+            uint32_t minFps = 0;
+            uint32_t maxFps = 0;
+            if (setting->type_ != FPS_RANGE || !ParseFpsRange(setting->value_, minFps, maxFps)) {
+                continue;
+            }
+            std::vector<int32_t> fpsRange = { static_cast<int32_t>(minFps), static_cast<int32_t>(maxFps) };
+            std::shared_ptr<CameraStandard::CameraMetadata> fpsSetting =
+                std::make_shared<CameraStandard::CameraMetadata>(FPS_SETTING_ITEM_CAPACITY, FPS_SETTING_DATA_CAPACITY);
+            if (!fpsSetting->addEntry(OHOS_CONTROL_AE_TARGET_FPS_RANGE, fpsRange.data(), fpsRange.size())) {
+                DHLOGE("DCameraClient::SetFrameRate %s add fps range failed",
+                    GetAnonyString(cameraId_).c_str());
+                return;
+            }
+            int32_t ret = ((sptr<CameraStandard::CameraInput> &)cameraInput_)->SetCameraSettings(
+                CameraStandard::MetadataUtils::EncodeToString(fpsSetting));
+            DHLOGI("DCameraClient::SetFrameRate %s fps range: [%u, %u], ret: %d", GetAnonyString(cameraId_).c_str(),
+                minFps, maxFps, ret);
+            return;
+        }
+    }
 }
 
 int32_t DCameraClient::ConfigCaptureSessionInner()
@@ -315,6 +396,11 @@ int32_t DCameraClient::CreatePhotoOutput(std::shared_ptr<DCameraCaptureInfo>& in
     photoSurface_ = Surface::CreateSurfaceAsConsumer();
     photoSurface_->SetDefaultWidthAndHeight(info->width_, info->height_);
     photoSurface_->SetUserData(CAMERA_SURFACE_FORMAT, std::to_string(info->format_));
+    // a burst holds its pictures in the surface until they are sent, so the queue has to fit the whole burst
+    uint32_t burstDepth = GetPhotoBurstDepth(info);
+    if (burstDepth > photoSurface_->GetQueueSize()) {
+        photoSurface_->SetQueueSize(burstDepth);
+    }
     photoListener_ = std::make_shared<DCameraPhotoSurfaceListener>(photoSurface_, resultCallback_);
     photoSurface_->RegisterConsumerListener((sptr<IBufferConsumerListener> &)photoListener_);
     photoOutput_ = cameraManager_->CreatePhotoOutput(photoSurface_);
@@ -382,13 +468,17 @@ int32_t DCameraClient::StartPhotoOutput(std::shared_ptr<DCameraCaptureInfo>& inf
         }
     }
 
+    // the pictures of a burst are requested back to back, each one is sent while the camera encodes the next
+    uint32_t burstDepth = GetPhotoBurstDepth(info);
     if (metadataSetting.empty()) {
         DHLOGE("DCameraClient::StartPhotoOutput no metadata settings to update");
-        int32_t ret = ((sptr<CameraStandard::PhotoOutput> &)photoOutput_)->Capture();
-        if (ret != DCAMERA_OK) {
-            DHLOGE("DCameraClient::StartPhotoOutput %s photoOutput capture failed, ret: %d",
-                   GetAnonyString(cameraId_).c_str(), ret);
-            return ret;
+        for (uint32_t i = 0; i < burstDepth; i++) {
+            int32_t ret = ((sptr<CameraStandard::PhotoOutput> &)photoOutput_)->Capture();
+            if (ret != DCAMERA_OK) {
+                DHLOGE("DCameraClient::StartPhotoOutput %s photoOutput capture failed, ret: %d",
+                       GetAnonyString(cameraId_).c_str(), ret);
+                return ret;
+            }
         }
         return DCAMERA_OK;
     }
@@ -409,15 +499,30 @@ int32_t DCameraClient::StartPhotoOutput(std::shared_ptr<DCameraCaptureInfo>& inf
     std::shared_ptr<CameraStandard::PhotoCaptureSetting> photoCaptureSettings =
             std::make_shared<CameraStandard::PhotoCaptureSetting>();
     photoCaptureSettings->SetRotation(rotation);
-    ret = ((sptr<CameraStandard::PhotoOutput> &)photoOutput_)->Capture(photoCaptureSettings);
-    if (ret != DCAMERA_OK) {
-        DHLOGE("DCameraClient::StartPhotoOutput %s photoOutput capture failed, ret: %d",
-               GetAnonyString(cameraId_).c_str(), ret);
-        return ret;
+    for (uint32_t i = 0; i < burstDepth; i++) {
+        ret = ((sptr<CameraStandard::PhotoOutput> &)photoOutput_)->Capture(photoCaptureSettings);
+        if (ret != DCAMERA_OK) {
+            DHLOGE("DCameraClient::StartPhotoOutput %s photoOutput capture failed, ret: %d",
+                   GetAnonyString(cameraId_).c_str(), ret);
+            return ret;
+        }
     }
     return DCAMERA_OK;
 }
 
+uint32_t DCameraClient::GetPhotoBurstDepth(std::shared_ptr<DCameraCaptureInfo>& info)
+{
+    for (auto& setting : info->captureSettings_) {
+        uint32_t depth = 0;
+        if (setting->type_ == SNAPSHOT_BURST && ParseBurstDepth(setting->value_, depth)) {
+            depth = GetBurstDepth(info->width_, info->height_, depth);
+            DHLOGI("DCameraClient::GetPhotoBurstDepth %s burst depth: %u", GetAnonyString(cameraId_).c_str(), depth);
+            return depth;
+        }
+    }
+    return 1;
+}
+
 int32_t DCameraClient::StartVideoOutput()
 {
     DHLOGI("DCameraClient::StartVideoOutput cameraId: %s", GetAnonyString(cameraId_).c_str());
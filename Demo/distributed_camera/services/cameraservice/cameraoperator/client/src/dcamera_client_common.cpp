@@ -30,6 +30,11 @@
 
 namespace OHOS {
 namespace DistributedHardware {
+namespace {
+const size_t FPS_SETTING_ITEM_CAPACITY = 1;
+const size_t FPS_SETTING_DATA_CAPACITY = 2 * sizeof(int32_t);
+}
+
 DCameraClient::DCameraClient(const std::string& dhId)
 {
     DHLOGI("DCameraClientCommon Constructor dhId: %s", GetAnonyString(dhId).c_str());
@@ -84,6 +89,7 @@ int32_t DCameraClient::UnInit()
     isInit_ = false;
     cameraInfo_ = nullptr;
     cameraManager_ = nullptr;
+    resultEncoder_.Reset();
     DHLOGI("DCameraClientCommon::UnInit %s success", GetAnonyString(cameraId_).c_str());
     return DCAMERA_OK;
 }
@@ -103,6 +109,7 @@ int32_t DCameraClient::UpdateSettings(std::vector<std::shared_ptr<DCameraSetting
                            GetAnonyString(cameraId_).c_str(), ret);
                     return ret;
                 }
+                ReportMetadataResult(metadataStr);
                 break;
             }
             default: {
@@ -115,6 +122,28 @@ int32_t DCameraClient::UpdateSettings(std::vector<std::shared_ptr<DCameraSetting
     return DCAMERA_OK;
 }
 
+void DCameraClient::ReportMetadataResult(const std::string& metadataStr)
+{
+    if (stateCallback_ == nullptr) {
+        return;
+    }
+    std::shared_ptr<CameraStandard::CameraMetadata> result =
+        CameraStandard::MetadataUtils::DecodeFromString(metadataStr);
+    std::string value = resultEncoder_.Encode(result);
+    if (value.empty()) {
+        return;
+    }
+
+    std::shared_ptr<DCameraSettings> setting = std::make_shared<DCameraSettings>();
+    setting->type_ = METADATA_RESULT;
+    setting->value_ = value;
+    std::vector<std::shared_ptr<DCameraSettings>> settings;
+    settings.push_back(setting);
+    DHLOGI("DCameraClientCommon::ReportMetadataResult %s report metadata result, size: %d",
+           GetAnonyString(cameraId_).c_str(), value.length());
+    stateCallback_->OnMetadataResult(settings);
+}
+
 int32_t DCameraClient::StartCapture(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos)
 {
     DHLOGI("DCameraClientCommon::StartCapture cameraId: %s", GetAnonyString(cameraId_).c_str());
@@ -219,7 +248,41 @@ int32_t DCameraClient::ConfigCaptureSession(std::vector<std::shared_ptr<DCameraC
         return ret;
     }
 
-    return ConfigCaptureSessionInner();
+    ret = ConfigCaptureSessionInner();
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+    SetFrameRate(captureInfos);
+    return DCAMERA_OK;
+}
+
+void DCameraClient::SetFrameRate(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos)
+{
+    for (auto& info : captureInfos) {
+        if (info->streamType_ != CONTINUOUS_FRAME) {
+            continue;
+        }
+        for (auto& setting : info->captureSettings_) {
+            uint32_t minFps = 0;
+            uint32_t maxFps = 0;
+            if (setting->type_ != FPS_RANGE || !ParseFpsRange(setting->value_, minFps, maxFps)) {
+                continue;
+            }
+            std::vector<int32_t> fpsRange = { static_cast<int32_t>(minFps), static_cast<int32_t>(maxFps) };
+            std::shared_ptr<CameraStandard::CameraMetadata> fpsSetting =
+                std::make_shared<CameraStandard::CameraMetadata>(FPS_SETTING_ITEM_CAPACITY, FPS_SETTING_DATA_CAPACITY);
+            if (!fpsSetting->addEntry(OHOS_CONTROL_AE_TARGET_FPS_RANGE, fpsRange.data(), fpsRange.size())) {
+                DHLOGE("DCameraClientCommon::SetFrameRate %s add fps range failed",
+                    GetAnonyString(cameraId_).c_str());
+                return;
+            }
+            int32_t ret = ((sptr<CameraStandard::CameraInput> &)cameraInput_)->SetCameraSettings(
+                CameraStandard::MetadataUtils::EncodeToString(fpsSetting));
+            DHLOGI("DCameraClientCommon::SetFrameRate %s fps range: [%u, %u], ret: %d",
+                GetAnonyString(cameraId_).c_str(), minFps, maxFps, ret);
+            return;
+        }
+    }
 }
 
 int32_t DCameraClient::ConfigCaptureSessionInner()
@@ -312,6 +375,11 @@ int32_t DCameraClient::CreatePhotoOutput(std::shared_ptr<DCameraCaptureInfo>& in
     photoSurface_ = Surface::CreateSurfaceAsConsumer();
     photoSurface_->SetDefaultWidthAndHeight(info->width_, info->height_);
     photoSurface_->SetUserData(CAMERA_SURFACE_FORMAT, std::to_string(camera_format_t::OHOS_CAMERA_FORMAT_RGBA_8888));
+    // a burst holds its pictures in the surface until they are sent, so the queue has to fit the whole burst
+    uint32_t burstDepth = GetPhotoBurstDepth(info);
+    if (burstDepth > photoSurface_->GetQueueSize()) {
+        photoSurface_->SetQueueSize(burstDepth);
+    }
     photoListener_ = std::make_shared<DCameraPhotoSurfaceListener>(photoSurface_, resultCallback_);
     photoSurface_->RegisterConsumerListener((sptr<IBufferConsumerListener> &)photoListener_);
     photoOutput_ = cameraManager_->CreatePhotoOutput(photoSurface_);
@@ -371,15 +439,32 @@ int32_t DCameraClient::StartPhotoOutput(std::shared_ptr<DCameraCaptureInfo>& inf
         DHLOGE("DCameraClientCommon::StartPhotoOutput photoOutput is null");
         return DCAMERA_BAD_VALUE;
     }
-    int32_t ret = ((sptr<CameraStandard::PhotoOutput> &)photoOutput_)->Capture();
-    if (ret != DCAMERA_OK) {
-        DHLOGE("DCameraClientCommon::StartPhotoOutput %s photoOutput capture failed, ret: %d",
-            GetAnonyString(cameraId_).c_str(), ret);
-        return ret;
+    uint32_t burstDepth = GetPhotoBurstDepth(info);
+    for (uint32_t i = 0; i < burstDepth; i++) {
+        int32_t ret = ((sptr<CameraStandard::PhotoOutput> &)photoOutput_)->Capture();
+        if (ret != DCAMERA_OK) {
+            DHLOGE("DCameraClientCommon::StartPhotoOutput %s photoOutput capture failed, ret: %d",
+                GetAnonyString(cameraId_).c_str(), ret);
+            return ret;
+        }
     }
     return DCAMERA_OK;
 }
 
+uint32_t DCameraClient::GetPhotoBurstDepth(std::shared_ptr<DCameraCaptureInfo>& info)
+{
+    for (auto& setting : info->captureSettings_) {
+        uint32_t depth = 0;
+        if (setting->type_ == SNAPSHOT_BURST && ParseBurstDepth(setting->value_, depth)) {
+            depth = GetBurstDepth(info->width_, info->height_, depth);
+            DHLOGI("DCameraClientCommon::GetPhotoBurstDepth %s burst depth: %u", GetAnonyString(cameraId_).c_str(),
+                depth);
+            return depth;
+        }
+    }
+    return 1;
+}
+
 int32_t DCameraClient::StartVideoOutput()
 {
     DHLOGI("DCameraClientCommon::StartVideoOutput cameraId: %s", GetAnonyString(cameraId_).c_str());
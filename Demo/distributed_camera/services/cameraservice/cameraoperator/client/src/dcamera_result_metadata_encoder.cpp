@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_result_metadata_encoder.h"
+
+#include <cstring>
+#include <vector>
+
+#include "dcamera_utils_tools.h"
+#include "distributed_hardware_log.h"
+#include "metadata_utils.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+const uint32_t RESULT_ITEM_CAPACITY = 100;
+const uint32_t RESULT_DATA_CAPACITY = 2000;
+const uint32_t RESULT_CAPACITY_FACTOR = 2;
+const uint32_t RESULT_SNAPSHOT_INTERVAL = 30;
+
+size_t GetItemDataSize(const camera_metadata_item_t& item)
+{
+    size_t size = 0;
+    switch (item.data_type) {
+        case META_TYPE_BYTE:
+            size = sizeof(uint8_t);
+            break;
+        case META_TYPE_INT32:
+            size = sizeof(int32_t);
+            break;
+        case META_TYPE_UINT32:
+            size = sizeof(uint32_t);
+            break;
+        case META_TYPE_FLOAT:
+            size = sizeof(float);
+            break;
+        case META_TYPE_INT64:
+            size = sizeof(int64_t);
+            break;
+        case META_TYPE_DOUBLE:
+            size = sizeof(double);
+            break;
+        case META_TYPE_RATIONAL:
+            size = sizeof(camera_rational_t);
+            break;
+        default:
+            break;
+    }
+    return size * static_cast<size_t>(item.count);
+}
+
+std::string EncodeMetadata(const std::shared_ptr<CameraStandard::CameraMetadata>& metadata)
+{
+    std::string metadataStr = CameraStandard::MetadataUtils::EncodeToString(metadata);
+    return Base64Encode(reinterpret_cast<const unsigned char *>(metadataStr.c_str()), metadataStr.length());
+}
+}
+
+std::string DCameraResultMetadataEncoder::Encode(const std::shared_ptr<CameraStandard::CameraMetadata>& result)
+{
+    if (result == nullptr || result->get() == nullptr) {
+        return "";
+    }
+    if (results_ == nullptr) {
+        results_ = std::make_shared<CameraStandard::CameraMetadata>(RESULT_ITEM_CAPACITY, RESULT_DATA_CAPACITY);
+    }
+
+    std::vector<camera_metadata_item_t> changedItems;
+    size_t changedDataSize = 0;
+    uint32_t count = CameraStandard::GetCameraMetadataItemCount(result->get());
+    for (uint32_t i = 0; i < count; i++) {
+        camera_metadata_item_t item;
+        if (CameraStandard::GetCameraMetadataItem(result->get(), i, &item) != CAM_META_SUCCESS) {
+            continue;
+        }
+        camera_metadata_item_t lastItem;
+        if (CameraStandard::FindCameraMetadataItem(results_->get(), item.item, &lastItem) == CAM_META_SUCCESS &&
+            item.data_type == lastItem.data_type && item.count == lastItem.count &&
+            memcmp(item.data.u8, lastItem.data.u8, GetItemDataSize(item)) == 0) {
+            continue;
+        }
+        if (!MergeItem(item)) {
+            DHLOGE("DCameraResultMetadataEncoder merge tag %d failed, resend snapshot", item.item);
+            needSnapshot_ = true;
+            return "";
+        }
+        changedItems.push_back(item);
+        changedDataSize += GetItemDataSize(item);
+    }
+
+    if (changedItems.empty() && !needSnapshot_) {
+        return "";
+    }
+
+    generation_++;
+    if (needSnapshot_ || deltaCount_ >= RESULT_SNAPSHOT_INTERVAL) {
+        needSnapshot_ = false;
+        deltaCount_ = 0;
+        return PackResultMetadata(generation_, true, EncodeMetadata(results_));
+    }
+
+    std::shared_ptr<CameraStandard::CameraMetadata> delta = std::make_shared<CameraStandard::CameraMetadata>(
+        changedItems.size(), changedDataSize * RESULT_CAPACITY_FACTOR);
+    for (auto& item : changedItems) {
+        if (!delta->addEntry(item.item, item.data.u8, item.count)) {
+            DHLOGE("DCameraResultMetadataEncoder add delta tag %d failed, send snapshot", item.item);
+            deltaCount_ = 0;
+            return PackResultMetadata(generation_, true, EncodeMetadata(results_));
+        }
+    }
+    deltaCount_++;
+    return PackResultMetadata(generation_, false, EncodeMetadata(delta));
+}
+
+void DCameraResultMetadataEncoder::Reset()
+{
+    results_ = nullptr;
+    deltaCount_ = 0;
+    needSnapshot_ = true;
+}
+
+bool DCameraResultMetadataEncoder::MergeItem(const camera_metadata_item_t& item)
+{
+    camera_metadata_item_t lastItem;
+    bool isExist = (CameraStandard::FindCameraMetadataItem(results_->get(), item.item, &lastItem) ==
+        CAM_META_SUCCESS);
+    if (isExist ? results_->updateEntry(item.item, item.data.u8, item.count) :
+        results_->addEntry(item.item, item.data.u8, item.count)) {
+        return true;
+    }
+
+    uint32_t itemCapacity = CameraStandard::GetCameraMetadataItemCapacity(results_->get());
+    uint32_t dataCapacity = CameraStandard::GetCameraMetadataDataSize(results_->get());
+    if (!CloneResults(itemCapacity + 1, (dataCapacity + GetItemDataSize(item)) * RESULT_CAPACITY_FACTOR)) {
+        return false;
+    }
+    return isExist ? results_->updateEntry(item.item, item.data.u8, item.count) :
+        results_->addEntry(item.item, item.data.u8, item.count);
+}
+
+bool DCameraResultMetadataEncoder::CloneResults(uint32_t itemCapacity, uint32_t dataCapacity)
+{
+    std::shared_ptr<CameraStandard::CameraMetadata> metadata =
+        std::make_shared<CameraStandard::CameraMetadata>(itemCapacity, dataCapacity);
+    if (metadata->get() == nullptr ||
+        CameraStandard::CopyCameraMetadataItems(metadata->get(), results_->get()) != CAM_META_SUCCESS) {
+        return false;
+    }
+    results_ = metadata;
+    return true;
+}
+} // namespace DistributedHardware
+} // namespace OHOS
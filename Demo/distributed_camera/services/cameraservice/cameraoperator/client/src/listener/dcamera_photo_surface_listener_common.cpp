@@ -15,9 +15,8 @@
 
 #include "dcamera_photo_surface_listener.h"
 
-#include <securec.h>
-
 #include "data_buffer.h"
+#include "dcamera_utils_tools.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
 
@@ -43,31 +42,36 @@ void DCameraPhotoSurfaceListener::OnBufferAvailable()
             break;
         }
 
-        int32_t size;
-        buffer->ExtraGet("dataSize", size);
-        if (size <= 0) {
-            size = static_cast<int32_t>(buffer->GetSize());
-        }
-
-        char *address = static_cast<char *>(buffer->GetVirAddr());
+        uint8_t *address = static_cast<uint8_t *>(buffer->GetVirAddr());
+        int32_t size = static_cast<int32_t>(buffer->GetSize());
         if ((address == nullptr) || (size <= 0)) {
             DHLOGE("DCameraPhotoSurfaceListenerCommon invalid params, size: %d", size);
             break;
         }
 
-        DHLOGI("DCameraPhotoSurfaceListenerCommon size: %d", size);
-        std::shared_ptr<DataBuffer> dataBuffer = std::make_shared<DataBuffer>(size);
-        int32_t ret = memcpy_s(dataBuffer->Data(), dataBuffer->Capacity(), address, size);
-        if (ret != EOK) {
-            DHLOGE("DCameraPhotoSurfaceListenerCommon Memory Copy failed, ret: %d", ret);
-            break;
-        }
-
         if (callback_ == nullptr) {
             DHLOGE("DCameraPhotoSurfaceListenerCommon ResultCallback is null");
             break;
         }
+
+        // only the encoded picture is sent, straight out of the surface buffer, which goes back to the
+        // surface once the last chunk of it has left the snapshot channel. The producer reports the length of
+        // the picture when it knows it, otherwise it is parsed out of the worst case sized buffer.
+        int32_t dataSize = 0;
+        buffer->ExtraGet("dataSize", dataSize);
+        if (dataSize > 0 && dataSize <= size) {
+            size = dataSize;
+        } else {
+            size = static_cast<int32_t>(GetJpegSize(address, static_cast<size_t>(size)));
+        }
+        DHLOGI("DCameraPhotoSurfaceListenerCommon size: %d", size);
+        sptr<Surface> surface = surface_;
+        std::shared_ptr<DataBuffer> dataBuffer = std::make_shared<DataBuffer>(address, size,
+            [surface, buffer]() mutable {
+                surface->ReleaseBuffer(buffer, -1);
+            });
         callback_->OnPhotoResult(dataBuffer);
+        return;
     } while (0);
     surface_->ReleaseBuffer(buffer, -1);
 }
@@ -18,6 +18,7 @@
 #include "anonymous_string.h"
 #include "dcamera_client.h"
 #include "distributed_camera_constants.h"
+#include "dcamera_utils_tools.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
 
@@ -33,9 +34,9 @@ public:
                event->eventType_, event->eventResult_);
     }
 
-    void OnMetadataResult()
+    void OnMetadataResult(std::vector<std::shared_ptr<DCameraSettings>>& settings)
     {
-        DHLOGI("DCameraClientTestStateCallback::OnMetadataResult");
+        DHLOGI("DCameraClientTestStateCallback::OnMetadataResult size: %d", settings.size());
     }
 };
 
@@ -57,6 +58,9 @@ const int32_t TEST_HEIGHT = 1080;
 const int32_t TEST_FORMAT_3 = 3;
 const int32_t TEST_FORMAT_4 = 4;
 const int32_t TEST_SLEEP_SEC = 2;
+const int32_t TEST_BURST_WIDTH = 4096;
+const int32_t TEST_BURST_HEIGHT = 3072;
+const uint32_t TEST_BURST_DEPTH = 3;
 const std::string TEST_CAMERA_ID = "Camera_device@3.5/legacy/1";
 
 class DCameraClientTest : public testing::Test {
@@ -265,5 +269,56 @@ HWTEST_F(DCameraClientTest, dcamera_client_test_005, TestSize.Level1)
     ret = client_->UnInit();
     EXPECT_EQ(DCAMERA_OK, ret);
 }
+
+/**
+ * @tc.name: dcamera_client_test_006
+ * @tc.desc: Verify the burst depth is clamped and a burst snapshot is captured
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6ML
+ */
+HWTEST_F(DCameraClientTest, dcamera_client_test_006, TestSize.Level1)
+{
+    DHLOGI("DCameraClientTest dcamera_client_test_006: test burst startCapture and stopCapture");
+    uint32_t depth = 0;
+    EXPECT_EQ(true, ParseBurstDepth(std::to_string(TEST_BURST_DEPTH), depth));
+    EXPECT_EQ(TEST_BURST_DEPTH, depth);
+    EXPECT_EQ(false, ParseBurstDepth("0", depth));
+    EXPECT_EQ(false, ParseBurstDepth(std::to_string(DCAMERA_BURST_MAX_DEPTH + 1), depth));
+    EXPECT_EQ(false, ParseBurstDepth("abc", depth));
+    EXPECT_EQ(DCAMERA_BURST_MAX_DEPTH, GetBurstDepth(TEST_WIDTH, TEST_HEIGHT, DCAMERA_BURST_MAX_DEPTH * 2));
+    EXPECT_EQ(1, GetBurstDepth(TEST_WIDTH, TEST_HEIGHT, 0));
+    uint64_t frameBytes = static_cast<uint64_t>(TEST_BURST_WIDTH) * TEST_BURST_HEIGHT * 3 / 2;
+    EXPECT_EQ(DCAMERA_BURST_MEMORY_MAX / frameBytes,
+        GetBurstDepth(TEST_BURST_WIDTH, TEST_BURST_HEIGHT, DCAMERA_BURST_MAX_DEPTH));
+
+    std::shared_ptr<StateCallback> stateCallback = std::make_shared<DCameraClientTestStateCallback>();
+    int32_t ret = client_->SetStateCallback(stateCallback);
+    EXPECT_EQ(DCAMERA_OK, ret);
+
+    std::shared_ptr<ResultCallback> resultCallback = std::make_shared<DCameraClientTestResultCallback>();
+    ret = client_->SetResultCallback(resultCallback);
+    EXPECT_EQ(DCAMERA_OK, ret);
+
+    ret = client_->Init();
+    EXPECT_EQ(DCAMERA_OK, ret);
+
+    std::shared_ptr<DCameraSettings> burstSetting = std::make_shared<DCameraSettings>();
+    burstSetting->type_ = SNAPSHOT_BURST;
+    burstSetting->value_ = std::to_string(TEST_BURST_DEPTH);
+    photoInfo_true_->captureSettings_.push_back(burstSetting);
+    std::vector<std::shared_ptr<DCameraCaptureInfo>> captureInfos;
+    captureInfos.push_back(videoInfo_true_);
+    captureInfos.push_back(photoInfo_true_);
+    ret = client_->StartCapture(captureInfos);
+    EXPECT_EQ(DCAMERA_OK, ret);
+
+    sleep(TEST_SLEEP_SEC);
+
+    ret = client_->StopCapture();
+    EXPECT_EQ(DCAMERA_OK, ret);
+
+    ret = client_->UnInit();
+    EXPECT_EQ(DCAMERA_OK, ret);
+}
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
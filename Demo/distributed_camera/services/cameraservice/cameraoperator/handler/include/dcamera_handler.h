@@ -23,6 +23,7 @@
 #include "camera_info.h"
 #include "camera_input.h"
 #include "camera_manager.h"
+#include "distributed_camera_constants.h"
 #include "json/json.h"
 #include "single_instance.h"
 #include "types.h"
@@ -56,8 +57,11 @@ private:
     void ConfigFormatAndResolution(ConfigInfo& info, Json::Value& outputFormat, Json::Value& resolution,
                                    std::vector<camera_format_t>& formatList, std::set<camera_format_t>& formatSet);
     bool IsValid(DCStreamType type, CameraStandard::CameraPicSize& size);
+    void ConfigEncoderCaps(Json::Value& root);
 
     sptr<CameraStandard::CameraManager> cameraManager_;
+    int32_t encoderMaxWidth_ = RESOLUTION_MAX_WIDTH_CONTINUOUS;
+    int32_t encoderMaxHeight_ = RESOLUTION_MAX_HEIGHT_CONTINUOUS;
     std::shared_ptr<PluginListener> pluginListener_;
 };
 
@@ -15,6 +15,8 @@
 
 #include "dcamera_handler.h"
 
+#include <algorithm>
+
 #include "anonymous_string.h"
 #include "avcodec_info.h"
 #include "avcodec_list.h"
@@ -129,14 +131,7 @@ DHItem DCameraHandler::CreateDHItem(sptr<CameraStandard::CameraInfo>& info)
     root[CAMERA_PROTOCOL_VERSION_KEY] = Json::Value(CAMERA_PROTOCOL_VERSION_VALUE);
     root[CAMERA_POSITION_KEY] = Json::Value(GetCameraPosition(info->GetPosition()));
 
-    std::shared_ptr<Media::AVCodecList> avCodecList = Media::AVCodecListFactory::CreateAVCodecList();
-    std::vector<std::shared_ptr<Media::VideoCaps>> videoCapsList = avCodecList->GetVideoEncoderCaps();
-    for (auto& videoCaps : videoCapsList) {
-        std::shared_ptr<Media::AVCodecInfo> codecInfo = videoCaps->GetCodecInfo();
-        std::string name = codecInfo->GetName();
-        root[CAMERA_CODEC_TYPE_KEY].append(name);
-        DHLOGI("DCameraHandler::CreateDHItem codec type: %s", name.c_str());
-    }
+    ConfigEncoderCaps(root);
 
     sptr<CameraStandard::CameraInput> cameraInput = cameraManager_->CreateCameraInput(info);
     if (cameraInput == nullptr) {
@@ -199,6 +194,36 @@ std::string DCameraHandler::GetCameraPosition(camera_position_enum_t position)
     return ret;
 }
 
+void DCameraHandler::ConfigEncoderCaps(Json::Value& root)
+{
+    int32_t maxWidth = 0;
+    int32_t maxHeight = 0;
+    int32_t maxFps = 0;
+    std::shared_ptr<Media::AVCodecList> avCodecList = Media::AVCodecListFactory::CreateAVCodecList();
+    std::vector<std::shared_ptr<Media::VideoCaps>> videoCapsList = avCodecList->GetVideoEncoderCaps();
+    for (auto& videoCaps : videoCapsList) {
+        std::shared_ptr<Media::AVCodecInfo> codecInfo = videoCaps->GetCodecInfo();
+        std::string name = codecInfo->GetName();
+        root[CAMERA_CODEC_TYPE_KEY].append(name);
+        maxWidth = std::max(maxWidth, videoCaps->GetSupportedWidth().maxVal);
+        maxHeight = std::max(maxHeight, videoCaps->GetSupportedHeight().maxVal);
+        maxFps = std::max(maxFps, videoCaps->GetSupportedFrameRate().maxVal);
+        DHLOGI("DCameraHandler::ConfigEncoderCaps codec type: %s, max width: %d, max height: %d, max fps: %d",
+            name.c_str(), videoCaps->GetSupportedWidth().maxVal, videoCaps->GetSupportedHeight().maxVal,
+            videoCaps->GetSupportedFrameRate().maxVal);
+    }
+
+    encoderMaxWidth_ = (maxWidth > 0) ? std::min(maxWidth, RESOLUTION_MAX_WIDTH_CONTINUOUS) :
+        RESOLUTION_MAX_WIDTH_CONTINUOUS;
+    encoderMaxHeight_ = (maxHeight > 0) ? std::min(maxHeight, RESOLUTION_MAX_HEIGHT_CONTINUOUS) :
+        RESOLUTION_MAX_HEIGHT_CONTINUOUS;
+    uint32_t fps = (maxFps > 0) ? std::min(static_cast<uint32_t>(maxFps), DCAMERA_PRODUCER_FPS_MAX) :
+        DCAMERA_PRODUCER_FPS_DEFAULT;
+    root[CAMERA_MAX_FPS_KEY] = Json::Value(fps);
+    DHLOGI("DCameraHandler::ConfigEncoderCaps continuous max resolution: %d*%d, max fps: %d", encoderMaxWidth_,
+        encoderMaxHeight_, fps);
+}
+
 void DCameraHandler::ConfigFormatAndResolution(ConfigInfo& info, Json::Value& outputFormat, Json::Value& resolution,
     std::vector<camera_format_t>& formatList, std::set<camera_format_t>& formatSet)
 {
@@ -228,8 +253,8 @@ bool DCameraHandler::IsValid(DCStreamType type, CameraStandard::CameraPicSize& s
         case CONTINUOUS_FRAME: {
             ret = (size.width >= RESOLUTION_MIN_WIDTH) &&
                     (size.height >= RESOLUTION_MIN_HEIGHT) &&
-                    (size.width <= RESOLUTION_MAX_WIDTH_CONTINUOUS) &&
-                    (size.height <= RESOLUTION_MAX_HEIGHT_CONTINUOUS);
+                    (size.width <= encoderMaxWidth_) &&
+                    (size.height <= encoderMaxHeight_);
             break;
         }
         case SNAPSHOT_FRAME: {
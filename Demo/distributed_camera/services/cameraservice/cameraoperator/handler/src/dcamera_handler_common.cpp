@@ -132,7 +132,7 @@ DHItem DCameraHandler::CreateDHItem(sptr<CameraStandard::CameraInfo>& info)
     Json::Value root;
     root[CAMERA_PROTOCOL_VERSION_KEY] = Json::Value(CAMERA_PROTOCOL_VERSION_VALUE);
     root[CAMERA_POSITION_KEY] = Json::Value(GetCameraPosition(info->GetPosition()));
-    root[CAMERA_CODEC_TYPE_KEY].append("OMX_hisi_video_encoder_avc");
+    ConfigEncoderCaps(root);
 
     sptr<CameraStandard::CameraInput> cameraInput = cameraManager_->CreateCameraInput(info);
     if (cameraInput == nullptr) {
@@ -198,6 +198,13 @@ std::string DCameraHandler::GetCameraPosition(camera_position_enum_t position)
     return ret;
 }
 
+void DCameraHandler::ConfigEncoderCaps(Json::Value& root)
+{
+    root[CAMERA_CODEC_TYPE_KEY].append("OMX_hisi_video_encoder_avc");
+    root[CAMERA_MAX_FPS_KEY] = Json::Value(DCAMERA_PRODUCER_FPS_DEFAULT);
+    DHLOGI("DCameraHandlerCommon::ConfigEncoderCaps max fps: %d", DCAMERA_PRODUCER_FPS_DEFAULT);
+}
+
 void DCameraHandler::ConfigFormatAndResolution(ConfigInfo& info, Json::Value& outputFormat, Json::Value& resolution,
     std::vector<camera_format_t>& formatList, std::set<camera_format_t>& formatSet)
 {
@@ -219,8 +226,8 @@ bool DCameraHandler::IsValid(DCStreamType type, CameraStandard::CameraPicSize& s
         case CONTINUOUS_FRAME: {
             ret = (size.width >= RESOLUTION_MIN_WIDTH) &&
                     (size.height >= RESOLUTION_MIN_HEIGHT) &&
-                    (size.width <= RESOLUTION_MAX_WIDTH_CONTINUOUS) &&
-                    (size.height <= RESOLUTION_MAX_HEIGHT_CONTINUOUS);
+                    (size.width <= encoderMaxWidth_) &&
+                    (size.height <= encoderMaxHeight_);
             break;
         }
         case SNAPSHOT_FRAME: {
@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 
 #include "dcamera_handler.h"
+#include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
 
@@ -86,5 +87,28 @@ HWTEST_F(DCameraHandlerTest, dcamera_handler_test_003, TestSize.Level1)
     int32_t ret = DCameraHandler::GetInstance().Query().size();
     EXPECT_GT(ret, DCAMERA_OK);
 }
+
+/**
+ * @tc.name: dcamera_handler_test_004
+ * @tc.desc: Verify Query reports a max fps within the supported range
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MF
+ */
+HWTEST_F(DCameraHandlerTest, dcamera_handler_test_004, TestSize.Level1)
+{
+    std::vector<DHItem> items = DCameraHandler::GetInstance().Query();
+    for (auto& item : items) {
+        Json::CharReaderBuilder builder;
+        JSONCPP_STRING errs;
+        Json::Value root;
+        std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+        bool parsed = reader->parse(item.attrs.c_str(), item.attrs.c_str() + item.attrs.length(), &root, &errs);
+        EXPECT_TRUE(parsed);
+        EXPECT_TRUE(root.isMember(CAMERA_MAX_FPS_KEY));
+        uint32_t maxFps = root[CAMERA_MAX_FPS_KEY].asUInt();
+        EXPECT_GE(maxFps, DCAMERA_PRODUCER_FPS_MIN);
+        EXPECT_LE(maxFps, DCAMERA_PRODUCER_FPS_MAX);
+    }
+}
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
@@ -28,7 +28,7 @@ public:
     ~DCameraSinkControllerStateCallback() = default;
 
     void OnStateChanged(std::shared_ptr<DCameraEvent>& event) override;
-    void OnMetadataResult() override;
+    void OnMetadataResult(std::vector<std::shared_ptr<DCameraSettings>>& settings) override;
 
 private:
     std::weak_ptr<DCameraSinkController> controller_;
@@ -17,6 +17,8 @@
 #define OHOS_DCAMERA_SINK_CONTROLLER_H
 
 #include "event_bus.h"
+#include "dcamera_command_dispatcher.h"
+#include "dcamera_executor.h"
 #include "dcamera_frame_trigger_event.h"
 #include "dcamera_post_authorization_event.h"
 #include "icamera_controller.h"
@@ -25,6 +27,8 @@
 #include "icamera_operator.h"
 #include "icamera_sink_access_control.h"
 #include "icamera_sink_output.h"
+#include <atomic>
+#include <future>
 #include <mutex>
 
 namespace OHOS {
@@ -47,25 +51,43 @@ public:
     int32_t CloseChannel() override;
     int32_t Init(std::vector<DCameraIndex>& indexs) override;
     int32_t UnInit() override;
+    int32_t EnableStandby() override;
+    int32_t DisableStandby() override;
 
     void OnEvent(DCameraFrameTriggerEvent& event) override;
     void OnEvent(DCameraPostAuthorizationEvent& event) override;
 
     void OnStateChanged(std::shared_ptr<DCameraEvent>& event);
-    void OnMetadataResult();
+    void OnMetadataResult(std::vector<std::shared_ptr<DCameraSettings>>& settings);
 
     void OnSessionState(int32_t state);
     void OnSessionError(int32_t eventType, int32_t eventReason, std::string detail);
     void OnDataReceived(std::vector<std::shared_ptr<DataBuffer>>& buffers);
 
 private:
+    // A camera session prepare that either the prepare queue or StartCaptureInner runs, whichever claims it first.
+    struct PrepareJob {
+        std::atomic<bool> isClaimed { false };
+        std::promise<int32_t> result;
+    };
+
     int32_t StartCaptureInner(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos);
     int32_t DCameraNotifyInner(int32_t type, int32_t result, std::string content);
     int32_t HandleReceivedData(std::shared_ptr<DataBuffer>& dataBuffer);
+    void RegisterCommandHandlers();
+    int32_t HandleCaptureCommand(const DCameraCommandPacket& packet);
+    int32_t HandleUpdateMetadataCommand(const DCameraCommandPacket& packet);
+    int32_t SendCodecNegotiation();
     void PostAuthorization(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos);
+    void PostPrepareStandby();
+    int32_t PrepareStandby();
+    void ReleaseStandby(uint64_t generation);
+    void ReleaseStandbyLocked();
+    void ClaimStandbyLocked(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos);
 
     bool isInit_;
     int32_t sessionState_;
+    uint32_t cmdCodecVersion_;
     std::mutex captureLock_;
     std::mutex channelLock_;
     std::string dhId_;
@@ -75,6 +97,13 @@ private:
     std::shared_ptr<ICameraOperator> operator_;
     std::shared_ptr<ICameraSinkAccessControl> accessControl_;
     std::shared_ptr<ICameraSinkOutput> output_;
+    std::shared_ptr<DCameraSerialQueue> prepareQueue_;
+    DCameraCommandDispatcher dispatcher_;
+    bool isCapturing_ = false;
+    bool isStandbyEnabled_ = false;
+    bool isStandby_ = false;
+    uint64_t standbyGeneration_ = 0;
+    std::vector<std::shared_ptr<DCameraCaptureInfo>> standbyInfos_;
 
     const std::string SESSION_FLAG = "control";
     const std::string SRC_TYPE = "camera";
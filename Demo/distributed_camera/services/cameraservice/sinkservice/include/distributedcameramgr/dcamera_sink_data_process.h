@@ -16,6 +16,8 @@
 #ifndef OHOS_DCAMERA_SINK_DATA_PROCESS_H
 #define OHOS_DCAMERA_SINK_DATA_PROCESS_H
 
+#include <atomic>
+
 #include "event_bus.h"
 #include "dcamera_photo_output_event.h"
 #include "dcamera_video_output_event.h"
@@ -38,6 +40,8 @@ public:
     int32_t StartCapture(std::shared_ptr<DCameraCaptureInfo>& captureInfo) override;
     int32_t StopCapture() override;
     int32_t FeedStream(std::shared_ptr<DataBuffer>& dataBuffer) override;
+    void SetFlowControl(bool isThrottled) override;
+    void SetDegradeLevel(int32_t level) override;
 
     void OnEvent(DCameraPhotoOutputEvent& event) override;
     void OnEvent(DCameraVideoOutputEvent& event) override;
@@ -47,14 +51,20 @@ public:
 
 private:
     int32_t FeedStreamInner(std::shared_ptr<DataBuffer>& dataBuffer);
+    void FeedThumbnail(std::shared_ptr<DataBuffer>& dataBuffer);
     VideoCodecType GetPipelineCodecType(DCEncodeType encodeType);
     Videoformat GetPipelineFormat(int32_t format);
+    uint32_t GetPipelineFrameRate(std::shared_ptr<DCameraCaptureInfo>& captureInfo);
 
     std::string dhId_;
     std::shared_ptr<DCameraCaptureInfo> captureInfo_;
     std::shared_ptr<EventBus> eventBus_;
     std::shared_ptr<ICameraChannel> channel_;
     std::shared_ptr<IDataProcessPipeline> pipeline_;
+    std::atomic<bool> isThrottled_ = false;
+    uint32_t throttledFrames_ = 0;
+    std::atomic<int32_t> degradeLevel_ = 0;
+    uint32_t frameCredit_ = 0;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
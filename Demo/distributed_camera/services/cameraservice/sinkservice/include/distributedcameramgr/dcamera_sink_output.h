@@ -37,6 +37,8 @@ public:
     int32_t StopCapture() override;
     int32_t OpenChannel(std::shared_ptr<DCameraChannelInfo>& info) override;
     int32_t CloseChannel() override;
+    void SetFlowControl(bool isThrottled) override;
+    void SetDegradeLevel(int32_t level) override;
 
     void OnPhotoResult(std::shared_ptr<DataBuffer>& buffer);
     void OnVideoResult(std::shared_ptr<DataBuffer>& buffer);
@@ -16,7 +16,10 @@
 #ifndef OHOS_DCAMERA_SINK_SERVICE_IPC_H
 #define OHOS_DCAMERA_SINK_SERVICE_IPC_H
 
-#include "event_handler.h"
+#include <map>
+#include <mutex>
+
+#include "dcamera_executor.h"
 #include "idistributed_camera_source.h"
 #include "single_instance.h"
 
@@ -47,7 +50,7 @@ private:
     std::mutex sourceRemoteDmsLock_;
 
     bool isInit_;
-    std::shared_ptr<AppExecFwk::EventHandler> serviceHandler_;
+    std::shared_ptr<DCameraSerialQueue> serviceQueue_;
     std::mutex initDmsLock_;
 };
 } // namespace DistributedHardware
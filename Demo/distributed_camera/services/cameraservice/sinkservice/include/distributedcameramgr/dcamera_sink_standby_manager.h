@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_SINK_STANDBY_MANAGER_H
+#define OHOS_DCAMERA_SINK_STANDBY_MANAGER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dcamera_capture_info_cmd.h"
+#include "single_instance.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+using DCameraStandbyEvictor = std::function<void()>;
+
+// Accounts the memory of idle warm-standby sessions and evicts them once they stay unused for too long,
+// or to make room for a newer standby when the budget runs out.
+class DCameraSinkStandbyManager {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraSinkStandbyManager);
+
+public:
+    int32_t AddStandby(const std::string& dhId, uint64_t memBytes, const DCameraStandbyEvictor& evictor);
+    void RemoveStandby(const std::string& dhId);
+    uint64_t GetMemoryUsage();
+    uint32_t GetStandbyCount();
+    static uint64_t EstimateMemory(const std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos);
+
+private:
+    DCameraSinkStandbyManager() = default;
+    ~DCameraSinkStandbyManager();
+
+    struct StandbyEntry {
+        uint64_t memBytes;
+        std::chrono::steady_clock::time_point deadline;
+        DCameraStandbyEvictor evictor;
+    };
+
+    void StartTimerLocked();
+    void TimerLoop();
+    void Evict(std::vector<DCameraStandbyEvictor>& evictors);
+
+    std::mutex standbyLock_;
+    std::condition_variable timerCond_;
+    std::map<std::string, StandbyEntry> entries_;
+    uint64_t memoryUsage_ = 0;
+    std::thread timerThread_;
+    bool isTimerRunning_ = false;
+    bool isStop_ = false;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_SINK_STANDBY_MANAGER_H
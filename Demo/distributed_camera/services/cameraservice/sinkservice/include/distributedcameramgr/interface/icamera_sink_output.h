@@ -36,6 +36,8 @@ public:
     virtual int32_t StopCapture() = 0;
     virtual int32_t OpenChannel(std::shared_ptr<DCameraChannelInfo>& info) = 0;
     virtual int32_t CloseChannel() = 0;
+    virtual void SetFlowControl(bool isThrottled) = 0;
+    virtual void SetDegradeLevel(int32_t level) = 0;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -23,8 +23,10 @@
 #include "system_ability_definition.h"
 
 #include "anonymous_string.h"
+#include "dcamera_executor.h"
 #include "dcamera_handler.h"
 #include "dcamera_sink_service_ipc.h"
+#include "dcamera_thread_policy.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
 
@@ -116,6 +118,8 @@ int32_t DistributedCameraSinkService::ReleaseSink()
         }
     }
     camerasMap_.clear();
+    DCameraExecutor::GetInstance().DumpStats();
+    DCameraThreadPolicy::GetInstance().DumpThreads();
     DHLOGI("DistributedCameraSinkService::ReleaseSink success");
     return DCAMERA_OK;
 }
@@ -34,14 +34,14 @@ void DCameraSinkControllerStateCallback::OnStateChanged(std::shared_ptr<DCameraE
     controller->OnStateChanged(event);
 }
 
-void DCameraSinkControllerStateCallback::OnMetadataResult()
+void DCameraSinkControllerStateCallback::OnMetadataResult(std::vector<std::shared_ptr<DCameraSettings>>& settings)
 {
     std::shared_ptr<DCameraSinkController> controller = controller_.lock();
     if (controller == nullptr) {
         DHLOGE("DCameraSinkControllerStateCallback::OnMetadataResult controller is null");
         return;
     }
-    controller->OnMetadataResult();
+    controller->OnMetadataResult(settings);
 }
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
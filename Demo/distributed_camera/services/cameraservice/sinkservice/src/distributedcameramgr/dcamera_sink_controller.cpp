@@ -15,11 +15,19 @@
 
 #include "dcamera_sink_controller.h"
 
+#include <algorithm>
+
 #include "anonymous_string.h"
 #include "dcamera_channel_sink_impl.h"
 #include "dcamera_client.h"
+#include "dcamera_command_packer.h"
+#include "dcamera_degrade_controller.h"
+#include "dcamera_executor.h"
 #include "dcamera_metadata_setting_cmd.h"
 #include "dcamera_protocol.h"
+#include "dcamera_protocol_codec.h"
+#include "dcamera_startup_profiler.h"
+#include "dcamera_thread_policy.h"
 #include "dcamera_utils_tools.h"
 
 #include "dcamera_sink_access_control.h"
@@ -27,6 +35,7 @@
 #include "dcamera_sink_controller_state_callback.h"
 #include "dcamera_sink_output.h"
 #include "dcamera_sink_service_ipc.h"
+#include "dcamera_sink_standby_manager.h"
 
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
@@ -36,9 +45,63 @@
 
 namespace OHOS {
 namespace DistributedHardware {
+namespace {
+const int32_t STANDBY_DEFAULT_WIDTH = 1920;
+const int32_t STANDBY_DEFAULT_HEIGHT = 1080;
+
+std::vector<std::shared_ptr<DCameraCaptureInfo>> GetDefaultStandbyInfos()
+{
+    std::shared_ptr<DCameraCaptureInfo> info = std::make_shared<DCameraCaptureInfo>();
+    info->width_ = STANDBY_DEFAULT_WIDTH;
+    info->height_ = STANDBY_DEFAULT_HEIGHT;
+    info->format_ = OHOS_CAMERA_FORMAT_YCRCB_420_SP;
+    info->dataspace_ = 0;
+    info->isCapture_ = true;
+    info->encodeType_ = ENCODE_TYPE_H264;
+    info->streamType_ = CONTINUOUS_FRAME;
+    std::vector<std::shared_ptr<DCameraCaptureInfo>> captureInfos;
+    captureInfos.push_back(info);
+    return captureInfos;
+}
+
+bool IsSameCaptureSettings(const std::vector<std::shared_ptr<DCameraSettings>>& first,
+    const std::vector<std::shared_ptr<DCameraSettings>>& second)
+{
+    if (first.size() != second.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < first.size(); i++) {
+        if ((first[i]->type_ != second[i]->type_) || (first[i]->value_ != second[i]->value_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IsSameCaptureConfig(const std::vector<std::shared_ptr<DCameraCaptureInfo>>& first,
+    const std::vector<std::shared_ptr<DCameraCaptureInfo>>& second)
+{
+    if (first.size() != second.size()) {
+        return false;
+    }
+    // the frame rate travels as an FPS_RANGE setting, so comparing the settings also compares the fps
+    for (size_t i = 0; i < first.size(); i++) {
+        if ((first[i]->width_ != second[i]->width_) || (first[i]->height_ != second[i]->height_) ||
+            (first[i]->format_ != second[i]->format_) || (first[i]->dataspace_ != second[i]->dataspace_) ||
+            (first[i]->encodeType_ != second[i]->encodeType_) || (first[i]->streamType_ != second[i]->streamType_) ||
+            !IsSameCaptureSettings(first[i]->captureSettings_, second[i]->captureSettings_)) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
 DCameraSinkController::DCameraSinkController(std::shared_ptr<ICameraSinkAccessControl>& accessControl)
-    : isInit_(false), sessionState_(DCAMERA_CHANNEL_STATE_DISCONNECTED), accessControl_(accessControl)
+    : isInit_(false), sessionState_(DCAMERA_CHANNEL_STATE_DISCONNECTED), cmdCodecVersion_(DCAMERA_CMD_CODEC_JSON),
+    accessControl_(accessControl)
 {
+    RegisterCommandHandlers();
 }
 
 DCameraSinkController::~DCameraSinkController()
@@ -89,6 +152,8 @@ int32_t DCameraSinkController::StopCapture()
         return ret;
     }
 
+    isCapturing_ = false;
+    PostPrepareStandby();
     DHLOGI("DCameraSinkController::StopCapture %s success", GetAnonyString(dhId_).c_str());
     return DCAMERA_OK;
 }
@@ -96,6 +161,7 @@ int32_t DCameraSinkController::StopCapture()
 int32_t DCameraSinkController::ChannelNeg(std::shared_ptr<DCameraChannelInfo>& info)
 {
     DHLOGI("DCameraSinkController::ChannelNeg dhId: %s", GetAnonyString(dhId_).c_str());
+    DCameraStartupPhaseScope phaseScope(dhId_, DCAMERA_STARTUP_PHASE_CHANNEL_NEG);
     int32_t ret = output_->OpenChannel(info);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSinkController::ChannelNeg channel negotiate failed, dhId: %s, ret: %d",
@@ -157,6 +223,22 @@ int32_t DCameraSinkController::DCameraNotify(std::shared_ptr<DCameraEvent>& even
 int32_t DCameraSinkController::UpdateSettings(std::vector<std::shared_ptr<DCameraSettings>>& settings)
 {
     DHLOGI("DCameraSinkController::UpdateSettings dhId: %s", GetAnonyString(dhId_).c_str());
+    // flow control and degradation are meant for the sink data path, the camera itself never sees them
+    for (auto iter = settings.begin(); iter != settings.end();) {
+        int32_t level = 0;
+        if ((*iter)->type_ == FLOW_CONTROL) {
+            output_->SetFlowControl((*iter)->value_ == "1");
+        } else if ((*iter)->type_ == DEGRADE_LEVEL && DCameraDegradeController::ParseLevel((*iter)->value_, level)) {
+            output_->SetDegradeLevel(level);
+        } else {
+            iter++;
+            continue;
+        }
+        iter = settings.erase(iter);
+    }
+    if (settings.empty()) {
+        return DCAMERA_OK;
+    }
     int32_t ret = operator_->UpdateSettings(settings);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSinkController::UpdateSettings failed, dhId: %s, ret: %d", GetAnonyString(dhId_).c_str(), ret);
@@ -183,7 +265,10 @@ int32_t DCameraSinkController::OpenChannel(std::shared_ptr<DCameraOpenInfo>& ope
                GetAnonyString(dhId_).c_str(), sessionState_);
         return DCAMERA_WRONG_STATE;
     }
+    DCameraStartupProfiler::GetInstance().Start(dhId_);
+    DCameraStartupPhaseScope phaseScope(dhId_, DCAMERA_STARTUP_PHASE_OPEN_CHANNEL);
     srcDevId_ = openInfo->sourceDevId_;
+    cmdCodecVersion_ = std::min(openInfo->cmdCodecVersion_, DCAMERA_CMD_CODEC_VERSION);
     std::vector<DCameraIndex> indexs;
     indexs.push_back(DCameraIndex(srcDevId_, dhId_));
     auto controller = std::shared_ptr<DCameraSinkController>(shared_from_this());
@@ -203,8 +288,10 @@ int32_t DCameraSinkController::CloseChannel()
 {
     std::lock_guard<std::mutex> autoLock(channelLock_);
     DHLOGI("DCameraSinkController::CloseChannel dhId: %s", GetAnonyString(dhId_).c_str());
+    DCameraStartupProfiler::GetInstance().Remove(dhId_);
     DCameraSinkServiceIpc::GetInstance().DeleteSourceRemoteDhms(srcDevId_);
     srcDevId_.clear();
+    cmdCodecVersion_ = DCAMERA_CMD_CODEC_JSON;
     int32_t ret = channel_->ReleaseSession();
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSinkController release channel failed, dhId: %s, ret: %d",
@@ -244,6 +331,7 @@ int32_t DCameraSinkController::Init(std::vector<DCameraIndex>& indexs)
         return ret;
     }
 
+    prepareQueue_ = DCameraExecutor::GetInstance().CreateSerialQueue("DCamSinkPrepare", DCAMERA_TASK_TIER_BACKGROUND);
     channel_ = std::make_shared<DCameraChannelSinkImpl>();
     eventBus_ = std::make_shared<EventBus>();
     DCameraFrameTriggerEvent triggerEvent(*this);
@@ -259,6 +347,14 @@ int32_t DCameraSinkController::Init(std::vector<DCameraIndex>& indexs)
 int32_t DCameraSinkController::UnInit()
 {
     DHLOGI("DCameraSinkController::UnInit dhId: %s", GetAnonyString(dhId_).c_str());
+    DisableStandby();
+    {
+        std::lock_guard<std::mutex> autoLock(captureLock_);
+        if (prepareQueue_ != nullptr) {
+            prepareQueue_->Close();
+            prepareQueue_ = nullptr;
+        }
+    }
     if (output_ != nullptr) {
         int32_t ret = output_->UnInit();
         if (ret != DCAMERA_OK) {
@@ -282,12 +378,14 @@ int32_t DCameraSinkController::UnInit()
 
 void DCameraSinkController::OnEvent(DCameraFrameTriggerEvent& event)
 {
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamSinkCtrl", DCAMERA_TASK_TIER_CONTROL);
     std::string param = event.GetParam();
     accessControl_->TriggerFrame(param);
 }
 
 void DCameraSinkController::OnEvent(DCameraPostAuthorizationEvent& event)
 {
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamSinkCtrl", DCAMERA_TASK_TIER_CONTROL);
     std::vector<std::shared_ptr<DCameraCaptureInfo>> captureInfos = event.GetParam();
     PostAuthorization(captureInfos);
 }
@@ -299,9 +397,38 @@ void DCameraSinkController::OnStateChanged(std::shared_ptr<DCameraEvent>& event)
     DCameraNotifyInner(DCAMERA_MESSAGE, DCAMERA_EVENT_CAMERA_ERROR, std::string("camera error"));
 }
 
-void DCameraSinkController::OnMetadataResult()
+void DCameraSinkController::OnMetadataResult(std::vector<std::shared_ptr<DCameraSettings>>& settings)
 {
     DHLOGI("DCameraSinkController::OnMetadataResult dhId: %s", GetAnonyString(dhId_).c_str());
+    if (settings.empty()) {
+        DHLOGE("DCameraSinkController::OnMetadataResult metadata result is empty");
+        return;
+    }
+
+    std::lock_guard<std::mutex> autoLock(channelLock_);
+    if (channel_ == nullptr || sessionState_ != DCAMERA_CHANNEL_STATE_CONNECTED) {
+        DHLOGE("DCameraSinkController::OnMetadataResult channel is not connected, dhId: %s",
+               GetAnonyString(dhId_).c_str());
+        return;
+    }
+
+    DCameraMetadataSettingCmd cmd;
+    cmd.type_ = DCAMERA_PROTOCOL_TYPE_MESSAGE;
+    cmd.dhId_ = dhId_;
+    cmd.command_ = DCAMERA_PROTOCOL_CMD_METADATA_RESULT;
+    cmd.value_.assign(settings.begin(), settings.end());
+    std::shared_ptr<DataBuffer> buffer = nullptr;
+    int32_t ret = PackCommand(cmd, cmdCodecVersion_, buffer);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSinkController::OnMetadataResult marshal failed, dhId: %s, ret: %d",
+               GetAnonyString(dhId_).c_str(), ret);
+        return;
+    }
+    ret = channel_->SendData(buffer);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSinkController::OnMetadataResult send data failed, dhId: %s, ret: %d",
+               GetAnonyString(dhId_).c_str(), ret);
+    }
 }
 
 void DCameraSinkController::OnSessionState(int32_t state)
@@ -315,6 +442,7 @@ void DCameraSinkController::OnSessionState(int32_t state)
         }
         case DCAMERA_CHANNEL_STATE_CONNECTED: {
             DHLOGI("DCameraSinkController::OnSessionState channel is connected");
+            SendCodecNegotiation();
             break;
         }
         case DCAMERA_CHANNEL_STATE_DISCONNECTED: {
@@ -365,15 +493,51 @@ int32_t DCameraSinkController::StartCaptureInner(std::vector<std::shared_ptr<DCa
 {
     std::lock_guard<std::mutex> autoLock(captureLock_);
     DHLOGI("DCameraSinkController::StartCaptureInner dhId: %s", GetAnonyString(dhId_).c_str());
-    int32_t ret = output_->StartCapture(captureInfos);
+    ClaimStandbyLocked(captureInfos);
+    // the camera session is configured on the prepare queue while the encoder is created here, both only
+    // depend on the capture infos. Whichever side claims the prepare first runs it, so this thread, which
+    // holds captureLock_, only ever waits for a prepare already running, and that never takes the lock.
+    std::shared_ptr<PrepareJob> prepareJob = std::make_shared<PrepareJob>();
+    std::future<int32_t> prepareResult = prepareJob->result.get_future();
+    if (prepareQueue_ != nullptr) {
+        std::shared_ptr<ICameraOperator> cameraOperator = operator_;
+        std::string dhId = dhId_;
+        prepareQueue_->PostTask([prepareJob, cameraOperator, captureInfos, dhId]() mutable {
+            if (prepareJob->isClaimed.exchange(true)) {
+                return;
+            }
+            DCameraStartupPhaseScope phaseScope(dhId, DCAMERA_STARTUP_PHASE_CAMERA_SESSION);
+            prepareJob->result.set_value(cameraOperator->PrepareCapture(captureInfos));
+        });
+    }
+
+    int32_t ret;
+    {
+        DCameraStartupPhaseScope phaseScope(dhId_, DCAMERA_STARTUP_PHASE_CREATE_CODEC);
+        ret = output_->StartCapture(captureInfos);
+    }
+    if (!prepareJob->isClaimed.exchange(true)) {
+        DCameraStartupPhaseScope phaseScope(dhId_, DCAMERA_STARTUP_PHASE_CAMERA_SESSION);
+        prepareJob->result.set_value(operator_->PrepareCapture(captureInfos));
+    }
+    int32_t prepareRet = prepareResult.get();
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSinkController::StartCaptureInner output start capture failed, dhId: %s, ret: %d",
                GetAnonyString(dhId_).c_str(), ret);
         DCameraNotifyInner(DCAMERA_MESSAGE, DCAMERA_EVENT_CAMERA_ERROR, std::string("output start capture failed"));
         return ret;
     }
+    if (prepareRet != DCAMERA_OK) {
+        DHLOGE("DCameraSinkController::StartCaptureInner camera client prepare capture failed, dhId: %s, ret: %d",
+               GetAnonyString(dhId_).c_str(), prepareRet);
+        DCameraNotifyInner(DCAMERA_MESSAGE, DCAMERA_EVENT_CAMERA_ERROR, std::string("operator start capture failed"));
+        return prepareRet;
+    }
 
-    ret = operator_->StartCapture(captureInfos);
+    {
+        DCameraStartupPhaseScope phaseScope(dhId_, DCAMERA_STARTUP_PHASE_START_CAMERA);
+        ret = operator_->StartCapture(captureInfos);
+    }
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSinkController::StartCaptureInner camera client start capture failed, dhId: %s, ret: %d",
                GetAnonyString(dhId_).c_str(), ret);
@@ -381,11 +545,125 @@ int32_t DCameraSinkController::StartCaptureInner(std::vector<std::shared_ptr<DCa
         return ret;
     }
 
+    isCapturing_ = true;
+    standbyInfos_ = captureInfos;
     DCameraNotifyInner(DCAMERA_MESSAGE, DCAMERA_EVENT_CAMERA_SUCCESS, std::string("operator start capture success"));
     DHLOGI("DCameraSinkController::StartCaptureInner %s success", GetAnonyString(dhId_).c_str());
     return DCAMERA_OK;
 }
 
+int32_t DCameraSinkController::EnableStandby()
+{
+    DHLOGI("DCameraSinkController::EnableStandby dhId: %s", GetAnonyString(dhId_).c_str());
+    {
+        std::lock_guard<std::mutex> autoLock(captureLock_);
+        isStandbyEnabled_ = true;
+    }
+    PostPrepareStandby();
+    return DCAMERA_OK;
+}
+
+int32_t DCameraSinkController::DisableStandby()
+{
+    std::lock_guard<std::mutex> autoLock(captureLock_);
+    DHLOGI("DCameraSinkController::DisableStandby dhId: %s", GetAnonyString(dhId_).c_str());
+    isStandbyEnabled_ = false;
+    ReleaseStandbyLocked();
+    return DCAMERA_OK;
+}
+
+void DCameraSinkController::PostPrepareStandby()
+{
+    // configuring a camera session takes hundreds of milliseconds, keep it off the ipc and control threads
+    std::weak_ptr<DCameraSinkController> weakController = shared_from_this();
+    DCameraExecutor::GetInstance().PostTask(DCAMERA_TASK_TIER_BACKGROUND, [weakController]() {
+        std::shared_ptr<DCameraSinkController> controller = weakController.lock();
+        if (controller != nullptr) {
+            controller->PrepareStandby();
+        }
+    });
+}
+
+int32_t DCameraSinkController::PrepareStandby()
+{
+    std::lock_guard<std::mutex> autoLock(captureLock_);
+    if (!isInit_ || !isStandbyEnabled_ || isStandby_ || isCapturing_) {
+        return DCAMERA_OK;
+    }
+    if (standbyInfos_.empty()) {
+        standbyInfos_ = GetDefaultStandbyInfos();
+    }
+
+    uint64_t generation = ++standbyGeneration_;
+    std::weak_ptr<DCameraSinkController> weakController = shared_from_this();
+    int32_t ret = DCameraSinkStandbyManager::GetInstance().AddStandby(dhId_,
+        DCameraSinkStandbyManager::EstimateMemory(standbyInfos_), [weakController, generation]() {
+            std::shared_ptr<DCameraSinkController> controller = weakController.lock();
+            if (controller != nullptr) {
+                controller->ReleaseStandby(generation);
+            }
+        });
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSinkController::PrepareStandby no memory for standby, dhId: %s, ret: %d",
+               GetAnonyString(dhId_).c_str(), ret);
+        return ret;
+    }
+
+    ret = output_->StartCapture(standbyInfos_);
+    if (ret == DCAMERA_OK) {
+        ret = operator_->PrepareCapture(standbyInfos_);
+    }
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSinkController::PrepareStandby prepare failed, dhId: %s, ret: %d",
+               GetAnonyString(dhId_).c_str(), ret);
+        operator_->StopCapture();
+        output_->StopCapture();
+        DCameraSinkStandbyManager::GetInstance().RemoveStandby(dhId_);
+        return ret;
+    }
+    isStandby_ = true;
+    DHLOGI("DCameraSinkController::PrepareStandby %s success", GetAnonyString(dhId_).c_str());
+    return DCAMERA_OK;
+}
+
+void DCameraSinkController::ReleaseStandby(uint64_t generation)
+{
+    std::lock_guard<std::mutex> autoLock(captureLock_);
+    // an eviction queued for an older standby must not tear down a newer one
+    if (generation != standbyGeneration_) {
+        return;
+    }
+    ReleaseStandbyLocked();
+}
+
+void DCameraSinkController::ReleaseStandbyLocked()
+{
+    if (!isStandby_) {
+        return;
+    }
+    DHLOGI("DCameraSinkController::ReleaseStandby dhId: %s", GetAnonyString(dhId_).c_str());
+    DCameraSinkStandbyManager::GetInstance().RemoveStandby(dhId_);
+    isStandby_ = false;
+    operator_->StopCapture();
+    output_->StopCapture();
+}
+
+void DCameraSinkController::ClaimStandbyLocked(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos)
+{
+    if (!isStandby_) {
+        return;
+    }
+    if (!IsSameCaptureConfig(standbyInfos_, captureInfos)) {
+        DHLOGI("DCameraSinkController::ClaimStandby %s config changed, drop standby", GetAnonyString(dhId_).c_str());
+        ReleaseStandbyLocked();
+        return;
+    }
+    // the configured session and encoder are kept, StartCapture below only starts the outputs
+    DHLOGI("DCameraSinkController::ClaimStandby %s reuse standby", GetAnonyString(dhId_).c_str());
+    DCameraSinkStandbyManager::GetInstance().RemoveStandby(dhId_);
+    isStandby_ = false;
+}
+
 int32_t DCameraSinkController::DCameraNotifyInner(int32_t type, int32_t result, std::string reason)
 {
     std::shared_ptr<DCameraEvent> event = std::make_shared<DCameraEvent>();
@@ -395,48 +673,77 @@ int32_t DCameraSinkController::DCameraNotifyInner(int32_t type, int32_t result,
     return DCameraNotify(event);
 }
 
+int32_t DCameraSinkController::SendCodecNegotiation()
+{
+    if (cmdCodecVersion_ == DCAMERA_CMD_CODEC_JSON) {
+        DHLOGI("DCameraSinkController::SendCodecNegotiation source only supports json, dhId: %s",
+               GetAnonyString(dhId_).c_str());
+        return DCAMERA_OK;
+    }
+
+    DCameraOpenInfoCmd cmd;
+    cmd.type_ = DCAMERA_PROTOCOL_TYPE_MESSAGE;
+    cmd.dhId_ = dhId_;
+    cmd.command_ = DCAMERA_PROTOCOL_CMD_CODEC_NEG;
+    cmd.value_ = std::make_shared<DCameraOpenInfo>(srcDevId_);
+    cmd.value_->cmdCodecVersion_ = cmdCodecVersion_;
+    // The negotiation itself always travels as JSON so that the source can read it whatever it supports.
+    std::shared_ptr<DataBuffer> buffer = nullptr;
+    int32_t ret = PackCommand(cmd, DCAMERA_CMD_CODEC_JSON, buffer);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSinkController::SendCodecNegotiation marshal failed, dhId: %s, ret: %d",
+               GetAnonyString(dhId_).c_str(), ret);
+        return ret;
+    }
+    ret = channel_->SendData(buffer);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSinkController::SendCodecNegotiation send data failed, dhId: %s, ret: %d",
+               GetAnonyString(dhId_).c_str(), ret);
+        return ret;
+    }
+    DHLOGI("DCameraSinkController::SendCodecNegotiation dhId: %s, version: %u", GetAnonyString(dhId_).c_str(),
+           cmdCodecVersion_);
+    return DCAMERA_OK;
+}
+
 int32_t DCameraSinkController::HandleReceivedData(std::shared_ptr<DataBuffer>& dataBuffer)
 {
     DHLOGI("DCameraSinkController::HandleReceivedData dhId: %s", GetAnonyString(dhId_).c_str());
-    uint8_t *data = dataBuffer->Data();
-    std::string jsonStr((const char *)data, dataBuffer->Capacity());
-
-    JSONCPP_STRING errs;
-    Json::CharReaderBuilder readerBuilder;
-    Json::Value root;
-    std::unique_ptr<Json::CharReader> const jsonReader(readerBuilder.newCharReader());
-    if ((!jsonReader->parse(jsonStr.c_str(), jsonStr.c_str() + jsonStr.length(), &root, &errs)) ||
-        (!root.isObject())) {
-        DHLOGE("DCameraSinkController::HandleReceivedData parse json string failed");
-        return DCAMERA_BAD_VALUE;
-    }
+    return dispatcher_.Dispatch(dataBuffer->Data(), dataBuffer->Capacity());
+}
 
-    if ((!root.isMember("Command")) || (!root["Command"].isString())) {
-        DHLOGE("DCameraSinkController::HandleReceivedData parse command failed");
-        return DCAMERA_BAD_VALUE;
+void DCameraSinkController::RegisterCommandHandlers()
+{
+    dispatcher_.RegisterHandler(DCAMERA_PROTOCOL_CMD_CAPTURE, [this](const DCameraCommandPacket& packet) {
+        return HandleCaptureCommand(packet);
+    });
+    dispatcher_.RegisterHandler(DCAMERA_PROTOCOL_CMD_UPDATE_METADATA, [this](const DCameraCommandPacket& packet) {
+        return HandleUpdateMetadataCommand(packet);
+    });
+}
+
+int32_t DCameraSinkController::HandleCaptureCommand(const DCameraCommandPacket& packet)
+{
+    DCameraCaptureInfoCmd captureInfoCmd;
+    int32_t ret = packet.Unmarshal(captureInfoCmd);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSinkController::HandleCaptureCommand Capture Info Unmarshal failed, dhId: %s ret: %d",
+               GetAnonyString(dhId_).c_str(), ret);
+        return ret;
     }
+    return StartCapture(captureInfoCmd.value_);
+}
 
-    std::string command = root["Command"].asString();
-    if ((!command.empty()) && (command.compare(DCAMERA_PROTOCOL_CMD_CAPTURE) == 0)) {
-        DCameraCaptureInfoCmd captureInfoCmd;
-        int ret = captureInfoCmd.Unmarshal(jsonStr);
-        if (ret != DCAMERA_OK) {
-            DHLOGE("DCameraSinkController::HandleReceivedData Capture Info Unmarshal failed, dhId: %s ret: %d",
-                   GetAnonyString(dhId_).c_str(), ret);
-            return ret;
-        }
-        return StartCapture(captureInfoCmd.value_);
-    } else if ((!command.empty()) && (command.compare(DCAMERA_PROTOCOL_CMD_UPDATE_METADATA) == 0)) {
-        DCameraMetadataSettingCmd metadataSettingCmd;
-        int ret = metadataSettingCmd.Unmarshal(jsonStr);
-        if (ret != DCAMERA_OK) {
-            DHLOGE("DCameraSinkController::HandleReceivedData Metadata Setting Unmarshal failed, dhId: %s ret: %d",
-                   GetAnonyString(dhId_).c_str(), ret);
-            return ret;
-        }
-        return UpdateSettings(metadataSettingCmd.value_);
+int32_t DCameraSinkController::HandleUpdateMetadataCommand(const DCameraCommandPacket& packet)
+{
+    DCameraMetadataSettingCmd metadataSettingCmd;
+    int32_t ret = packet.Unmarshal(metadataSettingCmd);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSinkController::HandleUpdateMetadataCommand Metadata Setting Unmarshal failed, dhId: %s ret: %d",
+               GetAnonyString(dhId_).c_str(), ret);
+        return ret;
     }
-    return DCAMERA_BAD_VALUE;
+    return UpdateSettings(metadataSettingCmd.value_);
 }
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
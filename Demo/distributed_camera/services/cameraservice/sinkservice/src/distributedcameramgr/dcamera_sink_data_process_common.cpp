@@ -17,8 +17,12 @@
 
 #include "anonymous_string.h"
 #include "dcamera_channel_sink_impl.h"
+#include "dcamera_degrade_controller.h"
 #include "dcamera_pipeline_sink.h"
 #include "dcamera_sink_data_process_listener.h"
+#include "dcamera_startup_profiler.h"
+#include "dcamera_thread_policy.h"
+#include "dcamera_utils_tools.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
@@ -52,14 +56,15 @@ int32_t DCameraSinkDataProcess::StartCapture(std::shared_ptr<DCameraCaptureInfo>
         pipeline_ = std::make_shared<DCameraPipelineSink>();
         auto dataProcess = std::shared_ptr<DCameraSinkDataProcess>(shared_from_this());
         std::shared_ptr<DataProcessListener> listener = std::make_shared<DCameraSinkDataProcessListener>(dataProcess);
+        uint32_t frameRate = GetPipelineFrameRate(captureInfo);
         VideoConfigParams srcParams(VideoCodecType::NO_CODEC,
                                     GetPipelineFormat(captureInfo->format_),
-                                    DCAMERA_PRODUCER_FPS_DEFAULT,
+                                    frameRate,
                                     captureInfo->width_,
                                     captureInfo->height_);
         VideoConfigParams destParams(GetPipelineCodecType(captureInfo->encodeType_),
                                      GetPipelineFormat(captureInfo->format_),
-                                     DCAMERA_PRODUCER_FPS_DEFAULT,
+                                     frameRate,
                                      captureInfo->width_,
                                      captureInfo->height_);
         int32_t ret = pipeline_->CreateDataProcessPipeline(PipelineType::VIDEO, srcParams, destParams, listener);
@@ -98,6 +103,7 @@ int32_t DCameraSinkDataProcess::FeedStream(std::shared_ptr<DataBuffer>& dataBuff
             break;
         }
         case SNAPSHOT_FRAME: {
+            FeedThumbnail(dataBuffer);
             DCameraPhotoOutputEvent photoEvent(*this, dataBuffer);
             eventBus_->PostEvent<DCameraPhotoOutputEvent>(photoEvent, POSTMODE::POST_ASYNC);
             break;
@@ -112,8 +118,22 @@ int32_t DCameraSinkDataProcess::FeedStream(std::shared_ptr<DataBuffer>& dataBuff
     return DCAMERA_OK;
 }
 
+void DCameraSinkDataProcess::SetFlowControl(bool isThrottled)
+{
+    DHLOGI("DCameraSinkDataProcess::SetFlowControl dhId: %s, throttled: %d", GetAnonyString(dhId_).c_str(),
+           isThrottled);
+    isThrottled_ = isThrottled;
+}
+
+void DCameraSinkDataProcess::SetDegradeLevel(int32_t level)
+{
+    DHLOGI("DCameraSinkDataProcess::SetDegradeLevel dhId: %s, level: %d", GetAnonyString(dhId_).c_str(), level);
+    degradeLevel_ = level;
+}
+
 void DCameraSinkDataProcess::OnEvent(DCameraPhotoOutputEvent& event)
 {
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamSinkOutput", DCAMERA_TASK_TIER_FRAME);
     std::shared_ptr<DataBuffer> buffer = event.GetParam();
     int32_t ret = channel_->SendData(buffer);
     DHLOGI("DCameraSinkDataProcess::OnEvent %s send photo output data ret: %d", GetAnonyString(dhId_).c_str(), ret);
@@ -121,9 +141,13 @@ void DCameraSinkDataProcess::OnEvent(DCameraPhotoOutputEvent& event)
 
 void DCameraSinkDataProcess::OnEvent(DCameraVideoOutputEvent& event)
 {
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamSinkOutput", DCAMERA_TASK_TIER_FRAME);
     std::shared_ptr<DataBuffer> buffer = event.GetParam();
     int32_t ret = channel_->SendData(buffer);
     DHLOGI("DCameraSinkDataProcess::OnEvent %s send video output data ret: %d", GetAnonyString(dhId_).c_str(), ret);
+    if (ret == DCAMERA_OK) {
+        DCameraStartupProfiler::GetInstance().OnFirstFrame(dhId_);
+    }
 }
 
 void DCameraSinkDataProcess::OnProcessedVideoBuffer(const std::shared_ptr<DataBuffer>& videoResult)
@@ -138,9 +162,49 @@ void DCameraSinkDataProcess::OnError(DataProcessErrorType errorType)
            GetAnonyString(dhId_).c_str(), errorType);
 }
 
+void DCameraSinkDataProcess::FeedThumbnail(std::shared_ptr<DataBuffer>& dataBuffer)
+{
+    bool isRequested = false;
+    for (auto& setting : captureInfo_->captureSettings_) {
+        if (setting->type_ == SNAPSHOT_THUMBNAIL) {
+            isRequested = true;
+            break;
+        }
+    }
+    size_t offset = 0;
+    size_t length = 0;
+    if (!isRequested || !GetJpegThumbnail(dataBuffer->Data(), dataBuffer->Size(), offset, length)) {
+        return;
+    }
+
+    // the thumbnail is a view into the full picture, which stays alive until the thumbnail is sent
+    std::shared_ptr<DataBuffer> fullBuffer = dataBuffer;
+    std::shared_ptr<DataBuffer> thumbnail = std::make_shared<DataBuffer>(dataBuffer->Data() + offset, length,
+        [fullBuffer]() mutable { fullBuffer = nullptr; });
+    thumbnail->SetInt32("frameType", DCAMERA_FRAME_TYPE_THUMBNAIL);
+    DHLOGI("DCameraSinkDataProcess::FeedThumbnail dhId: %s, thumbnail size: %zu, full size: %zu",
+           GetAnonyString(dhId_).c_str(), length, dataBuffer->Size());
+    DCameraPhotoOutputEvent photoEvent(*this, thumbnail);
+    eventBus_->PostEvent<DCameraPhotoOutputEvent>(photoEvent, POSTMODE::POST_ASYNC);
+}
+
 int32_t DCameraSinkDataProcess::FeedStreamInner(std::shared_ptr<DataBuffer>& dataBuffer)
 {
     DHLOGI("DCameraSinkDataProcess::FeedStreamInner dhId: %s", GetAnonyString(dhId_).c_str());
+    // raw frames are dropped ahead of the encoder, so the encoded stream the source decodes stays intact
+    if (isThrottled_ && (throttledFrames_++ % DCAMERA_FLOW_CONTROL_KEEP_INTERVAL) != 0) {
+        DHLOGD("DCameraSinkDataProcess::FeedStreamInner %s drop frame for flow control", GetAnonyString(dhId_).c_str());
+        return DCAMERA_OK;
+    }
+    // a degraded level keeps an even share of the frames and tells the encoder which share of its bitrate to use
+    DCameraDegradeStep step = DCameraDegradeController::GetStep(degradeLevel_);
+    frameCredit_ += step.fpsPercent;
+    if (frameCredit_ < DCAMERA_DEGRADE_PERCENT_FULL) {
+        return DCAMERA_OK;
+    }
+    frameCredit_ -= DCAMERA_DEGRADE_PERCENT_FULL;
+    dataBuffer->SetInt32("bitratePercent", static_cast<int32_t>(step.bitratePercent));
+
     std::vector<std::shared_ptr<DataBuffer>> buffers;
     buffers.push_back(dataBuffer);
     int32_t ret = pipeline_->ProcessData(buffers);
@@ -174,5 +238,19 @@ Videoformat DCameraSinkDataProcess::GetPipelineFormat(int32_t format)
 {
     return Videoformat::NV21;
 }
+
+uint32_t DCameraSinkDataProcess::GetPipelineFrameRate(std::shared_ptr<DCameraCaptureInfo>& captureInfo)
+{
+    for (auto& setting : captureInfo->captureSettings_) {
+        uint32_t minFps = 0;
+        uint32_t maxFps = 0;
+        if (setting->type_ == FPS_RANGE && ParseFpsRange(setting->value_, minFps, maxFps)) {
+            DHLOGI("DCameraSinkDataProcess::GetPipelineFrameRate %s fps range: [%d, %d]",
+                   GetAnonyString(dhId_).c_str(), minFps, maxFps);
+            return maxFps;
+        }
+    }
+    return DCAMERA_PRODUCER_FPS_DEFAULT;
+}
 } // namespace DistributedHardware
 } // namespace OHOS
\ No newline at end of file
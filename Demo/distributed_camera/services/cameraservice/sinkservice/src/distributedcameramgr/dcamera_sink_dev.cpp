@@ -21,11 +21,32 @@
 #include "dcamera_protocol.h"
 #include "dcamera_sink_access_control.h"
 #include "dcamera_sink_controller.h"
+#include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
+#include "json/json.h"
 
 namespace OHOS {
 namespace DistributedHardware {
+namespace {
+bool IsWarmStandbyRequested(const std::string& parameters)
+{
+    JSONCPP_STRING errs;
+    Json::CharReaderBuilder readerBuilder;
+    Json::Value rootValue;
+
+    std::unique_ptr<Json::CharReader> const jsonReader(readerBuilder.newCharReader());
+    if (!jsonReader->parse(parameters.c_str(), parameters.c_str() + parameters.length(), &rootValue, &errs) ||
+        !rootValue.isObject()) {
+        return false;
+    }
+    if (!rootValue.isMember(CAMERA_WARM_STANDBY_KEY) || !rootValue[CAMERA_WARM_STANDBY_KEY].isBool()) {
+        return false;
+    }
+    return rootValue[CAMERA_WARM_STANDBY_KEY].asBool();
+}
+}
+
 DCameraSinkDev::DCameraSinkDev(const std::string& dhId) : dhId_(dhId)
 {
     DHLOGI("DCameraSinkDev Constructor dhId: %s", GetAnonyString(dhId_).c_str());
@@ -74,13 +95,17 @@ int32_t DCameraSinkDev::UnInit()
 int32_t DCameraSinkDev::SubscribeLocalHardware(const std::string& parameters)
 {
     DHLOGI("DCameraSinkDev::SubscribeLocalHardware");
-    return DCAMERA_OK;
+    if (!IsWarmStandbyRequested(parameters)) {
+        return DCAMERA_OK;
+    }
+    DHLOGI("DCameraSinkDev::SubscribeLocalHardware %s enable warm standby", GetAnonyString(dhId_).c_str());
+    return controller_->EnableStandby();
 }
 
 int32_t DCameraSinkDev::UnsubscribeLocalHardware()
 {
     DHLOGI("DCameraSinkDev::UnsubscribeLocalHardware");
-    return DCAMERA_OK;
+    return controller_->DisableStandby();
 }
 
 int32_t DCameraSinkDev::StopCapture()
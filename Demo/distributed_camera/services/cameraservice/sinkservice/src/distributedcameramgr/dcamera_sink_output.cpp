@@ -170,6 +170,28 @@ int32_t DCameraSinkOutput::StopCapture()
     return DCAMERA_OK;
 }
 
+void DCameraSinkOutput::SetFlowControl(bool isThrottled)
+{
+    auto iter = dataProcesses_.find(CONTINUOUS_FRAME);
+    if (iter == dataProcesses_.end()) {
+        DHLOGE("DCameraSinkOutput::SetFlowControl has no continuous data process, dhId: %s",
+               GetAnonyString(dhId_).c_str());
+        return;
+    }
+    iter->second->SetFlowControl(isThrottled);
+}
+
+void DCameraSinkOutput::SetDegradeLevel(int32_t level)
+{
+    auto iter = dataProcesses_.find(CONTINUOUS_FRAME);
+    if (iter == dataProcesses_.end()) {
+        DHLOGE("DCameraSinkOutput::SetDegradeLevel has no continuous data process, dhId: %s",
+               GetAnonyString(dhId_).c_str());
+        return;
+    }
+    iter->second->SetDegradeLevel(level);
+}
+
 void DCameraSinkOutput::OnVideoResult(std::shared_ptr<DataBuffer>& buffer)
 {
     if (sessionState_[CONTINUOUS_FRAME] != DCAMERA_CHANNEL_STATE_CONNECTED) {
@@ -46,8 +46,8 @@ void DCameraSinkServiceIpc::Init()
         DHLOGI("DCameraSinkServiceIpc has already init");
         return;
     }
-    auto runner = AppExecFwk::EventRunner::Create("DCameraSinkServiceIpcHandler");
-    serviceHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    serviceQueue_ = DCameraExecutor::GetInstance().CreateSerialQueue("DCameraSinkServiceIpcHandler",
+        DCAMERA_TASK_TIER_BACKGROUND);
     sourceRemoteRecipient_ = new SourceRemoteRecipient();
     isInit_ = true;
     DHLOGI("DCameraSinkServiceIpc Init End");
@@ -63,7 +63,10 @@ void DCameraSinkServiceIpc::UnInit()
     }
     ClearSourceRemoteDhms();
     DHLOGI("DCameraSinkServiceIpc Start free serviceHandler");
-    serviceHandler_ = nullptr;
+    if (serviceQueue_ != nullptr) {
+        serviceQueue_->Close();
+        serviceQueue_ = nullptr;
+    }
     DHLOGI("DCameraSinkServiceIpc Start free recipient");
     sourceRemoteRecipient_ = nullptr;
     isInit_ = false;
@@ -164,8 +167,8 @@ void DCameraSinkServiceIpc::OnSourceRemoteDmsDied(const wptr<IRemoteObject>& rem
     auto remoteDmsDiedFunc = [this, diedRemoted]() {
         OnSourceRemoteDmsDied(diedRemoted);
     };
-    if (serviceHandler_ != nullptr) {
-        serviceHandler_->PostTask(remoteDmsDiedFunc);
+    if (serviceQueue_ != nullptr) {
+        serviceQueue_->PostTask(remoteDmsDiedFunc);
     }
 }
 
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_sink_standby_manager.h"
+
+#include <algorithm>
+
+#include "anonymous_string.h"
+#include "dcamera_executor.h"
+#include "dcamera_thread_policy.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+namespace {
+const uint64_t YUV_BYTES_PER_PIXEL_NUMERATOR = 3;
+const uint64_t YUV_BYTES_PER_PIXEL_DENOMINATOR = 2;
+}
+
+IMPLEMENT_SINGLE_INSTANCE(DCameraSinkStandbyManager);
+
+DCameraSinkStandbyManager::~DCameraSinkStandbyManager()
+{
+    {
+        std::lock_guard<std::mutex> autoLock(standbyLock_);
+        isStop_ = true;
+    }
+    timerCond_.notify_all();
+    if (timerThread_.joinable()) {
+        timerThread_.join();
+    }
+}
+
+int32_t DCameraSinkStandbyManager::AddStandby(const std::string& dhId, uint64_t memBytes,
+    const DCameraStandbyEvictor& evictor)
+{
+    if (memBytes > DCAMERA_STANDBY_MEMORY_MAX) {
+        DHLOGE("DCameraSinkStandbyManager AddStandby %s needs %llu bytes, over budget", GetAnonyString(dhId).c_str(),
+            (unsigned long long)memBytes);
+        return DCAMERA_BAD_VALUE;
+    }
+
+    std::vector<DCameraStandbyEvictor> evictors;
+    {
+        std::lock_guard<std::mutex> autoLock(standbyLock_);
+        auto iter = entries_.find(dhId);
+        if (iter != entries_.end()) {
+            memoryUsage_ -= iter->second.memBytes;
+            entries_.erase(iter);
+        }
+        // the oldest standby is the least likely to be claimed, so it gives way first
+        while (memoryUsage_ + memBytes > DCAMERA_STANDBY_MEMORY_MAX && !entries_.empty()) {
+            auto oldest = entries_.begin();
+            for (auto entry = entries_.begin(); entry != entries_.end(); entry++) {
+                if (entry->second.deadline < oldest->second.deadline) {
+                    oldest = entry;
+                }
+            }
+            DHLOGI("DCameraSinkStandbyManager evict %s for memory", GetAnonyString(oldest->first).c_str());
+            memoryUsage_ -= oldest->second.memBytes;
+            evictors.push_back(oldest->second.evictor);
+            entries_.erase(oldest);
+        }
+        StandbyEntry entry = { memBytes, std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(DCAMERA_STANDBY_IDLE_TIMEOUT_MS), evictor };
+        entries_[dhId] = entry;
+        memoryUsage_ += memBytes;
+        StartTimerLocked();
+        DHLOGI("DCameraSinkStandbyManager AddStandby %s memory: %llu, total: %llu", GetAnonyString(dhId).c_str(),
+            (unsigned long long)memBytes, (unsigned long long)memoryUsage_);
+    }
+    Evict(evictors);
+    return DCAMERA_OK;
+}
+
+void DCameraSinkStandbyManager::RemoveStandby(const std::string& dhId)
+{
+    std::lock_guard<std::mutex> autoLock(standbyLock_);
+    auto iter = entries_.find(dhId);
+    if (iter == entries_.end()) {
+        return;
+    }
+    memoryUsage_ -= iter->second.memBytes;
+    entries_.erase(iter);
+    DHLOGI("DCameraSinkStandbyManager RemoveStandby %s total: %llu", GetAnonyString(dhId).c_str(),
+        (unsigned long long)memoryUsage_);
+}
+
+uint64_t DCameraSinkStandbyManager::GetMemoryUsage()
+{
+    std::lock_guard<std::mutex> autoLock(standbyLock_);
+    return memoryUsage_;
+}
+
+uint32_t DCameraSinkStandbyManager::GetStandbyCount()
+{
+    std::lock_guard<std::mutex> autoLock(standbyLock_);
+    return static_cast<uint32_t>(entries_.size());
+}
+
+uint64_t DCameraSinkStandbyManager::EstimateMemory(const std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos)
+{
+    uint64_t memBytes = 0;
+    for (auto& info : captureInfos) {
+        if (info == nullptr || info->width_ <= 0 || info->height_ <= 0) {
+            continue;
+        }
+        uint64_t frameBytes = static_cast<uint64_t>(info->width_) * static_cast<uint64_t>(info->height_) *
+            YUV_BYTES_PER_PIXEL_NUMERATOR / YUV_BYTES_PER_PIXEL_DENOMINATOR;
+        memBytes += frameBytes * DCAMERA_STANDBY_BUFFER_NUM;
+    }
+    return memBytes;
+}
+
+void DCameraSinkStandbyManager::StartTimerLocked()
+{
+    if (isTimerRunning_) {
+        timerCond_.notify_one();
+        return;
+    }
+    // a previous timer thread that ran out of entries has already left its loop
+    if (timerThread_.joinable()) {
+        timerThread_.join();
+    }
+    isTimerRunning_ = true;
+    timerThread_ = std::thread(&DCameraSinkStandbyManager::TimerLoop, this);
+}
+
+void DCameraSinkStandbyManager::TimerLoop()
+{
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamStandby", DCAMERA_TASK_TIER_BACKGROUND);
+    std::unique_lock<std::mutex> lock(standbyLock_);
+    while (!isStop_ && !entries_.empty()) {
+        auto nextDeadline = entries_.begin()->second.deadline;
+        for (auto& entry : entries_) {
+            nextDeadline = std::min(nextDeadline, entry.second.deadline);
+        }
+        timerCond_.wait_until(lock, nextDeadline);
+
+        std::vector<DCameraStandbyEvictor> evictors;
+        auto now = std::chrono::steady_clock::now();
+        for (auto iter = entries_.begin(); iter != entries_.end();) {
+            if (iter->second.deadline > now) {
+                iter++;
+                continue;
+            }
+            DHLOGI("DCameraSinkStandbyManager evict %s for idle timeout", GetAnonyString(iter->first).c_str());
+            memoryUsage_ -= iter->second.memBytes;
+            evictors.push_back(iter->second.evictor);
+            iter = entries_.erase(iter);
+        }
+        lock.unlock();
+        Evict(evictors);
+        lock.lock();
+    }
+    isTimerRunning_ = false;
+}
+
+void DCameraSinkStandbyManager::Evict(std::vector<DCameraStandbyEvictor>& evictors)
+{
+    // releasing a camera session is slow, so it never runs under the lock or on the timer thread
+    for (auto& evictor : evictors) {
+        if (evictor != nullptr) {
+            DCameraExecutor::GetInstance().PostTask(DCAMERA_TASK_TIER_BACKGROUND, evictor);
+        }
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -13,8 +13,11 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <fstream>
+#include <future>
 #include <memory>
+#include <mutex>
 #define private public
 #include "dcamera_sink_data_process.h"
 #undef private
@@ -22,6 +25,8 @@
 #include <gtest/gtest.h>
 #include <securec.h>
 
+#include "dcamera_utils_tools.h"
+#include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "mock_camera_channel.h"
 #include "mock_data_process_pipeline.h"
@@ -44,6 +49,56 @@ const std::string TEST_DH_ID = "Camera_device@3.5/legacy/1";
 const std::string TEST_STRING = "test_string";
 const int32_t TEST_WIDTH = 1080;
 const int32_t TEST_HEIGHT = 1920;
+const int32_t TEST_RELEASE_WAIT_MS = 1000;
+const size_t TEST_JPEG_SIZE = 4;
+const size_t TEST_SURFACE_SIZE = 16;
+const size_t TEST_THUMBNAIL_OFFSET = 56;
+const size_t TEST_THUMBNAIL_SIZE = 4;
+const size_t TEST_THUMBNAIL_LENGTH_POS = 48;
+const size_t TEST_SCAN_JPEG_SIZE = 21;
+const size_t TEST_SEND_TIMES = 2;
+const int32_t TEST_SEND_WAIT_MS = 1000;
+
+// a jpeg whose EXIF block carries a 4 byte thumbnail in IFD1, followed by the scan of the full picture
+const uint8_t TEST_EXIF_JPEG[] = {
+    0xFF, 0xD8,
+    0xFF, 0xE1, 0x00, 0x38, 'E', 'x', 'i', 'f', 0x00, 0x00,
+    'M', 'M', 0x00, 0x2A, 0x00, 0x00, 0x00, 0x08,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0E,
+    0x00, 0x02,
+    0x02, 0x01, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x2C,
+    0x02, 0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04,
+    0x00, 0x00, 0x00, 0x00,
+    0xFF, 0xD8, 0xFF, 0xD9,
+    0xFF, 0xDA, 0x00, 0x02, 0x11, 0x22, 0xFF, 0xD9,
+};
+
+// a jpeg with an EOI inside a marker segment and stuffed bytes and a restart marker in its scan, followed by
+// what is left of an older picture in the surface buffer
+const uint8_t TEST_SCAN_JPEG[] = {
+    0xFF, 0xD8,
+    0xFF, 0xE0, 0x00, 0x04, 0xFF, 0xD9,
+    0xFF, 0xDA, 0x00, 0x02, 0x11, 0xFF, 0x00, 0x22, 0xFF, 0xD0, 0x33,
+    0xFF, 0xD9,
+    0x44, 0xFF, 0x00, 0xFF, 0xD9, 0x00, 0x00,
+};
+
+class RecordCameraChannel : public MockCameraChannel {
+public:
+    int32_t SendData(std::shared_ptr<DataBuffer>& buffer)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        sentBuffers_.push_back(buffer);
+        if (sentBuffers_.size() == TEST_SEND_TIMES) {
+            sent_.set_value();
+        }
+        return DCAMERA_OK;
+    }
+
+    std::mutex lock_;
+    std::promise<void> sent_;
+    std::vector<std::shared_ptr<DataBuffer>> sentBuffers_;
+};
 
 std::shared_ptr<DCameraCaptureInfo> g_testCaptureInfoContinuousNotEncode;
 std::shared_ptr<DCameraCaptureInfo> g_testCaptureInfoContinuousNeedEncode;
@@ -194,5 +249,99 @@ HWTEST_F(DCameraSinkDataProcessTest, dcamera_sink_data_process_test_007, TestSiz
     int32_t ret = dataProcess_->FeedStream(g_testDataBuffer);
     EXPECT_EQ(DCAMERA_OK, ret);
 }
+
+/**
+ * @tc.name: dcamera_sink_data_process_test_008
+ * @tc.desc: Verify a snapshot sent straight from the surface memory holds it until the send is done.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSinkDataProcessTest, dcamera_sink_data_process_test_008, TestSize.Level1)
+{
+    uint8_t surfaceData[TEST_SURFACE_SIZE] = { 0xFF, 0xD8, 0xFF, 0xD9 };
+    size_t jpegSize = GetJpegSize(surfaceData, TEST_SURFACE_SIZE);
+    EXPECT_EQ(TEST_JPEG_SIZE, jpegSize);
+
+    std::shared_ptr<std::promise<void>> released = std::make_shared<std::promise<void>>();
+    std::future<void> releaseResult = released->get_future();
+    std::shared_ptr<DataBuffer> buffer = std::make_shared<DataBuffer>(surfaceData, jpegSize,
+        [released]() { released->set_value(); });
+    EXPECT_EQ(surfaceData, buffer->Data());
+    EXPECT_EQ(jpegSize, buffer->Size());
+
+    dataProcess_->captureInfo_ = g_testCaptureInfoSnapshot;
+    int32_t ret = dataProcess_->FeedStream(buffer);
+    EXPECT_EQ(DCAMERA_OK, ret);
+    buffer = nullptr;
+    EXPECT_EQ(std::future_status::ready, releaseResult.wait_for(std::chrono::milliseconds(TEST_RELEASE_WAIT_MS)));
+}
+
+/**
+ * @tc.name: dcamera_sink_data_process_test_009
+ * @tc.desc: Verify the embedded thumbnail is sent ahead of the full picture when the source asks for it.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSinkDataProcessTest, dcamera_sink_data_process_test_009, TestSize.Level1)
+{
+    size_t offset = 0;
+    size_t length = 0;
+    EXPECT_EQ(true, GetJpegThumbnail(TEST_EXIF_JPEG, sizeof(TEST_EXIF_JPEG), offset, length));
+    EXPECT_EQ(TEST_THUMBNAIL_OFFSET, offset);
+    EXPECT_EQ(TEST_THUMBNAIL_SIZE, length);
+    EXPECT_EQ(false, GetJpegThumbnail(TEST_EXIF_JPEG, TEST_THUMBNAIL_OFFSET, offset, length));
+
+    std::shared_ptr<RecordCameraChannel> recordChannel = std::make_shared<RecordCameraChannel>();
+    std::future<void> sendResult = recordChannel->sent_.get_future();
+    std::shared_ptr<ICameraChannel> channel = recordChannel;
+    std::shared_ptr<DCameraSinkDataProcess> dataProcess = std::make_shared<DCameraSinkDataProcess>(TEST_DH_ID, channel);
+    std::shared_ptr<DCameraCaptureInfo> captureInfo = std::make_shared<DCameraCaptureInfo>(*g_testCaptureInfoSnapshot);
+    std::shared_ptr<DCameraSettings> thumbnailSetting = std::make_shared<DCameraSettings>();
+    thumbnailSetting->type_ = SNAPSHOT_THUMBNAIL;
+    captureInfo->captureSettings_.push_back(thumbnailSetting);
+    dataProcess->captureInfo_ = captureInfo;
+
+    std::shared_ptr<DataBuffer> buffer = std::make_shared<DataBuffer>(sizeof(TEST_EXIF_JPEG));
+    memcpy_s(buffer->Data(), buffer->Capacity(), TEST_EXIF_JPEG, sizeof(TEST_EXIF_JPEG));
+    EXPECT_EQ(DCAMERA_OK, dataProcess->FeedStream(buffer));
+    EXPECT_EQ(std::future_status::ready, sendResult.wait_for(std::chrono::milliseconds(TEST_SEND_WAIT_MS)));
+
+    std::lock_guard<std::mutex> autoLock(recordChannel->lock_);
+    int32_t frameType = DCAMERA_FRAME_TYPE_FULL;
+    EXPECT_EQ(true, recordChannel->sentBuffers_[0]->FindInt32("frameType", frameType));
+    EXPECT_EQ(DCAMERA_FRAME_TYPE_THUMBNAIL, frameType);
+    EXPECT_EQ(buffer->Data() + TEST_THUMBNAIL_OFFSET, recordChannel->sentBuffers_[0]->Data());
+    EXPECT_EQ(TEST_THUMBNAIL_SIZE, recordChannel->sentBuffers_[0]->Size());
+    EXPECT_EQ(buffer, recordChannel->sentBuffers_[1]);
+}
+
+/**
+ * @tc.name: dcamera_sink_data_process_test_010
+ * @tc.desc: Verify a thumbnail longer than its EXIF block is rejected.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSinkDataProcessTest, dcamera_sink_data_process_test_010, TestSize.Level1)
+{
+    uint8_t jpeg[sizeof(TEST_EXIF_JPEG)] = { 0 };
+    memcpy_s(jpeg, sizeof(jpeg), TEST_EXIF_JPEG, sizeof(TEST_EXIF_JPEG));
+    jpeg[TEST_THUMBNAIL_LENGTH_POS] = 0xFF;
+
+    size_t offset = 0;
+    size_t length = 0;
+    EXPECT_EQ(false, GetJpegThumbnail(jpeg, sizeof(jpeg), offset, length));
+}
+
+/**
+ * @tc.name: dcamera_sink_data_process_test_011
+ * @tc.desc: Verify the picture ends at the EOI that follows its scan, not at a later one in the buffer.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSinkDataProcessTest, dcamera_sink_data_process_test_011, TestSize.Level1)
+{
+    EXPECT_EQ(TEST_SCAN_JPEG_SIZE, GetJpegSize(TEST_SCAN_JPEG, sizeof(TEST_SCAN_JPEG)));
+    EXPECT_EQ(TEST_SCAN_JPEG_SIZE - 1, GetJpegSize(TEST_SCAN_JPEG, TEST_SCAN_JPEG_SIZE - 1));
+}
 } // namespace DistributedHardware
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
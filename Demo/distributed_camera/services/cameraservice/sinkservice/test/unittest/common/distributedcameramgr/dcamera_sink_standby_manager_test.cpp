@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <memory>
+
+#include "dcamera_sink_standby_manager.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraSinkStandbyManagerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const std::string TEST_DH_ID_0 = "camera_0";
+const std::string TEST_DH_ID_1 = "camera_1";
+const int32_t TEST_WIDTH = 1920;
+const int32_t TEST_HEIGHT = 1080;
+const int32_t TEST_EVICT_WAIT_MS = 1000;
+}
+
+void DCameraSinkStandbyManagerTest::SetUpTestCase(void)
+{
+}
+
+void DCameraSinkStandbyManagerTest::TearDownTestCase(void)
+{
+}
+
+void DCameraSinkStandbyManagerTest::SetUp(void)
+{
+}
+
+void DCameraSinkStandbyManagerTest::TearDown(void)
+{
+    DCameraSinkStandbyManager::GetInstance().RemoveStandby(TEST_DH_ID_0);
+    DCameraSinkStandbyManager::GetInstance().RemoveStandby(TEST_DH_ID_1);
+}
+
+/**
+ * @tc.name: dcamera_sink_standby_manager_test_001
+ * @tc.desc: Verify the standby memory is estimated and accounted per camera.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSinkStandbyManagerTest, dcamera_sink_standby_manager_test_001, TestSize.Level1)
+{
+    std::shared_ptr<DCameraCaptureInfo> info = std::make_shared<DCameraCaptureInfo>();
+    info->width_ = TEST_WIDTH;
+    info->height_ = TEST_HEIGHT;
+    std::vector<std::shared_ptr<DCameraCaptureInfo>> captureInfos = { info };
+    uint64_t memBytes = DCameraSinkStandbyManager::EstimateMemory(captureInfos);
+    EXPECT_EQ(static_cast<uint64_t>(TEST_WIDTH * TEST_HEIGHT * 3 / 2) * DCAMERA_STANDBY_BUFFER_NUM, memBytes);
+
+    DCameraSinkStandbyManager& manager = DCameraSinkStandbyManager::GetInstance();
+    EXPECT_EQ(DCAMERA_OK, manager.AddStandby(TEST_DH_ID_0, memBytes, nullptr));
+    EXPECT_EQ(DCAMERA_OK, manager.AddStandby(TEST_DH_ID_0, memBytes, nullptr));
+    EXPECT_EQ(memBytes, manager.GetMemoryUsage());
+    EXPECT_EQ(DCAMERA_OK, manager.AddStandby(TEST_DH_ID_1, memBytes, nullptr));
+    EXPECT_EQ(memBytes * 2, manager.GetMemoryUsage());
+    EXPECT_EQ(2, manager.GetStandbyCount());
+
+    manager.RemoveStandby(TEST_DH_ID_0);
+    manager.RemoveStandby(TEST_DH_ID_1);
+    EXPECT_EQ(0, manager.GetMemoryUsage());
+    EXPECT_EQ(DCAMERA_BAD_VALUE, manager.AddStandby(TEST_DH_ID_0, DCAMERA_STANDBY_MEMORY_MAX + 1, nullptr));
+}
+
+/**
+ * @tc.name: dcamera_sink_standby_manager_test_002
+ * @tc.desc: Verify the oldest standby is evicted when the memory budget runs out.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSinkStandbyManagerTest, dcamera_sink_standby_manager_test_002, TestSize.Level1)
+{
+    DCameraSinkStandbyManager& manager = DCameraSinkStandbyManager::GetInstance();
+    std::shared_ptr<std::promise<void>> evicted = std::make_shared<std::promise<void>>();
+    std::future<void> evictResult = evicted->get_future();
+    uint64_t memBytes = DCAMERA_STANDBY_MEMORY_MAX / 2 + 1;
+    EXPECT_EQ(DCAMERA_OK, manager.AddStandby(TEST_DH_ID_0, memBytes, [evicted]() { evicted->set_value(); }));
+    EXPECT_EQ(DCAMERA_OK, manager.AddStandby(TEST_DH_ID_1, memBytes, nullptr));
+
+    EXPECT_EQ(std::future_status::ready, evictResult.wait_for(std::chrono::milliseconds(TEST_EVICT_WAIT_MS)));
+    EXPECT_EQ(1, manager.GetStandbyCount());
+    EXPECT_EQ(memBytes, manager.GetMemoryUsage());
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -56,6 +56,11 @@ public:
         return DCAMERA_OK;
     }
 
+    int32_t PrepareCapture(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos)
+    {
+        return DCAMERA_OK;
+    }
+
     int32_t StartCapture(std::vector<std::shared_ptr<DCameraCaptureInfo>>& captureInfos)
     {
         return DCAMERA_OK;
@@ -71,6 +71,14 @@ public:
     {
         return DCAMERA_OK;
     }
+    int32_t EnableStandby()
+    {
+        return DCAMERA_OK;
+    }
+    int32_t DisableStandby()
+    {
+        return DCAMERA_OK;
+    }
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -59,6 +59,12 @@ public:
     {
         return DCAMERA_OK;
     }
+    void SetFlowControl(bool isThrottled)
+    {
+    }
+    void SetDegradeLevel(int32_t level)
+    {
+    }
     void OnEvent(DCameraPhotoOutputEvent& event)
     {
     }
@@ -56,6 +56,12 @@ public:
     {
         return DCAMERA_OK;
     }
+    void SetFlowControl(bool isThrottled)
+    {
+    }
+    void SetDegradeLevel(int32_t level)
+    {
+    }
 };
 } // namespace DistributedHardware
 } // namespace OHOS
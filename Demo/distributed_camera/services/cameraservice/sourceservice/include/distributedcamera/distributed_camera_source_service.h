@@ -18,7 +18,7 @@
 
 #include <memory>
 #include <mutex>
-#include <map>
+#include <unordered_map>
 
 #include "system_ability.h"
 #include "ipc_object_stub.h"
@@ -45,7 +45,10 @@ public:
         const std::string& reqId) override;
     int32_t DCameraNotify(const std::string& devId, const std::string& dhId, std::string& events) override;
 
-    static std::map<DCameraIndex, std::shared_ptr<DCameraSourceDev>> camerasMap_;
+    static void EraseCamDev(const DCameraIndex& index);
+
+    static std::unordered_map<DCameraIndex, std::shared_ptr<DCameraSourceDev>, DCameraIndexHash> camerasMap_;
+    static std::mutex camDevMutex_;
 
 protected:
     void OnStart() override;
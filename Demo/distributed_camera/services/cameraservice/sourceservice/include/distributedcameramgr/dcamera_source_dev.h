@@ -48,6 +48,8 @@ public:
     int32_t StartCapture(const std::vector<std::shared_ptr<DCCaptureInfo>>& captureInfos);
     int32_t StopCapture();
     int32_t UpdateCameraSettings(const std::vector<std::shared_ptr<DCameraSettings>>& settings);
+    void NotifyFlowControl(bool isThrottled);
+    void NotifyDegradeLevel(int32_t level);
 
     void OnEvent(DCameraSourceEvent& event) override;
 
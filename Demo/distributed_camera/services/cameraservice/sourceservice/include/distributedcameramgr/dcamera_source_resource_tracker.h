@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_SOURCE_RESOURCE_TRACKER_H
+#define OHOS_DCAMERA_SOURCE_RESOURCE_TRACKER_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "dcamera_index.h"
+#include "single_instance.h"
+#include "types.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+struct DCameraResourceStats {
+    uint32_t continuousStreamCount = 0;
+    uint32_t snapshotStreamCount = 0;
+    uint64_t frameCount = 0;
+    uint64_t byteCount = 0;
+};
+
+class DCameraSourceResourceTracker {
+DECLARE_SINGLE_INSTANCE_BASE(DCameraSourceResourceTracker);
+
+public:
+    int32_t AddCamera(const DCameraIndex& index);
+    void RemoveCamera(const DCameraIndex& index);
+    void UpdateStreamCount(const DCameraIndex& index, DCStreamType streamType, uint32_t streamCount);
+    void OnFrameFed(const DCameraIndex& index, size_t size);
+    int32_t GetStats(const DCameraIndex& index, DCameraResourceStats& stats);
+    uint32_t GetCameraCount();
+    void DumpStats();
+
+private:
+    DCameraSourceResourceTracker() = default;
+    ~DCameraSourceResourceTracker() = default;
+
+    std::mutex statsLock_;
+    std::unordered_map<DCameraIndex, DCameraResourceStats, DCameraIndexHash> statsMap_;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_SOURCE_RESOURCE_TRACKER_H
@@ -16,7 +16,10 @@
 #ifndef OHOS_DCAMERA_SOURCE_SERVICE_IPC_H
 #define OHOS_DCAMERA_SOURCE_SERVICE_IPC_H
 
-#include "event_handler.h"
+#include <map>
+#include <mutex>
+
+#include "dcamera_executor.h"
 #include "idistributed_camera_sink.h"
 #include "single_instance.h"
 
@@ -47,7 +50,7 @@ private:
     std::mutex sinkRemoteDmsLock_;
 
     bool isInit_;
-    std::shared_ptr<AppExecFwk::EventHandler> serviceHandler_;
+    std::shared_ptr<DCameraSerialQueue> serviceQueue_;
     std::mutex initDmsLock_;
 };
 } // namespace DistributedHardware
@@ -18,6 +18,10 @@
 
 #include "icamera_controller.h"
 
+#include <atomic>
+#include <mutex>
+
+#include "dcamera_command_dispatcher.h"
 #include "dcamera_index.h"
 #include "icamera_channel_listener.h"
 #include "dcamera_source_state_machine.h"
@@ -44,13 +48,19 @@ public:
     int32_t CloseChannel() override;
     int32_t Init(std::vector<DCameraIndex>& indexs) override;
     int32_t UnInit() override;
+    int32_t EnableStandby() override;
+    int32_t DisableStandby() override;
 
     void OnSessionState(int32_t state);
     void OnSessionError(int32_t eventType, int32_t eventReason, std::string detail);
     void OnDataReceived(std::vector<std::shared_ptr<DataBuffer>>& buffers);
 
 private:
-    void HandleMetaDataResult(std::string& jsonStr);
+    void RegisterCommandHandlers();
+    int32_t HandleMetaDataResult(const DCameraCommandPacket& packet);
+    int32_t HandleCodecNegotiation(const DCameraCommandPacket& packet);
+    sptr<IDCameraProvider> GetHdiProvider();
+    void ResetHdiProvider(const sptr<IDCameraProvider>& provider);
 
 private:
     std::string devId_;
@@ -61,6 +71,10 @@ private:
     std::shared_ptr<DCameraSourceStateMachine> stateMachine_;
     std::shared_ptr<EventBus> eventBus_;
     int32_t channelState_;
+    std::atomic<uint32_t> cmdCodecVersion_;
+    DCameraCommandDispatcher dispatcher_;
+    std::mutex providerMutex_;
+    sptr<IDCameraProvider> camHdiProvider_;
 
     bool isInit;
     const std::string SESSION_FLAG = "control";
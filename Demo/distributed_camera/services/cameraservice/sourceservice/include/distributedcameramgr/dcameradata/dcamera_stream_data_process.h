@@ -16,6 +16,8 @@
 #ifndef OHOS_DCAMERA_STREAM_DATA_PROCESS_H
 #define OHOS_DCAMERA_STREAM_DATA_PROCESS_H
 
+#include <deque>
+#include <mutex>
 #include <set>
 
 #include "data_buffer.h"
@@ -43,8 +45,10 @@ public:
     void OnError(DataProcessErrorType errorType);
 
 private:
+    bool IsSnapShotWanted(const std::shared_ptr<DataBuffer>& buffer);
     void FeedStreamToSnapShot(const std::shared_ptr<DataBuffer>& buffer);
     void FeedStreamToContinue(const std::shared_ptr<DataBuffer>& buffer);
+    void ProcessPendingBuffers();
     void CreatePipeline();
     void DestroyPipeline();
     VideoCodecType GetPipelineCodecType(DCEncodeType encodeType);
@@ -58,8 +62,13 @@ private:
     std::set<int32_t> streamIds_;
     std::shared_ptr<DCameraStreamConfig> srcConfig_;
     std::shared_ptr<DCameraStreamConfig> dstConfig_;
+    std::mutex pipelineMutex_;
     std::shared_ptr<IDataProcessPipeline> pipeline_;
     std::shared_ptr<DataProcessListener> listener_;
+    bool isCapturing_ = false;
+    bool hasThumbnail_ = false;
+    std::deque<std::shared_ptr<DataBuffer>> pendingBuffers_;
+    std::mutex producerMutex_;
     std::map<uint32_t, std::shared_ptr<DCameraStreamDataProcessProducer>> producers_;
 };
 } // namespace DistributedHardware
@@ -17,12 +17,14 @@
 #define OHOS_ICAMERA_SOURCE_DATA_PROCESS_PRODUCER_H
 
 #include <condition_variable>
+#include <deque>
+#include <map>
 #include <mutex>
 #include <queue>
 #include <thread>
 
 #include "data_buffer.h"
-#include "event_handler.h"
+#include "dcamera_executor.h"
 #include "idistributed_camera_provider.h"
 
 namespace OHOS {
@@ -41,13 +43,32 @@ public:
     void FeedStream(const std::shared_ptr<DataBuffer>& buffer);
     void UpdateInterval(uint32_t fps);
 
+    static void NotifyBufferAvailable(const std::string& devId, const std::string& dhId, int32_t streamId);
+    static void SetDegradeLevel(const std::string& devId, const std::string& dhId, int32_t level);
+
 private:
+    static std::string GetProducerKey(const std::string& devId, const std::string& dhId, int32_t streamId);
+    void OnBufferAvailable();
+    void UpdateIntervalLocked();
     void LooperContinue();
     void LooperSnapShot();
+    bool ReserveBufferLocked(const std::shared_ptr<DataBuffer>& buffer);
+    void PushBufferLocked(const std::shared_ptr<DataBuffer>& buffer);
+    void PopBufferLocked();
     int32_t FeedStreamToDriver(const std::shared_ptr<DHBase>& dhBase, const std::shared_ptr<DataBuffer>& buffer);
+    int32_t FeedStreamByHandle(sptr<IDCameraProvider>& camHdiProvider, const std::shared_ptr<DataBuffer>& buffer);
+    uint32_t GetPrefetchCount();
+    int32_t FeedStreamByDHBase(sptr<IDCameraProvider>& camHdiProvider, const std::shared_ptr<DHBase>& dhBase,
+        const std::shared_ptr<DataBuffer>& buffer);
+    int32_t CopyToDriverBuffer(const std::shared_ptr<DataBuffer>& buffer,
+        std::shared_ptr<DCameraBuffer>& sharedMemory);
+    void UnregisterStream();
 
     const uint32_t DCAMERA_PRODUCER_MAX_BUFFER_SIZE = 30;
     const uint32_t DCAMERA_PRODUCER_RETRY_SLEEP_MS = 500;
+    const uint32_t DCAMERA_PRODUCER_PREFETCH_COUNT = 2;
+    const uint32_t DCAMERA_PRODUCER_PERCENT_BASE = 100;
+    const int32_t DCAMERA_PRODUCER_INVALID_HANDLE = -1;
 
 private:
     std::string devId_;
@@ -57,11 +78,25 @@ private:
     std::condition_variable producerCon_;
     std::mutex producerMutex_;
     std::queue<std::shared_ptr<DataBuffer>> buffers_;
+    size_t queuedBytes_ = 0;
     DCameraProducerState state_;
     uint32_t interval_;
+    uint32_t fps_;
+    uint32_t fpsPercent_;
     int32_t streamId_;
     DCStreamType streamType_;
-    std::shared_ptr<AppExecFwk::EventHandler> eventHandler_;
+    std::shared_ptr<DCameraSerialQueue> feedQueue_;
+
+    // Driver side state, only touched by the feed queue or the snapshot looper.
+    int32_t streamHandle_ = DCAMERA_PRODUCER_INVALID_HANDLE;
+    bool isHandleUnsupported_ = false;
+    std::deque<std::shared_ptr<DCameraBuffer>> driverBuffers_;
+    // Set by the driver notification that a buffer freed up after a failed acquire, wakes the looper early.
+    bool isBufferAvailable_ = false;
+
+    // Started producers by device and stream, so that a driver notification reaches its producer directly.
+    static std::mutex producersLock_;
+    static std::map<std::string, DCameraStreamDataProcessProducer*> producers_;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
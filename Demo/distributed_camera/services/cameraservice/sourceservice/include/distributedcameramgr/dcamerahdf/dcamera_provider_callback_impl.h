@@ -36,6 +36,7 @@ public:
     DCamRetCode StopCapture(const std::shared_ptr<DHBase>& dhBase) override;
     DCamRetCode UpdateSettings(const std::shared_ptr<DHBase>& dhBase,
         const std::vector<std::shared_ptr<DCameraSettings>>& settings) override;
+    void NotifyBufferAvailable(const std::shared_ptr<DHBase>& dhBase, int streamId) override;
 
 private:
     std::string devId_;
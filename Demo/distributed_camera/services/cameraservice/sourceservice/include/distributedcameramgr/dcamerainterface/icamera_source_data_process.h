@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "data_buffer.h"
+#include "distributed_camera_constants.h"
 #include "types.h"
 
 namespace OHOS {
@@ -28,7 +29,7 @@ public:
     DCameraStreamConfig(int32_t width, int32_t height, int32_t format, int32_t dataspace,
         DCEncodeType encodeType, DCStreamType streamType)
         : width_(width), height_(height), format_(format), dataspace_(dataspace), encodeType_(encodeType),
-        type_(streamType)
+        type_(streamType), fps_(DCAMERA_PRODUCER_FPS_DEFAULT)
     {}
     ~DCameraStreamConfig() = default;
     int32_t width_;
@@ -37,12 +38,13 @@ public:
     int32_t dataspace_;
     DCEncodeType encodeType_;
     DCStreamType type_;
+    uint32_t fps_;
 
     bool operator == (const DCameraStreamConfig& others) const
     {
         return this->width_ == others.width_ && this->height_ == others.height_ && this->format_ == others.format_ &&
             this->dataspace_ == others.dataspace_ && this->encodeType_ == others.encodeType_ &&
-            this->type_ == others.type_;
+            this->type_ == others.type_ && this->fps_ == others.fps_;
     }
 
     bool operator < (const DCameraStreamConfig& others) const
@@ -15,9 +15,8 @@
 
 #include "dcamera_service_state_listener.h"
 
-#include <thread>
-
 #include "anonymous_string.h"
+#include "dcamera_executor.h"
 #include "dcamera_index.h"
 #include "distributed_camera_errno.h"
 #include "distributed_camera_source_service.h"
@@ -52,12 +51,12 @@ int32_t DCameraServiceStateListener::OnRegisterNotify(const std::string& devId,
         DHLOGE("DCameraServiceStateListener OnRegisterNotify OnNotifyRegResult failed: %d", ret);
     }
     if (status != DCAMERA_OK) {
-        std::thread([this, &devId, &dhId]() {
+        DCameraExecutor::GetInstance().PostTask(DCAMERA_TASK_TIER_BACKGROUND, [devId, dhId]() {
             DHLOGI("DCameraServiceStateListener OnRegisterNotify thread delete devId: %s dhId: %s",
                 GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
             DCameraIndex camIndex(devId, dhId);
-            DistributedCameraSourceService::camerasMap_.erase(camIndex);
-        }).detach();
+            DistributedCameraSourceService::EraseCamDev(camIndex);
+        });
     }
     return ret;
 }
@@ -78,12 +77,12 @@ int32_t DCameraServiceStateListener::OnUnregisterNotify(const std::string& devId
     }
 
     if (status == DCAMERA_OK) {
-        std::thread([this, &devId, &dhId]() {
+        DCameraExecutor::GetInstance().PostTask(DCAMERA_TASK_TIER_BACKGROUND, [devId, dhId]() {
             DHLOGI("DCameraServiceStateListener OnUnregisterNotify thread delete devId: %s dhId: %s",
                 GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
             DCameraIndex camIndex(devId, dhId);
-            DistributedCameraSourceService::camerasMap_.erase(camIndex);
-        }).detach();
+            DistributedCameraSourceService::EraseCamDev(camIndex);
+        });
     }
 
     return ret;
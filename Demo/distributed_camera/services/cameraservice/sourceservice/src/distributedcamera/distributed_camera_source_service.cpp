@@ -23,8 +23,11 @@
 #include "system_ability_definition.h"
 
 #include "anonymous_string.h"
+#include "dcamera_executor.h"
 #include "dcamera_service_state_listener.h"
+#include "dcamera_source_resource_tracker.h"
 #include "dcamera_source_service_ipc.h"
+#include "dcamera_thread_policy.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
 
@@ -32,7 +35,9 @@ namespace OHOS {
 namespace DistributedHardware {
 REGISTER_SYSTEM_ABILITY_BY_ID(DistributedCameraSourceService, DISTRIBUTED_HARDWARE_CAMERA_SOURCE_SA_ID, true);
 
-std::map<DCameraIndex, std::shared_ptr<DCameraSourceDev>> DistributedCameraSourceService::camerasMap_;
+std::unordered_map<DCameraIndex, std::shared_ptr<DCameraSourceDev>, DCameraIndexHash>
+    DistributedCameraSourceService::camerasMap_;
+std::mutex DistributedCameraSourceService::camDevMutex_;
 
 DistributedCameraSourceService::DistributedCameraSourceService(int32_t saId, bool runOnCreate)
     : SystemAbility(saId, runOnCreate)
@@ -102,6 +107,9 @@ int32_t DistributedCameraSourceService::ReleaseSource()
         return ret;
     }
     callbackProxy_ = nullptr;
+    DCameraSourceResourceTracker::GetInstance().DumpStats();
+    DCameraExecutor::GetInstance().DumpStats();
+    DCameraThreadPolicy::GetInstance().DumpThreads();
     return DCAMERA_OK;
 }
 
@@ -113,10 +121,16 @@ int32_t DistributedCameraSourceService::RegisterDistributedHardware(const std::s
     DCameraIndex camIndex(devId, dhId);
     std::shared_ptr<DCameraSourceDev> camDev = nullptr;
     int32_t ret = DCAMERA_OK;
+    std::lock_guard<std::mutex> autoLock(camDevMutex_);
     auto iter = camerasMap_.find(camIndex);
     if (iter == camerasMap_.end()) {
         DHLOGI("DistributedCameraSourceService RegisterDistributedHardware new dev devId: %s, dhId: %s, version: %s",
             GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str(), param.version.c_str());
+        if (camerasMap_.size() >= DCAMERA_SOURCE_DEV_MAX_NUM) {
+            DHLOGE("DistributedCameraSourceService RegisterDistributedHardware too many cameras: %zu",
+                camerasMap_.size());
+            return DCAMERA_INDEX_OVERFLOW;
+        }
         std::shared_ptr<ICameraStateListener> listener = std::make_shared<DCameraServiceStateListener>(callbackProxy_);
         camDev = std::make_shared<DCameraSourceDev>(devId, dhId, listener);
         if (camDev == nullptr) {
@@ -129,6 +143,7 @@ int32_t DistributedCameraSourceService::RegisterDistributedHardware(const std::s
             return ret;
         }
         camerasMap_.emplace(camIndex, camDev);
+        DCameraSourceResourceTracker::GetInstance().AddCamera(camIndex);
     } else {
         DHLOGI("DistributedCameraSourceService RegisterDistributedHardware exist devId: %s, dhId: %s, version: %s",
             GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str(), param.version.c_str());
@@ -139,6 +154,7 @@ int32_t DistributedCameraSourceService::RegisterDistributedHardware(const std::s
     if (ret != DCAMERA_OK) {
         DHLOGE("DistributedCameraSourceService RegisterDistributedHardware failed, ret: %d", ret);
         camerasMap_.erase(camIndex);
+        DCameraSourceResourceTracker::GetInstance().RemoveCamera(camIndex);
     }
     DHLOGI("DistributedCameraSourceService RegisterDistributedHardware end devId: %s, dhId: %s, version: %s",
         GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str(), param.version.c_str());
@@ -151,13 +167,16 @@ int32_t DistributedCameraSourceService::UnregisterDistributedHardware(const std:
     DHLOGI("DistributedCameraSourceService UnregisterDistributedHardware devId: %s, dhId: %s",
         GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
     DCameraIndex camIndex(devId, dhId);
-    auto iter = camerasMap_.find(camIndex);
-    if (iter == camerasMap_.end()) {
-        DHLOGE("DistributedCameraSourceService UnregisterDistributedHardware not found device");
-        return DCAMERA_NOT_FOUND;
+    std::shared_ptr<DCameraSourceDev> camDev = nullptr;
+    {
+        std::lock_guard<std::mutex> autoLock(camDevMutex_);
+        auto iter = camerasMap_.find(camIndex);
+        if (iter == camerasMap_.end()) {
+            DHLOGE("DistributedCameraSourceService UnregisterDistributedHardware not found device");
+            return DCAMERA_NOT_FOUND;
+        }
+        camDev = iter->second;
     }
-
-    std::shared_ptr<DCameraSourceDev> camDev = iter->second;
     int32_t ret = camDev->UnRegisterDistributedHardware(devId, dhId, reqId);
     if (ret != DCAMERA_OK) {
         DHLOGE("DistributedCameraSourceService UnregisterDistributedHardware failed, ret: %d", ret);
@@ -171,13 +190,16 @@ int32_t DistributedCameraSourceService::DCameraNotify(const std::string& devId,
     DHLOGI("DistributedCameraSourceService DCameraNotify devId: %s, dhId: %s", GetAnonyString(devId).c_str(),
         GetAnonyString(dhId).c_str());
     DCameraIndex camIndex(devId, dhId);
-    auto iter = camerasMap_.find(camIndex);
-    if (iter == camerasMap_.end()) {
-        DHLOGE("DistributedCameraSourceService DCameraNotify not found device");
-        return DCAMERA_NOT_FOUND;
+    std::shared_ptr<DCameraSourceDev> camDev = nullptr;
+    {
+        std::lock_guard<std::mutex> autoLock(camDevMutex_);
+        auto iter = camerasMap_.find(camIndex);
+        if (iter == camerasMap_.end()) {
+            DHLOGE("DistributedCameraSourceService DCameraNotify not found device");
+            return DCAMERA_NOT_FOUND;
+        }
+        camDev = iter->second;
     }
-
-    std::shared_ptr<DCameraSourceDev> camDev = iter->second;
     int32_t ret = camDev->DCameraNotify(events);
     if (ret != DCAMERA_OK) {
         DHLOGE("DistributedCameraSourceService DCameraNotify failed, ret: %d", ret);
@@ -185,6 +207,22 @@ int32_t DistributedCameraSourceService::DCameraNotify(const std::string& devId,
     return ret;
 }
 
+void DistributedCameraSourceService::EraseCamDev(const DCameraIndex& index)
+{
+    std::shared_ptr<DCameraSourceDev> camDev = nullptr;
+    {
+        std::lock_guard<std::mutex> autoLock(camDevMutex_);
+        auto iter = camerasMap_.find(index);
+        if (iter == camerasMap_.end()) {
+            return;
+        }
+        // keep the device alive until the lock is released, its destructor tears down the event bus
+        camDev = iter->second;
+        camerasMap_.erase(iter);
+    }
+    DCameraSourceResourceTracker::GetInstance().RemoveCamera(index);
+}
+
 int32_t DistributedCameraSourceService::LoadDCameraHDF()
 {
     return DCAMERA_OK;
@@ -21,10 +21,15 @@
 #include "distributed_hardware_log.h"
 
 #include "dcamera_channel_info_cmd.h"
+#include "dcamera_degrade_controller.h"
 #include "dcamera_info_cmd.h"
+#include "dcamera_memory_budget.h"
 #include "dcamera_provider_callback_impl.h"
 #include "dcamera_source_controller.h"
 #include "dcamera_source_input.h"
+#include "dcamera_startup_profiler.h"
+#include "dcamera_stream_data_process_producer.h"
+#include "dcamera_thread_policy.h"
 #include "dcamera_utils_tools.h"
 
 namespace OHOS {
@@ -184,8 +189,32 @@ int32_t DCameraSourceDev::UpdateCameraSettings(const std::vector<std::shared_ptr
     return DCAMERA_OK;
 }
 
+void DCameraSourceDev::NotifyFlowControl(bool isThrottled)
+{
+    DHLOGI("DCameraSourceDev NotifyFlowControl devId %s dhId %s throttled: %d", GetAnonyString(devId_).c_str(),
+        GetAnonyString(dhId_).c_str(), isThrottled);
+    std::shared_ptr<DCameraSettings> setting = std::make_shared<DCameraSettings>();
+    setting->type_ = FLOW_CONTROL;
+    setting->value_ = isThrottled ? "1" : "0";
+    std::vector<std::shared_ptr<DCameraSettings>> settings = { setting };
+    UpdateCameraSettings(settings);
+}
+
+void DCameraSourceDev::NotifyDegradeLevel(int32_t level)
+{
+    DHLOGI("DCameraSourceDev NotifyDegradeLevel devId %s dhId %s level: %d", GetAnonyString(devId_).c_str(),
+        GetAnonyString(dhId_).c_str(), level);
+    DCameraStreamDataProcessProducer::SetDegradeLevel(devId_, dhId_, level);
+    std::shared_ptr<DCameraSettings> setting = std::make_shared<DCameraSettings>();
+    setting->type_ = DEGRADE_LEVEL;
+    setting->value_ = std::to_string(level);
+    std::vector<std::shared_ptr<DCameraSettings>> settings = { setting };
+    UpdateCameraSettings(settings);
+}
+
 void DCameraSourceDev::OnEvent(DCameraSourceEvent& event)
 {
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamSourceDev", DCAMERA_TASK_TIER_CONTROL);
     DHLOGI("DCameraSourceDev OnEvent devId %s dhId %s eventType: %d", GetAnonyString(devId_).c_str(),
         GetAnonyString(dhId_).c_str(), event.GetEventType());
     int32_t ret = stateMachine_->Execute(event.GetEventType(), event);
@@ -286,6 +315,22 @@ int32_t DCameraSourceDev::ExecuteOpenCamera()
         return ret;
     }
 
+    DCameraStartupProfiler::GetInstance().Start(devId_ + dhId_);
+    std::weak_ptr<DCameraSourceDev> weakDev = shared_from_this();
+    DCameraMemoryBudget::GetInstance().AddCamera(devId_ + dhId_, DCAMERA_MEMORY_BUDGET_DEFAULT,
+        [weakDev](bool isThrottled) {
+            std::shared_ptr<DCameraSourceDev> camDev = weakDev.lock();
+            if (camDev != nullptr) {
+                camDev->NotifyFlowControl(isThrottled);
+            }
+        });
+    DCameraDegradeController::GetInstance().AddCamera(devId_ + dhId_, [weakDev](int32_t level) {
+        std::shared_ptr<DCameraSourceDev> camDev = weakDev.lock();
+        if (camDev != nullptr) {
+            camDev->NotifyDegradeLevel(level);
+        }
+    });
+    DCameraStartupPhaseScope phaseScope(devId_ + dhId_, DCAMERA_STARTUP_PHASE_OPEN_CHANNEL);
     ret = controller_->OpenChannel(openInfo);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceDev Execute OpenCamera OpenChannel failed, ret: %d, devId: %s dhId: %s", ret,
@@ -299,11 +344,14 @@ int32_t DCameraSourceDev::ExecuteCloseCamera()
 {
     DHLOGI("DCameraSourceDev Execute CloseCamera devId %s dhId %s", GetAnonyString(devId_).c_str(),
         GetAnonyString(dhId_).c_str());
+    DCameraStartupProfiler::GetInstance().Remove(devId_ + dhId_);
     int32_t ret = input_->CloseChannel();
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceDev Execute CloseCamera input CloseChannel failed, ret: %d, devId: %s dhId: %s", ret,
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
     }
+    DCameraMemoryBudget::GetInstance().RemoveCamera(devId_ + dhId_);
+    DCameraDegradeController::GetInstance().RemoveCamera(devId_ + dhId_);
     ret = controller_->CloseChannel();
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceDev Execute CloseCamera controller CloseChannel failed, ret: %d, devId: %s dhId: %s", ret,
@@ -316,7 +364,11 @@ int32_t DCameraSourceDev::ExecuteConfigStreams(std::vector<std::shared_ptr<DCStr
 {
     DHLOGI("DCameraSourceDev Execute ConfigStreams devId %s dhId %s", GetAnonyString(devId_).c_str(),
         GetAnonyString(dhId_).c_str());
-    int32_t ret = input_->ConfigStreams(streamInfos);
+    int32_t ret;
+    {
+        DCameraStartupPhaseScope phaseScope(devId_ + dhId_, DCAMERA_STARTUP_PHASE_CONFIG_STREAMS);
+        ret = input_->ConfigStreams(streamInfos);
+    }
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceDev Execute ConfigStreams ConfigStreams failed, ret: %d, devId: %s dhId: %s", ret,
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
@@ -335,7 +387,10 @@ int32_t DCameraSourceDev::ExecuteConfigStreams(std::vector<std::shared_ptr<DCStr
     chanInfo->detail_.push_back(continueChInfo);
     chanInfo->detail_.push_back(snapShotChInfo);
 
-    ret = controller_->ChannelNeg(chanInfo);
+    {
+        DCameraStartupPhaseScope phaseScope(devId_ + dhId_, DCAMERA_STARTUP_PHASE_CHANNEL_NEG);
+        ret = controller_->ChannelNeg(chanInfo);
+    }
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceDev ChannelNeg failed ret: %d, devId: %s, dhId: %s", ret,
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
@@ -344,7 +399,10 @@ int32_t DCameraSourceDev::ExecuteConfigStreams(std::vector<std::shared_ptr<DCStr
 
     std::vector<DCameraIndex> actualDevInfo;
     actualDevInfo.assign(actualDevInfo_.begin(), actualDevInfo_.end());
-    ret = input_->OpenChannel(actualDevInfo);
+    {
+        DCameraStartupPhaseScope phaseScope(devId_ + dhId_, DCAMERA_STARTUP_PHASE_OPEN_DATA_CHANNEL);
+        ret = input_->OpenChannel(actualDevInfo);
+    }
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceDev ChannelNeg OpenChannel failed ret: %d, devId: %s, dhId: %s", ret,
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
@@ -383,12 +441,6 @@ int32_t DCameraSourceDev::ExecuteStartCapture(std::vector<std::shared_ptr<DCCapt
 {
     DHLOGI("DCameraSourceDev Execute StartCapture devId %s dhId %s", GetAnonyString(devId_).c_str(),
         GetAnonyString(dhId_).c_str());
-    int32_t ret = input_->StartCapture(captureInfos);
-    if (ret != DCAMERA_OK) {
-        DHLOGE("DCameraSourceDev input StartCapture failed ret: %d, devId: %s, dhId: %s", ret,
-            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
-        return ret;
-    }
     std::vector<std::shared_ptr<DCameraCaptureInfo>> captures;
     for (auto iter = captureInfos.begin(); iter != captureInfos.end(); iter++) {
         std::shared_ptr<DCameraCaptureInfo> capture = std::make_shared<DCameraCaptureInfo>();
@@ -413,12 +465,30 @@ int32_t DCameraSourceDev::ExecuteStartCapture(std::vector<std::shared_ptr<DCCapt
         captures.push_back(capture);
     }
 
-    ret = controller_->StartCapture(captures);
+    // the request goes out first so the sink starts its camera while the decoder is created here,
+    // frames arriving before the decoder is ready are held by the stream data process
+    int32_t ret;
+    {
+        DCameraStartupPhaseScope phaseScope(devId_ + dhId_, DCAMERA_STARTUP_PHASE_CAPTURE_REQUEST);
+        ret = controller_->StartCapture(captures);
+    }
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceDev Execute StartCapture StartCapture failed, ret: %d, devId: %s dhId: %s", ret,
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+        return ret;
+    }
+
+    {
+        DCameraStartupPhaseScope phaseScope(devId_ + dhId_, DCAMERA_STARTUP_PHASE_CREATE_CODEC);
+        ret = input_->StartCapture(captureInfos);
+    }
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSourceDev input StartCapture failed ret: %d, devId: %s, dhId: %s", ret,
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+        controller_->StopCapture();
+        return ret;
     }
-    return ret;
+    return DCAMERA_OK;
 }
 
 int32_t DCameraSourceDev::ExecuteStopCapture()
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_source_resource_tracker.h"
+
+#include "anonymous_string.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+IMPLEMENT_SINGLE_INSTANCE(DCameraSourceResourceTracker);
+
+int32_t DCameraSourceResourceTracker::AddCamera(const DCameraIndex& index)
+{
+    std::lock_guard<std::mutex> autoLock(statsLock_);
+    if (statsMap_.find(index) != statsMap_.end()) {
+        return DCAMERA_ALREADY_EXISTS;
+    }
+    statsMap_.emplace(index, DCameraResourceStats());
+    DHLOGI("DCameraSourceResourceTracker AddCamera devId %s dhId %s, camera count: %zu",
+        GetAnonyString(index.devId_).c_str(), GetAnonyString(index.dhId_).c_str(), statsMap_.size());
+    return DCAMERA_OK;
+}
+
+void DCameraSourceResourceTracker::RemoveCamera(const DCameraIndex& index)
+{
+    std::lock_guard<std::mutex> autoLock(statsLock_);
+    auto iter = statsMap_.find(index);
+    if (iter == statsMap_.end()) {
+        return;
+    }
+    DHLOGI("DCameraSourceResourceTracker RemoveCamera devId %s dhId %s, frames: %llu, bytes: %llu",
+        GetAnonyString(index.devId_).c_str(), GetAnonyString(index.dhId_).c_str(),
+        (unsigned long long)iter->second.frameCount, (unsigned long long)iter->second.byteCount);
+    statsMap_.erase(iter);
+}
+
+void DCameraSourceResourceTracker::UpdateStreamCount(const DCameraIndex& index, DCStreamType streamType,
+    uint32_t streamCount)
+{
+    std::lock_guard<std::mutex> autoLock(statsLock_);
+    auto iter = statsMap_.find(index);
+    if (iter == statsMap_.end()) {
+        return;
+    }
+    if (streamType == SNAPSHOT_FRAME) {
+        iter->second.snapshotStreamCount = streamCount;
+    } else {
+        iter->second.continuousStreamCount = streamCount;
+    }
+}
+
+void DCameraSourceResourceTracker::OnFrameFed(const DCameraIndex& index, size_t size)
+{
+    std::lock_guard<std::mutex> autoLock(statsLock_);
+    auto iter = statsMap_.find(index);
+    if (iter == statsMap_.end()) {
+        return;
+    }
+    iter->second.frameCount++;
+    iter->second.byteCount += size;
+}
+
+int32_t DCameraSourceResourceTracker::GetStats(const DCameraIndex& index, DCameraResourceStats& stats)
+{
+    std::lock_guard<std::mutex> autoLock(statsLock_);
+    auto iter = statsMap_.find(index);
+    if (iter == statsMap_.end()) {
+        return DCAMERA_NOT_FOUND;
+    }
+    stats = iter->second;
+    return DCAMERA_OK;
+}
+
+uint32_t DCameraSourceResourceTracker::GetCameraCount()
+{
+    std::lock_guard<std::mutex> autoLock(statsLock_);
+    return static_cast<uint32_t>(statsMap_.size());
+}
+
+void DCameraSourceResourceTracker::DumpStats()
+{
+    std::lock_guard<std::mutex> autoLock(statsLock_);
+    for (auto& iter : statsMap_) {
+        DHLOGI("DCameraSourceResourceTracker devId %s dhId %s, continuous streams: %u, snapshot streams: %u, " \
+            "frames: %llu, bytes: %llu", GetAnonyString(iter.first.devId_).c_str(),
+            GetAnonyString(iter.first.dhId_).c_str(), iter.second.continuousStreamCount,
+            iter.second.snapshotStreamCount, (unsigned long long)iter.second.frameCount,
+            (unsigned long long)iter.second.byteCount);
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
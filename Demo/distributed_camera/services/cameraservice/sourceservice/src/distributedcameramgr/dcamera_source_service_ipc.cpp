@@ -46,8 +46,8 @@ void DCameraSourceServiceIpc::Init()
         DHLOGI("DCameraSourceServiceIpc has already init");
         return;
     }
-    auto runner = AppExecFwk::EventRunner::Create("DCameraSourceServiceIpcHandler");
-    serviceHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    serviceQueue_ = DCameraExecutor::GetInstance().CreateSerialQueue("DCameraSourceServiceIpcHandler",
+        DCAMERA_TASK_TIER_BACKGROUND);
     sinkRemoteRecipient_ = new SinkRemoteRecipient();
     isInit_ = true;
     DHLOGI("DCameraSourceServiceIpc Init End");
@@ -63,7 +63,10 @@ void DCameraSourceServiceIpc::UnInit()
     }
     ClearSinkRemoteDhms();
     DHLOGI("DCameraSourceServiceIpc UnInit Start free servicehandle");
-    serviceHandler_ = nullptr;
+    if (serviceQueue_ != nullptr) {
+        serviceQueue_->Close();
+        serviceQueue_ = nullptr;
+    }
     DHLOGI("DCameraSourceServiceIpc UnInit Start free recipient");
     sinkRemoteRecipient_ = nullptr;
     isInit_ = false;
@@ -164,8 +167,8 @@ void DCameraSourceServiceIpc::OnSinkRemoteDmsDied(const wptr<IRemoteObject>& rem
     auto remoteDmsDiedFunc = [this, diedRemoted]() {
         OnSinkRemoteDmsDied(diedRemoted);
     };
-    if (serviceHandler_ != nullptr) {
-        serviceHandler_->PostTask(remoteDmsDiedFunc);
+    if (serviceQueue_ != nullptr) {
+        serviceQueue_->PostTask(remoteDmsDiedFunc);
     }
 }
 
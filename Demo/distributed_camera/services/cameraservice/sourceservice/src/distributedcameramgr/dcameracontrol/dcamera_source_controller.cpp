@@ -15,13 +15,16 @@
 
 #include "dcamera_source_controller.h"
 
+#include <algorithm>
 #include <securec.h>
 #include "json/json.h"
 
 #include "dcamera_capture_info_cmd.h"
 #include "dcamera_channel_source_impl.h"
+#include "dcamera_command_packer.h"
 #include "dcamera_metadata_setting_cmd.h"
 #include "dcamera_protocol.h"
+#include "dcamera_protocol_codec.h"
 #include "dcamera_source_controller_channel_listener.h"
 #include "dcamera_source_service_ipc.h"
 #include "dcamera_utils_tools.h"
@@ -36,11 +39,12 @@ namespace DistributedHardware {
 DCameraSourceController::DCameraSourceController(std::string devId, std::string dhId,
     std::shared_ptr<DCameraSourceStateMachine>& stateMachine, std::shared_ptr<EventBus>& eventBus)
     : devId_(devId), dhId_(dhId), stateMachine_(stateMachine), eventBus_(eventBus),
-    channelState_(DCAMERA_CHANNEL_STATE_DISCONNECTED)
+    channelState_(DCAMERA_CHANNEL_STATE_DISCONNECTED), cmdCodecVersion_(DCAMERA_CMD_CODEC_JSON)
 {
     DHLOGI("DCameraSourceController create devId: %s dhId: %s", GetAnonyString(devId_).c_str(),
         GetAnonyString(dhId_).c_str());
     isInit = false;
+    RegisterCommandHandlers();
 }
 
 DCameraSourceController::~DCameraSourceController()
@@ -68,22 +72,16 @@ int32_t DCameraSourceController::StartCapture(std::vector<std::shared_ptr<DCamer
     cmd.dhId_ = dhId;
     cmd.command_ = DCAMERA_PROTOCOL_CMD_CAPTURE;
     cmd.value_.assign(captureInfos.begin(), captureInfos.end());
-    std::string jsonStr;
-    int32_t ret = cmd.Marshal(jsonStr);
+    std::shared_ptr<DataBuffer> buffer = nullptr;
+    uint32_t codecVersion = cmdCodecVersion_;
+    int32_t ret = PackCommand(cmd, codecVersion, buffer);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceController StartCapture Marshal faied %d, devId: %s, dhId: %s", ret,
             GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
         return ret;
     }
-    DHLOGI("DCameraSourceController StartCapture devId: %s, dhId: %s captureJson: %s", GetAnonyString(devId).c_str(),
-        GetAnonyString(dhId).c_str(), jsonStr.c_str());
-    std::shared_ptr<DataBuffer> buffer = std::make_shared<DataBuffer>(jsonStr.length() + 1);
-    ret = memcpy_s(buffer->Data(), buffer->Capacity(), (uint8_t *)jsonStr.c_str(), jsonStr.length());
-    if (ret != EOK) {
-        DHLOGE("DCameraSourceController StartCapture memcpy_s failed %d, devId: %s, dhId: %s", ret,
-            GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
-        return ret;
-    }
+    DHLOGI("DCameraSourceController StartCapture devId: %s, dhId: %s codec: %u, size: %zu",
+        GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str(), codecVersion, buffer->Capacity());
     ret = channel_->SendData(buffer);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceController StartCapture SendData failed %d, devId: %s, dhId: %s", ret,
@@ -204,20 +202,13 @@ int32_t DCameraSourceController::UpdateSettings(std::vector<std::shared_ptr<DCam
     cmd.dhId_ = dhId;
     cmd.command_ = DCAMERA_PROTOCOL_CMD_UPDATE_METADATA;
     cmd.value_.assign(settings.begin(), settings.end());
-    std::string jsonStr;
-    int32_t ret = cmd.Marshal(jsonStr);
+    std::shared_ptr<DataBuffer> buffer = nullptr;
+    int32_t ret = PackCommand(cmd, cmdCodecVersion_, buffer);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceController UpdateSettings Marshal faied %d, devId: %s, dhId: %s", ret,
             GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
         return ret;
     }
-    std::shared_ptr<DataBuffer> buffer = std::make_shared<DataBuffer>(jsonStr.length() + 1);
-    ret = memcpy_s(buffer->Data(), buffer->Capacity(), (uint8_t *)jsonStr.c_str(), jsonStr.length());
-    if (ret != EOK) {
-        DHLOGE("DCameraSourceController UpdateSettings memcpy_s failed %d, devId: %s, dhId: %s", ret,
-            GetAnonyString(devId).c_str(), GetAnonyString(dhId).c_str());
-        return ret;
-    }
     ret = channel_->SendData(buffer);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceController UpdateSettings SendData failed %d, devId: %s, dhId: %s", ret,
@@ -278,6 +269,8 @@ int32_t DCameraSourceController::OpenChannel(std::shared_ptr<DCameraOpenInfo>& o
         return DCAMERA_BAD_OPERATE;
     }
 
+    cmdCodecVersion_ = DCAMERA_CMD_CODEC_JSON;
+    openInfo->cmdCodecVersion_ = DCAMERA_CMD_CODEC_VERSION;
     DCameraOpenInfoCmd cmd;
     cmd.type_ = DCAMERA_PROTOCOL_TYPE_MESSAGE;
     cmd.dhId_ = dhId;
@@ -333,6 +326,7 @@ int32_t DCameraSourceController::CloseChannel()
     DHLOGI("DCameraSourceController CloseChannel devId: %s, dhId: %s success", GetAnonyString(devId).c_str(),
         GetAnonyString(dhId).c_str());
     channelState_ = DCAMERA_CHANNEL_STATE_DISCONNECTED;
+    cmdCodecVersion_ = DCAMERA_CMD_CODEC_JSON;
     ret = channel_->ReleaseSession();
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSourceController CloseChannel ReleaseSession failed %d", ret);
@@ -375,6 +369,18 @@ int32_t DCameraSourceController::UnInit()
     return DCAMERA_OK;
 }
 
+int32_t DCameraSourceController::EnableStandby()
+{
+    DHLOGE("DCameraSourceController EnableStandby not support on source");
+    return DCAMERA_BAD_OPERATE;
+}
+
+int32_t DCameraSourceController::DisableStandby()
+{
+    DHLOGE("DCameraSourceController DisableStandby not support on source");
+    return DCAMERA_BAD_OPERATE;
+}
+
 void DCameraSourceController::OnSessionState(int32_t state)
 {
     DHLOGI("DCameraSourceController OnSessionState state %d", state);
@@ -422,51 +428,87 @@ void DCameraSourceController::OnDataReceived(std::vector<std::shared_ptr<DataBuf
             GetAnonyString(dhId_).c_str());
         return;
     }
-    std::shared_ptr<DataBuffer> buffer = *(buffers.begin());
-    std::string jsonStr((char *)buffer->Data());
-    JSONCPP_STRING errs;
-    Json::CharReaderBuilder readerBuilder;
-    Json::Value rootValue;
+    for (auto& buffer : buffers) {
+        dispatcher_.Dispatch(buffer->Data(), buffer->Capacity());
+    }
+}
 
-    std::unique_ptr<Json::CharReader> const jsonReader(readerBuilder.newCharReader());
-    if (!jsonReader->parse(jsonStr.c_str(), jsonStr.c_str() + jsonStr.length(), &rootValue, &errs) ||
-        !rootValue.isObject()) {
-        return;
+void DCameraSourceController::RegisterCommandHandlers()
+{
+    dispatcher_.RegisterHandler(DCAMERA_PROTOCOL_CMD_METADATA_RESULT, [this](const DCameraCommandPacket& packet) {
+        return HandleMetaDataResult(packet);
+    });
+    dispatcher_.RegisterHandler(DCAMERA_PROTOCOL_CMD_CODEC_NEG, [this](const DCameraCommandPacket& packet) {
+        return HandleCodecNegotiation(packet);
+    });
+}
+
+int32_t DCameraSourceController::HandleCodecNegotiation(const DCameraCommandPacket& packet)
+{
+    DCameraOpenInfoCmd cmd;
+    int32_t ret = packet.Unmarshal(cmd);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSourceController HandleCodecNegotiation failed, ret: %d, devId: %s, dhId: %s", ret,
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+        return ret;
     }
+    cmdCodecVersion_ = std::min(cmd.value_->cmdCodecVersion_, DCAMERA_CMD_CODEC_VERSION);
+    DHLOGI("DCameraSourceController HandleCodecNegotiation version: %u, devId: %s, dhId: %s",
+        cmdCodecVersion_.load(), GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+    return DCAMERA_OK;
+}
 
-    if (!rootValue.isMember("Command") || !rootValue["Command"].isString()) {
-        return;
+sptr<IDCameraProvider> DCameraSourceController::GetHdiProvider()
+{
+    std::lock_guard<std::mutex> lock(providerMutex_);
+    if (camHdiProvider_ != nullptr && (camHdiProvider_->AsObject() == nullptr ||
+        camHdiProvider_->AsObject()->IsObjectDead())) {
+        DHLOGI("DCameraSourceController cached camHdiProvider died, devId: %s, dhId: %s",
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+        camHdiProvider_ = nullptr;
     }
-    std::string command = rootValue["Command"].asString();
-    if (command == DCAMERA_PROTOCOL_CMD_METADATA_RESULT) {
-        HandleMetaDataResult(jsonStr);
+    if (camHdiProvider_ == nullptr) {
+        camHdiProvider_ = IDCameraProvider::Get();
     }
-    return;
+    return camHdiProvider_;
 }
 
-void DCameraSourceController::HandleMetaDataResult(std::string& jsonStr)
+void DCameraSourceController::ResetHdiProvider(const sptr<IDCameraProvider>& provider)
 {
-    sptr<IDCameraProvider> camHdiProvider = IDCameraProvider::Get();
+    std::lock_guard<std::mutex> lock(providerMutex_);
+    if (camHdiProvider_ == provider) {
+        camHdiProvider_ = nullptr;
+    }
+}
+
+int32_t DCameraSourceController::HandleMetaDataResult(const DCameraCommandPacket& packet)
+{
+    sptr<IDCameraProvider> camHdiProvider = GetHdiProvider();
     if (camHdiProvider == nullptr) {
         DHLOGI("DCameraSourceController HandleMetaDataResult camHdiProvider is null, devId: %s, dhId: %s",
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
-        return;
+        return DCAMERA_BAD_OPERATE;
     }
     DCameraMetadataSettingCmd cmd;
-    int32_t ret = cmd.Unmarshal(jsonStr);
+    int32_t ret = packet.Unmarshal(cmd);
     if (ret != DCAMERA_OK) {
         DHLOGI("DCameraSourceController HandleMetaDataResult failed, ret: %d, devId: %s, dhId: %s", ret,
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
-        return;
+        return ret;
     }
     std::shared_ptr<DHBase> dhBase = std::make_shared<DHBase>();
     dhBase->deviceId_ = devId_;
     dhBase->dhId_ = dhId_;
     for (auto iter = cmd.value_.begin(); iter != cmd.value_.end(); iter++) {
         DCamRetCode retHdi = camHdiProvider->OnSettingsResult(dhBase, (*iter));
-        DHLOGI("OnSettingsResult hal, ret: %d, devId: %s dhId: %s, type: %d, result: %d, content: %s", retHdi,
+        DHLOGI("OnSettingsResult hal, ret: %d, devId: %s dhId: %s", retHdi,
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+        if (retHdi != SUCCESS) {
+            // the proxy may be stale after an HDF restart, look it up again for the next result
+            ResetHdiProvider(camHdiProvider);
+        }
     }
+    return DCAMERA_OK;
 }
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -16,6 +16,8 @@
 #include "dcamera_source_data_process.h"
 
 #include "anonymous_string.h"
+#include "dcamera_source_resource_tracker.h"
+#include "dcamera_utils_tools.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
@@ -39,17 +41,20 @@ DCameraSourceDataProcess::~DCameraSourceDataProcess()
 
 int32_t DCameraSourceDataProcess::FeedStream(std::vector<std::shared_ptr<DataBuffer>>& buffers)
 {
-    if (buffers.size() > DCAMERA_MAX_NUM) {
+    if (buffers.empty() || buffers.size() > DCAMERA_FEED_BATCH_MAX_NUM) {
         DHLOGI("DCameraSourceDataProcess FeedStream devId %s dhId %s size: %d over flow",
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), buffers.size());
         return DCAMERA_BAD_VALUE;
     }
 
-    auto buffer = *(buffers.begin());
-    DHLOGD("DCameraSourceDataProcess FeedStream devId %s dhId %s streamType %d streamSize: %d",
-        GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, buffer->Size());
-    for (auto iter = streamProcess_.begin(); iter != streamProcess_.end(); iter++) {
-        (*iter)->FeedStream(buffer);
+    DCameraIndex camIndex(devId_, dhId_);
+    for (auto& buffer : buffers) {
+        DHLOGD("DCameraSourceDataProcess FeedStream devId %s dhId %s streamType %d streamSize: %zu",
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, buffer->Size());
+        for (auto iter = streamProcess_.begin(); iter != streamProcess_.end(); iter++) {
+            (*iter)->FeedStream(buffer);
+        }
+        DCameraSourceResourceTracker::GetInstance().OnFrameFed(camIndex, buffer->Size());
     }
     return DCAMERA_OK;
 }
@@ -95,6 +100,8 @@ int32_t DCameraSourceDataProcess::ConfigStreams(std::vector<std::shared_ptr<DCSt
         streamProcess_.push_back(streamProcess);
     }
 
+    DCameraSourceResourceTracker::GetInstance().UpdateStreamCount(DCameraIndex(devId_, dhId_), streamType_,
+        static_cast<uint32_t>(streamIds_.size()));
     return DCAMERA_OK;
 }
 
@@ -123,6 +130,8 @@ int32_t DCameraSourceDataProcess::ReleaseStreams(std::vector<int32_t>& streamIds
     DHLOGI("DCameraSourceDataProcess ReleaseStreams devId %s dhId %s streamType: %d streamProcessSize: %d streams: %s",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamProcess_.size(),
         strStreams.c_str());
+    DCameraSourceResourceTracker::GetInstance().UpdateStreamCount(DCameraIndex(devId_, dhId_), streamType_,
+        static_cast<uint32_t>(streamIds_.size()));
     return DCAMERA_OK;
 }
 
@@ -136,6 +145,15 @@ int32_t DCameraSourceDataProcess::StartCapture(std::shared_ptr<DCCaptureInfo>& c
     std::shared_ptr<DCameraStreamConfig> streamConfig =
         std::make_shared<DCameraStreamConfig>(captureInfo->width_, captureInfo->height_, captureInfo->format_,
         captureInfo->dataspace_, captureInfo->encodeType_, captureInfo->type_);
+    for (auto& setting : captureInfo->captureSettings_) {
+        uint32_t minFps = 0;
+        uint32_t maxFps = 0;
+        if (setting->type_ == FPS_RANGE && ParseFpsRange(setting->value_, minFps, maxFps)) {
+            streamConfig->fps_ = maxFps;
+            DHLOGI("DCameraSourceDataProcess StartCapture devId %s dhId %s fps range: [%d, %d]",
+                GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), minFps, maxFps);
+        }
+    }
     std::set<int32_t> streamIds(captureInfo->streamIds_.begin(), captureInfo->streamIds_.end());
     for (auto iterSet = streamIds.begin(); iterSet != streamIds.end(); iterSet++) {
         DHLOGI("DCameraSourceDataProcess StartCapture devId %s dhId %s StartCapture id: %d",
@@ -16,11 +16,13 @@
 #include "dcamera_stream_data_process.h"
 
 #include "anonymous_string.h"
+#include "dcamera_utils_tools.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
 
 #include "dcamera_pipeline_source.h"
+#include "dcamera_startup_profiler.h"
 #include "dcamera_stream_data_process_pipeline_listener.h"
 
 namespace OHOS {
@@ -49,9 +51,12 @@ void DCameraStreamDataProcess::FeedStream(std::shared_ptr<DataBuffer>& buffer)
 {
     DHLOGD("DCameraStreamDataProcess FeedStream devId %s dhId %s streamType %d streamSize: %d",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, buffer->Size());
+    buffer->SetString("budgetKey", devId_ + dhId_);
     switch (streamType_) {
         case SNAPSHOT_FRAME: {
-            FeedStreamToSnapShot(buffer);
+            if (IsSnapShotWanted(buffer)) {
+                FeedStreamToSnapShot(buffer);
+            }
             break;
         }
         case CONTINUOUS_FRAME: {
@@ -63,6 +68,22 @@ void DCameraStreamDataProcess::FeedStream(std::shared_ptr<DataBuffer>& buffer)
     }
 }
 
+bool DCameraStreamDataProcess::IsSnapShotWanted(const std::shared_ptr<DataBuffer>& buffer)
+{
+    int32_t frameType = DCAMERA_FRAME_TYPE_FULL;
+    buffer->FindInt32("frameType", frameType);
+    bool isThumbnailStream = (dstConfig_ != nullptr) && IsThumbnailSize(dstConfig_->width_, dstConfig_->height_);
+    if (frameType == DCAMERA_FRAME_TYPE_THUMBNAIL) {
+        hasThumbnail_ = isThumbnailStream;
+        return isThumbnailStream;
+    }
+
+    // the full picture closes the capture, a thumbnail stream only falls back to it when nothing came ahead
+    bool isWanted = !(isThumbnailStream && hasThumbnail_);
+    hasThumbnail_ = false;
+    return isWanted;
+}
+
 void DCameraStreamDataProcess::ConfigStreams(std::shared_ptr<DCameraStreamConfig>& dstConfig,
     std::set<int32_t>& streamIds)
 {
@@ -79,12 +100,17 @@ void DCameraStreamDataProcess::ReleaseStreams(std::set<int32_t>& streamIds)
         DHLOGI("DCameraStreamDataProcess ReleaseStreams devId %s dhId %s streamId: %d", GetAnonyString(devId_).c_str(),
             GetAnonyString(dhId_).c_str(), streamId);
         streamIds_.erase(streamId);
-        auto producerIter = producers_.find(streamId);
-        if (producerIter == producers_.end()) {
-            continue;
+        std::shared_ptr<DCameraStreamDataProcessProducer> producer = nullptr;
+        {
+            std::lock_guard<std::mutex> autoLock(producerMutex_);
+            auto producerIter = producers_.find(streamId);
+            if (producerIter == producers_.end()) {
+                continue;
+            }
+            producer = producerIter->second;
+            producers_.erase(producerIter);
         }
-        producerIter->second->Stop();
-        producers_.erase(streamId);
+        producer->Stop();
     }
 }
 
@@ -93,7 +119,8 @@ void DCameraStreamDataProcess::StartCapture(std::shared_ptr<DCameraStreamConfig>
 {
     srcConfig_ = srcConfig;
     if (streamType_ == CONTINUOUS_FRAME) {
-        CreatePipeline();
+        std::lock_guard<std::mutex> autoLock(pipelineMutex_);
+        isCapturing_ = true;
     }
     for (auto iter = streamIds_.begin(); iter != streamIds_.end(); iter++) {
         uint32_t streamId = *iter;
@@ -105,15 +132,23 @@ void DCameraStreamDataProcess::StartCapture(std::shared_ptr<DCameraStreamConfig>
 
         DHLOGI("DCameraStreamDataProcess StartCapture findProducer devId %s dhId %s streamType: %d streamId: %d",
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamId);
+        std::lock_guard<std::mutex> autoLock(producerMutex_);
         auto producerIter = producers_.find(streamId);
         if (producerIter != producers_.end()) {
+            // a producer kept from the last capture paces frames at the rate negotiated for this one
+            producerIter->second->UpdateInterval(srcConfig_->fps_);
             continue;
         }
         DHLOGI("DCameraStreamDataProcess StartCapture CreateProducer devId %s dhId %s streamType: %d streamId: %d",
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamId);
         producers_[streamId] = std::make_shared<DCameraStreamDataProcessProducer>(devId_, dhId_, streamId, streamType_);
+        producers_[streamId]->UpdateInterval(srcConfig_->fps_);
         producers_[streamId]->Start();
     }
+    // producers exist first so frames decoded from the pending buffers have somewhere to go
+    if (streamType_ == CONTINUOUS_FRAME) {
+        CreatePipeline();
+    }
 }
 
 void DCameraStreamDataProcess::StopCapture()
@@ -123,10 +158,13 @@ void DCameraStreamDataProcess::StopCapture()
     if (streamType_ == CONTINUOUS_FRAME) {
         DestroyPipeline();
     }
-    auto iter = producers_.begin();
-    while (iter != producers_.end()) {
+    std::map<uint32_t, std::shared_ptr<DCameraStreamDataProcessProducer>> producers;
+    {
+        std::lock_guard<std::mutex> autoLock(producerMutex_);
+        producers.swap(producers_);
+    }
+    for (auto iter = producers.begin(); iter != producers.end(); iter++) {
         iter->second->Stop();
-        iter = producers_.erase(iter);
     }
 }
 
@@ -139,6 +177,7 @@ void DCameraStreamDataProcess::FeedStreamToSnapShot(const std::shared_ptr<DataBu
 {
     DHLOGD("DCameraStreamDataProcess FeedStreamToSnapShot devId %s dhId %s streamType %d streamSize: %d",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, buffer->Size());
+    std::lock_guard<std::mutex> autoLock(producerMutex_);
     for (auto iter = producers_.begin(); iter != producers_.end(); iter++) {
         iter->second->FeedStream(buffer);
     }
@@ -148,13 +187,27 @@ void DCameraStreamDataProcess::FeedStreamToContinue(const std::shared_ptr<DataBu
 {
     DHLOGD("DCameraStreamDataProcess FeedStreamToContinue devId %s dhId %s streamType %d streamSize: %d",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, buffer->Size());
-    std::vector<std::shared_ptr<DataBuffer>> buffers;
-    buffers.push_back(buffer);
+    DCameraStartupProfiler::GetInstance().MarkPhase(devId_ + dhId_, DCAMERA_STARTUP_PHASE_FIRST_PACKET);
+    std::lock_guard<std::mutex> autoLock(pipelineMutex_);
     if (pipeline_ == nullptr) {
-        DHLOGE("DCameraStreamDataProcess FeedStreamToContinue pipeline null devId %s dhId %s type: %d streamSize: %d",
-            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, buffer->Size());
+        if (!isCapturing_) {
+            DHLOGE("DCameraStreamDataProcess FeedStreamToContinue pipeline null devId %s dhId %s type: %d " \
+                "streamSize: %d", GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_,
+                buffer->Size());
+            return;
+        }
+        // the capture request goes out before the decoder is ready, so early frames wait here; once full the
+        // newest are dropped to keep the leading key frame decodable
+        if (pendingBuffers_.size() >= DCAMERA_PENDING_FRAME_MAX_NUM) {
+            DHLOGE("DCameraStreamDataProcess FeedStreamToContinue pending full devId %s dhId %s streamSize: %d",
+                GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), buffer->Size());
+            return;
+        }
+        pendingBuffers_.push_back(buffer);
         return;
     }
+    std::vector<std::shared_ptr<DataBuffer>> buffers;
+    buffers.push_back(buffer);
     int32_t ret = pipeline_->ProcessData(buffers);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraStreamDataProcess FeedStreamToContinue pipeline ProcessData failed, ret: %d", ret);
@@ -165,6 +218,7 @@ void DCameraStreamDataProcess::OnProcessedVideoBuffer(const std::shared_ptr<Data
 {
     DHLOGI("DCameraStreamDataProcess OnProcessedVideoBuffer devId %s dhId %s streamType: %d streamSize: %d",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, videoResult->Size());
+    std::lock_guard<std::mutex> autoLock(producerMutex_);
     for (auto iter = producers_.begin(); iter != producers_.end(); iter++) {
         iter->second->FeedStream(videoResult);
     }
@@ -175,33 +229,59 @@ void DCameraStreamDataProcess::OnError(DataProcessErrorType errorType)
     DHLOGE("DCameraStreamDataProcess OnError pipeline errorType: %d", errorType);
 }
 
+void DCameraStreamDataProcess::ProcessPendingBuffers()
+{
+    while (!pendingBuffers_.empty()) {
+        std::vector<std::shared_ptr<DataBuffer>> buffers;
+        buffers.push_back(pendingBuffers_.front());
+        pendingBuffers_.pop_front();
+        int32_t ret = pipeline_->ProcessData(buffers);
+        if (ret != DCAMERA_OK) {
+            DHLOGE("DCameraStreamDataProcess ProcessPendingBuffers pipeline ProcessData failed, ret: %d", ret);
+        }
+    }
+}
+
 void DCameraStreamDataProcess::CreatePipeline()
 {
-    if (pipeline_ != nullptr) {
-        DHLOGI("DCameraStreamDataProcess CreatePipeline already exist, devId %s dhId %s",
-            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
-        return;
+    {
+        std::lock_guard<std::mutex> autoLock(pipelineMutex_);
+        if (pipeline_ != nullptr) {
+            DHLOGI("DCameraStreamDataProcess CreatePipeline already exist, devId %s dhId %s",
+                GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str());
+            return;
+        }
     }
-    pipeline_ = std::make_shared<DCameraPipelineSource>();
+    // the decoder is created without the lock so early frames can keep queueing meanwhile
+    std::shared_ptr<IDataProcessPipeline> pipeline = std::make_shared<DCameraPipelineSource>();
     auto process = std::shared_ptr<DCameraStreamDataProcess>(shared_from_this());
     listener_ = std::make_shared<DCameraStreamDataProcessPipelineListener>(process);
     VideoConfigParams srcParams(GetPipelineCodecType(srcConfig_->encodeType_), GetPipelineFormat(srcConfig_->format_),
-        DCAMERA_PRODUCER_FPS_DEFAULT, srcConfig_->width_, srcConfig_->height_);
+        srcConfig_->fps_, srcConfig_->width_, srcConfig_->height_);
     VideoConfigParams dstParams(GetPipelineCodecType(dstConfig_->encodeType_), GetPipelineFormat(dstConfig_->format_),
-        DCAMERA_PRODUCER_FPS_DEFAULT, dstConfig_->width_, dstConfig_->height_);
-    int32_t ret = pipeline_->CreateDataProcessPipeline(PipelineType::VIDEO, srcParams, dstParams, listener_);
+        srcConfig_->fps_, dstConfig_->width_, dstConfig_->height_);
+    int32_t ret = pipeline->CreateDataProcessPipeline(PipelineType::VIDEO, srcParams, dstParams, listener_);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraStreamDataProcess CreateDataProcessPipeline type: %d failed, ret: %d", PipelineType::VIDEO, ret);
     }
+    std::lock_guard<std::mutex> autoLock(pipelineMutex_);
+    pipeline_ = pipeline;
+    ProcessPendingBuffers();
 }
 
 void DCameraStreamDataProcess::DestroyPipeline()
 {
-    if (pipeline_ == nullptr) {
+    std::shared_ptr<IDataProcessPipeline> pipeline = nullptr;
+    {
+        std::lock_guard<std::mutex> autoLock(pipelineMutex_);
+        isCapturing_ = false;
+        pendingBuffers_.clear();
+        pipeline.swap(pipeline_);
+    }
+    if (pipeline == nullptr) {
         return;
     }
-    pipeline_->DestroyDataProcessPipeline();
-    pipeline_ = nullptr;
+    pipeline->DestroyDataProcessPipeline();
 }
 
 VideoCodecType DCameraStreamDataProcess::GetPipelineCodecType(DCEncodeType encodeType)
@@ -19,12 +19,21 @@
 #include <securec.h>
 
 #include "anonymous_string.h"
+#include "dcamera_buffer_handle_cache.h"
+#include "dcamera_degrade_controller.h"
+#include "dcamera_memory_budget.h"
+#include "dcamera_startup_profiler.h"
+#include "dcamera_thread_policy.h"
+#include "dcamera_utils_tools.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
 #include "distributed_hardware_log.h"
 
 namespace OHOS {
 namespace DistributedHardware {
+std::mutex DCameraStreamDataProcessProducer::producersLock_;
+std::map<std::string, DCameraStreamDataProcessProducer*> DCameraStreamDataProcessProducer::producers_;
+
 DCameraStreamDataProcessProducer::DCameraStreamDataProcessProducer(std::string devId, std::string dhId,
     int32_t streamId, DCStreamType streamType)
     : devId_(devId), dhId_(dhId), streamId_(streamId), streamType_(streamType)
@@ -33,6 +42,8 @@ DCameraStreamDataProcessProducer::DCameraStreamDataProcessProducer(std::string d
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamId_);
     state_ = DCAMERA_PRODUCER_STATE_STOP;
     interval_ = DCAMERA_PRODUCER_ONE_MINUTE_MS / DCAMERA_PRODUCER_FPS_DEFAULT;
+    fps_ = DCAMERA_PRODUCER_FPS_DEFAULT;
+    fpsPercent_ = DCAMERA_PRODUCER_PERCENT_BASE;
 }
 
 DCameraStreamDataProcessProducer::~DCameraStreamDataProcessProducer()
@@ -49,11 +60,20 @@ void DCameraStreamDataProcessProducer::Start()
     DHLOGI("DCameraStreamDataProcessProducer Start producer devId: %s dhId: %s streamType: %d streamId: %d",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamId_);
     state_ = DCAMERA_PRODUCER_STATE_START;
+    {
+        std::unique_lock<std::mutex> lock(producerMutex_);
+        fpsPercent_ = DCameraDegradeController::GetStep(
+            DCameraDegradeController::GetInstance().GetLevel(devId_ + dhId_)).fpsPercent;
+        UpdateIntervalLocked();
+    }
+    {
+        std::lock_guard<std::mutex> autoLock(producersLock_);
+        producers_[GetProducerKey(devId_, dhId_, streamId_)] = this;
+    }
     if (streamType_ == CONTINUOUS_FRAME) {
+        std::string queueName = "DCameraProducer_" + std::to_string(streamType_) + "_" + std::to_string(streamId_);
+        feedQueue_ = DCameraExecutor::GetInstance().CreateSerialQueue(queueName, DCAMERA_TASK_TIER_FRAME);
         producerThread_ = std::thread(&DCameraStreamDataProcessProducer::LooperContinue, this);
-        std::string threadName = "DCameraProducer_" + std::to_string(streamType_) + "_" + std::to_string(streamId_);
-        auto runner = AppExecFwk::EventRunner::Create(threadName);
-        eventHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
     } else {
         producerThread_ = std::thread(&DCameraStreamDataProcessProducer::LooperSnapShot, this);
     }
@@ -63,32 +83,161 @@ void DCameraStreamDataProcessProducer::Stop()
 {
     DHLOGI("DCameraStreamDataProcessProducer Stop devId: %s dhId: %s streamType: %d streamId: %d state: %d",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamId_, state_);
+    {
+        std::lock_guard<std::mutex> autoLock(producersLock_);
+        auto iter = producers_.find(GetProducerKey(devId_, dhId_, streamId_));
+        if (iter != producers_.end() && iter->second == this) {
+            producers_.erase(iter);
+        }
+    }
     state_ = DCAMERA_PRODUCER_STATE_STOP;
     producerCon_.notify_one();
     producerThread_.join();
-    eventHandler_ = nullptr;
+    if (feedQueue_ != nullptr) {
+        feedQueue_->Close();
+        feedQueue_ = nullptr;
+    }
+    {
+        std::unique_lock<std::mutex> lock(producerMutex_);
+        while (!buffers_.empty()) {
+            PopBufferLocked();
+        }
+    }
+    UnregisterStream();
+    DCameraBufferHandleCache::GetInstance().ReleaseStream(devId_, dhId_, streamId_);
     DHLOGI("DCameraStreamDataProcessProducer Stop end devId: %s dhId: %s streamType: %d streamId: %d state: %d",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamId_, state_);
 }
 
+void DCameraStreamDataProcessProducer::UpdateInterval(uint32_t fps)
+{
+    if (fps == 0) {
+        DHLOGE("DCameraStreamDataProcessProducer UpdateInterval invalid fps, devId: %s dhId: %s streamId: %d",
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_);
+        return;
+    }
+    std::unique_lock<std::mutex> lock(producerMutex_);
+    fps_ = fps;
+    UpdateIntervalLocked();
+}
+
+void DCameraStreamDataProcessProducer::UpdateIntervalLocked()
+{
+    // a degraded sink sends fewer frames, repeating the last one at the full rate only costs copies
+    uint32_t fps = fps_ * fpsPercent_ / DCAMERA_PRODUCER_PERCENT_BASE;
+    interval_ = DCAMERA_PRODUCER_ONE_MINUTE_MS / ((fps > 0) ? fps : 1);
+    DHLOGI("DCameraStreamDataProcessProducer UpdateInterval devId: %s dhId: %s streamId: %d fps: %d interval: %d",
+        GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_, fps, interval_);
+}
+
+void DCameraStreamDataProcessProducer::SetDegradeLevel(const std::string& devId, const std::string& dhId,
+    int32_t level)
+{
+    std::string keyPrefix = devId + "#" + dhId + "#";
+    std::lock_guard<std::mutex> autoLock(producersLock_);
+    for (auto& producer : producers_) {
+        if (producer.first.compare(0, keyPrefix.size(), keyPrefix) != 0 ||
+            producer.second->streamType_ != CONTINUOUS_FRAME) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(producer.second->producerMutex_);
+        producer.second->fpsPercent_ = DCameraDegradeController::GetStep(level).fpsPercent;
+        producer.second->UpdateIntervalLocked();
+    }
+}
+
+void DCameraStreamDataProcessProducer::NotifyBufferAvailable(const std::string& devId, const std::string& dhId,
+    int32_t streamId)
+{
+    std::lock_guard<std::mutex> autoLock(producersLock_);
+    auto iter = producers_.find(GetProducerKey(devId, dhId, streamId));
+    if (iter == producers_.end()) {
+        DHLOGD("NotifyBufferAvailable no producer devId: %s dhId: %s streamId: %d", GetAnonyString(devId).c_str(),
+            GetAnonyString(dhId).c_str(), streamId);
+        return;
+    }
+    iter->second->OnBufferAvailable();
+}
+
+std::string DCameraStreamDataProcessProducer::GetProducerKey(const std::string& devId, const std::string& dhId,
+    int32_t streamId)
+{
+    return devId + "#" + dhId + "#" + std::to_string(streamId);
+}
+
+void DCameraStreamDataProcessProducer::OnBufferAvailable()
+{
+    DHLOGD("OnBufferAvailable devId: %s dhId: %s streamType: %d streamId: %d", GetAnonyString(devId_).c_str(),
+        GetAnonyString(dhId_).c_str(), streamType_, streamId_);
+    {
+        std::unique_lock<std::mutex> lock(producerMutex_);
+        isBufferAvailable_ = true;
+    }
+    producerCon_.notify_one();
+}
+
 void DCameraStreamDataProcessProducer::FeedStream(const std::shared_ptr<DataBuffer>& buffer)
 {
     DHLOGD("DCameraStreamDataProcessProducer FeedStream devId %s dhId %s streamType: %d streamSize: %d",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, buffer->Size());
     std::unique_lock<std::mutex> lock(producerMutex_);
+    if (streamType_ == SNAPSHOT_FRAME) {
+        // a burst queues whole pictures until driver buffers free up, bounded by depth and by bytes
+        while (!buffers_.empty() && (buffers_.size() >= DCAMERA_BURST_MAX_DEPTH ||
+            queuedBytes_ + buffer->Size() > DCAMERA_BURST_MEMORY_MAX)) {
+            DHLOGI("DCameraStreamDataProcessProducer FeedStream drop snapshot devId %s dhId %s queued: %zu bytes: %zu",
+                GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), buffers_.size(), queuedBytes_);
+            PopBufferLocked();
+        }
+        if (ReserveBufferLocked(buffer)) {
+            PushBufferLocked(buffer);
+            producerCon_.notify_one();
+        }
+        return;
+    }
     if (buffers_.size() >= DCAMERA_PRODUCER_MAX_BUFFER_SIZE) {
         DHLOGD("DCameraStreamDataProcessProducer FeedStream OverSize devId %s dhId %s streamType: %d streamSize: %d",
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, buffer->Size());
-        buffers_.pop();
+        PopBufferLocked();
     }
-    buffers_.push(buffer);
-    if (streamType_ == SNAPSHOT_FRAME) {
-        producerCon_.notify_one();
+    if (ReserveBufferLocked(buffer)) {
+        PushBufferLocked(buffer);
     }
 }
 
+bool DCameraStreamDataProcessProducer::ReserveBufferLocked(const std::shared_ptr<DataBuffer>& buffer)
+{
+    // the oldest queued frame makes room first, the incoming one is dropped only when nothing is left to give up
+    std::string budgetKey = devId_ + dhId_;
+    while (!DCameraMemoryBudget::GetInstance().Acquire(budgetKey, DCAMERA_MEMORY_STAGE_PRODUCER, buffer->Size())) {
+        DCameraMemoryBudget::GetInstance().OnFrameDropped(budgetKey);
+        if (buffers_.empty()) {
+            DHLOGI("DCameraStreamDataProcessProducer drop frame over memory budget devId %s dhId %s streamId: %d",
+                GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_);
+            return false;
+        }
+        PopBufferLocked();
+    }
+    return true;
+}
+
+void DCameraStreamDataProcessProducer::PushBufferLocked(const std::shared_ptr<DataBuffer>& buffer)
+{
+    buffers_.push(buffer);
+    queuedBytes_ += buffer->Size();
+}
+
+void DCameraStreamDataProcessProducer::PopBufferLocked()
+{
+    size_t size = buffers_.front()->Size();
+    buffers_.pop();
+    queuedBytes_ -= size;
+    DCameraMemoryBudget::GetInstance().Release(devId_ + dhId_, DCAMERA_MEMORY_STAGE_PRODUCER, size);
+}
+
 void DCameraStreamDataProcessProducer::LooperContinue()
 {
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamProducer", DCAMERA_TASK_TIER_FRAME);
     DHLOGI("LooperContinue producer devId: %s dhId: %s streamType: %d streamId: %d state: %d",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamId_, state_);
     std::shared_ptr<DHBase> dhBase = std::make_shared<DHBase>();
@@ -99,16 +248,18 @@ void DCameraStreamDataProcessProducer::LooperContinue()
         std::shared_ptr<DataBuffer> buffer = nullptr;
         {
             std::unique_lock<std::mutex> lock(producerMutex_);
+            // a driver buffer freeing up retries the pending frame now instead of at the next tick
             producerCon_.wait_for(lock, std::chrono::milliseconds(interval_), [this] {
-                return (this->state_ == DCAMERA_PRODUCER_STATE_STOP);
+                return (this->state_ == DCAMERA_PRODUCER_STATE_STOP || isBufferAvailable_);
             });
+            isBufferAvailable_ = false;
             if (state_ == DCAMERA_PRODUCER_STATE_STOP || buffers_.empty()) {
                 continue;
             }
 
             buffer = buffers_.front();
             if (buffers_.size() > 1) {
-                buffers_.pop();
+                PopBufferLocked();
                 DHLOGD("common devId %s dhId %s streamSize: %d bufferSize: %d streamType: %d",
                     GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), buffer->Size(), buffers_.size(),
                     streamType_);
@@ -120,10 +271,15 @@ void DCameraStreamDataProcessProducer::LooperContinue()
         }
 
         auto feedFunc = [this, dhBase, buffer]() {
-            FeedStreamToDriver(dhBase, buffer);
+            int64_t startUs = GetNowTimeStampUs();
+            if (FeedStreamToDriver(dhBase, buffer) == DCAMERA_OK) {
+                DCameraStartupProfiler::GetInstance().OnFirstFrame(devId_ + dhId_);
+                DCameraDegradeController::GetInstance().OnStageLatency(devId_ + dhId_, DCAMERA_DEGRADE_STAGE_DELIVER,
+                    GetNowTimeStampUs() - startUs);
+            }
         };
-        if (eventHandler_ != nullptr) {
-            eventHandler_->PostTask(feedFunc);
+        if (feedQueue_ != nullptr) {
+            feedQueue_->PostTask(feedFunc);
         }
     }
     DHLOGI("LooperContinue producer end devId: %s dhId: %s streamType: %d streamId: %d state: %d",
@@ -132,6 +288,7 @@ void DCameraStreamDataProcessProducer::LooperContinue()
 
 void DCameraStreamDataProcessProducer::LooperSnapShot()
 {
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamSnapshot", DCAMERA_TASK_TIER_FRAME);
     DHLOGI("LooperSnapShot producer devId: %s dhId: %s streamType: %d streamId: %d state: %d",
         GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamType_, streamId_, state_);
     std::shared_ptr<DHBase> dhBase = std::make_shared<DHBase>();
@@ -163,12 +320,19 @@ void DCameraStreamDataProcessProducer::LooperSnapShot()
         }
         int32_t ret = FeedStreamToDriver(dhBase, buffer);
         if (ret != DCAMERA_OK) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(DCAMERA_PRODUCER_RETRY_SLEEP_MS));
+            // the driver notifies once a buffer frees up, the timeout only covers a driver that never does
+            std::unique_lock<std::mutex> lock(producerMutex_);
+            producerCon_.wait_for(lock, std::chrono::milliseconds(DCAMERA_PRODUCER_RETRY_SLEEP_MS), [this] {
+                return state_ == DCAMERA_PRODUCER_STATE_STOP || isBufferAvailable_;
+            });
+            isBufferAvailable_ = false;
             continue;
         }
         {
             std::unique_lock<std::mutex> lock(producerMutex_);
-            buffers_.pop();
+            if (!buffers_.empty() && buffers_.front() == buffer) {
+                PopBufferLocked();
+            }
         }
     }
     DHLOGI("LooperSnapShot producer end devId: %s dhId: %s streamType: %d streamId: %d state: %d",
@@ -185,6 +349,70 @@ int32_t DCameraStreamDataProcessProducer::FeedStreamToDriver(const std::shared_p
         DHLOGI("camHdiProvider is nullptr");
         return DCAMERA_BAD_VALUE;
     }
+
+    if (streamHandle_ == DCAMERA_PRODUCER_INVALID_HANDLE && !isHandleUnsupported_) {
+        DCamRetCode retHdi = camHdiProvider->RegisterStream(dhBase, streamId_, streamHandle_);
+        if (retHdi != SUCCESS) {
+            DHLOGI("RegisterStream devId: %s dhId: %s streamId: %d ret: %d, use per frame acquire and shutter",
+                GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_, retHdi);
+            streamHandle_ = DCAMERA_PRODUCER_INVALID_HANDLE;
+            isHandleUnsupported_ = true;
+        }
+    }
+
+    int32_t ret = isHandleUnsupported_ ? FeedStreamByDHBase(camHdiProvider, dhBase, buffer) :
+        FeedStreamByHandle(camHdiProvider, buffer);
+    DHLOGD("LooperFeed end devId %s dhId %s streamSize: %d streamType: %d ret: %d", GetAnonyString(devId_).c_str(),
+        GetAnonyString(dhId_).c_str(), buffer->Size(), streamType_, ret);
+    return ret;
+}
+
+int32_t DCameraStreamDataProcessProducer::FeedStreamByHandle(sptr<IDCameraProvider>& camHdiProvider,
+    const std::shared_ptr<DataBuffer>& buffer)
+{
+    if (driverBuffers_.empty()) {
+        std::vector<std::shared_ptr<DCameraBuffer>> buffers;
+        DCamRetCode retHdi = camHdiProvider->AcquireBuffers(streamHandle_, GetPrefetchCount(), buffers);
+        if (retHdi != SUCCESS || buffers.empty()) {
+            DHLOGE("AcquireBuffers devId: %s dhId: %s streamId: %d ret: %d",
+                GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_, retHdi);
+            return DCAMERA_BAD_OPERATE;
+        }
+        driverBuffers_.insert(driverBuffers_.end(), buffers.begin(), buffers.end());
+    }
+
+    std::shared_ptr<DCameraBuffer> sharedMemory = driverBuffers_.front();
+    driverBuffers_.pop_front();
+    int32_t ret = CopyToDriverBuffer(buffer, sharedMemory);
+
+    // Returns the filled buffer and takes the next one in a single call.
+    std::shared_ptr<DCameraBuffer> nextBuffer = nullptr;
+    DCamRetCode retHdi = camHdiProvider->ShutterAndAcquireBuffer(streamHandle_, sharedMemory, nextBuffer);
+    if (nextBuffer != nullptr) {
+        driverBuffers_.push_back(nextBuffer);
+    }
+    if (retHdi != SUCCESS) {
+        DHLOGE("ShutterAndAcquireBuffer devId: %s dhId: %s streamId: %d ret: %d",
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_, retHdi);
+        return DCAMERA_BAD_OPERATE;
+    }
+    return ret;
+}
+
+uint32_t DCameraStreamDataProcessProducer::GetPrefetchCount()
+{
+    if (streamType_ != SNAPSHOT_FRAME) {
+        return DCAMERA_PRODUCER_PREFETCH_COUNT;
+    }
+    // take as many driver buffers in one call as there are burst pictures waiting for them
+    std::unique_lock<std::mutex> lock(producerMutex_);
+    uint32_t pending = static_cast<uint32_t>(buffers_.size());
+    return pending > DCAMERA_PRODUCER_PREFETCH_COUNT ? pending : DCAMERA_PRODUCER_PREFETCH_COUNT;
+}
+
+int32_t DCameraStreamDataProcessProducer::FeedStreamByDHBase(sptr<IDCameraProvider>& camHdiProvider,
+    const std::shared_ptr<DHBase>& dhBase, const std::shared_ptr<DataBuffer>& buffer)
+{
     std::shared_ptr<DCameraBuffer> sharedMemory;
     DCamRetCode retHdi = camHdiProvider->AcquireBuffer(dhBase, streamId_, sharedMemory);
     if (retHdi != SUCCESS) {
@@ -193,43 +421,67 @@ int32_t DCameraStreamDataProcessProducer::FeedStreamToDriver(const std::shared_p
         return DCAMERA_BAD_OPERATE;
     }
 
-    int32_t ret = DCAMERA_OK;
-    do {
-        if (sharedMemory == nullptr) {
-            DHLOGE("sharedMemory devId: %s dhId: %s streamId: %d, sharedMemory is null",
-                GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_);
-            ret = DCAMERA_MEMORY_OPT_ERROR;
-            break;
-        }
-
-        if (buffer->Size() > sharedMemory->size_) {
-            DHLOGE("sharedMemory devId: %s dhId: %s streamId: %d bufSize: %d, addressSize: %d",
-                GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_, buffer->Size(),
-                sharedMemory->size_);
-            ret = DCAMERA_MEMORY_OPT_ERROR;
-            break;
-        }
-        int32_t ret = memcpy_s(sharedMemory->bufferHandle_->virAddr, sharedMemory->size_, buffer->Data(),
-            buffer->Size());
-        if (ret != EOK) {
-            DHLOGE("memcpy_s devId: %s dhId: %s streamId: %d bufSize: %d, addressSize: %d",
-                GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_, buffer->Size(),
-                sharedMemory->size_);
-            ret = DCAMERA_MEMORY_OPT_ERROR;
-            break;
-        }
-        sharedMemory->size_ = buffer->Size();
-    } while (0);
-
+    int32_t ret = CopyToDriverBuffer(buffer, sharedMemory);
     retHdi = camHdiProvider->ShutterBuffer(dhBase, streamId_, sharedMemory);
     if (retHdi != SUCCESS) {
         DHLOGE("ShutterBuffer devId: %s dhId: %s streamId: %d ret: %d",
             GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_, retHdi);
         return DCAMERA_BAD_OPERATE;
     }
-    DHLOGD("LooperFeed end devId %s dhId %s streamSize: %d streamType: %d", GetAnonyString(devId_).c_str(),
-        GetAnonyString(dhId_).c_str(), buffer->Size(), streamType_);
     return ret;
 }
+
+int32_t DCameraStreamDataProcessProducer::CopyToDriverBuffer(const std::shared_ptr<DataBuffer>& buffer,
+    std::shared_ptr<DCameraBuffer>& sharedMemory)
+{
+    if (sharedMemory == nullptr) {
+        DHLOGE("sharedMemory devId: %s dhId: %s streamId: %d, sharedMemory is null",
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_);
+        return DCAMERA_MEMORY_OPT_ERROR;
+    }
+
+    if (buffer->Size() > sharedMemory->size_) {
+        DHLOGE("sharedMemory devId: %s dhId: %s streamId: %d bufSize: %d, addressSize: %d",
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_, buffer->Size(),
+            sharedMemory->size_);
+        // the buffer still goes back to the driver, but empty so that it is not reported as a frame
+        sharedMemory->size_ = 0;
+        return DCAMERA_MEMORY_OPT_ERROR;
+    }
+    int32_t ret = memcpy_s(sharedMemory->bufferHandle_->virAddr, sharedMemory->size_, buffer->Data(),
+        buffer->Size());
+    if (ret != EOK) {
+        DHLOGE("memcpy_s devId: %s dhId: %s streamId: %d bufSize: %d, addressSize: %d",
+            GetAnonyString(devId_).c_str(), GetAnonyString(dhId_).c_str(), streamId_, buffer->Size(),
+            sharedMemory->size_);
+        sharedMemory->size_ = 0;
+        return DCAMERA_MEMORY_OPT_ERROR;
+    }
+    sharedMemory->size_ = buffer->Size();
+    return DCAMERA_OK;
+}
+
+void DCameraStreamDataProcessProducer::UnregisterStream()
+{
+    isHandleUnsupported_ = false;
+    sptr<IDCameraProvider> camHdiProvider = IDCameraProvider::Get();
+    if (camHdiProvider == nullptr) {
+        driverBuffers_.clear();
+        streamHandle_ = DCAMERA_PRODUCER_INVALID_HANDLE;
+        return;
+    }
+
+    // Hand the prefetched buffers back empty, the driver waits for them before it flushes the stream.
+    std::shared_ptr<DHBase> dhBase = std::make_shared<DHBase>(devId_, dhId_);
+    for (auto &sharedMemory : driverBuffers_) {
+        sharedMemory->size_ = 0;
+        camHdiProvider->ShutterBuffer(dhBase, streamId_, sharedMemory);
+    }
+    driverBuffers_.clear();
+    if (streamHandle_ != DCAMERA_PRODUCER_INVALID_HANDLE) {
+        camHdiProvider->UnregisterStream(streamHandle_);
+        streamHandle_ = DCAMERA_PRODUCER_INVALID_HANDLE;
+    }
+}
 } // namespace DistributedHardware
 } // namespace OHOS
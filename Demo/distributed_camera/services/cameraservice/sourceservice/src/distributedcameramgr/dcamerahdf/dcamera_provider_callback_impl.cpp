@@ -17,6 +17,7 @@
 
 #include "dcamera_index.h"
 #include "dcamera_source_dev.h"
+#include "dcamera_stream_data_process_producer.h"
 
 #include "anonymous_string.h"
 #include "distributed_camera_errno.h"
@@ -177,5 +178,11 @@ DCamRetCode DCameraProviderCallbackImpl::UpdateSettings(const std::shared_ptr<DH
     }
     return SUCCESS;
 }
+
+void DCameraProviderCallbackImpl::NotifyBufferAvailable(const std::shared_ptr<DHBase>& dhBase, int streamId)
+{
+    // wakes the waiting producer directly, a frame is due as soon as the driver buffer is back
+    DCameraStreamDataProcessProducer::NotifyBufferAvailable(devId_, dhId_, streamId);
+}
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <buffer_handle_utils.h>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+#include "dcamera_buffer_handle_cache.h"
+#include "distributed_hardware_log.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraBufferHandleCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const std::string TEST_DEVICE_ID = "bb536a637105409e904d4da83790a4a7";
+const std::string TEST_CAMERA_DH_ID_0 = "camera_0";
+const std::string TEST_BUFFER_PATH = "/data/local/tmp/dcamera_buffer_";
+const int32_t TEST_STREAMID = 2;
+const int32_t TEST_BUFFER_NUM = 8;
+const int32_t TEST_BUFFER_SIZE = 1920 * 1080 * 3 / 2;
+const int32_t TEST_FRAME_NUM = 600;
+
+std::vector<int> g_bufferFds;
+
+int CreateBufferFd(int32_t index)
+{
+    std::string path = TEST_BUFFER_PATH + std::to_string(index);
+    int fd = open(path.c_str(), O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        return fd;
+    }
+    unlink(path.c_str());
+    if (ftruncate(fd, TEST_BUFFER_SIZE) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Every handle read from a reply parcel carries its own duplicated fd of the same driver buffer.
+BufferHandle* ReceiveBufferHandle(int fd)
+{
+    BufferHandle *handle = AllocateBufferHandle(1, 0);
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    handle->fd = dup(fd);
+    handle->reserve[0] = dup(fd);
+    handle->size = TEST_BUFFER_SIZE;
+    handle->virAddr = nullptr;
+    return handle;
+}
+}
+
+void DCameraBufferHandleCacheTest::SetUpTestCase(void)
+{
+    for (int32_t i = 0; i < TEST_BUFFER_NUM; i++) {
+        g_bufferFds.push_back(CreateBufferFd(i));
+    }
+}
+
+void DCameraBufferHandleCacheTest::TearDownTestCase(void)
+{
+    for (int fd : g_bufferFds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    g_bufferFds.clear();
+}
+
+void DCameraBufferHandleCacheTest::SetUp(void)
+{
+}
+
+void DCameraBufferHandleCacheTest::TearDown(void)
+{
+    DCameraBufferHandleCache::GetInstance().ReleaseDevice(TEST_DEVICE_ID, TEST_CAMERA_DH_ID_0);
+}
+
+/**
+ * @tc.name: dcamera_buffer_handle_cache_test_001
+ * @tc.desc: Verify a reused driver buffer keeps its mapping and a new buffer is remapped.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraBufferHandleCacheTest, dcamera_buffer_handle_cache_test_001, TestSize.Level1)
+{
+    ASSERT_GE(g_bufferFds[0], 0);
+    ASSERT_GE(g_bufferFds[1], 0);
+    DCameraBufferHandleCache &cache = DCameraBufferHandleCache::GetInstance();
+    BufferHandle *first = cache.MapBuffer(TEST_DEVICE_ID, TEST_CAMERA_DH_ID_0, TEST_STREAMID, 0,
+        ReceiveBufferHandle(g_bufferFds[0]));
+    ASSERT_NE(nullptr, first);
+    ASSERT_NE(nullptr, first->virAddr);
+    void *virAddr = first->virAddr;
+
+    BufferHandle *second = cache.MapBuffer(TEST_DEVICE_ID, TEST_CAMERA_DH_ID_0, TEST_STREAMID, 0,
+        ReceiveBufferHandle(g_bufferFds[0]));
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(virAddr, second->virAddr);
+
+    BufferHandle *remapped = cache.MapBuffer(TEST_DEVICE_ID, TEST_CAMERA_DH_ID_0, TEST_STREAMID, 0,
+        ReceiveBufferHandle(g_bufferFds[1]));
+    ASSERT_NE(nullptr, remapped);
+    EXPECT_NE(nullptr, remapped->virAddr);
+
+    cache.ReleaseStream(TEST_DEVICE_ID, TEST_CAMERA_DH_ID_0, TEST_STREAMID);
+    BufferHandle *fresh = cache.MapBuffer(TEST_DEVICE_ID, TEST_CAMERA_DH_ID_0, TEST_STREAMID, 0,
+        ReceiveBufferHandle(g_bufferFds[1]));
+    ASSERT_NE(nullptr, fresh);
+    EXPECT_NE(nullptr, fresh->virAddr);
+}
+
+/**
+ * @tc.name: dcamera_buffer_handle_cache_test_002
+ * @tc.desc: Verify invalid buffer handles are rejected.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraBufferHandleCacheTest, dcamera_buffer_handle_cache_test_002, TestSize.Level1)
+{
+    DCameraBufferHandleCache &cache = DCameraBufferHandleCache::GetInstance();
+    EXPECT_EQ(nullptr, cache.MapBuffer(TEST_DEVICE_ID, TEST_CAMERA_DH_ID_0, TEST_STREAMID, 0, nullptr));
+
+    BufferHandle *handle = AllocateBufferHandle(1, 0);
+    ASSERT_NE(nullptr, handle);
+    handle->fd = -1;
+    handle->reserve[0] = -1;
+    handle->size = TEST_BUFFER_SIZE;
+    EXPECT_EQ(nullptr, cache.MapBuffer(TEST_DEVICE_ID, TEST_CAMERA_DH_ID_0, TEST_STREAMID, 0, handle));
+}
+
+/**
+ * @tc.name: dcamera_buffer_handle_cache_test_003
+ * @tc.desc: Benchmark per frame buffer mapping, map and unmap per frame against the mapping cache.
+ * @tc.type: PERF
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraBufferHandleCacheTest, dcamera_buffer_handle_cache_test_003, TestSize.Level1)
+{
+    for (int fd : g_bufferFds) {
+        ASSERT_GE(fd, 0);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < TEST_FRAME_NUM; i++) {
+        BufferHandle *handle = ReceiveBufferHandle(g_bufferFds[i % TEST_BUFFER_NUM]);
+        ASSERT_NE(nullptr, handle);
+        handle->virAddr = DCameraBufferHandleCache::MemoryMap(handle);
+        ASSERT_NE(nullptr, handle->virAddr);
+        static_cast<uint8_t *>(handle->virAddr)[0] = static_cast<uint8_t>(i);
+        DCameraBufferHandleCache::MemoryUnmap(handle);
+    }
+    auto mapCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    DCameraBufferHandleCache &cache = DCameraBufferHandleCache::GetInstance();
+    start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < TEST_FRAME_NUM; i++) {
+        int32_t index = i % TEST_BUFFER_NUM;
+        BufferHandle *handle = cache.MapBuffer(TEST_DEVICE_ID, TEST_CAMERA_DH_ID_0, TEST_STREAMID, index,
+            ReceiveBufferHandle(g_bufferFds[index]));
+        ASSERT_NE(nullptr, handle);
+        static_cast<uint8_t *>(handle->virAddr)[0] = static_cast<uint8_t>(i);
+    }
+    auto cacheCost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    DHLOGI("DCameraBufferHandleCacheTest %d frames over %d buffers, map per frame: %lld us, cached: %lld us",
+        TEST_FRAME_NUM, TEST_BUFFER_NUM, static_cast<long long>(mapCost.count()),
+        static_cast<long long>(cacheCost.count()));
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dcamera_degrade_controller.h"
+#include "dcamera_thread_policy.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraDegradeControllerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const std::string TEST_CAMERA_KEY = "bb536a637105409e904d4da83790a4a7camera_0";
+const uint32_t TEST_ALTERNATE_TIMES = 20;
+const int64_t TEST_QUIET_LATENCY_US = 1000;
+const int32_t TEST_FEED_INTERVAL_MS = 10;
+const int64_t TEST_CPU_WAIT_WINDOWS = 6;
+
+DCameraPressureSample MakeOverloadSample()
+{
+    DCameraPressureSample sample;
+    sample.latencyUs[DCAMERA_DEGRADE_STAGE_DECODE] = DCAMERA_DEGRADE_LATENCY_HIGH_US + 1;
+    return sample;
+}
+
+DCameraPressureSample MakeIdleSample()
+{
+    return DCameraPressureSample();
+}
+
+DCameraPressureSample MakeNeutralSample()
+{
+    DCameraPressureSample sample;
+    sample.cpuPercent = (DCAMERA_DEGRADE_CPU_HIGH_PERCENT + DCAMERA_DEGRADE_CPU_LOW_PERCENT) / 2;
+    return sample;
+}
+}
+
+void DCameraDegradeControllerTest::SetUpTestCase(void)
+{
+}
+
+void DCameraDegradeControllerTest::TearDownTestCase(void)
+{
+}
+
+void DCameraDegradeControllerTest::SetUp(void)
+{
+}
+
+void DCameraDegradeControllerTest::TearDown(void)
+{
+    DCameraDegradeController::GetInstance().RemoveCamera(TEST_CAMERA_KEY);
+}
+
+/**
+ * @tc.name: dcamera_degrade_controller_test_001
+ * @tc.desc: Verify sustained overload walks the whole ladder one step at a time and stops at the last rung.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraDegradeControllerTest, dcamera_degrade_controller_test_001, TestSize.Level1)
+{
+    std::vector<int32_t> levels;
+    DCameraDegradeController& controller = DCameraDegradeController::GetInstance();
+    EXPECT_EQ(DCAMERA_NOT_FOUND, controller.Evaluate(TEST_CAMERA_KEY, MakeOverloadSample()));
+    controller.AddCamera(TEST_CAMERA_KEY, [&levels](int32_t level) { levels.push_back(level); });
+
+    int32_t maxLevel = DCameraDegradeController::GetMaxLevel();
+    for (int32_t i = 0; i < (maxLevel + 1) * static_cast<int32_t>(DCAMERA_DEGRADE_STEP_DOWN_WINDOWS); i++) {
+        controller.Evaluate(TEST_CAMERA_KEY, MakeOverloadSample());
+    }
+    std::vector<int32_t> expectLevels;
+    for (int32_t level = 1; level <= maxLevel; level++) {
+        expectLevels.push_back(level);
+    }
+    EXPECT_EQ(expectLevels, levels);
+    EXPECT_EQ(maxLevel, controller.GetLevel(TEST_CAMERA_KEY));
+
+    // frame rate gives way before quality, and nothing ever asks for more than the full stream
+    DCameraDegradeStep previous = DCameraDegradeController::GetStep(0);
+    EXPECT_EQ(DCAMERA_DEGRADE_PERCENT_FULL, previous.fpsPercent);
+    EXPECT_EQ(DCAMERA_DEGRADE_PERCENT_FULL, previous.bitratePercent);
+    for (int32_t level = 1; level <= maxLevel; level++) {
+        DCameraDegradeStep step = DCameraDegradeController::GetStep(level);
+        EXPECT_LE(step.fpsPercent, previous.fpsPercent);
+        EXPECT_LE(step.bitratePercent, previous.bitratePercent);
+        if (step.bitratePercent < previous.bitratePercent) {
+            EXPECT_EQ(step.fpsPercent, previous.fpsPercent);
+        }
+        previous = step;
+    }
+}
+
+/**
+ * @tc.name: dcamera_degrade_controller_test_002
+ * @tc.desc: Verify the level neither flaps on alternating windows nor steps up before a long enough idle run.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraDegradeControllerTest, dcamera_degrade_controller_test_002, TestSize.Level1)
+{
+    int32_t transitions = 0;
+    DCameraDegradeController& controller = DCameraDegradeController::GetInstance();
+    controller.AddCamera(TEST_CAMERA_KEY, [&transitions](int32_t level) { transitions++; });
+
+    for (uint32_t i = 0; i < TEST_ALTERNATE_TIMES; i++) {
+        controller.Evaluate(TEST_CAMERA_KEY, MakeOverloadSample());
+        controller.Evaluate(TEST_CAMERA_KEY, MakeNeutralSample());
+    }
+    EXPECT_EQ(0, transitions);
+
+    for (uint32_t i = 0; i < DCAMERA_DEGRADE_STEP_DOWN_WINDOWS; i++) {
+        controller.Evaluate(TEST_CAMERA_KEY, MakeOverloadSample());
+    }
+    EXPECT_EQ(1, controller.GetLevel(TEST_CAMERA_KEY));
+
+    for (uint32_t i = 0; i + 1 < DCAMERA_DEGRADE_STEP_UP_WINDOWS; i++) {
+        controller.Evaluate(TEST_CAMERA_KEY, MakeIdleSample());
+    }
+    controller.Evaluate(TEST_CAMERA_KEY, MakeNeutralSample());
+    for (uint32_t i = 0; i + 1 < DCAMERA_DEGRADE_STEP_UP_WINDOWS; i++) {
+        controller.Evaluate(TEST_CAMERA_KEY, MakeIdleSample());
+    }
+    EXPECT_EQ(1, controller.GetLevel(TEST_CAMERA_KEY));
+    EXPECT_EQ(0, controller.Evaluate(TEST_CAMERA_KEY, MakeIdleSample()));
+    EXPECT_EQ(2, transitions);
+}
+
+/**
+ * @tc.name: dcamera_degrade_controller_test_003
+ * @tc.desc: Verify a degradation level sent over the wire is only accepted inside the ladder.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraDegradeControllerTest, dcamera_degrade_controller_test_003, TestSize.Level1)
+{
+    int32_t level = -1;
+    int32_t maxLevel = DCameraDegradeController::GetMaxLevel();
+    EXPECT_EQ(true, DCameraDegradeController::ParseLevel(std::to_string(maxLevel), level));
+    EXPECT_EQ(maxLevel, level);
+    EXPECT_EQ(false, DCameraDegradeController::ParseLevel(std::to_string(maxLevel + 1), level));
+    EXPECT_EQ(false, DCameraDegradeController::ParseLevel("", level));
+    EXPECT_EQ(false, DCameraDegradeController::ParseLevel("-1", level));
+    EXPECT_EQ(false, DCameraDegradeController::ParseLevel("1a", level));
+
+    DCameraDegradeStep step = DCameraDegradeController::GetStep(maxLevel + 1);
+    EXPECT_EQ(DCAMERA_DEGRADE_PERCENT_FULL, step.fpsPercent);
+    EXPECT_EQ(DCAMERA_DEGRADE_PERCENT_FULL, step.bitratePercent);
+}
+
+/**
+ * @tc.name: dcamera_degrade_controller_test_004
+ * @tc.desc: Verify one saturated frame thread steps the camera down while latency and queue stay quiet.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraDegradeControllerTest, dcamera_degrade_controller_test_004, TestSize.Level1)
+{
+    DCameraDegradeController& controller = DCameraDegradeController::GetInstance();
+    controller.AddCamera(TEST_CAMERA_KEY, nullptr);
+
+    std::atomic<bool> isBusy(true);
+    std::thread busyThread([&isBusy]() {
+        DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamTestBusy", DCAMERA_TASK_TIER_FRAME);
+        while (isBusy.load()) {
+        }
+    });
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(DCAMERA_DEGRADE_WINDOW_US * TEST_CPU_WAIT_WINDOWS);
+    while (controller.GetLevel(TEST_CAMERA_KEY) == 0 && std::chrono::steady_clock::now() < deadline) {
+        controller.OnStageLatency(TEST_CAMERA_KEY, DCAMERA_DEGRADE_STAGE_DECODE, TEST_QUIET_LATENCY_US);
+        controller.OnStageLatency(TEST_CAMERA_KEY, DCAMERA_DEGRADE_STAGE_DELIVER, TEST_QUIET_LATENCY_US);
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_FEED_INTERVAL_MS));
+    }
+    isBusy = false;
+    busyThread.join();
+    EXPECT_EQ(1, controller.GetLevel(TEST_CAMERA_KEY));
+}
+} // namespace DistributedHardware
+} // namespace OHOS
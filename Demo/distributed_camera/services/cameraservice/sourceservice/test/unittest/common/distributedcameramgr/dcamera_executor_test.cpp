@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dcamera_executor.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraExecutorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const int32_t TEST_TASK_NUM = 100;
+const std::chrono::milliseconds TEST_WAIT_TIMEOUT(2000);
+const std::chrono::milliseconds TEST_CLOSE_DELAY(50);
+const std::chrono::milliseconds TEST_POLL_INTERVAL(50);
+
+// Parks a worker until the test releases it, so the test controls when the task ends.
+class TestGate {
+public:
+    void Enter()
+    {
+        entered_.set_value();
+        released_.get_future().wait();
+    }
+    bool WaitEntered()
+    {
+        return entered_.get_future().wait_for(TEST_WAIT_TIMEOUT) == std::future_status::ready;
+    }
+    void Release()
+    {
+        released_.set_value();
+    }
+
+private:
+    std::promise<void> entered_;
+    std::promise<void> released_;
+};
+}
+
+void DCameraExecutorTest::SetUpTestCase(void)
+{
+}
+
+void DCameraExecutorTest::TearDownTestCase(void)
+{
+}
+
+void DCameraExecutorTest::SetUp(void)
+{
+}
+
+void DCameraExecutorTest::TearDown(void)
+{
+}
+
+/**
+ * @tc.name: dcamera_executor_test_001
+ * @tc.desc: Verify a serial queue runs its tasks one at a time and in posting order.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraExecutorTest, dcamera_executor_test_001, TestSize.Level1)
+{
+    std::shared_ptr<DCameraSerialQueue> queue =
+        DCameraExecutor::GetInstance().CreateSerialQueue("DCamTestOrder", DCAMERA_TASK_TIER_FRAME);
+    ASSERT_NE(nullptr, queue);
+
+    std::mutex orderLock;
+    std::vector<int32_t> order;
+    std::atomic<int32_t> running(0);
+    std::atomic<bool> isOverlapped(false);
+    std::promise<void> done;
+    for (int32_t i = 0; i < TEST_TASK_NUM; i++) {
+        EXPECT_TRUE(queue->PostTask([&, i]() {
+            if (running.fetch_add(1) != 0) {
+                isOverlapped = true;
+            }
+            {
+                std::lock_guard<std::mutex> autoLock(orderLock);
+                order.push_back(i);
+            }
+            running.fetch_sub(1);
+            if (i == TEST_TASK_NUM - 1) {
+                done.set_value();
+            }
+        }));
+    }
+    ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(TEST_WAIT_TIMEOUT));
+    queue->Close();
+
+    EXPECT_FALSE(isOverlapped);
+    ASSERT_EQ(static_cast<size_t>(TEST_TASK_NUM), order.size());
+    for (int32_t i = 0; i < TEST_TASK_NUM; i++) {
+        EXPECT_EQ(i, order[i]);
+    }
+}
+
+/**
+ * @tc.name: dcamera_executor_test_002
+ * @tc.desc: Verify Close waits for the running task, drops the pending ones and refuses new posts.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraExecutorTest, dcamera_executor_test_002, TestSize.Level1)
+{
+    std::shared_ptr<DCameraSerialQueue> queue =
+        DCameraExecutor::GetInstance().CreateSerialQueue("DCamTestClose", DCAMERA_TASK_TIER_FRAME);
+    ASSERT_NE(nullptr, queue);
+
+    TestGate gate;
+    std::atomic<bool> isRunningDone(false);
+    std::atomic<int32_t> pendingRunCount(0);
+    EXPECT_TRUE(queue->PostTask([&]() {
+        gate.Enter();
+        isRunningDone = true;
+    }));
+    for (int32_t i = 0; i < TEST_TASK_NUM; i++) {
+        EXPECT_TRUE(queue->PostTask([&]() { pendingRunCount++; }));
+    }
+    ASSERT_TRUE(gate.WaitEntered());
+
+    std::atomic<bool> isClosed(false);
+    std::thread closer([&]() {
+        queue->Close();
+        isClosed = true;
+    });
+    std::this_thread::sleep_for(TEST_CLOSE_DELAY);
+    EXPECT_FALSE(isClosed);
+
+    gate.Release();
+    closer.join();
+    EXPECT_TRUE(isRunningDone);
+    EXPECT_EQ(0, pendingRunCount.load());
+    EXPECT_FALSE(queue->PostTask([&]() { pendingRunCount++; }));
+}
+
+/**
+ * @tc.name: dcamera_executor_test_003
+ * @tc.desc: Verify blocked frame work holds up neither the control tier nor another frame queue.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraExecutorTest, dcamera_executor_test_003, TestSize.Level1)
+{
+    DCameraExecutor& executor = DCameraExecutor::GetInstance();
+    // more blocked queues than the frame tier has base workers, one per stalled camera stream
+    const uint32_t blockedNum = DCAMERA_EXECUTOR_FRAME_THREAD_NUM + 1;
+    std::vector<std::shared_ptr<DCameraSerialQueue>> blockedQueues;
+    std::vector<std::shared_ptr<TestGate>> gates;
+    for (uint32_t i = 0; i < blockedNum; i++) {
+        std::shared_ptr<DCameraSerialQueue> queue =
+            executor.CreateSerialQueue("DCamTestBlocked" + std::to_string(i), DCAMERA_TASK_TIER_FRAME);
+        ASSERT_NE(nullptr, queue);
+        std::shared_ptr<TestGate> gate = std::make_shared<TestGate>();
+        EXPECT_TRUE(queue->PostTask([gate]() { gate->Enter(); }));
+        blockedQueues.push_back(queue);
+        gates.push_back(gate);
+    }
+    for (auto& gate : gates) {
+        EXPECT_TRUE(gate->WaitEntered());
+    }
+
+    std::shared_ptr<DCameraSerialQueue> frameQueue =
+        executor.CreateSerialQueue("DCamTestFrame", DCAMERA_TASK_TIER_FRAME);
+    std::shared_ptr<DCameraSerialQueue> controlQueue =
+        executor.CreateSerialQueue("DCamTestControl", DCAMERA_TASK_TIER_CONTROL);
+    ASSERT_NE(nullptr, frameQueue);
+    ASSERT_NE(nullptr, controlQueue);
+    std::promise<void> frameDone;
+    std::promise<void> controlDone;
+    EXPECT_TRUE(frameQueue->PostTask([&frameDone]() { frameDone.set_value(); }));
+    EXPECT_TRUE(controlQueue->PostTask([&controlDone]() { controlDone.set_value(); }));
+    EXPECT_EQ(std::future_status::ready, frameDone.get_future().wait_for(TEST_WAIT_TIMEOUT));
+    EXPECT_EQ(std::future_status::ready, controlDone.get_future().wait_for(TEST_WAIT_TIMEOUT));
+
+    for (auto& gate : gates) {
+        gate->Release();
+    }
+    for (auto& queue : blockedQueues) {
+        queue->Close();
+    }
+    frameQueue->Close();
+    controlQueue->Close();
+
+    DCameraTierStats stats;
+    EXPECT_EQ(DCAMERA_OK, executor.GetTierStats(DCAMERA_TASK_TIER_FRAME, stats));
+    EXPECT_EQ(DCAMERA_EXECUTOR_FRAME_THREAD_NUM, stats.maxThreadCount);
+    EXPECT_EQ(DCAMERA_BAD_VALUE, executor.GetTierStats(DCAMERA_TASK_TIER_BUTT, stats));
+}
+
+/**
+ * @tc.name: dcamera_executor_test_004
+ * @tc.desc: Verify open queues raise a tier no higher than its cap, and idle workers go once they are closed.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraExecutorTest, dcamera_executor_test_004, TestSize.Level1)
+{
+    DCameraExecutor& executor = DCameraExecutor::GetInstance();
+    std::vector<std::shared_ptr<DCameraSerialQueue>> queues;
+    std::vector<std::shared_ptr<TestGate>> gates;
+    for (uint32_t i = 0; i <= DCAMERA_EXECUTOR_TIER_MAX_THREAD_NUM; i++) {
+        std::shared_ptr<DCameraSerialQueue> queue =
+            executor.CreateSerialQueue("DCamTestCapped" + std::to_string(i), DCAMERA_TASK_TIER_FRAME);
+        ASSERT_NE(nullptr, queue);
+        queues.push_back(queue);
+    }
+    for (uint32_t i = 0; i < DCAMERA_EXECUTOR_FRAME_THREAD_NUM + 1; i++) {
+        std::shared_ptr<TestGate> gate = std::make_shared<TestGate>();
+        EXPECT_TRUE(queues[i]->PostTask([gate]() { gate->Enter(); }));
+        gates.push_back(gate);
+    }
+    for (auto& gate : gates) {
+        EXPECT_TRUE(gate->WaitEntered());
+    }
+
+    DCameraTierStats stats;
+    EXPECT_EQ(DCAMERA_OK, executor.GetTierStats(DCAMERA_TASK_TIER_FRAME, stats));
+    EXPECT_EQ(DCAMERA_EXECUTOR_TIER_MAX_THREAD_NUM, stats.maxThreadCount);
+    EXPECT_GT(stats.threadCount, DCAMERA_EXECUTOR_FRAME_THREAD_NUM);
+
+    for (auto& gate : gates) {
+        gate->Release();
+    }
+    for (auto& queue : queues) {
+        queue->Close();
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(DCAMERA_EXECUTOR_IDLE_TIMEOUT_MS) +
+        TEST_WAIT_TIMEOUT;
+    do {
+        std::this_thread::sleep_for(TEST_POLL_INTERVAL);
+        EXPECT_EQ(DCAMERA_OK, executor.GetTierStats(DCAMERA_TASK_TIER_FRAME, stats));
+    } while (stats.threadCount > DCAMERA_EXECUTOR_FRAME_THREAD_NUM && std::chrono::steady_clock::now() < deadline);
+    EXPECT_EQ(DCAMERA_EXECUTOR_FRAME_THREAD_NUM, stats.threadCount);
+    EXPECT_EQ(DCAMERA_EXECUTOR_FRAME_THREAD_NUM, stats.maxThreadCount);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dcamera_memory_budget.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraMemoryBudgetTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const std::string TEST_BUDGET_KEY = "bb536a637105409e904d4da83790a4a7camera_0";
+const uint64_t TEST_FRAME_SIZE = 1920 * 1080 * 3 / 2;
+const uint64_t TEST_BUDGET_FRAMES = 8;
+const uint64_t TEST_BUDGET = TEST_FRAME_SIZE * TEST_BUDGET_FRAMES;
+const int32_t TEST_FRAME_NUM = 300;
+const int32_t TEST_DRAIN_INTERVAL = 3;
+const int32_t TEST_RACE_ROUNDS = 2000;
+}
+
+void DCameraMemoryBudgetTest::SetUpTestCase(void)
+{
+}
+
+void DCameraMemoryBudgetTest::TearDownTestCase(void)
+{
+}
+
+void DCameraMemoryBudgetTest::SetUp(void)
+{
+}
+
+void DCameraMemoryBudgetTest::TearDown(void)
+{
+    DCameraMemoryBudget::GetInstance().RemoveCamera(TEST_BUDGET_KEY);
+}
+
+/**
+ * @tc.name: dcamera_memory_budget_test_001
+ * @tc.desc: Verify a stage is refused once the camera is at its budget and gets room back after a release.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraMemoryBudgetTest, dcamera_memory_budget_test_001, TestSize.Level1)
+{
+    DCameraMemoryBudget& budget = DCameraMemoryBudget::GetInstance();
+    EXPECT_EQ(true, budget.Acquire(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_PRODUCER, TEST_BUDGET));
+
+    budget.AddCamera(TEST_BUDGET_KEY, TEST_BUDGET, nullptr);
+    for (uint64_t i = 0; i < TEST_BUDGET_FRAMES; i++) {
+        EXPECT_EQ(true, budget.Acquire(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_PRODUCER, TEST_FRAME_SIZE));
+    }
+    EXPECT_EQ(false, budget.Acquire(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_ASSEMBLE, TEST_FRAME_SIZE));
+    budget.Release(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_PRODUCER, TEST_FRAME_SIZE);
+    EXPECT_EQ(true, budget.Acquire(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_ASSEMBLE, TEST_FRAME_SIZE));
+
+    // a release larger than the stage holds never drives the camera below zero
+    budget.Release(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_ASSEMBLE, TEST_BUDGET);
+    DCameraMemoryReport report;
+    EXPECT_EQ(DCAMERA_OK, budget.GetReport(TEST_BUDGET_KEY, report));
+    EXPECT_EQ(TEST_FRAME_SIZE * (TEST_BUDGET_FRAMES - 1), report.inFlightBytes);
+    EXPECT_EQ(0, report.stageBytes[DCAMERA_MEMORY_STAGE_ASSEMBLE]);
+    EXPECT_EQ(TEST_BUDGET, report.highWaterBytes);
+    EXPECT_EQ(TEST_FRAME_SIZE, report.stageHighWaterBytes[DCAMERA_MEMORY_STAGE_ASSEMBLE]);
+
+    budget.RemoveCamera(TEST_BUDGET_KEY);
+    EXPECT_EQ(DCAMERA_NOT_FOUND, budget.GetReport(TEST_BUDGET_KEY, report));
+}
+
+/**
+ * @tc.name: dcamera_memory_budget_test_002
+ * @tc.desc: Verify the listener is told to throttle at the high mark and to resume only at the low mark.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraMemoryBudgetTest, dcamera_memory_budget_test_002, TestSize.Level1)
+{
+    std::vector<bool> notices;
+    DCameraMemoryBudget& budget = DCameraMemoryBudget::GetInstance();
+    budget.AddCamera(TEST_BUDGET_KEY, TEST_BUDGET, [&notices](bool isThrottled) { notices.push_back(isThrottled); });
+
+    uint64_t throttleFrames = TEST_BUDGET_FRAMES * DCAMERA_MEMORY_THROTTLE_PERCENT / 100;
+    uint64_t resumeFrames = TEST_BUDGET_FRAMES * DCAMERA_MEMORY_RESUME_PERCENT / 100;
+    for (uint64_t i = 0; i < throttleFrames; i++) {
+        budget.Charge(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_DECODE, TEST_FRAME_SIZE);
+    }
+    EXPECT_EQ(std::vector<bool>({ true }), notices);
+
+    for (uint64_t i = throttleFrames; i > resumeFrames + 1; i--) {
+        budget.Release(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_DECODE, TEST_FRAME_SIZE);
+    }
+    EXPECT_EQ(std::vector<bool>({ true }), notices);
+    budget.Release(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_DECODE, TEST_FRAME_SIZE);
+    EXPECT_EQ(std::vector<bool>({ true, false }), notices);
+
+    DCameraMemoryReport report;
+    EXPECT_EQ(DCAMERA_OK, budget.GetReport(TEST_BUDGET_KEY, report));
+    EXPECT_EQ(false, report.isThrottled);
+}
+
+/**
+ * @tc.name: dcamera_memory_budget_test_003
+ * @tc.desc: Verify a sustained overload stays inside the budget by dropping frames and leaks nothing once drained.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraMemoryBudgetTest, dcamera_memory_budget_test_003, TestSize.Level1)
+{
+    int32_t throttleNotices = 0;
+    DCameraMemoryBudget& budget = DCameraMemoryBudget::GetInstance();
+    budget.AddCamera(TEST_BUDGET_KEY, TEST_BUDGET, [&throttleNotices](bool isThrottled) {
+        throttleNotices += isThrottled ? 1 : 0;
+    });
+
+    // frames arrive faster than the driver drains them, a refused frame takes the place of the oldest queued one
+    std::queue<uint64_t> queued;
+    for (int32_t i = 0; i < TEST_FRAME_NUM; i++) {
+        while (!budget.Acquire(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_PRODUCER, TEST_FRAME_SIZE)) {
+            budget.OnFrameDropped(TEST_BUDGET_KEY);
+            ASSERT_EQ(false, queued.empty());
+            budget.Release(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_PRODUCER, queued.front());
+            queued.pop();
+        }
+        queued.push(TEST_FRAME_SIZE);
+        if (i % TEST_DRAIN_INTERVAL == 0) {
+            budget.Release(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_PRODUCER, queued.front());
+            queued.pop();
+        }
+    }
+
+    DCameraMemoryReport report;
+    EXPECT_EQ(DCAMERA_OK, budget.GetReport(TEST_BUDGET_KEY, report));
+    EXPECT_LE(report.highWaterBytes, TEST_BUDGET);
+    EXPECT_GT(report.droppedFrames, 0);
+    EXPECT_EQ(1, throttleNotices);
+    EXPECT_EQ(true, report.isThrottled);
+
+    while (!queued.empty()) {
+        budget.Release(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_PRODUCER, queued.front());
+        queued.pop();
+    }
+    EXPECT_EQ(DCAMERA_OK, budget.GetReport(TEST_BUDGET_KEY, report));
+    EXPECT_EQ(0, report.inFlightBytes);
+    EXPECT_EQ(false, report.isThrottled);
+}
+
+/**
+ * @tc.name: dcamera_memory_budget_test_004
+ * @tc.desc: Verify stages crossing the marks at once tell the listener in order, ending on the latest state.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraMemoryBudgetTest, dcamera_memory_budget_test_004, TestSize.Level1)
+{
+    std::mutex noticeLock;
+    std::vector<bool> notices;
+    DCameraMemoryBudget& budget = DCameraMemoryBudget::GetInstance();
+    budget.AddCamera(TEST_BUDGET_KEY, TEST_BUDGET, [&noticeLock, &notices](bool isThrottled) {
+        std::lock_guard<std::mutex> autoLock(noticeLock);
+        notices.push_back(isThrottled);
+    });
+
+    // every stage alone swings the camera from the resume mark to the throttle mark and back
+    uint64_t throttleFrames = TEST_BUDGET_FRAMES * DCAMERA_MEMORY_THROTTLE_PERCENT / 100;
+    uint64_t resumeFrames = TEST_BUDGET_FRAMES * DCAMERA_MEMORY_RESUME_PERCENT / 100;
+    budget.Charge(TEST_BUDGET_KEY, DCAMERA_MEMORY_STAGE_DECODE, TEST_FRAME_SIZE * resumeFrames);
+    uint64_t swingBytes = TEST_FRAME_SIZE * (throttleFrames - resumeFrames);
+    std::vector<std::thread> stages;
+    for (int32_t stage = DCAMERA_MEMORY_STAGE_ASSEMBLE; stage < DCAMERA_MEMORY_STAGE_BUTT; stage++) {
+        stages.emplace_back([&budget, stage, swingBytes]() {
+            DCameraMemoryStage memoryStage = static_cast<DCameraMemoryStage>(stage);
+            for (int32_t i = 0; i < TEST_RACE_ROUNDS; i++) {
+                budget.Charge(TEST_BUDGET_KEY, memoryStage, swingBytes);
+                budget.Release(TEST_BUDGET_KEY, memoryStage, swingBytes);
+            }
+        });
+    }
+    for (auto& stage : stages) {
+        stage.join();
+    }
+
+    DCameraMemoryReport report;
+    EXPECT_EQ(DCAMERA_OK, budget.GetReport(TEST_BUDGET_KEY, report));
+    std::lock_guard<std::mutex> autoLock(noticeLock);
+    for (size_t i = 1; i < notices.size(); i++) {
+        EXPECT_NE(notices[i - 1], notices[i]);
+    }
+    bool lastNotice = notices.empty() ? false : notices.back();
+    EXPECT_EQ(report.isThrottled, lastNotice);
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <sys/resource.h>
+#include <unordered_set>
+#include <vector>
+
+#include "dcamera_index.h"
+#include "dcamera_source_data_process.h"
+#include "dcamera_source_resource_tracker.h"
+#include "mock_dcamera_source_dev.h"
+#include "mock_dcamera_source_state_listener.h"
+
+#include "data_buffer.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraSourceResourceTrackerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const std::string TEST_DEVICE_ID = "bb536a637105409e904d4da83790a4a7";
+const std::string TEST_CAMERA_DH_ID_PREFIX = "camera_";
+const size_t TEST_FRAME_SIZE = 1920 * 1080 * 3 / 2;
+const int32_t TEST_FRAME_NUM = 300;
+const int64_t TEST_US_PER_SECOND = 1000000;
+
+DCameraIndex MakeIndex(uint32_t num)
+{
+    return DCameraIndex(TEST_DEVICE_ID, TEST_CAMERA_DH_ID_PREFIX + std::to_string(num));
+}
+
+int64_t ReadProcStatus(const std::string& key)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, key.size(), key) == 0) {
+            return std::stoll(line.substr(key.size()));
+        }
+    }
+    return 0;
+}
+
+int64_t GetCpuTimeUs()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * TEST_US_PER_SECOND +
+        usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+}
+
+void DCameraSourceResourceTrackerTest::SetUpTestCase(void)
+{
+}
+
+void DCameraSourceResourceTrackerTest::TearDownTestCase(void)
+{
+}
+
+void DCameraSourceResourceTrackerTest::SetUp(void)
+{
+}
+
+void DCameraSourceResourceTrackerTest::TearDown(void)
+{
+    for (uint32_t i = 0; i < DCAMERA_SOURCE_DEV_MAX_NUM; i++) {
+        DCameraSourceResourceTracker::GetInstance().RemoveCamera(MakeIndex(i));
+    }
+}
+
+/**
+ * @tc.name: dcamera_source_resource_tracker_test_001
+ * @tc.desc: Verify the camera index ordering and hash do not confuse device and dh ids.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSourceResourceTrackerTest, dcamera_source_resource_tracker_test_001, TestSize.Level1)
+{
+    DCameraIndex first("dev1", "camera_0");
+    DCameraIndex second("dev", "1camera_0");
+    EXPECT_FALSE(first == second);
+    EXPECT_TRUE(second < first);
+    EXPECT_FALSE(first < second);
+    EXPECT_FALSE(first < first);
+
+    std::unordered_set<DCameraIndex, DCameraIndexHash> indexSet;
+    for (uint32_t i = 0; i < DCAMERA_SOURCE_DEV_MAX_NUM; i++) {
+        indexSet.insert(MakeIndex(i));
+    }
+    indexSet.insert(first);
+    indexSet.insert(second);
+    indexSet.insert(DCameraIndex("dev1", "camera_0"));
+    EXPECT_EQ(DCAMERA_SOURCE_DEV_MAX_NUM + 2, indexSet.size());
+}
+
+/**
+ * @tc.name: dcamera_source_resource_tracker_test_002
+ * @tc.desc: Verify frames and streams are accounted per camera.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSourceResourceTrackerTest, dcamera_source_resource_tracker_test_002, TestSize.Level1)
+{
+    DCameraSourceResourceTracker& tracker = DCameraSourceResourceTracker::GetInstance();
+    DCameraIndex first = MakeIndex(0);
+    DCameraIndex second = MakeIndex(1);
+    EXPECT_EQ(DCAMERA_OK, tracker.AddCamera(first));
+    EXPECT_EQ(DCAMERA_ALREADY_EXISTS, tracker.AddCamera(first));
+    EXPECT_EQ(DCAMERA_OK, tracker.AddCamera(second));
+
+    DCameraSourceDataProcess process(first.devId_, first.dhId_, CONTINUOUS_FRAME);
+    std::vector<std::shared_ptr<DataBuffer>> buffers;
+    for (uint32_t i = 0; i < DCAMERA_FEED_BATCH_MAX_NUM; i++) {
+        buffers.push_back(std::make_shared<DataBuffer>(TEST_FRAME_SIZE));
+    }
+    EXPECT_EQ(DCAMERA_OK, process.FeedStream(buffers));
+    buffers.push_back(std::make_shared<DataBuffer>(TEST_FRAME_SIZE));
+    EXPECT_EQ(DCAMERA_BAD_VALUE, process.FeedStream(buffers));
+    tracker.UpdateStreamCount(first, SNAPSHOT_FRAME, 2);
+
+    DCameraResourceStats stats;
+    EXPECT_EQ(DCAMERA_OK, tracker.GetStats(first, stats));
+    EXPECT_EQ(DCAMERA_FEED_BATCH_MAX_NUM, stats.frameCount);
+    EXPECT_EQ(DCAMERA_FEED_BATCH_MAX_NUM * TEST_FRAME_SIZE, stats.byteCount);
+    EXPECT_EQ(2, stats.snapshotStreamCount);
+    EXPECT_EQ(0, stats.continuousStreamCount);
+    EXPECT_EQ(DCAMERA_OK, tracker.GetStats(second, stats));
+    EXPECT_EQ(0, stats.frameCount);
+
+    tracker.RemoveCamera(first);
+    EXPECT_EQ(DCAMERA_NOT_FOUND, tracker.GetStats(first, stats));
+    EXPECT_EQ(1, tracker.GetCameraCount());
+}
+
+/**
+ * @tc.name: dcamera_source_resource_tracker_test_003
+ * @tc.desc: Measure cpu, memory and thread cost as concurrent cameras grow from 1 to the maximum.
+ * @tc.type: PERF
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSourceResourceTrackerTest, dcamera_source_resource_tracker_test_003, TestSize.Level1)
+{
+    DCameraSourceResourceTracker& tracker = DCameraSourceResourceTracker::GetInstance();
+    std::shared_ptr<ICameraStateListener> stateListener = std::make_shared<MockDCameraSourceStateListener>();
+    for (uint32_t camNum = 1; camNum <= DCAMERA_SOURCE_DEV_MAX_NUM; camNum++) {
+        int64_t startRssKb = ReadProcStatus("VmRSS:");
+        int64_t startThreads = ReadProcStatus("Threads:");
+        int64_t startCpuUs = GetCpuTimeUs();
+
+        std::vector<std::shared_ptr<DCameraSourceDev>> camDevs;
+        std::vector<std::shared_ptr<DCameraSourceDataProcess>> processes;
+        for (uint32_t i = 0; i < camNum; i++) {
+            DCameraIndex index = MakeIndex(i);
+            std::shared_ptr<DCameraSourceDev> camDev =
+                std::make_shared<MockDCameraSourceDev>(index.devId_, index.dhId_, stateListener);
+            ASSERT_EQ(DCAMERA_OK, camDev->InitDCameraSourceDev());
+            ASSERT_EQ(DCAMERA_OK, tracker.AddCamera(index));
+            camDevs.push_back(camDev);
+            processes.push_back(std::make_shared<DCameraSourceDataProcess>(index.devId_, index.dhId_,
+                CONTINUOUS_FRAME));
+        }
+        int64_t threads = ReadProcStatus("Threads:");
+
+        std::vector<std::shared_ptr<DataBuffer>> buffers = { std::make_shared<DataBuffer>(TEST_FRAME_SIZE) };
+        for (int32_t frame = 0; frame < TEST_FRAME_NUM; frame++) {
+            for (auto& process : processes) {
+                process->FeedStream(buffers);
+            }
+        }
+        int64_t cpuUs = GetCpuTimeUs() - startCpuUs;
+        int64_t rssKb = ReadProcStatus("VmRSS:") - startRssKb;
+        EXPECT_EQ(camNum, tracker.GetCameraCount());
+        for (uint32_t i = 0; i < camNum; i++) {
+            DCameraResourceStats stats;
+            EXPECT_EQ(DCAMERA_OK, tracker.GetStats(MakeIndex(i), stats));
+            EXPECT_EQ(static_cast<uint64_t>(TEST_FRAME_NUM), stats.frameCount);
+            tracker.RemoveCamera(MakeIndex(i));
+        }
+        DHLOGI("dcamera_source_resource_tracker_test_003 cameras: %u, threads: %lld, cpu: %lld us, rss: %lld KB " \
+            "(%lld KB per camera)", camNum, (long long)(threads - startThreads), (long long)cpuUs, (long long)rssKb,
+            (long long)(rssKb / camNum));
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "dcamera_thread_policy.h"
+#include "distributed_camera_errno.h"
+
+using namespace std;
+using namespace OHOS::DistributedHardware;
+
+namespace {
+const uint32_t BENCH_FRAME_COUNT = 1000;
+const int64_t BENCH_FRAME_INTERVAL_US = 4000;
+const int64_t BENCH_FRAME_WORK_US = 500;
+const int64_t BENCH_LOAD_SLICE_US = 1000;
+const uint32_t BENCH_LOAD_THREADS_PER_CPU = 2;
+const uint32_t BENCH_PERCENTILES[] = { 50, 90, 99 };
+const uint32_t BENCH_PERCENT_BASE = 100;
+
+void Spin(int64_t durationUs)
+{
+    auto end = chrono::steady_clock::now() + chrono::microseconds(durationUs);
+    while (chrono::steady_clock::now() < end) {
+    }
+}
+
+// Stands in for logging, control and other background work that keeps every CPU busy.
+void RunLoad(const atomic<bool> &isRunning, bool usePolicy)
+{
+    if (usePolicy) {
+        DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamBenchLoad", DCAMERA_TASK_TIER_BACKGROUND);
+    }
+    while (isRunning) {
+        Spin(BENCH_LOAD_SLICE_US);
+    }
+}
+
+/*
+ * Stands in for the producer: wakes up on a fixed frame clock and does a slice of work,
+ * the latency of a frame is the time from its deadline to the end of its work.
+ */
+void RunFrames(bool usePolicy, vector<int64_t> &latencies, bool &isApplied)
+{
+    isApplied = false;
+    if (usePolicy) {
+        DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamBenchFrame", DCAMERA_TASK_TIER_FRAME);
+        DCameraThreadInfo info;
+        pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        isApplied = DCameraThreadPolicy::GetInstance().GetThreadInfo(tid, info) == DCAMERA_OK && info.isApplied;
+    }
+    auto deadline = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BENCH_FRAME_COUNT; i++) {
+        deadline += chrono::microseconds(BENCH_FRAME_INTERVAL_US);
+        this_thread::sleep_until(deadline);
+        Spin(BENCH_FRAME_WORK_US);
+        latencies.push_back(chrono::duration_cast<chrono::microseconds>(
+            chrono::steady_clock::now() - deadline).count());
+    }
+}
+
+void RunBench(const string &title, bool usePolicy)
+{
+    uint32_t cpuCount = static_cast<uint32_t>(max(1L, sysconf(_SC_NPROCESSORS_ONLN)));
+    atomic<bool> isRunning(true);
+    vector<thread> loads;
+    for (uint32_t i = 0; i < cpuCount * BENCH_LOAD_THREADS_PER_CPU; i++) {
+        loads.emplace_back(RunLoad, cref(isRunning), usePolicy);
+    }
+    vector<int64_t> latencies;
+    bool isApplied = false;
+    thread frames(RunFrames, usePolicy, ref(latencies), ref(isApplied));
+    frames.join();
+    isRunning = false;
+    for (auto &load : loads) {
+        load.join();
+    }
+
+    sort(latencies.begin(), latencies.end());
+    cout << title << (usePolicy && !isApplied ? " (frame nice refused, background nice only)" : "") << ":";
+    for (uint32_t percentile : BENCH_PERCENTILES) {
+        size_t index = latencies.size() * percentile / BENCH_PERCENT_BASE;
+        cout << " p" << percentile << ": " << latencies[min(index, latencies.size() - 1)] << " us";
+    }
+    cout << " max: " << latencies.back() << " us" << endl;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && DCameraThreadPolicy::GetInstance().LoadConfig(argv[1]) != DCAMERA_OK) {
+        cout << "invalid thread policy config " << argv[1] << endl;
+        return -1;
+    }
+    cout << "distributed camera thread policy benchmark, " << BENCH_FRAME_COUNT << " frames of " <<
+        BENCH_FRAME_WORK_US << " us every " << BENCH_FRAME_INTERVAL_US << " us, " << BENCH_LOAD_THREADS_PER_CPU <<
+        " busy threads per cpu" << endl;
+    RunBench("default scheduling", false);
+    RunBench("thread policy", true);
+    return 0;
+}
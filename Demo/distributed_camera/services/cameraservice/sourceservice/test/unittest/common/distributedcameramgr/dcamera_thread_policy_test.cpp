@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <string>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+#include "dcamera_thread_policy.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraThreadPolicyTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const std::string TEST_THREAD_NAME = "DCamTestThread";
+const int32_t TEST_CONTROL_NICE = 5;
+const size_t TEST_THREAD_NAME_LEN = 16;
+
+struct TestThreadResult {
+    pid_t tid = 0;
+    std::string name;
+    int32_t nice = 0;
+    cpu_set_t cpuSet;
+};
+
+// The policy is applied on a fresh thread, so nice and affinity of the test runner stay untouched.
+TestThreadResult RunTestThread(const std::string& name, DCameraTaskTier tier)
+{
+    TestThreadResult result;
+    std::thread testThread([&result, &name, tier]() {
+        DCameraThreadPolicy::GetInstance().ApplyCurrentThread(name, tier);
+        result.tid = static_cast<pid_t>(syscall(SYS_gettid));
+        char threadName[TEST_THREAD_NAME_LEN] = { 0 };
+        prctl(PR_GET_NAME, threadName);
+        result.name = threadName;
+        result.nice = getpriority(PRIO_PROCESS, static_cast<id_t>(result.tid));
+        CPU_ZERO(&result.cpuSet);
+        sched_getaffinity(0, sizeof(result.cpuSet), &result.cpuSet);
+    });
+    testThread.join();
+    return result;
+}
+}
+
+void DCameraThreadPolicyTest::SetUpTestCase(void)
+{
+}
+
+void DCameraThreadPolicyTest::TearDownTestCase(void)
+{
+}
+
+void DCameraThreadPolicyTest::SetUp(void)
+{
+    DCameraThreadPolicy::GetInstance().ParseConfig("{}");
+}
+
+void DCameraThreadPolicyTest::TearDown(void)
+{
+    DCameraThreadPolicy::GetInstance().ParseConfig("{}");
+}
+
+/**
+ * @tc.name: dcamera_thread_policy_test_001
+ * @tc.desc: Verify a background thread is named and runs at the background nice value.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraThreadPolicyTest, dcamera_thread_policy_test_001, TestSize.Level1)
+{
+    TestThreadResult result = RunTestThread(TEST_THREAD_NAME, DCAMERA_TASK_TIER_BACKGROUND);
+    EXPECT_EQ(TEST_THREAD_NAME, result.name);
+    EXPECT_EQ(DCAMERA_THREAD_NICE_BACKGROUND, result.nice);
+
+    // the thread has left, so it is no longer reported
+    DCameraThreadInfo info;
+    EXPECT_EQ(DCAMERA_NOT_FOUND, DCameraThreadPolicy::GetInstance().GetThreadInfo(result.tid, info));
+}
+
+/**
+ * @tc.name: dcamera_thread_policy_test_002
+ * @tc.desc: Verify the config sets the tier nice value and pins a thread by its name prefix.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraThreadPolicyTest, dcamera_thread_policy_test_002, TestSize.Level1)
+{
+    std::string config = "{\"tiers\": {\"control\": {\"nice\": " + std::to_string(TEST_CONTROL_NICE) +
+        "}}, \"threads\": {\"DCamTest\": [0]}}";
+    EXPECT_EQ(DCAMERA_OK, DCameraThreadPolicy::GetInstance().ParseConfig(config));
+
+    TestThreadResult result = RunTestThread(TEST_THREAD_NAME, DCAMERA_TASK_TIER_CONTROL);
+    EXPECT_EQ(TEST_CONTROL_NICE, result.nice);
+    EXPECT_EQ(1, CPU_COUNT(&result.cpuSet));
+    EXPECT_NE(0, CPU_ISSET(0, &result.cpuSet));
+}
+
+/**
+ * @tc.name: dcamera_thread_policy_test_003
+ * @tc.desc: Verify an invalid config is refused as a whole and the previous policy stays.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraThreadPolicyTest, dcamera_thread_policy_test_003, TestSize.Level1)
+{
+    DCameraThreadPolicy& policy = DCameraThreadPolicy::GetInstance();
+    EXPECT_EQ(DCAMERA_BAD_VALUE, policy.ParseConfig("{\"tiers\": "));
+    EXPECT_EQ(DCAMERA_BAD_VALUE, policy.ParseConfig("{\"tiers\": {\"realtime\": {\"nice\": 0}}}"));
+    EXPECT_EQ(DCAMERA_BAD_VALUE, policy.ParseConfig("{\"tiers\": {\"background\": {\"nice\": 20}}}"));
+    EXPECT_EQ(DCAMERA_BAD_VALUE, policy.ParseConfig("{\"tiers\": {\"background\": {\"nice\": 19}}, " \
+        "\"threads\": {\"DCamTest\": [-1]}}"));
+    EXPECT_EQ(DCAMERA_BAD_VALUE, policy.ParseConfig("{\"threads\": {\"DCamTestThreadTooLong\": [0]}}"));
+    EXPECT_EQ(DCAMERA_NOT_FOUND, policy.LoadConfig("/nonexistent/dcamera_thread_policy.json"));
+
+    TestThreadResult result = RunTestThread(TEST_THREAD_NAME, DCAMERA_TASK_TIER_BACKGROUND);
+    EXPECT_EQ(DCAMERA_THREAD_NICE_BACKGROUND, result.nice);
+}
+
+/**
+ * @tc.name: dcamera_thread_policy_test_004
+ * @tc.desc: Verify a thread without a name of its own keeps its name and nice value.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraThreadPolicyTest, dcamera_thread_policy_test_004, TestSize.Level1)
+{
+    char runnerName[TEST_THREAD_NAME_LEN] = { 0 };
+    prctl(PR_GET_NAME, runnerName);
+    int32_t runnerNice = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+
+    TestThreadResult result = RunTestThread("", DCAMERA_TASK_TIER_BACKGROUND);
+    EXPECT_EQ(std::string(runnerName), result.name);
+    EXPECT_EQ(runnerNice, result.nice);
+    DCameraThreadInfo info;
+    EXPECT_EQ(DCAMERA_NOT_FOUND, DCameraThreadPolicy::GetInstance().GetThreadInfo(result.tid, info));
+}
+} // namespace DistributedHardware
+} // namespace OHOS
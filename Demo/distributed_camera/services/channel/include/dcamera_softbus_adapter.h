@@ -16,6 +16,7 @@
 #ifndef OHOS_DCAMERA_SOFTBUS_ADAPTER_H
 #define OHOS_DCAMERA_SOFTBUS_ADAPTER_H
 
+#include <condition_variable>
 #include <mutex>
 #include <map>
 #include <unistd.h>
@@ -24,6 +25,7 @@
 #include "single_instance.h"
 
 #include "dcamera_softbus_session.h"
+#include "dcamera_softbus_session_pool.h"
 
 namespace OHOS {
 namespace DistributedHardware {
@@ -41,6 +43,12 @@ public:
     int32_t OpenSoftbusSession(std::string mySessName, std::string peerSessName, int32_t sessionMode,
         std::string peerDevId);
     int32_t CloseSoftbusSession(int32_t sessionId);
+    int32_t ParkSoftbusSession(int32_t sessionId, std::string mySessName, std::string peerSessName,
+        int32_t sessionMode, std::string peerDevId);
+    int32_t AcquireSoftbusSession(std::string mySessName, std::string peerSessName, int32_t sessionMode,
+        std::string peerDevId, int32_t& sessionId);
+    int32_t ConfirmSoftbusSession(int32_t sessionId);
+    void SetSessionIdleTimeout(uint32_t idleTimeoutMs);
     int32_t SendSofbusBytes(int32_t sessionId, std::shared_ptr<DataBuffer>& buffer);
     int32_t SendSofbusStream(int32_t sessionId, std::shared_ptr<DataBuffer>& buffer);
     int32_t GetLocalNetworkId(std::string& myDevId);
@@ -70,6 +78,11 @@ private:
     int32_t DCameraSoftbusSourceGetSession(int32_t sessionId, std::shared_ptr<DCameraSoftbusSession>& session);
     int32_t DCameraSoftbusSinkGetSession(int32_t sessionId, std::shared_ptr<DCameraSoftbusSession>& session);
     int32_t DCameraSoftbusGetSessionById(int32_t sessionId, std::shared_ptr<DCameraSoftbusSession>& session);
+    bool IsPooledSessionAlive(int32_t sessionId);
+    void ClosePooledSession(int32_t sessionId, const std::string& serverName);
+    void DropPooledSession(int32_t sessionId);
+    bool ClaimPooledSession(int32_t sessionId);
+    bool ReceiveReuseAck(int32_t sessionId, const StreamData *data);
 
 private:
     std::mutex optLock_;
@@ -79,8 +92,14 @@ private:
     std::map<std::string, uint32_t> sessionTotal_;
     static const uint32_t DCAMERA_LINK_TYPE_MAX = 4;
     static const uint32_t DCAMERA_LINK_TYPE_INDEX_2 = 2;
+    static const uint8_t DCAMERA_SESSION_REUSE_NOTICE = 1;
+    static const uint8_t DCAMERA_SESSION_REUSE_ACK = 2;
+    std::mutex ackLock_;
+    std::condition_variable ackCond_;
+    std::map<int32_t, bool> pendingAcks_;
     std::mutex idMapLock_;
     std::map<int32_t, std::shared_ptr<DCameraSoftbusSession>> sessionIdMap_;
+    std::shared_ptr<DCameraSoftbusSessionPool> sessionPool_;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -16,9 +16,9 @@
 #ifndef OHOS_DCAMERA_SOFTBUS_SESSION_H
 #define OHOS_DCAMERA_SOFTBUS_SESSION_H
 
-#include "event_handler.h"
 #include <string>
 
+#include "dcamera_executor.h"
 #include "icamera_channel.h"
 #include "icamera_channel_listener.h"
 
@@ -44,6 +44,7 @@ public:
     std::string GetPeerDevId();
     std::string GetPeerSessionName();
     std::string GetMySessionName();
+    void SetBudgetKey(const std::string& budgetKey);
 
 private:
     struct SessionDataHeader {
@@ -67,6 +68,7 @@ private:
     void GetFragDataLen(uint8_t *ptrPacket, SessionDataHeader& headerPara);
     int32_t UnPackSendData(std::shared_ptr<DataBuffer>& buffer, DCameraSendFuc memberFunc);
     void MakeFragDataHeader(const SessionDataHeader& headPara, uint8_t *header, uint32_t len);
+    void SetFrameType(std::shared_ptr<DataBuffer>& buffer, const SessionDataHeader& headerPara);
     void PostData(std::shared_ptr<DataBuffer>& buffer);
     uint16_t U16Get(const uint8_t *ptr);
     uint32_t U32Get(const uint8_t *ptr);
@@ -95,6 +97,7 @@ private:
     static const uint32_t BINARY_HEADER_TOTALLEN_OFFSET = 11;
     static const uint32_t BINARY_HEADER_SUBSEQ_OFFSET = 15;
     static const uint32_t BINARY_HEADER_DATALEN_OFFSET = 17;
+    static const uint32_t BINARY_DATA_TYPE_FRAME_SHIFT = 16;
 
     std::shared_ptr<DataBuffer> packBuffer_;
     bool isWaiting_;
@@ -102,6 +105,8 @@ private:
     uint32_t nowSubSeq_;
     uint32_t offset_;
     uint32_t totalLen_;
+    uint64_t chargedBytes_ = 0;
+    std::string budgetKey_;
 
 private:
     std::string myDevId_;
@@ -113,7 +118,7 @@ private:
     DCameraSofbutState state_;
     DCameraSessionMode mode_;
     std::map<DCameraSessionMode, DCameraSendFuc> sendFuncMap_;
-    std::shared_ptr<AppExecFwk::EventHandler> eventHandler_;
+    std::shared_ptr<DCameraSerialQueue> recvQueue_;
 };
 } // namespace DistributedHardware
 } // namespace OHOS
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DCAMERA_SOFTBUS_SESSION_POOL_H
+#define OHOS_DCAMERA_SOFTBUS_SESSION_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace DistributedHardware {
+using DCameraPooledSessionChecker = std::function<bool(int32_t sessionId)>;
+using DCameraPooledSessionCloser = std::function<void(int32_t sessionId, const std::string& serverName)>;
+
+// Holds recently closed softbus sessions idle for a grace period, so that reopening the same channel
+// hands back the established link instead of negotiating a new one.
+class DCameraSoftbusSessionPool {
+public:
+    DCameraSoftbusSessionPool(const DCameraPooledSessionChecker& checker, const DCameraPooledSessionCloser& closer,
+        uint32_t idleTimeoutMs);
+    ~DCameraSoftbusSessionPool();
+
+    int32_t Park(const std::string& key, const std::string& serverName, int32_t sessionId);
+    int32_t Acquire(const std::string& key, int32_t& sessionId);
+    bool Drop(int32_t sessionId, std::string& serverName);
+    void Clear();
+    uint32_t GetIdleCount();
+    void SetIdleTimeout(uint32_t idleTimeoutMs);
+
+    static std::string MakeKey(const std::string& mySessName, const std::string& peerSessName, int32_t sessionMode,
+        const std::string& peerDevId);
+
+private:
+    struct PooledSession {
+        int32_t sessionId;
+        std::string serverName;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    std::map<std::string, PooledSession>::iterator EraseLocked(std::map<std::string, PooledSession>::iterator iter);
+    void StartTimerLocked();
+    void TimerLoop();
+    void Close(std::vector<PooledSession>& sessions);
+
+    DCameraPooledSessionChecker checker_;
+    DCameraPooledSessionCloser closer_;
+    uint32_t idleTimeoutMs_;
+    std::mutex poolLock_;
+    std::condition_variable timerCond_;
+    std::map<std::string, PooledSession> sessions_;
+    std::map<int32_t, std::string> sessionKeys_;
+    std::thread timerThread_;
+    bool isTimerRunning_ = false;
+    bool isStop_ = false;
+};
+} // namespace DistributedHardware
+} // namespace OHOS
+#endif // OHOS_DCAMERA_SOFTBUS_SESSION_POOL_H
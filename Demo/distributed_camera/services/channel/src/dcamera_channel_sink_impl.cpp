@@ -92,6 +92,9 @@ int32_t DCameraChannelSinkImpl::CreateSession(std::vector<DCameraIndex>& camInde
     softbusSession_ = std::make_shared<DCameraSoftbusSession>(myDevId, mySessionName_, peerDevId, peerSessionName,
         listener, sessionMode);
     DCameraSoftbusAdapter::GetInstance().sinkSessions_[mySessionName_] = softbusSession_;
+
+    // an idle stream session is handed back only once the source confirms its reuse on it,
+    // otherwise the source opens a fresh one and the open callback reaches us as usual
     return DCAMERA_OK;
 }
 
@@ -101,7 +104,9 @@ int32_t DCameraChannelSinkImpl::ReleaseSession()
     if (softbusSession_ == nullptr) {
         return DCAMERA_OK;
     }
-    DCameraSoftbusAdapter::GetInstance().sourceSessions_.erase(softbusSession_->GetMySessionName());
+    // park a live stream session before its server reference goes away, so the next open can take it back
+    softbusSession_->CloseSession();
+    DCameraSoftbusAdapter::GetInstance().sinkSessions_.erase(softbusSession_->GetMySessionName());
     int32_t ret = DCameraSoftbusAdapter::GetInstance().DestroySoftbusSessionServer(softbusSession_->GetMySessionName());
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraChannelSinkImpl ReleaseSession %s failed, ret: %d", mySessionName_.c_str(), ret);
@@ -106,6 +106,11 @@ DCameraSoftbusAdapter::DCameraSoftbusAdapter()
     sinkListener.OnMessageReceived = DCameraSinkOnMessageReceived;
     sinkListener.OnStreamReceived = DCameraSinkOnStreamReceived;
     sessListeners_[DCAMERA_CHANNLE_ROLE_SINK] = sinkListener;
+
+    sessionPool_ = std::make_shared<DCameraSoftbusSessionPool>(
+        [this](int32_t sessionId) { return IsPooledSessionAlive(sessionId); },
+        [this](int32_t sessionId, const std::string& serverName) { ClosePooledSession(sessionId, serverName); },
+        DCAMERA_SESSION_POOL_IDLE_TIMEOUT_MS);
 }
 
 DCameraSoftbusAdapter::~DCameraSoftbusAdapter()
@@ -214,6 +219,158 @@ int32_t DCameraSoftbusAdapter::CloseSoftbusSession(int32_t sessionId)
     return DCAMERA_OK;
 }
 
+int32_t DCameraSoftbusAdapter::ParkSoftbusSession(int32_t sessionId, std::string mySessName, std::string peerSessName,
+    int32_t sessionMode, std::string peerDevId)
+{
+    // control sessions are cheap byte links, and the sink talks on them as soon as they connect,
+    // so only the stream sessions that pay for the p2p link setup are kept for reuse
+    if (sessionMode == DCAMERA_SESSION_MODE_CTRL) {
+        return CloseSoftbusSession(sessionId);
+    }
+    {
+        std::lock_guard<std::mutex> autoLock(idMapLock_);
+        sessionIdMap_.erase(sessionId);
+    }
+    {
+        // an idle session keeps its session server registered until it is reused or evicted
+        std::lock_guard<std::mutex> autoLock(optLock_);
+        if (sessionTotal_.find(mySessName) == sessionTotal_.end()) {
+            DHLOGI("DCameraSoftbusAdapter park sessionId: %d without session server %s", sessionId,
+                mySessName.c_str());
+            CloseSession(sessionId);
+            return DCAMERA_OK;
+        }
+        sessionTotal_[mySessName]++;
+    }
+    std::string key = DCameraSoftbusSessionPool::MakeKey(mySessName, peerSessName, sessionMode, peerDevId);
+    int32_t ret = sessionPool_->Park(key, mySessName, sessionId);
+    if (ret != DCAMERA_OK) {
+        ClosePooledSession(sessionId, mySessName);
+    }
+    return DCAMERA_OK;
+}
+
+int32_t DCameraSoftbusAdapter::AcquireSoftbusSession(std::string mySessName, std::string peerSessName,
+    int32_t sessionMode, std::string peerDevId, int32_t& sessionId)
+{
+    if (sessionMode == DCAMERA_SESSION_MODE_CTRL) {
+        return DCAMERA_NOT_FOUND;
+    }
+    std::string key = DCameraSoftbusSessionPool::MakeKey(mySessName, peerSessName, sessionMode, peerDevId);
+    int32_t ret = sessionPool_->Acquire(key, sessionId);
+    if (ret != DCAMERA_OK) {
+        return ret;
+    }
+    // the reopened channel already holds its own reference on the session server
+    DestroySoftbusSessionServer(mySessName);
+    return DCAMERA_OK;
+}
+
+int32_t DCameraSoftbusAdapter::ConfirmSoftbusSession(int32_t sessionId)
+{
+    // the peer only takes its own idle copy back once this notice arrives on it, and answers with an ack.
+    // A send may still succeed after the peer evicted its copy, so only the ack proves the link is live,
+    // without it the caller falls back to a fresh open.
+    {
+        std::lock_guard<std::mutex> autoLock(ackLock_);
+        pendingAcks_[sessionId] = false;
+    }
+    uint8_t notice = DCAMERA_SESSION_REUSE_NOTICE;
+    StreamData streamData = { reinterpret_cast<char *>(&notice), sizeof(notice) };
+    StreamData ext = { 0 };
+    StreamFrameInfo param = { 0 };
+    int32_t ret = SendStream(sessionId, &streamData, &ext, &param);
+    bool isAcked = false;
+    {
+        std::unique_lock<std::mutex> lock(ackLock_);
+        if (ret == DCAMERA_OK) {
+            ackCond_.wait_for(lock, std::chrono::milliseconds(DCAMERA_SESSION_REUSE_ACK_TIMEOUT_MS),
+                [this, sessionId] { return pendingAcks_[sessionId]; });
+        }
+        isAcked = pendingAcks_[sessionId];
+        pendingAcks_.erase(sessionId);
+    }
+    if (!isAcked) {
+        DHLOGE("DCameraSoftbusAdapter ConfirmSoftbusSession sessionId: %d failed ret: %d", sessionId, ret);
+        CloseSession(sessionId);
+        return DCAMERA_BAD_OPERATE;
+    }
+    return DCAMERA_OK;
+}
+
+bool DCameraSoftbusAdapter::ReceiveReuseAck(int32_t sessionId, const StreamData *data)
+{
+    if (data->bufLen != sizeof(uint8_t) || static_cast<uint8_t>(data->buf[0]) != DCAMERA_SESSION_REUSE_ACK) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> autoLock(ackLock_);
+        auto iter = pendingAcks_.find(sessionId);
+        if (iter == pendingAcks_.end()) {
+            return false;
+        }
+        iter->second = true;
+    }
+    ackCond_.notify_all();
+    return true;
+}
+
+void DCameraSoftbusAdapter::SetSessionIdleTimeout(uint32_t idleTimeoutMs)
+{
+    DHLOGI("DCameraSoftbusAdapter SetSessionIdleTimeout %d ms", idleTimeoutMs);
+    sessionPool_->SetIdleTimeout(idleTimeoutMs);
+    if (idleTimeoutMs == 0) {
+        sessionPool_->Clear();
+    }
+}
+
+bool DCameraSoftbusAdapter::IsPooledSessionAlive(int32_t sessionId)
+{
+    char peerDevId[NETWORK_ID_BUF_LEN] = "";
+    return GetPeerDeviceId(sessionId, peerDevId, sizeof(peerDevId)) == DCAMERA_OK;
+}
+
+void DCameraSoftbusAdapter::ClosePooledSession(int32_t sessionId, const std::string& serverName)
+{
+    DHLOGI("DCameraSoftbusAdapter close idle sessionId: %d server: %s", sessionId, serverName.c_str());
+    CloseSession(sessionId);
+    DestroySoftbusSessionServer(serverName);
+}
+
+void DCameraSoftbusAdapter::DropPooledSession(int32_t sessionId)
+{
+    std::string serverName;
+    if (sessionPool_->Drop(sessionId, serverName)) {
+        DestroySoftbusSessionServer(serverName);
+    }
+}
+
+bool DCameraSoftbusAdapter::ClaimPooledSession(int32_t sessionId)
+{
+    std::string serverName;
+    if (!sessionPool_->Drop(sessionId, serverName)) {
+        return false;
+    }
+    // data on an idle session is the source telling us it reused its copy, so ours is confirmed live. The
+    // source only takes the link once our ack reaches it.
+    DHLOGI("DCameraSoftbusAdapter reuse sessionId: %d server: %s confirmed by peer", sessionId, serverName.c_str());
+    DestroySoftbusSessionServer(serverName);
+    uint8_t ack = DCAMERA_SESSION_REUSE_ACK;
+    StreamData streamData = { reinterpret_cast<char *>(&ack), sizeof(ack) };
+    StreamData ext = { 0 };
+    StreamFrameInfo param = { 0 };
+    int32_t ret = SendStream(sessionId, &streamData, &ext, &param);
+    if (ret != DCAMERA_OK) {
+        DHLOGE("DCameraSoftbusAdapter reuse sessionId: %d ack failed ret: %d", sessionId, ret);
+        CloseSession(sessionId);
+        return true;
+    }
+    if (OnSinkSessionOpened(sessionId, DCAMERA_OK) != DCAMERA_OK) {
+        CloseSession(sessionId);
+    }
+    return true;
+}
+
 int32_t DCameraSoftbusAdapter::SendSofbusBytes(int32_t sessionId, std::shared_ptr<DataBuffer>& buffer)
 {
     return SendBytes(sessionId, buffer->Data(), buffer->Size());
@@ -297,6 +454,7 @@ void DCameraSoftbusAdapter::OnSourceSessionClosed(int32_t sessionId)
     int32_t ret = DCameraSoftbusGetSessionById(sessionId, session);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSoftbusAdapter OnSourceSessionClosed not find session %d", sessionId);
+        DropPooledSession(sessionId);
         return;
     }
     {
@@ -344,6 +502,9 @@ void DCameraSoftbusAdapter::OnSourceStreamReceived(int32_t sessionId, const Stre
         DHLOGE("DCameraSoftbusAdapter OnSourceStreamReceived dataLen: %d, sessionId: %d", dataLen, sessionId);
         return;
     }
+    if (ReceiveReuseAck(sessionId, data)) {
+        return;
+    }
     std::shared_ptr<DCameraSoftbusSession> session = nullptr;
     int32_t ret = DCameraSoftbusSourceGetSession(sessionId, session);
     if (ret != DCAMERA_OK) {
@@ -409,6 +570,7 @@ void DCameraSoftbusAdapter::OnSinkSessionClosed(int32_t sessionId)
     int32_t ret = DCameraSoftbusGetSessionById(sessionId, session);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSoftbusAdapter OnSinkSessionClosed not find session %d", sessionId);
+        DropPooledSession(sessionId);
         return;
     }
     {
@@ -455,6 +617,9 @@ void DCameraSoftbusAdapter::OnSinkStreamReceived(int32_t sessionId, const Stream
         DHLOGE("DCameraSoftbusAdapter OnSinkStreamReceived dataLen: %d sessionId: %d", dataLen, sessionId);
         return;
     }
+    if (ClaimPooledSession(sessionId)) {
+        return;
+    }
     std::shared_ptr<DCameraSoftbusSession> session = nullptr;
     int32_t ret = DCameraSoftbusSinkGetSession(sessionId, session);
     if (ret != DCAMERA_OK) {
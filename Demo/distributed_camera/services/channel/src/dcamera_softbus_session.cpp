@@ -18,6 +18,7 @@
 #include <securec.h>
 
 #include "anonymous_string.h"
+#include "dcamera_memory_budget.h"
 #include "dcamera_softbus_adapter.h"
 #include "distributed_camera_constants.h"
 #include "distributed_camera_errno.h"
@@ -41,29 +42,45 @@ DCameraSoftbusSession::DCameraSoftbusSession(std::string myDevId, std::string my
     sendFuncMap_[DCAMERA_SESSION_MODE_CTRL] = &DCameraSoftbusSession::SendBytes;
     sendFuncMap_[DCAMERA_SESSION_MODE_VIDEO] = &DCameraSoftbusSession::SendStream;
     sendFuncMap_[DCAMERA_SESSION_MODE_JPEG] = &DCameraSoftbusSession::SendStream;
-    auto runner = AppExecFwk::EventRunner::Create(mySessionName);
-    eventHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    DCameraTaskTier tier = (mode == DCAMERA_SESSION_MODE_CTRL) ? DCAMERA_TASK_TIER_CONTROL : DCAMERA_TASK_TIER_FRAME;
+    recvQueue_ = DCameraExecutor::GetInstance().CreateSerialQueue(mySessionName, tier);
     ResetAssembleFrag();
 }
 
 DCameraSoftbusSession::~DCameraSoftbusSession()
 {
     if (sessionId_ != -1) {
-        int32_t ret = DCameraSoftbusAdapter::GetInstance().CloseSoftbusSession(sessionId_);
+        int32_t ret = DCameraSoftbusAdapter::GetInstance().ParkSoftbusSession(sessionId_, mySessionName_,
+            peerSessionName_, mode_, peerDevId_);
         if (ret != DCAMERA_OK) {
             DHLOGE("DCameraSoftbusSession delete failed, ret: %d, sessId: %d peerDevId: %s peerSessionName: %s", ret,
                 sessionId_, GetAnonyString(peerDevId_).c_str(), GetAnonyString(peerSessionName_).c_str());
         }
     }
     sendFuncMap_.clear();
-    eventHandler_ = nullptr;
+    if (recvQueue_ != nullptr) {
+        recvQueue_->Close();
+        recvQueue_ = nullptr;
+    }
+    ResetAssembleFrag();
 }
 
 int32_t DCameraSoftbusSession::OpenSession()
 {
     DHLOGI("DCameraSoftbusSession OpenSession peerDevId: %s peerSessionName: %s",
         GetAnonyString(peerDevId_).c_str(), GetAnonyString(peerSessionName_).c_str());
-    int32_t ret = DCameraSoftbusAdapter::GetInstance().OpenSoftbusSession(mySessionName_, peerSessionName_, mode_,
+    int32_t sessionId = -1;
+    int32_t ret = DCameraSoftbusAdapter::GetInstance().AcquireSoftbusSession(mySessionName_, peerSessionName_, mode_,
+        peerDevId_, sessionId);
+    if (ret == DCAMERA_OK) {
+        ret = DCameraSoftbusAdapter::GetInstance().ConfirmSoftbusSession(sessionId);
+    }
+    if (ret == DCAMERA_OK) {
+        listener_->OnSessionState(DCAMERA_CHANNEL_STATE_CONNECTING);
+        return DCameraSoftbusAdapter::GetInstance().OnSourceSessionOpened(sessionId, DCAMERA_OK);
+    }
+
+    ret = DCameraSoftbusAdapter::GetInstance().OpenSoftbusSession(mySessionName_, peerSessionName_, mode_,
         peerDevId_);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSoftbusSession OpenSession failed, ret: %d, peerDevId: %s peerSessionName: %s", ret,
@@ -84,7 +101,8 @@ int32_t DCameraSoftbusSession::CloseSession()
             GetAnonyString(peerDevId_).c_str(), GetAnonyString(peerSessionName_).c_str());
         return DCAMERA_OK;
     }
-    int32_t ret = DCameraSoftbusAdapter::GetInstance().CloseSoftbusSession(sessionId_);
+    int32_t ret = DCameraSoftbusAdapter::GetInstance().ParkSoftbusSession(sessionId_, mySessionName_,
+        peerSessionName_, mode_, peerDevId_);
     if (ret != DCAMERA_OK) {
         DHLOGE("DCameraSoftbusSession CloseSession failed, ret: %d, peerDevId: %s peerSessionName: %s", ret,
             GetAnonyString(peerDevId_).c_str(), GetAnonyString(peerSessionName_).c_str());
@@ -130,8 +148,8 @@ int32_t DCameraSoftbusSession::OnDataReceived(std::shared_ptr<DataBuffer>& buffe
     auto recvDataFunc = [this, buffer]() mutable {
         DealRecvData(buffer);
     };
-    if (eventHandler_ != nullptr) {
-        eventHandler_->PostTask(recvDataFunc);
+    if (recvQueue_ != nullptr) {
+        recvQueue_->PostTask(recvDataFunc);
     }
     return DCAMERA_OK;
 }
@@ -187,18 +205,30 @@ void DCameraSoftbusSession::AssembleNoFrag(std::shared_ptr<DataBuffer>& buffer,
             ret, mySessionName_.c_str(), peerSessionName_.c_str());
         return;
     }
+    SetFrameType(postData, headerPara);
     PostData(postData);
 }
 
 void DCameraSoftbusSession::AssembleFrag(std::shared_ptr<DataBuffer>& buffer, SessionDataHeader& headerPara)
 {
     if (headerPara.fragFlag == FRAG_START) {
+        ResetAssembleFrag();
+        // a picture the source has no room for is refused before its reassembly buffer is allocated
+        if (!DCameraMemoryBudget::GetInstance().Acquire(budgetKey_, DCAMERA_MEMORY_STAGE_ASSEMBLE,
+            headerPara.totalLen)) {
+            DHLOGI("DCameraSoftbusSession AssembleFrag drop seq: %d over memory budget, sess: %s peerSess: %s",
+                headerPara.seqNum, mySessionName_.c_str(), peerSessionName_.c_str());
+            DCameraMemoryBudget::GetInstance().OnFrameDropped(budgetKey_);
+            return;
+        }
+        chargedBytes_ = headerPara.totalLen;
         isWaiting_ = true;
         nowSeq_ = headerPara.seqNum;
         nowSubSeq_ = headerPara.subSeq;
         offset_ = 0;
         totalLen_ = headerPara.totalLen;
         packBuffer_ = std::make_shared<DataBuffer>(headerPara.totalLen);
+        SetFrameType(packBuffer_, headerPara);
         int32_t ret = memcpy_s(packBuffer_->Data(), packBuffer_->Size(), buffer->Data() + BINARY_HEADER_FRAG_LEN,
             buffer->Size() - BINARY_HEADER_FRAG_LEN);
         if (ret != EOK) {
@@ -263,6 +293,11 @@ int32_t DCameraSoftbusSession::CheckUnPackBuffer(SessionDataHeader& headerPara)
     return DCAMERA_OK;
 }
 
+void DCameraSoftbusSession::SetBudgetKey(const std::string& budgetKey)
+{
+    budgetKey_ = budgetKey;
+}
+
 void DCameraSoftbusSession::ResetAssembleFrag()
 {
     isWaiting_ = false;
@@ -271,6 +306,18 @@ void DCameraSoftbusSession::ResetAssembleFrag()
     offset_ = 0;
     totalLen_ = 0;
     packBuffer_ = nullptr;
+    if (chargedBytes_ != 0) {
+        DCameraMemoryBudget::GetInstance().Release(budgetKey_, DCAMERA_MEMORY_STAGE_ASSEMBLE, chargedBytes_);
+        chargedBytes_ = 0;
+    }
+}
+
+void DCameraSoftbusSession::SetFrameType(std::shared_ptr<DataBuffer>& buffer, const SessionDataHeader& headerPara)
+{
+    int32_t frameType = static_cast<int32_t>(headerPara.dataType >> BINARY_DATA_TYPE_FRAME_SHIFT);
+    if (frameType != DCAMERA_FRAME_TYPE_FULL) {
+        buffer->SetInt32("frameType", frameType);
+    }
 }
 
 void DCameraSoftbusSession::PostData(std::shared_ptr<DataBuffer>& buffer)
@@ -320,7 +367,11 @@ int32_t DCameraSoftbusSession::UnPackSendData(std::shared_ptr<DataBuffer>& buffe
     uint16_t subSeq = 0;
     uint32_t seq = 0;
     uint32_t totalLen = buffer->Size();
-    SessionDataHeader headPara = { PROTOCOL_VERSION, FRAG_START, mode_, seq, totalLen, subSeq };
+    // the frame type rides in the upper half of the data type, which older peers never look at
+    int32_t frameType = DCAMERA_FRAME_TYPE_FULL;
+    buffer->FindInt32("frameType", frameType);
+    uint32_t dataType = (static_cast<uint32_t>(frameType) << BINARY_DATA_TYPE_FRAME_SHIFT) | mode_;
+    SessionDataHeader headPara = { PROTOCOL_VERSION, FRAG_START, dataType, seq, totalLen, subSeq };
 
     if (buffer->Size() <= BINARY_DATA_PACKET_MAX_LEN) {
         headPara.fragFlag = FRAG_START_END;
@@ -337,6 +388,10 @@ int32_t DCameraSoftbusSession::UnPackSendData(std::shared_ptr<DataBuffer>& buffe
         return (this->*memberFunc)(unpackData);
     }
 
+    // every fragment is built in the same scratch chunk straight from the source buffer, which softbus copies
+    // out before the send returns, so a large picture never costs more than one chunk on top of itself
+    std::shared_ptr<DataBuffer> unpackData =
+        std::make_shared<DataBuffer>(BINARY_DATA_PACKET_MAX_LEN + BINARY_HEADER_FRAG_LEN);
     uint32_t offset = 0;
     while (totalLen > offset) {
         if (totalLen - offset > BINARY_DATA_PACKET_MAX_LEN) {
@@ -346,8 +401,7 @@ int32_t DCameraSoftbusSession::UnPackSendData(std::shared_ptr<DataBuffer>& buffe
             headPara.dataLen = totalLen - offset;
         }
 
-        std::shared_ptr<DataBuffer> unpackData =
-            std::make_shared<DataBuffer>(headPara.dataLen + BINARY_HEADER_FRAG_LEN);
+        unpackData->SetRange(0, headPara.dataLen + BINARY_HEADER_FRAG_LEN);
         MakeFragDataHeader(headPara, unpackData->Data(), BINARY_HEADER_FRAG_LEN);
         int ret = memcpy_s(unpackData->Data() + BINARY_HEADER_FRAG_LEN, unpackData->Size() - BINARY_HEADER_FRAG_LEN,
             buffer->Data() + offset, headPara.dataLen);
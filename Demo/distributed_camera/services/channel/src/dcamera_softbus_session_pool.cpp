@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dcamera_softbus_session_pool.h"
+
+#include <algorithm>
+
+#include "dcamera_thread_policy.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+#include "distributed_hardware_log.h"
+
+namespace OHOS {
+namespace DistributedHardware {
+DCameraSoftbusSessionPool::DCameraSoftbusSessionPool(const DCameraPooledSessionChecker& checker,
+    const DCameraPooledSessionCloser& closer, uint32_t idleTimeoutMs)
+    : checker_(checker), closer_(closer), idleTimeoutMs_(idleTimeoutMs)
+{
+}
+
+DCameraSoftbusSessionPool::~DCameraSoftbusSessionPool()
+{
+    {
+        std::lock_guard<std::mutex> autoLock(poolLock_);
+        isStop_ = true;
+    }
+    timerCond_.notify_all();
+    if (timerThread_.joinable()) {
+        timerThread_.join();
+    }
+}
+
+int32_t DCameraSoftbusSessionPool::Park(const std::string& key, const std::string& serverName, int32_t sessionId)
+{
+    if (sessionId < 0) {
+        return DCAMERA_BAD_VALUE;
+    }
+
+    std::vector<PooledSession> closeSessions;
+    {
+        std::lock_guard<std::mutex> autoLock(poolLock_);
+        if (idleTimeoutMs_ == 0) {
+            return DCAMERA_DISABLE_PROCESS;
+        }
+        auto iter = sessions_.find(key);
+        if (iter != sessions_.end()) {
+            closeSessions.push_back(iter->second);
+            EraseLocked(iter);
+        }
+        while (sessions_.size() >= DCAMERA_SESSION_POOL_MAX_NUM) {
+            auto oldest = sessions_.begin();
+            for (auto entry = sessions_.begin(); entry != sessions_.end(); entry++) {
+                if (entry->second.deadline < oldest->second.deadline) {
+                    oldest = entry;
+                }
+            }
+            DHLOGI("DCameraSoftbusSessionPool evict sessionId: %d for capacity", oldest->second.sessionId);
+            closeSessions.push_back(oldest->second);
+            EraseLocked(oldest);
+        }
+        PooledSession session = { sessionId, serverName, std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(idleTimeoutMs_) };
+        sessions_[key] = session;
+        sessionKeys_[sessionId] = key;
+        StartTimerLocked();
+        DHLOGI("DCameraSoftbusSessionPool park sessionId: %d server: %s idle: %d", sessionId, serverName.c_str(),
+            static_cast<int32_t>(sessions_.size()));
+    }
+    Close(closeSessions);
+    return DCAMERA_OK;
+}
+
+int32_t DCameraSoftbusSessionPool::Acquire(const std::string& key, int32_t& sessionId)
+{
+    PooledSession session;
+    {
+        std::lock_guard<std::mutex> autoLock(poolLock_);
+        auto iter = sessions_.find(key);
+        if (iter == sessions_.end()) {
+            return DCAMERA_NOT_FOUND;
+        }
+        session = iter->second;
+        EraseLocked(iter);
+    }
+
+    // the peer may have dropped the link without the close callback reaching us yet
+    if (checker_ != nullptr && !checker_(session.sessionId)) {
+        DHLOGI("DCameraSoftbusSessionPool sessionId: %d failed health check", session.sessionId);
+        std::vector<PooledSession> closeSessions = { session };
+        Close(closeSessions);
+        return DCAMERA_NOT_FOUND;
+    }
+    DHLOGI("DCameraSoftbusSessionPool reuse sessionId: %d server: %s", session.sessionId, session.serverName.c_str());
+    sessionId = session.sessionId;
+    return DCAMERA_OK;
+}
+
+bool DCameraSoftbusSessionPool::Drop(int32_t sessionId, std::string& serverName)
+{
+    // called for every frame received on the sink, so the session is found through its id, not by a scan
+    std::lock_guard<std::mutex> autoLock(poolLock_);
+    auto keyIter = sessionKeys_.find(sessionId);
+    if (keyIter == sessionKeys_.end()) {
+        return false;
+    }
+    auto iter = sessions_.find(keyIter->second);
+    if (iter == sessions_.end()) {
+        sessionKeys_.erase(keyIter);
+        return false;
+    }
+    DHLOGI("DCameraSoftbusSessionPool drop sessionId: %d", sessionId);
+    serverName = iter->second.serverName;
+    EraseLocked(iter);
+    return true;
+}
+
+void DCameraSoftbusSessionPool::Clear()
+{
+    std::vector<PooledSession> closeSessions;
+    {
+        std::lock_guard<std::mutex> autoLock(poolLock_);
+        for (auto& entry : sessions_) {
+            closeSessions.push_back(entry.second);
+        }
+        sessions_.clear();
+        sessionKeys_.clear();
+    }
+    Close(closeSessions);
+}
+
+uint32_t DCameraSoftbusSessionPool::GetIdleCount()
+{
+    std::lock_guard<std::mutex> autoLock(poolLock_);
+    return static_cast<uint32_t>(sessions_.size());
+}
+
+void DCameraSoftbusSessionPool::SetIdleTimeout(uint32_t idleTimeoutMs)
+{
+    std::lock_guard<std::mutex> autoLock(poolLock_);
+    idleTimeoutMs_ = idleTimeoutMs;
+}
+
+std::string DCameraSoftbusSessionPool::MakeKey(const std::string& mySessName, const std::string& peerSessName,
+    int32_t sessionMode, const std::string& peerDevId)
+{
+    return peerDevId + "#" + mySessName + "#" + peerSessName + "#" + std::to_string(sessionMode);
+}
+
+std::map<std::string, DCameraSoftbusSessionPool::PooledSession>::iterator DCameraSoftbusSessionPool::EraseLocked(
+    std::map<std::string, PooledSession>::iterator iter)
+{
+    sessionKeys_.erase(iter->second.sessionId);
+    return sessions_.erase(iter);
+}
+
+void DCameraSoftbusSessionPool::StartTimerLocked()
+{
+    if (isTimerRunning_) {
+        timerCond_.notify_one();
+        return;
+    }
+    // a previous timer thread that ran out of sessions has already left its loop
+    if (timerThread_.joinable()) {
+        timerThread_.join();
+    }
+    isTimerRunning_ = true;
+    timerThread_ = std::thread(&DCameraSoftbusSessionPool::TimerLoop, this);
+}
+
+void DCameraSoftbusSessionPool::TimerLoop()
+{
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamSessPool", DCAMERA_TASK_TIER_BACKGROUND);
+    std::unique_lock<std::mutex> lock(poolLock_);
+    while (!isStop_ && !sessions_.empty()) {
+        auto nextDeadline = sessions_.begin()->second.deadline;
+        for (auto& entry : sessions_) {
+            nextDeadline = std::min(nextDeadline, entry.second.deadline);
+        }
+        timerCond_.wait_until(lock, nextDeadline);
+
+        std::vector<PooledSession> closeSessions;
+        auto now = std::chrono::steady_clock::now();
+        for (auto iter = sessions_.begin(); iter != sessions_.end();) {
+            if (iter->second.deadline > now) {
+                iter++;
+                continue;
+            }
+            DHLOGI("DCameraSoftbusSessionPool evict sessionId: %d for idle timeout", iter->second.sessionId);
+            closeSessions.push_back(iter->second);
+            iter = EraseLocked(iter);
+        }
+        lock.unlock();
+        Close(closeSessions);
+        lock.lock();
+    }
+    isTimerRunning_ = false;
+}
+
+void DCameraSoftbusSessionPool::Close(std::vector<PooledSession>& sessions)
+{
+    if (closer_ == nullptr) {
+        return;
+    }
+    for (auto& session : sessions) {
+        closer_(session.sessionId, session.serverName);
+    }
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <securec.h>
+
+#include "session.h"
+#include "softbus_bus_center.h"
+
+#include "dcamera_channel_sink_impl.h"
+#include "dcamera_channel_source_impl.h"
+#include "dcamera_softbus_adapter.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace {
+const uint8_t TEST_REUSE_NOTICE = 1;
+const uint8_t TEST_REUSE_ACK = 2;
+
+// Stands in for softbus on this device: every session id remembers both ends, and a session whose peer
+// copy is gone still answers local queries but fails to send, the same way a real link does until its
+// close callback arrives. A live peer answers a reuse notice with an ack, unless it is muted.
+class FakeSoftbus {
+public:
+    struct FakeSession {
+        std::string mySessionName;
+        std::string peerSessionName;
+        std::string peerDevId;
+        bool isPeerAlive;
+        bool isPeerAcking;
+    };
+
+    int32_t AddSession(const std::string& mySessionName, const std::string& peerSessionName,
+        const std::string& peerDevId)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        int32_t sessionId = nextSessionId_++;
+        sessions_[sessionId] = { mySessionName, peerSessionName, peerDevId, true, true };
+        return sessionId;
+    }
+
+    bool GetSession(int32_t sessionId, FakeSession& session)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        auto iter = sessions_.find(sessionId);
+        if (iter == sessions_.end()) {
+            return false;
+        }
+        session = iter->second;
+        return true;
+    }
+
+    void EvictPeer(int32_t sessionId)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        auto iter = sessions_.find(sessionId);
+        if (iter != sessions_.end()) {
+            iter->second.isPeerAlive = false;
+        }
+    }
+
+    // the peer evicted its copy after the send went out, so the send still succeeds but nothing answers
+    void MuteAck(int32_t sessionId)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        auto iter = sessions_.find(sessionId);
+        if (iter != sessions_.end()) {
+            iter->second.isPeerAcking = false;
+        }
+    }
+
+    bool IsPeerAcking(int32_t sessionId)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        auto iter = sessions_.find(sessionId);
+        return iter != sessions_.end() && iter->second.isPeerAcking;
+    }
+
+    void Close(int32_t sessionId)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        sessions_.erase(sessionId);
+    }
+
+    bool IsOpened(int32_t sessionId)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return sessions_.find(sessionId) != sessions_.end();
+    }
+
+    int32_t Send(int32_t sessionId, uint32_t len)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        auto iter = sessions_.find(sessionId);
+        if (iter == sessions_.end() || !iter->second.isPeerAlive) {
+            return -1;
+        }
+        sent_.push_back({ sessionId, len });
+        return 0;
+    }
+
+    std::vector<std::pair<int32_t, uint32_t>> GetSent()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return sent_;
+    }
+
+    int32_t Open(const std::string& mySessionName, const std::string& peerSessionName,
+        const std::string& peerDevId)
+    {
+        int32_t sessionId = AddSession(mySessionName, peerSessionName, peerDevId);
+        std::lock_guard<std::mutex> autoLock(lock_);
+        openTimes_++;
+        lastOpenId_ = sessionId;
+        return sessionId;
+    }
+
+    int32_t GetLastOpenId()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return lastOpenId_;
+    }
+
+    int32_t GetOpenTimes()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return openTimes_;
+    }
+
+    void Reset()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        sessions_.clear();
+        sent_.clear();
+        openTimes_ = 0;
+        lastOpenId_ = -1;
+    }
+
+private:
+    std::mutex lock_;
+    std::map<int32_t, FakeSession> sessions_;
+    std::vector<std::pair<int32_t, uint32_t>> sent_;
+    int32_t nextSessionId_ = 1;
+    int32_t openTimes_ = 0;
+    int32_t lastOpenId_ = -1;
+};
+
+FakeSoftbus g_softbus;
+const char TEST_LOCAL_NETWORK_ID[] = "a4b2c6e5f3d7481d9d4a6e2b7c9f1e30";
+
+int CopyName(const std::string& name, char *buf, unsigned int len)
+{
+    if (buf == nullptr || memcpy_s(buf, len, name.c_str(), name.size() + 1) != EOK) {
+        return -1;
+    }
+    return 0;
+}
+}
+
+// the channel library calls softbus through these symbols, so the test binary answers in its place
+int CreateSessionServer(const char *pkgName, const char *sessionName, const ISessionListener *listener)
+{
+    return 0;
+}
+
+int RemoveSessionServer(const char *pkgName, const char *sessionName)
+{
+    return 0;
+}
+
+int OpenSession(const char *mySessionName, const char *peerSessionName, const char *peerDeviceId,
+    const char *groupId, const SessionAttribute *attr)
+{
+    return g_softbus.Open(mySessionName, peerSessionName, peerDeviceId);
+}
+
+void CloseSession(int sessionId)
+{
+    g_softbus.Close(sessionId);
+}
+
+int SendBytes(int sessionId, const void *data, unsigned int len)
+{
+    return g_softbus.Send(sessionId, len);
+}
+
+int SendStream(int sessionId, const StreamData *data, const StreamData *ext, const StreamFrameInfo *param)
+{
+    int ret = g_softbus.Send(sessionId, static_cast<uint32_t>(data->bufLen));
+    if (ret != 0 || data->bufLen != sizeof(uint8_t) || static_cast<uint8_t>(data->buf[0]) != TEST_REUSE_NOTICE ||
+        !g_softbus.IsPeerAcking(sessionId)) {
+        return ret;
+    }
+    uint8_t ack = TEST_REUSE_ACK;
+    StreamData ackData = { reinterpret_cast<char *>(&ack), sizeof(ack) };
+    StreamData ackExt = { 0 };
+    StreamFrameInfo ackParam = { 0 };
+    OHOS::DistributedHardware::DCameraSoftbusAdapter::GetInstance().OnSourceStreamReceived(sessionId, &ackData,
+        &ackExt, &ackParam);
+    return ret;
+}
+
+int GetMySessionName(int sessionId, char *sessionName, unsigned int len)
+{
+    FakeSoftbus::FakeSession session;
+    return g_softbus.GetSession(sessionId, session) ? CopyName(session.mySessionName, sessionName, len) : -1;
+}
+
+int GetPeerSessionName(int sessionId, char *sessionName, unsigned int len)
+{
+    FakeSoftbus::FakeSession session;
+    return g_softbus.GetSession(sessionId, session) ? CopyName(session.peerSessionName, sessionName, len) : -1;
+}
+
+int GetPeerDeviceId(int sessionId, char *devId, unsigned int len)
+{
+    FakeSoftbus::FakeSession session;
+    return g_softbus.GetSession(sessionId, session) ? CopyName(session.peerDevId, devId, len) : -1;
+}
+
+int32_t GetLocalNodeDeviceInfo(const char *pkgName, NodeBasicInfo *info)
+{
+    return CopyName(TEST_LOCAL_NETWORK_ID, info->networkId, sizeof(info->networkId));
+}
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraSoftbusAdapterTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const std::string TEST_SESSION_HEAD = "ohos.dhardware.dcamera_";
+const std::string TEST_SESSION_FLAG = "dataContinue";
+const std::string TEST_PEER_DEV_ID = "bb536a637105409e904d4da83790a4a7";
+const std::string TEST_CAMERA_DH_ID = "camera_0";
+const std::string TEST_SINK_SESSION_NAME = TEST_SESSION_HEAD + TEST_CAMERA_DH_ID + "_" + TEST_SESSION_FLAG;
+const std::string TEST_SOURCE_SESSION_NAME = TEST_SESSION_HEAD + TEST_SESSION_FLAG;
+const uint32_t TEST_FRAME_LEN = 64;
+
+class TestChannelListener : public ICameraChannelListener {
+public:
+    void OnSessionState(int32_t state) override
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        states_.push_back(state);
+    }
+
+    void OnSessionError(int32_t eventType, int32_t eventReason, std::string detail) override
+    {
+    }
+
+    void OnDataReceived(std::vector<std::shared_ptr<DataBuffer>>& buffers) override
+    {
+    }
+
+    int32_t GetStateTimes(int32_t state)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        int32_t times = 0;
+        for (auto item : states_) {
+            times += (item == state) ? 1 : 0;
+        }
+        return times;
+    }
+
+private:
+    std::mutex lock_;
+    std::vector<int32_t> states_;
+};
+
+std::shared_ptr<ICameraChannel> CreateSinkChannel(std::shared_ptr<ICameraChannelListener> listener)
+{
+    std::shared_ptr<ICameraChannel> channel = std::make_shared<DCameraChannelSinkImpl>();
+    std::vector<DCameraIndex> indexs = { DCameraIndex(TEST_PEER_DEV_ID, TEST_CAMERA_DH_ID) };
+    EXPECT_EQ(DCAMERA_OK, channel->CreateSession(indexs, TEST_SESSION_FLAG, DCAMERA_SESSION_MODE_VIDEO, listener));
+    return channel;
+}
+
+// the source opening a session to us, as the softbus open callback delivers it
+int32_t OpenFromSource()
+{
+    int32_t sessionId = g_softbus.AddSession(TEST_SINK_SESSION_NAME, TEST_SOURCE_SESSION_NAME, TEST_PEER_DEV_ID);
+    DCameraSoftbusAdapter::GetInstance().OnSinkSessionOpened(sessionId, DCAMERA_OK);
+    return sessionId;
+}
+
+void NotifyReuseFromSource(int32_t sessionId)
+{
+    uint8_t notice = TEST_REUSE_NOTICE;
+    StreamData data = { reinterpret_cast<char *>(&notice), sizeof(notice) };
+    StreamData ext = { 0 };
+    StreamFrameInfo param = { 0 };
+    DCameraSoftbusAdapter::GetInstance().OnSinkStreamReceived(sessionId, &data, &ext, &param);
+}
+
+bool IsSentOn(int32_t sessionId, uint32_t len)
+{
+    for (auto& item : g_softbus.GetSent()) {
+        if (item.first == sessionId && item.second == len) {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+void DCameraSoftbusAdapterTest::SetUpTestCase(void)
+{
+}
+
+void DCameraSoftbusAdapterTest::TearDownTestCase(void)
+{
+}
+
+void DCameraSoftbusAdapterTest::SetUp(void)
+{
+    g_softbus.Reset();
+}
+
+void DCameraSoftbusAdapterTest::TearDown(void)
+{
+    DCameraSoftbusAdapter::GetInstance().SetSessionIdleTimeout(0);
+    DCameraSoftbusAdapter::GetInstance().SetSessionIdleTimeout(DCAMERA_SESSION_POOL_IDLE_TIMEOUT_MS);
+}
+
+/**
+ * @tc.name: dcamera_softbus_adapter_test_001
+ * @tc.desc: Verify a released sink channel parks its stream session and reports it open again only after
+ *           the source confirms the reuse on it.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSoftbusAdapterTest, dcamera_softbus_adapter_test_001, TestSize.Level1)
+{
+    std::shared_ptr<TestChannelListener> listener = std::make_shared<TestChannelListener>();
+    std::shared_ptr<ICameraChannel> channel = CreateSinkChannel(listener);
+    int32_t sessionId = OpenFromSource();
+    EXPECT_EQ(1, listener->GetStateTimes(DCAMERA_CHANNEL_STATE_CONNECTED));
+    EXPECT_EQ(DCAMERA_OK, channel->ReleaseSession());
+    EXPECT_TRUE(g_softbus.IsOpened(sessionId));
+
+    std::shared_ptr<TestChannelListener> reopenListener = std::make_shared<TestChannelListener>();
+    std::shared_ptr<ICameraChannel> reopenChannel = CreateSinkChannel(reopenListener);
+    EXPECT_EQ(0, reopenListener->GetStateTimes(DCAMERA_CHANNEL_STATE_CONNECTED));
+
+    NotifyReuseFromSource(sessionId);
+    EXPECT_EQ(1, reopenListener->GetStateTimes(DCAMERA_CHANNEL_STATE_CONNECTED));
+    EXPECT_TRUE(IsSentOn(sessionId, sizeof(TEST_REUSE_ACK)));
+    std::shared_ptr<DataBuffer> frame = std::make_shared<DataBuffer>(TEST_FRAME_LEN);
+    EXPECT_EQ(DCAMERA_OK, reopenChannel->SendData(frame));
+    EXPECT_TRUE(IsSentOn(sessionId, TEST_FRAME_LEN));
+    EXPECT_EQ(DCAMERA_OK, reopenChannel->ReleaseSession());
+}
+
+/**
+ * @tc.name: dcamera_softbus_adapter_test_002
+ * @tc.desc: Verify a sink channel reopened after the source evicted its copy is not reported open on the
+ *           parked session, takes the fresh one, and is not torn down when the stale close arrives late.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSoftbusAdapterTest, dcamera_softbus_adapter_test_002, TestSize.Level1)
+{
+    std::shared_ptr<TestChannelListener> listener = std::make_shared<TestChannelListener>();
+    std::shared_ptr<ICameraChannel> channel = CreateSinkChannel(listener);
+    int32_t staleId = OpenFromSource();
+    EXPECT_EQ(DCAMERA_OK, channel->ReleaseSession());
+    // the source has evicted its copy, but the close callback has not reached us yet
+    g_softbus.EvictPeer(staleId);
+
+    std::shared_ptr<TestChannelListener> reopenListener = std::make_shared<TestChannelListener>();
+    std::shared_ptr<ICameraChannel> reopenChannel = CreateSinkChannel(reopenListener);
+    EXPECT_EQ(0, reopenListener->GetStateTimes(DCAMERA_CHANNEL_STATE_CONNECTED));
+
+    int32_t freshId = OpenFromSource();
+    EXPECT_NE(staleId, freshId);
+    EXPECT_EQ(1, reopenListener->GetStateTimes(DCAMERA_CHANNEL_STATE_CONNECTED));
+    g_softbus.Close(staleId);
+    DCameraSoftbusAdapter::GetInstance().OnSinkSessionClosed(staleId);
+    EXPECT_EQ(0, reopenListener->GetStateTimes(DCAMERA_CHANNEL_STATE_DISCONNECTED));
+
+    std::shared_ptr<DataBuffer> frame = std::make_shared<DataBuffer>(TEST_FRAME_LEN);
+    EXPECT_EQ(DCAMERA_OK, reopenChannel->SendData(frame));
+    EXPECT_TRUE(IsSentOn(freshId, TEST_FRAME_LEN));
+    EXPECT_EQ(DCAMERA_OK, reopenChannel->ReleaseSession());
+}
+
+/**
+ * @tc.name: dcamera_softbus_adapter_test_003
+ * @tc.desc: Verify the source reuses its parked stream session only when the reuse notice reaches the sink,
+ *           and opens a fresh session when the sink has already evicted its copy.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSoftbusAdapterTest, dcamera_softbus_adapter_test_003, TestSize.Level1)
+{
+    std::shared_ptr<TestChannelListener> listener = std::make_shared<TestChannelListener>();
+    std::shared_ptr<ICameraChannelListener> channelListener = listener;
+    std::shared_ptr<ICameraChannel> channel = std::make_shared<DCameraChannelSourceImpl>();
+    std::vector<DCameraIndex> indexs = { DCameraIndex(TEST_PEER_DEV_ID, TEST_CAMERA_DH_ID) };
+    EXPECT_EQ(DCAMERA_OK, channel->CreateSession(indexs, TEST_SESSION_FLAG, DCAMERA_SESSION_MODE_VIDEO,
+        channelListener));
+
+    EXPECT_EQ(DCAMERA_OK, channel->OpenSession());
+    EXPECT_EQ(1, g_softbus.GetOpenTimes());
+    int32_t sessionId = g_softbus.GetLastOpenId();
+    EXPECT_EQ(DCAMERA_OK, DCameraSoftbusAdapter::GetInstance().OnSourceSessionOpened(sessionId, DCAMERA_OK));
+    EXPECT_EQ(DCAMERA_OK, channel->CloseSession());
+
+    EXPECT_EQ(DCAMERA_OK, channel->OpenSession());
+    EXPECT_EQ(1, g_softbus.GetOpenTimes());
+    EXPECT_TRUE(IsSentOn(sessionId, sizeof(uint8_t)));
+    EXPECT_EQ(2, listener->GetStateTimes(DCAMERA_CHANNEL_STATE_CONNECTED));
+    EXPECT_EQ(DCAMERA_OK, channel->CloseSession());
+
+    // the sink has evicted its copy, but the close callback has not reached us yet
+    g_softbus.EvictPeer(sessionId);
+    EXPECT_EQ(DCAMERA_OK, channel->OpenSession());
+    EXPECT_EQ(2, g_softbus.GetOpenTimes());
+    EXPECT_FALSE(g_softbus.IsOpened(sessionId));
+    EXPECT_EQ(2, listener->GetStateTimes(DCAMERA_CHANNEL_STATE_CONNECTED));
+    EXPECT_EQ(DCAMERA_OK, channel->ReleaseSession());
+}
+
+/**
+ * @tc.name: dcamera_softbus_adapter_test_004
+ * @tc.desc: Verify the source opens a fresh session when its reuse notice is sent but the sink never acks it.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSoftbusAdapterTest, dcamera_softbus_adapter_test_004, TestSize.Level1)
+{
+    std::shared_ptr<TestChannelListener> listener = std::make_shared<TestChannelListener>();
+    std::shared_ptr<ICameraChannelListener> channelListener = listener;
+    std::shared_ptr<ICameraChannel> channel = std::make_shared<DCameraChannelSourceImpl>();
+    std::vector<DCameraIndex> indexs = { DCameraIndex(TEST_PEER_DEV_ID, TEST_CAMERA_DH_ID) };
+    EXPECT_EQ(DCAMERA_OK, channel->CreateSession(indexs, TEST_SESSION_FLAG, DCAMERA_SESSION_MODE_VIDEO,
+        channelListener));
+
+    EXPECT_EQ(DCAMERA_OK, channel->OpenSession());
+    int32_t sessionId = g_softbus.GetLastOpenId();
+    EXPECT_EQ(DCAMERA_OK, DCameraSoftbusAdapter::GetInstance().OnSourceSessionOpened(sessionId, DCAMERA_OK));
+    EXPECT_EQ(DCAMERA_OK, channel->CloseSession());
+
+    g_softbus.MuteAck(sessionId);
+    EXPECT_EQ(DCAMERA_OK, channel->OpenSession());
+    EXPECT_TRUE(IsSentOn(sessionId, sizeof(TEST_REUSE_NOTICE)));
+    EXPECT_EQ(2, g_softbus.GetOpenTimes());
+    EXPECT_FALSE(g_softbus.IsOpened(sessionId));
+    EXPECT_EQ(1, listener->GetStateTimes(DCAMERA_CHANNEL_STATE_CONNECTED));
+    EXPECT_EQ(DCAMERA_OK, channel->ReleaseSession());
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include "dcamera_softbus_session_pool.h"
+#include "icamera_channel.h"
+#include "distributed_camera_constants.h"
+#include "distributed_camera_errno.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace DistributedHardware {
+class DCameraSoftbusSessionPoolTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+namespace {
+const std::string TEST_MY_SESSION_NAME = "DBinder.ohos.dhardware.dcamera.dataContinue";
+const std::string TEST_PEER_SESSION_NAME = "DBinder.ohos.dhardware.dcamera.camera_0_dataContinue";
+const std::string TEST_PEER_DEV_ID = "bb536a637105409e904d4da83790a4a7";
+const int32_t TEST_REOPEN_TIMES = 5;
+const uint32_t TEST_IDLE_TIMEOUT_MS = 100;
+const int32_t TEST_EVICT_WAIT_MS = 1000;
+
+// Stands in for softbus: opening a session hands out a new id, closing makes the id unusable.
+class StubSessionBackend {
+public:
+    int32_t Open()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        int32_t sessionId = nextSessionId_++;
+        aliveIds_.insert(sessionId);
+        openTimes_++;
+        return sessionId;
+    }
+
+    bool IsAlive(int32_t sessionId)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return aliveIds_.find(sessionId) != aliveIds_.end();
+    }
+
+    void Close(int32_t sessionId)
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        aliveIds_.erase(sessionId);
+        closeTimes_++;
+    }
+
+    int32_t GetCloseTimes()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return closeTimes_;
+    }
+
+    int32_t GetOpenTimes()
+    {
+        std::lock_guard<std::mutex> autoLock(lock_);
+        return openTimes_;
+    }
+
+private:
+    std::mutex lock_;
+    std::set<int32_t> aliveIds_;
+    int32_t nextSessionId_ = 1;
+    int32_t openTimes_ = 0;
+    int32_t closeTimes_ = 0;
+};
+
+std::shared_ptr<DCameraSoftbusSessionPool> CreatePool(std::shared_ptr<StubSessionBackend>& backend,
+    uint32_t idleTimeoutMs)
+{
+    return std::make_shared<DCameraSoftbusSessionPool>(
+        [backend](int32_t sessionId) { return backend->IsAlive(sessionId); },
+        [backend](int32_t sessionId, const std::string& serverName) { backend->Close(sessionId); },
+        idleTimeoutMs);
+}
+
+int32_t ReopenSession(std::shared_ptr<StubSessionBackend>& backend, std::shared_ptr<DCameraSoftbusSessionPool>& pool,
+    const std::string& key)
+{
+    int32_t sessionId = -1;
+    if (pool->Acquire(key, sessionId) == DCAMERA_OK) {
+        return sessionId;
+    }
+    return backend->Open();
+}
+}
+
+void DCameraSoftbusSessionPoolTest::SetUpTestCase(void)
+{
+}
+
+void DCameraSoftbusSessionPoolTest::TearDownTestCase(void)
+{
+}
+
+void DCameraSoftbusSessionPoolTest::SetUp(void)
+{
+}
+
+void DCameraSoftbusSessionPoolTest::TearDown(void)
+{
+}
+
+/**
+ * @tc.name: dcamera_softbus_session_pool_test_001
+ * @tc.desc: Verify reopening a pooled session hands back the parked link instead of opening a new one.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSoftbusSessionPoolTest, dcamera_softbus_session_pool_test_001, TestSize.Level1)
+{
+    std::shared_ptr<StubSessionBackend> backend = std::make_shared<StubSessionBackend>();
+    std::shared_ptr<DCameraSoftbusSessionPool> pool = CreatePool(backend, DCAMERA_SESSION_POOL_IDLE_TIMEOUT_MS);
+    std::string key = DCameraSoftbusSessionPool::MakeKey(TEST_MY_SESSION_NAME, TEST_PEER_SESSION_NAME,
+        DCAMERA_SESSION_MODE_VIDEO, TEST_PEER_DEV_ID);
+
+    int32_t sessionId = ReopenSession(backend, pool, key);
+    for (int32_t i = 0; i < TEST_REOPEN_TIMES; i++) {
+        EXPECT_EQ(DCAMERA_OK, pool->Park(key, TEST_MY_SESSION_NAME, sessionId));
+        EXPECT_EQ(sessionId, ReopenSession(backend, pool, key));
+    }
+    EXPECT_EQ(1, backend->GetOpenTimes());
+    EXPECT_EQ(0, backend->GetCloseTimes());
+    EXPECT_EQ(0, pool->GetIdleCount());
+}
+
+/**
+ * @tc.name: dcamera_softbus_session_pool_test_002
+ * @tc.desc: Verify a pooled session that fails the health check or is closed by the peer is not handed back.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSoftbusSessionPoolTest, dcamera_softbus_session_pool_test_002, TestSize.Level1)
+{
+    std::shared_ptr<StubSessionBackend> backend = std::make_shared<StubSessionBackend>();
+    std::shared_ptr<DCameraSoftbusSessionPool> pool = CreatePool(backend, DCAMERA_SESSION_POOL_IDLE_TIMEOUT_MS);
+    std::string key = DCameraSoftbusSessionPool::MakeKey(TEST_MY_SESSION_NAME, TEST_PEER_SESSION_NAME,
+        DCAMERA_SESSION_MODE_JPEG, TEST_PEER_DEV_ID);
+
+    int32_t sessionId = backend->Open();
+    EXPECT_EQ(DCAMERA_OK, pool->Park(key, TEST_MY_SESSION_NAME, sessionId));
+    backend->Close(sessionId);
+    int32_t reopenId = -1;
+    EXPECT_EQ(DCAMERA_NOT_FOUND, pool->Acquire(key, reopenId));
+
+    sessionId = backend->Open();
+    EXPECT_EQ(DCAMERA_OK, pool->Park(key, TEST_MY_SESSION_NAME, sessionId));
+    std::string serverName;
+    EXPECT_EQ(true, pool->Drop(sessionId, serverName));
+    EXPECT_EQ(TEST_MY_SESSION_NAME, serverName);
+    EXPECT_EQ(DCAMERA_NOT_FOUND, pool->Acquire(key, reopenId));
+}
+
+/**
+ * @tc.name: dcamera_softbus_session_pool_test_003
+ * @tc.desc: Verify an idle session is closed once the grace period runs out.
+ * @tc.type: FUNC
+ * @tc.require: AR000GK6MV
+ */
+HWTEST_F(DCameraSoftbusSessionPoolTest, dcamera_softbus_session_pool_test_003, TestSize.Level1)
+{
+    std::shared_ptr<StubSessionBackend> backend = std::make_shared<StubSessionBackend>();
+    std::shared_ptr<std::promise<int32_t>> closed = std::make_shared<std::promise<int32_t>>();
+    std::future<int32_t> closeResult = closed->get_future();
+    std::shared_ptr<DCameraSoftbusSessionPool> pool = std::make_shared<DCameraSoftbusSessionPool>(
+        [backend](int32_t sessionId) { return backend->IsAlive(sessionId); },
+        [backend, closed](int32_t sessionId, const std::string& serverName) {
+            backend->Close(sessionId);
+            closed->set_value(sessionId);
+        }, TEST_IDLE_TIMEOUT_MS);
+    std::string key = DCameraSoftbusSessionPool::MakeKey(TEST_MY_SESSION_NAME, TEST_PEER_SESSION_NAME,
+        DCAMERA_SESSION_MODE_VIDEO, TEST_PEER_DEV_ID);
+
+    int32_t sessionId = backend->Open();
+    EXPECT_EQ(DCAMERA_OK, pool->Park(key, TEST_MY_SESSION_NAME, sessionId));
+    EXPECT_EQ(1, pool->GetIdleCount());
+    EXPECT_EQ(std::future_status::ready, closeResult.wait_for(std::chrono::milliseconds(TEST_EVICT_WAIT_MS)));
+    EXPECT_EQ(sessionId, closeResult.get());
+    EXPECT_EQ(0, pool->GetIdleCount());
+    EXPECT_EQ(false, backend->IsAlive(sessionId));
+}
+} // namespace DistributedHardware
+} // namespace OHOS
@@ -54,11 +54,11 @@ private:
 
 private:
     const static std::string PIPELINE_OWNER;
-    const static uint32_t MAX_FRAME_RATE = 30;
+    const static uint32_t MAX_FRAME_RATE = 60;
     const static uint32_t MIN_VIDEO_WIDTH = 320;
     const static uint32_t MIN_VIDEO_HEIGHT = 240;
-    const static uint32_t MAX_VIDEO_WIDTH = 1920;
-    const static uint32_t MAX_VIDEO_HEIGHT = 1080;
+    const static uint32_t MAX_VIDEO_WIDTH = 3840;
+    const static uint32_t MAX_VIDEO_HEIGHT = 2160;
 
     std::shared_ptr<DataProcessListener> processListener_ = nullptr;
     std::shared_ptr<AbstractDataProcess> pipelineHead_ = nullptr;
@@ -46,7 +46,7 @@ private:
     int32_t FpsControllerDone(std::vector<std::shared_ptr<DataBuffer>> outputBuffers);
 
 private:
-    const static uint32_t MAX_TARGET_FRAME_RATE = 30;
+    const static uint32_t MAX_TARGET_FRAME_RATE = 60;
     const static int32_t VIDEO_FRAME_DROP_INTERVAL = 4;
     const static int32_t MIN_INCOME_FRAME_NUM_COEFFICIENT = 3;
     const static int32_t INCOME_FRAME_TIME_HISTORY_WINDOWS_SIZE = 60;
@@ -91,12 +91,15 @@ private:
 
 private:
     const static int32_t VIDEO_DECODER_QUEUE_MAX = 1000;
-    const static int32_t MAX_YUV420_BUFFER_SIZE = 1920 * 1080 * 3 / 2 * 2;
-    const static uint32_t MAX_FRAME_RATE = 30;
+    const static int32_t YUV420_SIZE_NUMERATOR = 3;
+    const static int32_t YUV420_SIZE_DENOMINATOR = 2;
+    const static int32_t RGBA_BYTES_PER_PIXEL = 4;
+    const static int32_t INPUT_BUFFER_SIZE_FACTOR = 2;
+    const static uint32_t MAX_FRAME_RATE = 60;
     const static uint32_t MIN_VIDEO_WIDTH = 320;
     const static uint32_t MIN_VIDEO_HEIGHT = 240;
-    const static uint32_t MAX_VIDEO_WIDTH = 1920;
-    const static uint32_t MAX_VIDEO_HEIGHT = 1080;
+    const static uint32_t MAX_VIDEO_WIDTH = 3840;
+    const static uint32_t MAX_VIDEO_HEIGHT = 2160;
     const static int32_t FIRST_FRAME_INPUT_NUM = 2;
 
     std::mutex mtxDecoderState_;
@@ -117,6 +120,7 @@ private:
     bool isDecoderProcess_ = false;
     int32_t waitDecoderOutputCount_ = 0;
     int32_t alignedHeight_ = 0;
+    int32_t maxInputBufferSize_ = 0;
     int64_t lastFeedDecoderInputBufferTimeUs_ = 0;
     int64_t outputTimeStampUs_ = 0;
     std::string processType_;
@@ -125,6 +129,9 @@ private:
     Media::AVCodecBufferInfo outputInfo_;
     std::queue<std::shared_ptr<DataBuffer>> inputBuffersQueue_;
     std::queue<uint32_t> availableInputIndexsQueue_;
+    std::string budgetKey_;
+    uint64_t inputQueuedBytes_ = 0;
+    std::queue<int64_t> feedTimeUsQueue_;
 };
 
 class DecodeSurfaceListener : public IBufferConsumerListener {
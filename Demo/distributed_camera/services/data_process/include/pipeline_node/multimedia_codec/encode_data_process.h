@@ -63,6 +63,7 @@ private:
     int32_t InitEncoder();
     int32_t InitEncoderMetadataFormat();
     int32_t InitEncoderBitrateFormat();
+    void UpdateEncoderBitrate(const std::shared_ptr<DataBuffer>& inputBuffer);
     int32_t FeedEncoderInputBuffer(std::shared_ptr<DataBuffer>& inputBuffer);
     sptr<SurfaceBuffer> GetEncoderInputSurfaceBuffer();
     int64_t GetEncoderTimeStamp();
@@ -71,12 +72,15 @@ private:
 
 private:
     const static int32_t ENCODER_STRIDE_ALIGNMENT = 8;
-    const static int64_t NORM_YUV420_BUFFER_SIZE = 1920 * 1080 * 3 / 2;
-    const static uint32_t MAX_FRAME_RATE = 30;
+    const static int64_t YUV420_SIZE_NUMERATOR = 3;
+    const static int64_t YUV420_SIZE_DENOMINATOR = 2;
+    const static int64_t RGBA_BYTES_PER_PIXEL = 4;
+    const static int64_t INPUT_BUFFER_SIZE_FACTOR = 2;
+    const static uint32_t MAX_FRAME_RATE = 60;
     const static uint32_t MIN_VIDEO_WIDTH = 320;
     const static uint32_t MIN_VIDEO_HEIGHT = 240;
-    const static uint32_t MAX_VIDEO_WIDTH = 1920;
-    const static uint32_t MAX_VIDEO_HEIGHT = 1080;
+    const static uint32_t MAX_VIDEO_WIDTH = 3840;
+    const static uint32_t MAX_VIDEO_HEIGHT = 2160;
     const static int32_t IDR_FRAME_INTERVAL_MS = 300;
     const static int32_t FIRST_FRAME_OUTPUT_NUM = 2;
 
@@ -90,6 +94,8 @@ private:
     const static int64_t WIDTH_1280_HEIGHT_720 = 1280 * 720;
     const static int64_t WIDTH_1440_HEIGHT_1080 = 1440 * 1080;
     const static int64_t WIDTH_1920_HEIGHT_1080 = 1920 * 1080;
+    const static int64_t WIDTH_2560_HEIGHT_1440 = 2560 * 1440;
+    const static int64_t WIDTH_3840_HEIGHT_2160 = 3840 * 2160;
     const static int32_t BITRATE_500000 = 500000;
     const static int32_t BITRATE_1110000 = 1110000;
     const static int32_t BITRATE_1500000 = 1500000;
@@ -100,6 +106,9 @@ private:
     const static int32_t BITRATE_3400000 = 3400000;
     const static int32_t BITRATE_5000000 = 5000000;
     const static int32_t BITRATE_6000000 = 6000000;
+    const static int32_t BITRATE_10000000 = 10000000;
+    const static int32_t BITRATE_16000000 = 16000000;
+    const static uint32_t NORM_FRAME_RATE = 30;
     const static std::map<std::int64_t, int32_t> ENCODER_BITRATE_TABLE;
 
     std::mutex mtxEncoderState_;
@@ -113,8 +122,11 @@ private:
 
     bool isEncoderProcess_ = false;
     int32_t waitEncoderOutputCount_ = 0;
+    int64_t maxInputBufferSize_ = 0;
     int64_t lastFeedEncoderInputBufferTimeUs_ = 0;
     int64_t inputTimeStampUs_ = 0;
+    int32_t encoderBitrate_ = 0;
+    int32_t bitratePercent_ = 0;
     std::string processType_;
     Media::Format metadataFormat_;
     Media::Format encodeOutputFormat_;
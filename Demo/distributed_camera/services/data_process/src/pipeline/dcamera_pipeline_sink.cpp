@@ -69,8 +69,8 @@ int32_t DCameraPipelineSink::CreateDataProcessPipeline(PipelineType piplineType,
 
 bool DCameraPipelineSink::IsInRange(const VideoConfigParams& curConfig)
 {
-    return (curConfig.GetFrameRate() <= MAX_FRAME_RATE || curConfig.GetWidth() >= MIN_VIDEO_WIDTH ||
-        curConfig.GetWidth() <= MAX_VIDEO_WIDTH || curConfig.GetHeight() >= MIN_VIDEO_HEIGHT ||
+    return (curConfig.GetFrameRate() <= MAX_FRAME_RATE && curConfig.GetWidth() >= MIN_VIDEO_WIDTH &&
+        curConfig.GetWidth() <= MAX_VIDEO_WIDTH && curConfig.GetHeight() >= MIN_VIDEO_HEIGHT &&
         curConfig.GetHeight() <= MAX_VIDEO_HEIGHT);
 }
 
@@ -17,6 +17,7 @@
 
 #include "distributed_hardware_log.h"
 
+#include "dcamera_thread_policy.h"
 #include "decode_data_process.h"
 #include "fps_controller_process.h"
 
@@ -72,8 +73,8 @@ int32_t DCameraPipelineSource::CreateDataProcessPipeline(PipelineType piplineTyp
 
 bool DCameraPipelineSource::IsInRange(const VideoConfigParams& curConfig)
 {
-    return (curConfig.GetFrameRate() <= MAX_FRAME_RATE || curConfig.GetWidth() >= MIN_VIDEO_WIDTH ||
-        curConfig.GetWidth() <= MAX_VIDEO_WIDTH || curConfig.GetHeight() >= MIN_VIDEO_HEIGHT ||
+    return (curConfig.GetFrameRate() <= MAX_FRAME_RATE && curConfig.GetWidth() >= MIN_VIDEO_WIDTH &&
+        curConfig.GetWidth() <= MAX_VIDEO_WIDTH && curConfig.GetHeight() >= MIN_VIDEO_HEIGHT &&
         curConfig.GetHeight() <= MAX_VIDEO_HEIGHT);
 }
 
@@ -174,6 +175,7 @@ void DCameraPipelineSource::DestroyDataProcessPipeline()
 
 void DCameraPipelineSource::OnEvent(DCameraPipelineEvent& ev)
 {
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamPipeSource", DCAMERA_TASK_TIER_FRAME);
     DHLOGD("Receive asynchronous event then start process data in source pipeline.");
     std::shared_ptr<PipelineConfig> pipelineConfig = ev.GetPipelineConfig();
     std::vector<std::shared_ptr<DataBuffer>> inputBuffers = pipelineConfig->GetDataBuffers();
@@ -19,6 +19,9 @@
 #include "graphic_common_c.h"
 
 #include "convert_nv12_to_nv21.h"
+#include "dcamera_degrade_controller.h"
+#include "dcamera_memory_budget.h"
+#include "dcamera_thread_policy.h"
 #include "dcamera_utils_tools.h"
 #include "decode_video_callback.h"
 
@@ -74,8 +77,8 @@ int32_t DecodeDataProcess::GetAlignedHeight()
 
 bool DecodeDataProcess::IsInDecoderRange(const VideoConfigParams& curConfig)
 {
-    return (curConfig.GetWidth() >= MIN_VIDEO_WIDTH || curConfig.GetWidth() <= MAX_VIDEO_WIDTH ||
-        curConfig.GetHeight() >= MIN_VIDEO_HEIGHT || curConfig.GetHeight() <= MAX_VIDEO_HEIGHT ||
+    return (curConfig.GetWidth() >= MIN_VIDEO_WIDTH && curConfig.GetWidth() <= MAX_VIDEO_WIDTH &&
+        curConfig.GetHeight() >= MIN_VIDEO_HEIGHT && curConfig.GetHeight() <= MAX_VIDEO_HEIGHT &&
         curConfig.GetFrameRate() <= MAX_FRAME_RATE);
 }
 
@@ -148,11 +151,12 @@ int32_t DecodeDataProcess::InitDecoderMetadataFormat()
     
     int32_t width = (int32_t)sourceConfig_.GetWidth();
     int32_t height = (int32_t)sourceConfig_.GetHeight();
+    maxInputBufferSize_ = width * height * RGBA_BYTES_PER_PIXEL * INPUT_BUFFER_SIZE_FACTOR;
     metadataFormat_.PutIntValue("pixel_format", Media::VideoPixelFormat::RGBA);
-    metadataFormat_.PutIntValue("max_input_size", width * height * 4 * 2);
+    metadataFormat_.PutIntValue("max_input_size", maxInputBufferSize_);
     metadataFormat_.PutIntValue("width", width);
     metadataFormat_.PutIntValue("height", height);
-    metadataFormat_.PutIntValue("frame_rate", MAX_FRAME_RATE);
+    metadataFormat_.PutIntValue("frame_rate", (int32_t)sourceConfig_.GetFrameRate());
     return DCAMERA_OK;
 }
 
@@ -238,8 +242,12 @@ void DecodeDataProcess::ReleaseProcessNode()
     processType_ = "";
     std::queue<std::shared_ptr<DataBuffer>> emptyBuffersQueue;
     inputBuffersQueue_.swap(emptyBuffersQueue);
+    DCameraMemoryBudget::GetInstance().Release(budgetKey_, DCAMERA_MEMORY_STAGE_DECODE, inputQueuedBytes_);
+    inputQueuedBytes_ = 0;
     std::queue<uint32_t> emptyIndexsQueue;
     availableInputIndexsQueue_.swap(emptyIndexsQueue);
+    std::queue<int64_t> emptyFeedTimeQueue;
+    feedTimeUsQueue_.swap(emptyFeedTimeQueue);
     waitDecoderOutputCount_ = 0;
     lastFeedDecoderInputBufferTimeUs_ = 0;
     outputTimeStampUs_ = 0;
@@ -268,8 +276,7 @@ int32_t DecodeDataProcess::ProcessData(std::vector<std::shared_ptr<DataBuffer>>&
         DHLOGE("video decoder input buffers queue over flow.");
         return DCAMERA_INDEX_OVERFLOW;
     }
-    int32_t bufferSize = 1920 * 1808 * 4 * 2;
-    if (inputBuffers[0]->Size() > bufferSize) {
+    if (inputBuffers[0]->Size() > (size_t)maxInputBufferSize_) {
         DHLOGE("DecodeNode input buffer size %d error.", inputBuffers[0]->Size());
         return DCAMERA_MEMORY_OPT_ERROR;
     }
@@ -277,6 +284,10 @@ int32_t DecodeDataProcess::ProcessData(std::vector<std::shared_ptr<DataBuffer>>&
         DHLOGE("Decoder node occurred error or start release.");
         return DCAMERA_DISABLE_PROCESS;
     }
+    // encoded frames are only accounted here, dropping one would corrupt every frame that refers to it
+    inputBuffers[0]->FindString("budgetKey", budgetKey_);
+    DCameraMemoryBudget::GetInstance().Charge(budgetKey_, DCAMERA_MEMORY_STAGE_DECODE, inputBuffers[0]->Size());
+    inputQueuedBytes_ += inputBuffers[0]->Size();
     inputBuffersQueue_.push(inputBuffers[0]);
     DHLOGD("Push inputBuffer sucess. BufSize %d, QueueSize %d.", inputBuffers[0]->Size(), inputBuffersQueue_.size());
     int32_t err = FeedDecoderInputBuffer();
@@ -337,11 +348,14 @@ int32_t DecodeDataProcess::FeedDecoderInputBuffer()
         }
 
         inputBuffersQueue_.pop();
+        DCameraMemoryBudget::GetInstance().Release(budgetKey_, DCAMERA_MEMORY_STAGE_DECODE, buffer->Size());
+        inputQueuedBytes_ -= buffer->Size();
         DHLOGD("Push inputBuffer sucess. inputBuffersQueue size is %d.", inputBuffersQueue_.size());
 
         {
             std::lock_guard<std::mutex> lck(mtxHoldCount_);
             availableInputIndexsQueue_.pop();
+            feedTimeUsQueue_.push(GetNowTimeStampUs());
             waitDecoderOutputCount_++;
             DHLOGD("Wait decoder output frames number is %d.", waitDecoderOutputCount_);
         }
@@ -384,6 +398,7 @@ void DecodeDataProcess::GetDecoderOutputBuffer(const sptr<Surface>& surface)
     CopyDecodedImage(surfaceBuffer, timeStampUs, alignedWidth, alignedHeight);
     surface->ReleaseBuffer(surfaceBuffer, -1);
     outputTimeStampUs_ = timeStampUs;
+    int64_t latencyUs = -1;
     {
         std::lock_guard<std::mutex> lck(mtxHoldCount_);
         if (waitDecoderOutputCount_ <= 0) {
@@ -394,8 +409,18 @@ void DecodeDataProcess::GetDecoderOutputBuffer(const sptr<Surface>& surface)
         } else {
             waitDecoderOutputCount_--;
         }
+        // frames come back in feed order, feed times beyond the frames still inside the decoder belong to this one
+        size_t pending = (waitDecoderOutputCount_ > 0) ? static_cast<size_t>(waitDecoderOutputCount_) : 0;
+        while (feedTimeUsQueue_.size() > pending + 1) {
+            feedTimeUsQueue_.pop();
+        }
+        if (!feedTimeUsQueue_.empty()) {
+            latencyUs = GetNowTimeStampUs() - feedTimeUsQueue_.front();
+            feedTimeUsQueue_.pop();
+        }
         DHLOGD("Wait decoder output frames number is %d.", waitDecoderOutputCount_);
     }
+    DCameraDegradeController::GetInstance().OnStageLatency(budgetKey_, DCAMERA_DEGRADE_STAGE_DECODE, latencyUs);
 }
 
 void DecodeDataProcess::CopyDecodedImage(const sptr<SurfaceBuffer>& surBuf, int64_t timeStampUs, int32_t alignedWidth,
@@ -555,6 +580,7 @@ int32_t DecodeDataProcess::DecodeDone(std::vector<std::shared_ptr<DataBuffer>> o
 
 void DecodeDataProcess::OnEvent(DCameraCodecEvent& ev)
 {
+    DCameraThreadPolicy::GetInstance().ApplyCurrentThread("DCamDecode", DCAMERA_TASK_TIER_FRAME);
     DHLOGD("Receiving asynchronous DCameraCodecEvents.");
     std::shared_ptr<CodecPacket> receivedCodecPacket = ev.GetCodecPacket();
     VideoCodecAction action = ev.GetAction();
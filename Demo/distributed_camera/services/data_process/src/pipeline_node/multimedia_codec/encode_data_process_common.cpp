@@ -22,6 +22,7 @@
 #include "graphic_common_c.h"
 
 #include "dcamera_utils_tools.h"
+#include "distributed_camera_constants.h"
 #include "encode_video_callback.h"
 
 #ifndef DH_LOG_TAG
@@ -41,6 +42,8 @@ const std::map<int64_t, int32_t> EncodeDataProcess::ENCODER_BITRATE_TABLE = {
     std::map<int64_t, int32_t>::value_type(WIDTH_1280_HEIGHT_720, BITRATE_3400000),
     std::map<int64_t, int32_t>::value_type(WIDTH_1440_HEIGHT_1080, BITRATE_5000000),
     std::map<int64_t, int32_t>::value_type(WIDTH_1920_HEIGHT_1080, BITRATE_6000000),
+    std::map<int64_t, int32_t>::value_type(WIDTH_2560_HEIGHT_1440, BITRATE_10000000),
+    std::map<int64_t, int32_t>::value_type(WIDTH_3840_HEIGHT_2160, BITRATE_16000000),
 };
 
 EncodeDataProcess::~EncodeDataProcess()
@@ -81,8 +84,8 @@ int32_t EncodeDataProcess::InitNode()
 
 bool EncodeDataProcess::IsInEncoderRange(const VideoConfigParams& curConfig)
 {
-    return (curConfig.GetWidth() >= MIN_VIDEO_WIDTH || curConfig.GetWidth() <= MAX_VIDEO_WIDTH ||
-        curConfig.GetHeight() >= MIN_VIDEO_HEIGHT || curConfig.GetHeight() <= MAX_VIDEO_HEIGHT ||
+    return (curConfig.GetWidth() >= MIN_VIDEO_WIDTH && curConfig.GetWidth() <= MAX_VIDEO_WIDTH &&
+        curConfig.GetHeight() >= MIN_VIDEO_HEIGHT && curConfig.GetHeight() <= MAX_VIDEO_HEIGHT &&
         curConfig.GetFrameRate() <= MAX_FRAME_RATE);
 }
 
@@ -151,10 +154,12 @@ int32_t EncodeDataProcess::InitEncoderMetadataFormat()
     int32_t width = (int32_t)sourceConfig_.GetWidth();
     int32_t height = (int32_t)sourceConfig_.GetHeight();
     metadataFormat_.PutIntValue("pixel_format",  Media::VideoPixelFormat::RGBA);
-    metadataFormat_.PutLongValue("max_input_size", width * height * 4);
+    // leave room for the row padding of the camera surface buffers
+    maxInputBufferSize_ = static_cast<int64_t>(width) * height * RGBA_BYTES_PER_PIXEL * INPUT_BUFFER_SIZE_FACTOR;
+    metadataFormat_.PutLongValue("max_input_size", maxInputBufferSize_);
     metadataFormat_.PutIntValue("width", width);
     metadataFormat_.PutIntValue("height", height);
-    metadataFormat_.PutIntValue("frame_rate", MAX_FRAME_RATE);
+    metadataFormat_.PutIntValue("frame_rate", (int32_t)sourceConfig_.GetFrameRate());
     return DCAMERA_OK;
 }
 
@@ -174,7 +179,7 @@ int32_t EncodeDataProcess::InitEncoderBitrateFormat()
     }
     int64_t pixelformat = static_cast<int64_t>(sourceConfig_.GetWidth() * sourceConfig_.GetHeight());
     int32_t matchedBitrate = BITRATE_6000000;
-    int64_t minPixelformatDiff = WIDTH_1920_HEIGHT_1080 - pixelformat;
+    int64_t minPixelformatDiff = WIDTH_3840_HEIGHT_2160 - pixelformat;
     for (auto it = ENCODER_BITRATE_TABLE.begin(); it != ENCODER_BITRATE_TABLE.end(); it++) {
         int64_t pixelformatDiff = abs(pixelformat - it->first);
         if (pixelformatDiff == 0) {
@@ -186,12 +191,42 @@ int32_t EncodeDataProcess::InitEncoderBitrateFormat()
             matchedBitrate = it->second;
         }
     }
+    if (sourceConfig_.GetFrameRate() > NORM_FRAME_RATE) {
+        matchedBitrate = static_cast<int32_t>(static_cast<int64_t>(matchedBitrate) * sourceConfig_.GetFrameRate() /
+            NORM_FRAME_RATE);
+    }
     DHLOGD("Source config: width : %d, height : %d, matched bitrate %d.", sourceConfig_.GetWidth(),
         sourceConfig_.GetHeight(), matchedBitrate);
     metadataFormat_.PutIntValue("bitrate", matchedBitrate);
+    encoderBitrate_ = matchedBitrate;
+    bitratePercent_ = static_cast<int32_t>(DCAMERA_DEGRADE_PERCENT_FULL);
     return DCAMERA_OK;
 }
 
+void EncodeDataProcess::UpdateEncoderBitrate(const std::shared_ptr<DataBuffer>& inputBuffer)
+{
+    int32_t bitratePercent = 0;
+    if (!inputBuffer->FindInt32("bitratePercent", bitratePercent) || bitratePercent <= 0 ||
+        bitratePercent == bitratePercent_ || encoderBitrate_ == 0) {
+        return;
+    }
+    int32_t bitrate = static_cast<int32_t>(static_cast<int64_t>(encoderBitrate_) * bitratePercent /
+        DCAMERA_DEGRADE_PERCENT_FULL);
+    Media::Format format;
+    format.PutIntValue("bitrate", bitrate);
+    std::lock_guard<std::mutex> lck(mtxEncoderState_);
+    if (videoEncoder_ == nullptr) {
+        return;
+    }
+    int32_t ret = videoEncoder_->SetParameter(format);
+    if (ret != Media::MediaServiceErrCode::MSERR_OK) {
+        DHLOGE("Update video encoder bitrate %d fail.", bitrate);
+        return;
+    }
+    bitratePercent_ = bitratePercent;
+    DHLOGI("Update video encoder bitrate %d, percent %d.", bitrate, bitratePercent);
+}
+
 void EncodeDataProcess::ReleaseProcessNode()
 {
     DHLOGD("Start release [%d] node : EncodeNode.", nodeRank_);
@@ -216,6 +251,8 @@ void EncodeDataProcess::ReleaseProcessNode()
     waitEncoderOutputCount_ = 0;
     lastFeedEncoderInputBufferTimeUs_ = 0;
     inputTimeStampUs_ = 0;
+    encoderBitrate_ = 0;
+    bitratePercent_ = 0;
     processType_ = "";
     DHLOGD("Release [%d] node : EncodeNode end.", nodeRank_);
 }
@@ -237,15 +274,15 @@ int32_t EncodeDataProcess::ProcessData(std::vector<std::shared_ptr<DataBuffer>>&
         DHLOGE("The video encoder does not exist before encoding data.");
         return DCAMERA_INIT_ERR;
     }
-    size_t bufferSize = 1920 * 1808 * 4;
-    if (inputBuffers[0]->Size() > bufferSize) {
-        DHLOGE("EncodeNode input buffer size %d error.", inputBuffers[0]->Size());
+    if (static_cast<int64_t>(inputBuffers[0]->Size()) > maxInputBufferSize_) {
+        DHLOGE("EncodeNode input buffer size %zu error.", inputBuffers[0]->Size());
         return DCAMERA_MEMORY_OPT_ERROR;
     }
     if (!isEncoderProcess_) {
         DHLOGE("EncodeNode occurred error or start release.");
         return DCAMERA_DISABLE_PROCESS;
     }
+    UpdateEncoderBitrate(inputBuffers[0]);
     int32_t err = FeedEncoderInputBuffer(inputBuffers[0]);
     if (err != DCAMERA_OK) {
         DHLOGE("Feed encoder input Buffer fail.");